@@ -28,7 +28,10 @@
 #include "util/traits.hpp"
 #include "hipSYCL/algorithms/util/allocation_cache.hpp"
 #include "hipSYCL/algorithms/util/memory_streaming.hpp"
+#include "hipSYCL/algorithms/numeric.hpp"
 #include "hipSYCL/algorithms/sort/bitonic_sort.hpp"
+#include "hipSYCL/algorithms/sort/merge_sort.hpp"
+#include "hipSYCL/algorithms/sort/radix_sort.hpp"
 #include "hipSYCL/algorithms/merge/merge.hpp"
 #include "hipSYCL/algorithms/scan/scan.hpp"
 
@@ -80,18 +83,107 @@ inline bool should_use_memset(const sycl::device& dev) {
 
 }
 
+namespace detail {
+
+// Kernel bodies of the element-wise algorithms, invoked with the index
+// of the element. They are also used by stdpar to fuse several
+// element-wise algorithms into one kernel.
+
+template <class ForwardIt, class UnaryFunction2>
+auto for_each_kernel(ForwardIt first, UnaryFunction2 f) {
+  return [=](std::size_t i) {
+    auto it = first;
+    std::advance(it, i);
+    f(*it);
+  };
+}
+
+template <class ForwardIt1, class ForwardIt2, class UnaryOperation>
+auto transform_kernel(ForwardIt1 first1, ForwardIt2 d_first,
+                      UnaryOperation unary_op) {
+  return [=](std::size_t i) {
+    auto input = first1;
+    auto output = d_first;
+    std::advance(input, i);
+    std::advance(output, i);
+    *output = unary_op(*input);
+  };
+}
+
+template <class ForwardIt1, class ForwardIt2, class ForwardIt3,
+          class BinaryOperation>
+auto transform_kernel(ForwardIt1 first1, ForwardIt2 first2, ForwardIt3 d_first,
+                      BinaryOperation binary_op) {
+  return [=](std::size_t i) {
+    auto input1 = first1;
+    auto input2 = first2;
+    auto output = d_first;
+    std::advance(input1, i);
+    std::advance(input2, i);
+    std::advance(output, i);
+    *output = binary_op(*input1, *input2);
+  };
+}
+
+template <class ForwardIt, class Generator>
+auto generate_kernel(ForwardIt first, Generator g) {
+  return [=](std::size_t i) {
+    auto it = first;
+    std::advance(it, i);
+    *it = g();
+  };
+}
+
+template <class ForwardIt, class T>
+auto replace_kernel(ForwardIt first, const T &old_value, const T &new_value) {
+  return for_each_kernel(first, [=](auto& x){
+    if(x == old_value)
+      x = new_value;
+  });
+}
+
+template <class ForwardIt, class UnaryPredicate, class T>
+auto replace_if_kernel(ForwardIt first, UnaryPredicate p, const T &new_value) {
+  return for_each_kernel(first, [=](auto& x){
+    if(p(x))
+      x = new_value;
+  });
+}
+
+template <class ForwardIt1, class ForwardIt2, class UnaryPredicate, class T>
+auto replace_copy_if_kernel(ForwardIt1 first, ForwardIt2 d_first,
+                            UnaryPredicate p, const T &new_value) {
+  return [=](std::size_t i) {
+    auto input = first;
+    auto output = d_first;
+    std::advance(input, i);
+    std::advance(output, i);
+    if (p(*input)) {
+      *output = new_value;
+    } else {
+      *output = *input;
+    }
+  };
+}
+
+template <class Kernel>
+sycl::event element_wise_parallel_for(sycl::queue &q, std::size_t problem_size,
+                                      Kernel k,
+                                      const std::vector<sycl::event> &deps) {
+  return q.parallel_for(sycl::range{problem_size}, deps,
+                        [=](sycl::id<1> id) { k(id[0]); });
+}
+
+}
+
 template <class ForwardIt, class UnaryFunction2>
 sycl::event for_each(sycl::queue &q, ForwardIt first, ForwardIt last,
                      UnaryFunction2 f,
                      const std::vector<sycl::event> &deps = {}) {
   if(first == last)
     return sycl::event{};
-  return q.parallel_for(sycl::range{std::distance(first, last)}, deps,
-                        [=](sycl::id<1> id) {
-                          auto it = first;
-                          std::advance(it, id[0]);
-                          f(*it);
-                        });
+  return detail::element_wise_parallel_for(
+      q, std::distance(first, last), detail::for_each_kernel(first, f), deps);
 }
 
 template <class ForwardIt, class Size, class UnaryFunction2>
@@ -103,12 +195,8 @@ sycl::event for_each_n(sycl::queue &q, ForwardIt first, Size n,
     // This means it does not respect prior tasks in the task graph!
     // TODO Is this okay? Can we defer this responsibility to the user?
     return sycl::event{};
-  return q.parallel_for(sycl::range{static_cast<size_t>(n)}, deps,
-                        [=](sycl::id<1> id) {
-                          auto it = first;
-                          std::advance(it, id[0]);
-                          f(*it);
-                        });
+  return detail::element_wise_parallel_for(
+      q, static_cast<size_t>(n), detail::for_each_kernel(first, f), deps);
 }
 
 template <class ForwardIt1, class ForwardIt2, class UnaryOperation>
@@ -117,14 +205,9 @@ sycl::event transform(sycl::queue &q, ForwardIt1 first1, ForwardIt1 last1,
                       const std::vector<sycl::event> &deps = {}) {
   if(first1 == last1)
     return sycl::event{};
-  return q.parallel_for(sycl::range{std::distance(first1, last1)}, deps,
-                        [=](sycl::id<1> id) {
-                          auto input = first1;
-                          auto output = d_first;
-                          std::advance(input, id[0]);
-                          std::advance(output, id[0]);
-                          *output = unary_op(*input);
-                        });
+  return detail::element_wise_parallel_for(
+      q, std::distance(first1, last1),
+      detail::transform_kernel(first1, d_first, unary_op), deps);
 }
 
 template <class ForwardIt1, class ForwardIt2, class ForwardIt3,
@@ -135,16 +218,9 @@ sycl::event transform(sycl::queue &q, ForwardIt1 first1, ForwardIt1 last1,
                       const std::vector<sycl::event> &deps = {}) {
   if(first1 == last1)
     return sycl::event{};
-  return q.parallel_for(sycl::range{std::distance(first1, last1)}, deps,
-                        [=](sycl::id<1> id) {
-                          auto input1 = first1;
-                          auto input2 = first2;
-                          auto output = d_first;
-                          std::advance(input1, id[0]);
-                          std::advance(input2, id[0]);
-                          std::advance(output, id[0]);
-                          *output = binary_op(*input1, *input2);
-                        });
+  return detail::element_wise_parallel_for(
+      q, std::distance(first1, last1),
+      detail::transform_kernel(first1, first2, d_first, binary_op), deps);
 }
 
 template <class ForwardIt1, class ForwardIt2>
@@ -305,12 +381,8 @@ sycl::event generate(sycl::queue &q, ForwardIt first, ForwardIt last,
                      Generator g, const std::vector<sycl::event> &deps = {}) {
   if(first == last)
     return sycl::event{};
-  return q.parallel_for(sycl::range{std::distance(first, last)}, deps,
-                        [=](sycl::id<1> id) {
-                          auto it = first;
-                          std::advance(it, id[0]);
-                          *it = g();
-                        });
+  return detail::element_wise_parallel_for(
+      q, std::distance(first, last), detail::generate_kernel(first, g), deps);
 }
 
 template <class ForwardIt, class Size, class Generator>
@@ -318,12 +390,8 @@ sycl::event generate_n(sycl::queue &q, ForwardIt first, Size count, Generator g,
                        const std::vector<sycl::event> &deps = {}) {
   if(count <= 0)
     return sycl::event{};
-  return q.parallel_for(sycl::range{static_cast<size_t>(count)}, deps,
-                        [=](sycl::id<1> id) {
-                          auto it = first;
-                          std::advance(it, id[0]);
-                          *it = g();
-                        });
+  return detail::element_wise_parallel_for(
+      q, static_cast<size_t>(count), detail::generate_kernel(first, g), deps);
 }
 
 template <class ForwardIt, class T>
@@ -332,10 +400,9 @@ sycl::event replace(sycl::queue &q, ForwardIt first, ForwardIt last,
                     const std::vector<sycl::event> &deps = {}) {
   if(first == last)
     return sycl::event{};
-  return for_each(q, first, last,[=](auto& x){
-    if(x == old_value)
-      x = new_value;
-  }, deps);
+  return detail::element_wise_parallel_for(
+      q, std::distance(first, last),
+      detail::replace_kernel(first, old_value, new_value), deps);
 }
 
 template <class ForwardIt, class UnaryPredicate, class T>
@@ -344,10 +411,9 @@ sycl::event replace_if(sycl::queue &q, ForwardIt first, ForwardIt last,
                        const std::vector<sycl::event> &deps = {}) {
   if(first == last)
     return sycl::event{};
-  return for_each(q, first, last, [=](auto& x){
-    if(p(x))
-      x = new_value;
-  }, deps);
+  return detail::element_wise_parallel_for(
+      q, std::distance(first, last),
+      detail::replace_if_kernel(first, p, new_value), deps);
 }
 
 template <class ForwardIt1, class ForwardIt2, class UnaryPredicate, class T>
@@ -357,18 +423,9 @@ sycl::event replace_copy_if(sycl::queue &q, ForwardIt1 first, ForwardIt1 last,
                             const std::vector<sycl::event> &deps = {}) {
   if (first == last)
     return sycl::event{};
-  return q.parallel_for(sycl::range{std::distance(first, last)}, deps,
-                        [=](sycl::id<1> id) {
-                          auto input = first;
-                          auto output = d_first;
-                          std::advance(input, id[0]);
-                          std::advance(output, id[0]);
-                          if (p(*input)) {
-                            *output = new_value;
-                          } else {
-                            *output = *input;
-                          }
-                        });
+  return detail::element_wise_parallel_for(
+      q, std::distance(first, last),
+      detail::replace_copy_if_kernel(first, d_first, p, new_value), deps);
 }
 
 template <class ForwardIt1, class ForwardIt2, class T>
@@ -383,42 +440,6 @@ sycl::event replace_copy(sycl::queue &q, ForwardIt1 first, ForwardIt1 last,
       new_value, deps);
 }
 
-// Need transform_reduce functionality for find etc, so forward
-// declare here.
-/*template <class ForwardIt, class T, class BinaryReductionOp,
-          class UnaryTransformOp>
-sycl::event
-transform_reduce(sycl::queue &q, util::allocation_group &scratch_allocations,
-                 ForwardIt first, ForwardIt last, T* out, T init,
-                 BinaryReductionOp reduce, UnaryTransformOp transform,
-                 const std::vector<sycl::event> &deps);
-
-// Need transform_reduce functionality for find etc, so forward
-// declare here.
-template <class ForwardIt, class T, class BinaryReductionOp,
-          class UnaryTransformOp>
-sycl::event
-transform_reduce(sycl::queue &q, util::allocation_group &scratch_allocations,
-                 ForwardIt first, ForwardIt last, T* out, T init,
-                 BinaryReductionOp reduce, UnaryTransformOp transform);
-
-template <class ForwardIt, class T>
-sycl::event find(sycl::queue &q, util::allocation_group &scratch_allocations, ForwardIt first, ForwardIt last,
-                 typename std::iterator_traits<ForwardIt>::difference_type* out, const T &value) {
-  using difference_type = typename std::iterator_traits<ForwardIt>::difference_type;
-  
-  return transform_reduce(q, scratch_allocations, first, last, out, std::distance(first, last), sycl::minimum<difference_type>{},)
-}
-
-template <class ForwardIt, class UnaryPredicate>
-sycl::event find_if(sycl::queue &q, util::allocation_group &scratch_allocations, ForwardIt first, ForwardIt last,
-                    typename std::iterator_traits<ForwardIt>::difference_type* out, UnaryPredicate p);
-
-template <class ForwardIt, class UnaryPredicate>
-sycl::event find_if_not(sycl::queue &q, util::allocation_group &scratch_allocations, ForwardIt first, ForwardIt last,
-                        typename std::iterator_traits<ForwardIt>::difference_type* out, UnaryPredicate p);
-*/
-
 namespace detail {
 using early_exit_flag_t = int;
 
@@ -466,6 +487,74 @@ sycl::event early_exit_for_each(sycl::queue &q, std::size_t problem_size,
                         kernel);
 }
 
+// predicate must be a callable of type bool(sycl::id<1>).
+// Stores the lowest index for which the predicate returns true in out,
+// or problem_size if there is no such index. Work items stop as soon as
+// all indices that they have yet to process are larger than the
+// lowest index found so far.
+template <class Index, class Predicate>
+sycl::event early_exit_find_first(sycl::queue &q, std::size_t problem_size,
+                                  Index *out, Predicate pred,
+                                  const std::vector<sycl::event> &deps = {}) {
+
+  std::size_t group_size = 128;
+
+  util::abortable_data_streamer streamer{q.get_device(), problem_size, group_size};
+
+  std::size_t dispatched_global_size = streamer.get_required_global_size();
+
+  auto kernel = [=](sycl::nd_item<1> idx) {
+      util::abortable_data_streamer::run(problem_size, idx, [&](sycl::id<1> idx){
+        const Index current = static_cast<Index>(idx[0]);
+        // Each work item processes its indices in increasing order,
+        // so none of the remaining ones can improve the result.
+        if (current >= sycl::detail::__acpp_atomic_load<
+                           sycl::access::address_space::global_space>(
+                           out, sycl::memory_order_relaxed,
+                           sycl::memory_scope_device)) {
+          return true;
+        }
+
+        if (pred(idx)) {
+          sycl::detail::__acpp_atomic_fetch_min<
+              sycl::access::address_space::global_space>(
+              out, current, sycl::memory_order_relaxed,
+              sycl::memory_scope_device);
+          return true;
+        }
+
+        return false;
+      });
+    };
+
+  auto evt = q.single_task(deps, [=](){*out = static_cast<Index>(problem_size);});
+  return q.parallel_for(sycl::nd_range<1>{dispatched_global_size, group_size}, evt,
+                        kernel);
+}
+
+// Reduces element indices to the index of the first element that is
+// preferred over all others. prefer(a, b) must return true if a
+// is preferred over b.
+template <class Index, class Preference>
+sycl::event find_preferred_element(sycl::queue &q,
+                                   util::allocation_group &scratch_allocations,
+                                   std::size_t problem_size, Index *out,
+                                   Preference prefer,
+                                   const std::vector<sycl::event> &deps) {
+  auto kernel = [=](sycl::id<1> idx, auto& reducer) {
+    reducer.combine(static_cast<Index>(idx[0]));
+  };
+  auto op = [=](Index a, Index b) -> Index {
+    if(prefer(b, a))
+      return b;
+    if(prefer(a, b))
+      return a;
+    return a < b ? a : b;
+  };
+  return transform_reduce_impl(q, scratch_allocations, out, Index{0},
+                               problem_size, kernel, op, deps);
+}
+
 }
 
 template <class ForwardIt, class UnaryPredicate>
@@ -515,7 +604,165 @@ sycl::event none_of(sycl::queue &q,
   });
 }
 
-template <class RandomIt, class Compare>
+// Note: The find and mismatch variants store the position of the result
+// relative to first in out, or the problem size if there is no result.
+// If the problem size is 0, out remains untouched.
+template <class ForwardIt, class UnaryPredicate>
+sycl::event
+find_if(sycl::queue &q, ForwardIt first, ForwardIt last,
+        typename std::iterator_traits<ForwardIt>::difference_type *out,
+        UnaryPredicate p, const std::vector<sycl::event> &deps = {}) {
+  std::size_t problem_size = std::distance(first, last);
+  if(problem_size == 0)
+    return sycl::event{};
+  return detail::early_exit_find_first(q, problem_size, out,
+                                       [=](sycl::id<1> idx) -> bool {
+                                         auto it = first;
+                                         std::advance(it, idx[0]);
+                                         return p(*it);
+                                       }, deps);
+}
+
+template <class ForwardIt, class UnaryPredicate>
+sycl::event
+find_if_not(sycl::queue &q, ForwardIt first, ForwardIt last,
+            typename std::iterator_traits<ForwardIt>::difference_type *out,
+            UnaryPredicate p, const std::vector<sycl::event> &deps = {}) {
+  return find_if(q, first, last, out,
+                 [=](const auto &x) { return !p(x); }, deps);
+}
+
+template <class ForwardIt, class T>
+sycl::event find(sycl::queue &q, ForwardIt first, ForwardIt last,
+                 typename std::iterator_traits<ForwardIt>::difference_type *out,
+                 const T &value, const std::vector<sycl::event> &deps = {}) {
+  return find_if(q, first, last, out,
+                 [=](const auto &x) { return x == value; }, deps);
+}
+
+/// If there are fewer than two elements, out remains untouched.
+template <class ForwardIt, class BinaryPredicate = std::equal_to<>>
+sycl::event
+adjacent_find(sycl::queue &q, ForwardIt first, ForwardIt last,
+              typename std::iterator_traits<ForwardIt>::difference_type *out,
+              BinaryPredicate p = std::equal_to<>{},
+              const std::vector<sycl::event> &deps = {}) {
+  using difference_type =
+      typename std::iterator_traits<ForwardIt>::difference_type;
+  std::size_t problem_size = std::distance(first, last);
+  if(problem_size < 2)
+    return sycl::event{};
+  // If no pair matches, the result is problem_size - 1 at this point.
+  auto evt = detail::early_exit_find_first(q, problem_size - 1, out,
+                                           [=](sycl::id<1> idx) -> bool {
+                                             auto it = first;
+                                             std::advance(it, idx[0]);
+                                             auto next = it;
+                                             ++next;
+                                             return p(*it, *next);
+                                           }, deps);
+  return q.single_task(evt, [=](){
+    if(*out == static_cast<difference_type>(problem_size - 1))
+      *out = static_cast<difference_type>(problem_size);
+  });
+}
+
+template <class ForwardIt1, class ForwardIt2,
+          class BinaryPredicate = std::equal_to<>>
+sycl::event
+mismatch(sycl::queue &q, ForwardIt1 first1, ForwardIt1 last1,
+         ForwardIt2 first2,
+         typename std::iterator_traits<ForwardIt1>::difference_type *out,
+         BinaryPredicate p = std::equal_to<>{},
+         const std::vector<sycl::event> &deps = {}) {
+  std::size_t problem_size = std::distance(first1, last1);
+  if(problem_size == 0)
+    return sycl::event{};
+  return detail::early_exit_find_first(q, problem_size, out,
+                                       [=](sycl::id<1> idx) -> bool {
+                                         auto it1 = first1;
+                                         auto it2 = first2;
+                                         std::advance(it1, idx[0]);
+                                         std::advance(it2, idx[0]);
+                                         return !p(*it1, *it2);
+                                       }, deps);
+}
+
+// Note: Like transform_reduce, the following algorithms leave out untouched
+// if first == last.
+template <class ForwardIt, class UnaryPredicate>
+sycl::event
+count_if(sycl::queue &q, util::allocation_group &scratch_allocations,
+         ForwardIt first, ForwardIt last,
+         typename std::iterator_traits<ForwardIt>::difference_type *out,
+         UnaryPredicate p, const std::vector<sycl::event> &deps = {}) {
+  using difference_type =
+      typename std::iterator_traits<ForwardIt>::difference_type;
+  return transform_reduce(
+      q, scratch_allocations, first, last, out, difference_type{0},
+      std::plus<difference_type>{},
+      [=](const auto &x) -> difference_type { return p(x) ? 1 : 0; }, deps);
+}
+
+template <class ForwardIt, class T>
+sycl::event
+count(sycl::queue &q, util::allocation_group &scratch_allocations,
+      ForwardIt first, ForwardIt last,
+      typename std::iterator_traits<ForwardIt>::difference_type *out,
+      const T &value, const std::vector<sycl::event> &deps = {}) {
+  return count_if(q, scratch_allocations, first, last, out,
+                  [=](const auto &x) { return x == value; }, deps);
+}
+
+/// Stores the position of the first smallest element relative to first
+/// in out.
+template <class ForwardIt, class Compare = std::less<>>
+sycl::event
+min_element(sycl::queue &q, util::allocation_group &scratch_allocations,
+            ForwardIt first, ForwardIt last,
+            typename std::iterator_traits<ForwardIt>::difference_type *out,
+            Compare comp = std::less<>{},
+            const std::vector<sycl::event> &deps = {}) {
+  if(first == last)
+    return sycl::event{};
+  using difference_type =
+      typename std::iterator_traits<ForwardIt>::difference_type;
+  return detail::find_preferred_element(
+      q, scratch_allocations, std::distance(first, last), out,
+      [=](difference_type a, difference_type b) {
+        auto it_a = first;
+        auto it_b = first;
+        std::advance(it_a, a);
+        std::advance(it_b, b);
+        return comp(*it_a, *it_b);
+      }, deps);
+}
+
+/// Stores the position of the first largest element relative to first
+/// in out.
+template <class ForwardIt, class Compare = std::less<>>
+sycl::event
+max_element(sycl::queue &q, util::allocation_group &scratch_allocations,
+            ForwardIt first, ForwardIt last,
+            typename std::iterator_traits<ForwardIt>::difference_type *out,
+            Compare comp = std::less<>{},
+            const std::vector<sycl::event> &deps = {}) {
+  if(first == last)
+    return sycl::event{};
+  using difference_type =
+      typename std::iterator_traits<ForwardIt>::difference_type;
+  return detail::find_preferred_element(
+      q, scratch_allocations, std::distance(first, last), out,
+      [=](difference_type a, difference_type b) {
+        auto it_a = first;
+        auto it_b = first;
+        std::advance(it_a, a);
+        std::advance(it_b, b);
+        return comp(*it_b, *it_a);
+      }, deps);
+}
+
+template <class RandomIt, class Compare = std::less<>>
 sycl::event sort(sycl::queue &q, RandomIt first, RandomIt last,
                  Compare comp = std::less<>{},
                  const std::vector<sycl::event>& deps = {}) {
@@ -526,6 +773,46 @@ sycl::event sort(sycl::queue &q, RandomIt first, RandomIt last,
   return sorting::bitonic_sort(q, first, last, comp, deps);
 }
 
+template <class RandomIt, class Compare = std::less<>>
+sycl::event sort(sycl::queue &q, util::allocation_group &scratch_allocations,
+                 RandomIt first, RandomIt last, Compare comp = std::less<>{},
+                 const std::vector<sycl::event> &deps = {}) {
+  std::size_t problem_size = std::distance(first, last);
+  if(problem_size == 0)
+    return sycl::event{};
+
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  if constexpr (sorting::is_radix_sortable<T, Compare>()) {
+    if (problem_size <= sorting::get_max_radix_sort_size())
+      return sorting::radix_sort(q, scratch_allocations, first, last, comp,
+                                 deps);
+  }
+  if constexpr (std::is_trivially_copyable_v<T>)
+    return sorting::merge_sort(q, scratch_allocations, first, last, comp,
+                               deps);
+  else
+    return sorting::bitonic_sort(q, first, last, comp, deps);
+}
+
+/// Requires trivially copyable elements.
+template <class RandomIt, class Compare = std::less<>>
+sycl::event stable_sort(sycl::queue &q,
+                        util::allocation_group &scratch_allocations,
+                        RandomIt first, RandomIt last,
+                        Compare comp = std::less<>{},
+                        const std::vector<sycl::event> &deps = {}) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  static_assert(std::is_trivially_copyable_v<T>,
+                "stable_sort requires trivially copyable elements");
+  // Radix sort orders -0.0 before 0.0 even though they compare equal, so
+  // it is only stable for integral keys.
+  if constexpr (std::is_floating_point_v<T>)
+    return sorting::merge_sort(q, scratch_allocations, first, last, comp,
+                               deps);
+  else
+    return sort(q, scratch_allocations, first, last, comp, deps);
+}
+
 template< class ForwardIt1, class ForwardIt2,
           class ForwardIt3, class Compare >
 sycl::event merge(sycl::queue& q,
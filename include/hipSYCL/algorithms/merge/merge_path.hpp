@@ -83,21 +83,10 @@ private:
                      Size size1, Size size2,
                      Size diag_index, Size &array1_index_out,
                      Size &array2_index_out) {
-    
-    if(size1 <= 1 && size2 <= 1) {
-      array1_index_out = 0;
-      array2_index_out = 0;
-      return;
-    }
 
+    // Note: Short diagonals, including the first and the last one, are
+    // handled correctly by the binary search below.
     Size dlen = diag_length(size1, size2, diag_index);
-    
-
-    if(dlen <= 1) {
-      array1_index_out = 0;
-      array2_index_out = 0;
-      return;
-    }
 
     // The idea behind the merge path algorithm is to create the merge matrix, where the
     // [i][j] entries are 1 exactly if comp(first1[i],first2[j]) == true, and 0
@@ -160,6 +160,29 @@ sycl::event transform_reduce_impl(sycl::queue &q,
 
 }
 
+// Per-element kernel bodies of transform_reduce. They are also used by
+// stdpar to fuse preceding element-wise algorithms into the reduction.
+template <class ForwardIt1, class ForwardIt2, class BinaryTransformOp>
+auto transform_reduce_kernel(ForwardIt1 first1, ForwardIt2 first2,
+                             BinaryTransformOp transform) {
+  return [=](sycl::id<1> idx, auto& reducer) {
+    auto input_a = first1;
+    auto input_b = first2;
+    std::advance(input_a, idx[0]);
+    std::advance(input_b, idx[0]);
+    reducer.combine(transform(*input_a, *input_b));
+  };
+}
+
+template <class ForwardIt, class UnaryTransformOp>
+auto transform_reduce_kernel(ForwardIt first, UnaryTransformOp transform) {
+  return [=](sycl::id<1> idx, auto& reducer) {
+    auto input = first;
+    std::advance(input, idx[0]);
+    reducer.combine(transform(*input));
+  };
+}
+
 }
 
 // Note: All transform_reduce variants defined here behave slightly different than STL
@@ -179,13 +202,7 @@ transform_reduce(sycl::queue &q, util::allocation_group &scratch_allocations,
     return sycl::event{};
   
   std::size_t n = std::distance(first1, last1);
-  auto kernel = [=](sycl::id<1> idx, auto& reducer) {
-    auto input_a = first1;
-    auto input_b = first2;
-    std::advance(input_a, idx[0]);
-    std::advance(input_b, idx[0]);
-    reducer.combine(transform(*input_a, *input_b));
-  };
+  auto kernel = detail::transform_reduce_kernel(first1, first2, transform);
 
   return detail::transform_reduce_impl(q, scratch_allocations, out, init, n,
                                        kernel, reduce, deps);
@@ -202,11 +219,7 @@ transform_reduce(sycl::queue &q, util::allocation_group &scratch_allocations,
     return sycl::event{};
   
   std::size_t n = std::distance(first, last);
-  auto kernel = [=](sycl::id<1> idx, auto& reducer) {
-    auto input = first;
-    std::advance(input, idx[0]);
-    reducer.combine(transform(*input));
-  };
+  auto kernel = detail::transform_reduce_kernel(first, transform);
 
   return detail::transform_reduce_impl(q, scratch_allocations, out, init, n,
                                        kernel, reduce, deps);
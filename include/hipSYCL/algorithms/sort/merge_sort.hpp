@@ -0,0 +1,284 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef ACPP_ALGORITHMS_MERGE_SORT
+#define ACPP_ALGORITHMS_MERGE_SORT
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "hipSYCL/sycl/queue.hpp"
+#include "hipSYCL/sycl/libkernel/group_functions.hpp"
+#include "hipSYCL/algorithms/util/allocation_cache.hpp"
+#include "hipSYCL/algorithms/merge/merge.hpp"
+#include "hipSYCL/algorithms/merge/merge_path.hpp"
+
+namespace hipsycl::algorithms::sorting {
+
+namespace detail {
+
+// Number of elements that each work item sorts before the merge passes
+// on the host
+constexpr std::size_t merge_sort_block_size = 16;
+// Number of output elements that each work item produces in a merge pass
+constexpr std::size_t merge_sort_segment_size = 128;
+// On devices, work groups sort blocks in local memory before the global
+// merge passes. Each work item sorts this many elements at first, and then
+// produces this many elements in each merge pass within the group.
+constexpr std::size_t merge_sort_local_item_size = 8;
+constexpr std::size_t merge_sort_max_group_size = 128;
+// Local memory used by the two buffers of a work group, in bytes
+constexpr std::size_t merge_sort_local_memory_size = 16 * 1024;
+
+template<class T>
+constexpr std::size_t get_merge_sort_group_size() {
+  std::size_t group_size = merge_sort_max_group_size;
+  while(group_size > 1 && 2 * group_size * merge_sort_local_item_size *
+                                  sizeof(T) > merge_sort_local_memory_size)
+    group_size /= 2;
+  return group_size;
+}
+
+template<class RandomIt, class Compare>
+void insertion_sort(RandomIt first, std::size_t size, Compare comp) {
+  for(std::size_t i = 1; i < size; ++i) {
+    auto current = first;
+    std::advance(current, i);
+    auto x = *current;
+
+    std::size_t j = i;
+    for(; j > 0; --j) {
+      auto prev = first;
+      std::advance(prev, j - 1);
+      // Strict comparison keeps equivalent elements in order
+      if(!comp(x, *prev))
+        break;
+      auto target = first;
+      std::advance(target, j);
+      *target = *prev;
+    }
+    auto target = first;
+    std::advance(target, j);
+    *target = x;
+  }
+}
+
+// Produces the elements [segment_begin, segment_end) of the output of a merge
+// pass, in which pairs of adjacent sorted runs of size run_size are merged.
+template <class InputIt, class OutputIt, class Compare>
+void merge_sort_pass_segment(InputIt in, OutputIt out, std::size_t problem_size,
+                             std::size_t run_size, Compare comp,
+                             std::size_t segment_begin,
+                             std::size_t segment_end) {
+  std::size_t pos = segment_begin;
+  while(pos < segment_end) {
+    std::size_t pair_begin = pos / (2 * run_size) * (2 * run_size);
+    std::size_t pair_mid = std::min(pair_begin + run_size, problem_size);
+    std::size_t pair_end = std::min(pair_begin + 2 * run_size, problem_size);
+    std::size_t count = std::min(segment_end, pair_end) - pos;
+    std::size_t diag = pos - pair_begin;
+
+    auto left_first = in;
+    std::advance(left_first, pair_begin);
+    auto left_last = in;
+    std::advance(left_last, pair_mid);
+    auto right_last = in;
+    std::advance(right_last, pair_end);
+
+    auto segment_out = out;
+    std::advance(segment_out, pos);
+
+    if(pair_mid == pair_end) {
+      // No right run to merge with
+      auto segment_in = left_first;
+      std::advance(segment_in, diag);
+      for(std::size_t i = 0; i < count; ++i, ++segment_in, ++segment_out)
+        *segment_out = *segment_in;
+    } else {
+      // merging::sequential_merge prefers elements from its second input
+      // if they are equivalent, so pass the right run first to obtain a
+      // stable merge.
+      std::size_t right_pos = 0;
+      std::size_t left_pos = 0;
+      merging::merge_path::nth_independent_merge_begin(
+          left_last, right_last, left_first, left_last, comp, diag,
+          std::size_t{1}, right_pos, left_pos);
+
+      auto right_first = left_last;
+      std::advance(right_first, right_pos);
+      std::advance(left_first, left_pos);
+      merging::detail::sequential_merge(right_first, right_last, left_first,
+                                        left_last, segment_out, comp, count);
+    }
+    pos += count;
+  }
+}
+
+// Sorts the block of the input that belongs to the work group of idx.
+// The block is loaded into local memory, where each work item sorts a few
+// elements, which are then merged within the group.
+template <class RandomIt, class Compare, class T>
+void local_block_sort(sycl::nd_item<1> idx, RandomIt first,
+                      std::size_t problem_size, Compare comp, T *local_in,
+                      T *local_out) {
+  const std::size_t group_size = idx.get_local_range(0);
+  const std::size_t local_id = idx.get_local_id(0);
+  const std::size_t group_block_size = group_size * merge_sort_local_item_size;
+  const std::size_t group_begin = idx.get_group_linear_id() * group_block_size;
+  const std::size_t size = std::min(group_block_size, problem_size - group_begin);
+
+  auto group_first = first;
+  std::advance(group_first, group_begin);
+  for(std::size_t i = local_id; i < size; i += group_size)
+    local_in[i] = group_first[i];
+  sycl::group_barrier(idx.get_group());
+
+  const std::size_t item_begin = local_id * merge_sort_local_item_size;
+  const std::size_t item_end =
+      std::min(item_begin + merge_sort_local_item_size, size);
+  if(item_begin < size)
+    insertion_sort(local_in + item_begin, item_end - item_begin, comp);
+  sycl::group_barrier(idx.get_group());
+
+  // size is the same for all work items of the group, so all of
+  // them take part in every barrier.
+  for(std::size_t run_size = merge_sort_local_item_size; run_size < size;
+      run_size *= 2) {
+    if(item_begin < size)
+      merge_sort_pass_segment(local_in, local_out, size, run_size, comp,
+                              item_begin, item_end);
+    sycl::group_barrier(idx.get_group());
+    std::swap(local_in, local_out);
+  }
+
+  for(std::size_t i = local_id; i < size; i += group_size)
+    group_first[i] = local_in[i];
+}
+
+}
+
+/// Stable merge sort for arbitrary comparators. Blocks of the input are first
+/// sorted individually, and then merged in log(n/block size) passes. Each
+/// merge pass is a single kernel, where every work item produces a
+/// fixed-size segment of the output whose inputs are found using the merge
+/// path algorithm.
+///
+/// On devices, each work group sorts a block of
+/// group size * \c merge_sort_local_item_size elements in local memory,
+/// using the same merge path passes within the group. On the host, where
+/// group barriers are expensive, each work item sorts a block of
+/// \c merge_sort_block_size elements instead.
+///
+/// Requires scratch memory for a copy of the input from \c scratch_alloc,
+/// which needs to provide device-accessible memory. Elements are assigned
+/// to the uninitialized scratch memory, so they must be trivially copyable.
+template <class RandomIt, class Compare>
+sycl::event merge_sort(sycl::queue &q, util::allocation_group &scratch_alloc,
+                       RandomIt first, RandomIt last, Compare comp,
+                       const std::vector<sycl::event> &deps = {}) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  static_assert(std::is_trivially_copyable_v<T>,
+                "merge_sort requires trivially copyable elements");
+
+  std::size_t problem_size = std::distance(first, last);
+  if(problem_size == 0)
+    return sycl::event{};
+
+  constexpr std::size_t segment_size = detail::merge_sort_segment_size;
+
+  const bool is_host = q.get_device().get_backend() == sycl::backend::omp;
+  std::size_t block_size = 0;
+  sycl::event most_recent_event;
+  if(is_host) {
+    block_size = detail::merge_sort_block_size;
+    std::size_t num_blocks = (problem_size + block_size - 1) / block_size;
+    most_recent_event =
+        q.parallel_for(sycl::range<1>{num_blocks}, deps, [=](sycl::id<1> idx) {
+          std::size_t block_begin = idx[0] * block_size;
+          auto block_first = first;
+          std::advance(block_first, block_begin);
+          detail::insertion_sort(
+              block_first, std::min(block_size, problem_size - block_begin),
+              comp);
+        });
+  } else {
+    constexpr std::size_t group_size = detail::get_merge_sort_group_size<T>();
+    block_size = group_size * detail::merge_sort_local_item_size;
+    std::size_t num_groups = (problem_size + block_size - 1) / block_size;
+    most_recent_event = q.submit([&](sycl::handler &cgh) {
+      cgh.depends_on(deps);
+      sycl::local_accessor<T> local_in{block_size, cgh};
+      sycl::local_accessor<T> local_out{block_size, cgh};
+      cgh.parallel_for(
+          sycl::nd_range<1>{num_groups * group_size, group_size},
+          [=](sycl::nd_item<1> idx) {
+            detail::local_block_sort(idx, first, problem_size, comp,
+                                     &(local_in[0]), &(local_out[0]));
+          });
+    });
+  }
+
+  if(problem_size <= block_size)
+    return most_recent_event;
+
+  auto submit_pass = [&](auto kernel) {
+    if(q.is_in_order())
+      most_recent_event = q.parallel_for(
+          sycl::range<1>{(problem_size + segment_size - 1) / segment_size},
+          kernel);
+    else
+      most_recent_event = q.parallel_for(
+          sycl::range<1>{(problem_size + segment_size - 1) / segment_size},
+          most_recent_event, kernel);
+  };
+
+  T* scratch = scratch_alloc.obtain<T>(problem_size);
+  bool is_result_in_scratch = false;
+
+  for(std::size_t run_size = block_size; run_size < problem_size;
+      run_size *= 2) {
+    auto kernel = [=](auto in, auto out) {
+      return [=](sycl::id<1> idx) {
+        std::size_t segment_begin = idx[0] * segment_size;
+        std::size_t segment_end =
+            std::min(segment_begin + segment_size, problem_size);
+        detail::merge_sort_pass_segment(in, out, problem_size, run_size,
+                                        comp, segment_begin, segment_end);
+      };
+    };
+
+    if(is_result_in_scratch)
+      submit_pass(kernel(scratch, first));
+    else
+      submit_pass(kernel(first, scratch));
+    is_result_in_scratch = !is_result_in_scratch;
+  }
+
+  if(is_result_in_scratch) {
+    submit_pass([=](sycl::id<1> idx) {
+      std::size_t segment_begin = idx[0] * segment_size;
+      std::size_t segment_end =
+          std::min(segment_begin + segment_size, problem_size);
+      auto out = first;
+      std::advance(out, segment_begin);
+      for(std::size_t i = segment_begin; i < segment_end; ++i, ++out)
+        *out = scratch[i];
+    });
+  }
+
+  return most_recent_event;
+}
+
+}
+
+#endif
@@ -0,0 +1,806 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef ACPP_ALGORITHMS_RADIX_SORT
+#define ACPP_ALGORITHMS_RADIX_SORT
+
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include "hipSYCL/sycl/queue.hpp"
+#include "hipSYCL/sycl/libkernel/atomic_ref.hpp"
+#include "hipSYCL/sycl/libkernel/bit_cast.hpp"
+#include "hipSYCL/sycl/libkernel/group_functions.hpp"
+#include "hipSYCL/algorithms/util/allocation_cache.hpp"
+#include "hipSYCL/algorithms/scan/decoupled_lookback_scan.hpp"
+
+namespace hipsycl::algorithms::sorting {
+
+namespace detail {
+
+constexpr int radix_bits = 8;
+constexpr int radix_buckets = 1 << radix_bits;
+
+template<std::size_t Size>
+struct unsigned_int_of_size {};
+
+template<> struct unsigned_int_of_size<1> { using type = uint8_t; };
+template<> struct unsigned_int_of_size<2> { using type = uint16_t; };
+template<> struct unsigned_int_of_size<4> { using type = uint32_t; };
+template<> struct unsigned_int_of_size<8> { using type = uint64_t; };
+
+// Maps keys to unsigned integers whose order matches the order of the keys.
+template<class T, bool Descending>
+struct radix_key_traits {
+  using bits_type = typename unsigned_int_of_size<sizeof(T)>::type;
+  static constexpr bits_type sign_bit = bits_type{1}
+                                        << (sizeof(bits_type) * 8 - 1);
+
+  static bits_type to_bits(T x) {
+    bits_type b = sycl::bit_cast<bits_type>(x);
+    if constexpr (std::is_floating_point_v<T>) {
+      // Negative floating point values are ordered in reverse
+      b = (b & sign_bit) ? static_cast<bits_type>(~b)
+                         : static_cast<bits_type>(b | sign_bit);
+    } else if constexpr (std::is_signed_v<T>) {
+      b ^= sign_bit;
+    }
+    if constexpr (Descending)
+      b = static_cast<bits_type>(~b);
+    return b;
+  }
+
+  static T from_bits(bits_type b) {
+    if constexpr (Descending)
+      b = static_cast<bits_type>(~b);
+    if constexpr (std::is_floating_point_v<T>) {
+      b = (b & sign_bit) ? static_cast<bits_type>(b & ~sign_bit)
+                         : static_cast<bits_type>(~b);
+    } else if constexpr (std::is_signed_v<T>) {
+      b ^= sign_bit;
+    }
+    return sycl::bit_cast<T>(b);
+  }
+
+  static int get_digit(bits_type b, int pass) {
+    return static_cast<int>((b >> (pass * radix_bits)) & (radix_buckets - 1));
+  }
+};
+
+template <class T, class Compare>
+struct radix_sort_order {
+  static constexpr bool is_supported = false;
+  static constexpr bool is_descending = false;
+};
+
+template <class T>
+struct radix_sort_order<T, std::less<T>> {
+  static constexpr bool is_supported = true;
+  static constexpr bool is_descending = false;
+};
+
+template <class T>
+struct radix_sort_order<T, std::less<>> {
+  static constexpr bool is_supported = true;
+  static constexpr bool is_descending = false;
+};
+
+template <class T>
+struct radix_sort_order<T, std::greater<T>> {
+  static constexpr bool is_supported = true;
+  static constexpr bool is_descending = true;
+};
+
+template <class T>
+struct radix_sort_order<T, std::greater<>> {
+  static constexpr bool is_supported = true;
+  static constexpr bool is_descending = true;
+};
+
+template <class Bits>
+struct radix_sort_config {
+  static constexpr int num_passes = sizeof(Bits) * 8 / radix_bits;
+  // Each work item handles one digit in the device kernels
+  static constexpr int group_size = radix_buckets;
+  static constexpr int items_per_work_item = sizeof(Bits) <= 4 ? 16 : 8;
+  static constexpr int tile_size = group_size * items_per_work_item;
+  // On host, a single work item processes each tile sequentially
+  static constexpr int host_tile_size = 1 << 14;
+
+  static_assert(tile_size <= std::numeric_limits<uint16_t>::max(),
+                "Local indices must fit into uint16_t");
+};
+
+template <class KeyTraits, class RandomIt>
+struct iterator_key_access {
+  using bits_type = typename KeyTraits::bits_type;
+
+  bits_type load(std::size_t i) const {
+    auto it = first;
+    std::advance(it, i);
+    return KeyTraits::to_bits(*it);
+  }
+
+  void store(std::size_t i, bits_type b) const {
+    auto it = first;
+    std::advance(it, i);
+    *it = KeyTraits::from_bits(b);
+  }
+
+  RandomIt first;
+};
+
+template <class Bits>
+struct buffer_key_access {
+  Bits load(std::size_t i) const {
+    return data[i];
+  }
+
+  void store(std::size_t i, Bits b) const {
+    data[i] = b;
+  }
+
+  Bits* data;
+};
+
+template <class RandomIt>
+struct iterator_value_access {
+  auto load(std::size_t i) const {
+    auto it = first;
+    std::advance(it, i);
+    return *it;
+  }
+
+  template<class V>
+  void store(std::size_t i, const V& v) const {
+    auto it = first;
+    std::advance(it, i);
+    *it = v;
+  }
+
+  RandomIt first;
+};
+
+template <class V>
+struct buffer_value_access {
+  V load(std::size_t i) const {
+    return data[i];
+  }
+
+  void store(std::size_t i, const V& v) const {
+    data[i] = v;
+  }
+
+  V* data;
+};
+
+// Used for sorts without values
+struct no_value_access {
+  int load(std::size_t) const { return 0; }
+  void store(std::size_t, int) const {}
+};
+
+struct radix_sort_scratch {
+  // Global digit counts for each pass, and after the initial
+  // scan the global offset of each digit.
+  uint32_t* digit_offsets;
+  // Whether all keys have the same digit in a pass
+  uint32_t* is_trivial_pass;
+  uint32_t* tile_counter;
+  // Lookback state of each tile for each digit, indexed by
+  // digit * num_tiles + tile
+  scanning::detail::status* tile_status;
+  uint32_t* tile_aggregate;
+  uint32_t* tile_inclusive_prefix;
+};
+
+// Publishes the digit count of a tile, and returns the number of elements
+// with that digit in all preceding tiles.
+inline uint32_t publish_and_look_back(const radix_sort_scratch &scratch,
+                                      std::size_t num_tiles, uint32_t tile,
+                                      int digit, uint32_t count) {
+  std::size_t offset = static_cast<std::size_t>(digit) * num_tiles;
+  scanning::detail::status *status = scratch.tile_status + offset;
+  uint32_t *aggregate = scratch.tile_aggregate + offset;
+  uint32_t *inclusive_prefix = scratch.tile_inclusive_prefix + offset;
+
+  sycl::atomic_ref<uint32_t, sycl::memory_order::acq_rel,
+                   sycl::memory_scope::device,
+                   sycl::access::address_space::global_space>
+      status_ref{reinterpret_cast<uint32_t &>(status[tile])};
+
+  if(tile == 0) {
+    aggregate[tile] = count;
+    inclusive_prefix[tile] = count;
+    status_ref.store(
+        static_cast<uint32_t>(scanning::detail::status::prefix_available));
+    return 0;
+  }
+
+  aggregate[tile] = count;
+  status_ref.store(
+      static_cast<uint32_t>(scanning::detail::status::aggregate_available));
+
+  uint32_t exclusive_prefix = scanning::detail::exclusive_prefix_look_back(
+      uint32_t{0}, tile, status, aggregate, inclusive_prefix,
+      std::plus<uint32_t>{});
+
+  inclusive_prefix[tile] = exclusive_prefix + count;
+  status_ref.store(
+      static_cast<uint32_t>(scanning::detail::status::prefix_available));
+  return exclusive_prefix;
+}
+
+template <class KeyTraits, class KeySrc>
+void host_histogram_kernel(std::size_t tile, std::size_t problem_size,
+                           uint32_t *digit_counts, KeySrc keys) {
+  using config = radix_sort_config<typename KeyTraits::bits_type>;
+
+  uint32_t local_counts[config::num_passes * radix_buckets] = {};
+
+  std::size_t tile_start = tile * config::host_tile_size;
+  std::size_t tile_end =
+      std::min(tile_start + config::host_tile_size, problem_size);
+  for(std::size_t i = tile_start; i < tile_end; ++i) {
+    auto b = keys.load(i);
+    for(int pass = 0; pass < config::num_passes; ++pass)
+      ++local_counts[pass * radix_buckets + KeyTraits::get_digit(b, pass)];
+  }
+
+  for(int i = 0; i < config::num_passes * radix_buckets; ++i) {
+    if(local_counts[i] != 0) {
+      sycl::atomic_ref<uint32_t, sycl::memory_order::relaxed,
+                       sycl::memory_scope::device,
+                       sycl::access::address_space::global_space>
+          count_ref{digit_counts[i]};
+      count_ref.fetch_add(local_counts[i]);
+    }
+  }
+}
+
+template <class KeyTraits, class KeySrc>
+void histogram_kernel(sycl::nd_item<1> idx, std::size_t problem_size,
+                      uint32_t *digit_counts, uint32_t *local_counts,
+                      KeySrc keys) {
+  using config = radix_sort_config<typename KeyTraits::bits_type>;
+  constexpr int num_counters = config::num_passes * radix_buckets;
+
+  const int lid = idx.get_local_linear_id();
+  for(int i = lid; i < num_counters; i += config::group_size)
+    local_counts[i] = 0;
+  sycl::group_barrier(idx.get_group());
+
+  std::size_t tile_start = idx.get_group_linear_id() * config::tile_size;
+  for(int r = 0; r < config::items_per_work_item; ++r) {
+    std::size_t i = tile_start + r * config::group_size + lid;
+    if(i < problem_size) {
+      auto b = keys.load(i);
+      for(int pass = 0; pass < config::num_passes; ++pass) {
+        sycl::atomic_ref<uint32_t, sycl::memory_order::relaxed,
+                         sycl::memory_scope::work_group,
+                         sycl::access::address_space::local_space>
+            count_ref{
+                local_counts[pass * radix_buckets + KeyTraits::get_digit(b, pass)]};
+        count_ref.fetch_add(uint32_t{1});
+      }
+    }
+  }
+  sycl::group_barrier(idx.get_group());
+
+  for(int i = lid; i < num_counters; i += config::group_size) {
+    if(local_counts[i] != 0) {
+      sycl::atomic_ref<uint32_t, sycl::memory_order::relaxed,
+                       sycl::memory_scope::device,
+                       sycl::access::address_space::global_space>
+          count_ref{digit_counts[i]};
+      count_ref.fetch_add(local_counts[i]);
+    }
+  }
+}
+
+template <class KeySrc, class KeyDst, class ValueSrc, class ValueDst>
+void copy_tile(std::size_t tile_start, std::size_t tile_end, std::size_t stride,
+               KeySrc key_src, KeyDst key_dst, ValueSrc value_src,
+               ValueDst value_dst) {
+  for(std::size_t i = tile_start; i < tile_end; i += stride) {
+    key_dst.store(i, key_src.load(i));
+    value_dst.store(i, value_src.load(i));
+  }
+}
+
+template <class KeyTraits, class KeySrc, class KeyDst, class ValueSrc,
+          class ValueDst>
+void host_onesweep_kernel(std::size_t problem_size, std::size_t num_tiles,
+                          int pass, radix_sort_scratch scratch, KeySrc key_src,
+                          KeyDst key_dst, ValueSrc value_src,
+                          ValueDst value_dst) {
+  using config = radix_sort_config<typename KeyTraits::bits_type>;
+
+  // Tiles need to be processed in the order in which they are started
+  // for the lookback to make progress.
+  sycl::atomic_ref<uint32_t, sycl::memory_order::relaxed,
+                   sycl::memory_scope::device,
+                   sycl::access::address_space::global_space>
+      tile_counter{*scratch.tile_counter};
+  uint32_t tile = tile_counter.fetch_add(uint32_t{1});
+
+  std::size_t tile_start = static_cast<std::size_t>(tile) * config::host_tile_size;
+  std::size_t tile_end =
+      std::min(tile_start + config::host_tile_size, problem_size);
+
+  if(scratch.is_trivial_pass[pass]) {
+    copy_tile(tile_start, tile_end, 1, key_src, key_dst, value_src,
+              value_dst);
+    return;
+  }
+
+  uint32_t counts[radix_buckets] = {};
+  for(std::size_t i = tile_start; i < tile_end; ++i)
+    ++counts[KeyTraits::get_digit(key_src.load(i), pass)];
+
+  std::size_t offsets[radix_buckets];
+  for(int d = 0; d < radix_buckets; ++d)
+    offsets[d] = scratch.digit_offsets[pass * radix_buckets + d] +
+                 publish_and_look_back(scratch, num_tiles, tile, d, counts[d]);
+
+  for(std::size_t i = tile_start; i < tile_end; ++i) {
+    auto b = key_src.load(i);
+    std::size_t target = offsets[KeyTraits::get_digit(b, pass)]++;
+    key_dst.store(target, b);
+    value_dst.store(target, value_src.load(i));
+  }
+}
+
+template <class Bits>
+struct onesweep_local_memory {
+  Bits* keys;
+  uint16_t* indices;
+  uint32_t* scan;
+  uint32_t* digit_begin;
+  uint32_t* digit_end;
+  std::size_t* digit_base;
+};
+
+template <class KeyTraits, class KeySrc, class KeyDst, class ValueSrc,
+          class ValueDst>
+void onesweep_kernel(sycl::nd_item<1> idx, std::size_t problem_size,
+                     std::size_t num_tiles, int pass,
+                     radix_sort_scratch scratch,
+                     onesweep_local_memory<typename KeyTraits::bits_type> mem,
+                     KeySrc key_src, KeyDst key_dst, ValueSrc value_src,
+                     ValueDst value_dst) {
+  using bits_type = typename KeyTraits::bits_type;
+  using config = radix_sort_config<bits_type>;
+  constexpr int group_size = config::group_size;
+  constexpr int items = config::items_per_work_item;
+
+  const int lid = idx.get_local_linear_id();
+
+  if(scratch.is_trivial_pass[pass]) {
+    std::size_t tile_start = idx.get_group_linear_id() * config::tile_size;
+    std::size_t tile_end =
+        std::min(tile_start + config::tile_size, problem_size);
+    copy_tile(tile_start + lid, tile_end, group_size, key_src, key_dst,
+              value_src, value_dst);
+    return;
+  }
+
+  // Tiles need to be processed in the order in which they are started
+  // for the lookback to make progress.
+  uint32_t tile = 0;
+  if(lid == 0) {
+    sycl::atomic_ref<uint32_t, sycl::memory_order::relaxed,
+                     sycl::memory_scope::device,
+                     sycl::access::address_space::global_space>
+        tile_counter{*scratch.tile_counter};
+    tile = tile_counter.fetch_add(uint32_t{1});
+  }
+  tile = scanning::detail::collective_broadcast<uint32_t, std::plus<uint32_t>>(
+      idx, tile, 0, mem.scan);
+
+  const std::size_t tile_start =
+      static_cast<std::size_t>(tile) * config::tile_size;
+  const int num_valid = static_cast<int>(
+      std::min(static_cast<std::size_t>(config::tile_size),
+               problem_size - tile_start));
+
+  // Out-of-bounds elements get the largest key, so that they end up
+  // behind all valid elements.
+  for(int r = 0; r < items; ++r) {
+    int pos = r * group_size + lid;
+    mem.keys[pos] = pos < num_valid
+                        ? key_src.load(tile_start + pos)
+                        : std::numeric_limits<bits_type>::max();
+    mem.indices[pos] = static_cast<uint16_t>(pos);
+  }
+  sycl::group_barrier(idx.get_group());
+
+  bits_type keys[items];
+  uint16_t indices[items];
+  for(int j = 0; j < items; ++j) {
+    keys[j] = mem.keys[lid * items + j];
+    indices[j] = mem.indices[lid * items + j];
+  }
+  sycl::group_barrier(idx.get_group());
+
+  // Stable sort of the tile by the current digit, one bit at a time
+  for(int bit = 0; bit < radix_bits; ++bit) {
+    const int shift = pass * radix_bits + bit;
+
+    uint32_t num_zeros = 0;
+    for(int j = 0; j < items; ++j)
+      num_zeros += ((keys[j] >> shift) & 1) == 0;
+
+    uint32_t zeros_inclusive_scan = scanning::detail::kogge_stone_scan(
+        idx, num_zeros, std::plus<uint32_t>{}, mem.scan);
+    uint32_t total_zeros =
+        scanning::detail::collective_broadcast<uint32_t, std::plus<uint32_t>>(
+            idx, zeros_inclusive_scan, group_size - 1, mem.scan);
+
+    uint32_t zero_pos = zeros_inclusive_scan - num_zeros;
+    uint32_t one_pos = total_zeros + lid * items - zero_pos;
+    for(int j = 0; j < items; ++j) {
+      uint32_t pos = ((keys[j] >> shift) & 1) ? one_pos++ : zero_pos++;
+      mem.keys[pos] = keys[j];
+      mem.indices[pos] = indices[j];
+    }
+    sycl::group_barrier(idx.get_group());
+
+    if(bit != radix_bits - 1) {
+      for(int j = 0; j < items; ++j) {
+        keys[j] = mem.keys[lid * items + j];
+        indices[j] = mem.indices[lid * items + j];
+      }
+      sycl::group_barrier(idx.get_group());
+    }
+  }
+
+  // The tile is now sorted by digit; find the range of each digit.
+  const int digit = lid;
+  mem.digit_begin[digit] = 0;
+  mem.digit_end[digit] = 0;
+  sycl::group_barrier(idx.get_group());
+
+  for(int r = 0; r < items; ++r) {
+    int pos = r * group_size + lid;
+    if(pos < num_valid) {
+      int d = KeyTraits::get_digit(mem.keys[pos], pass);
+      if(pos == 0 || d != KeyTraits::get_digit(mem.keys[pos - 1], pass))
+        mem.digit_begin[d] = pos;
+      if(pos == num_valid - 1 ||
+         d != KeyTraits::get_digit(mem.keys[pos + 1], pass))
+        mem.digit_end[d] = pos + 1;
+    }
+  }
+  sycl::group_barrier(idx.get_group());
+
+  uint32_t count = mem.digit_end[digit] - mem.digit_begin[digit];
+  uint32_t prefix =
+      publish_and_look_back(scratch, num_tiles, tile, digit, count);
+  mem.digit_base[digit] =
+      static_cast<std::size_t>(
+          scratch.digit_offsets[pass * radix_buckets + digit]) +
+      prefix - mem.digit_begin[digit];
+  sycl::group_barrier(idx.get_group());
+
+  for(int r = 0; r < items; ++r) {
+    int pos = r * group_size + lid;
+    if(pos < num_valid) {
+      bits_type b = mem.keys[pos];
+      std::size_t target = mem.digit_base[KeyTraits::get_digit(b, pass)] + pos;
+      key_dst.store(target, b);
+      value_dst.store(target, value_src.load(tile_start + mem.indices[pos]));
+    }
+  }
+}
+
+template <class KeyTraits>
+class radix_sort_launcher {
+public:
+  using bits_type = typename KeyTraits::bits_type;
+  using config = radix_sort_config<bits_type>;
+
+  radix_sort_launcher(sycl::queue &q, util::allocation_group &scratch_alloc,
+                      std::size_t problem_size,
+                      const std::vector<sycl::event> &deps)
+      : _q{q}, _problem_size{problem_size}, _deps{deps} {
+    _is_host = q.get_device().get_backend() == sycl::backend::omp;
+    std::size_t tile_size = _is_host ? config::host_tile_size : config::tile_size;
+    _num_tiles = (problem_size + tile_size - 1) / tile_size;
+
+    constexpr std::size_t num_digit_counters = config::num_passes * radix_buckets;
+    std::size_t num_tile_states = radix_buckets * _num_tiles;
+
+    _scratch.digit_offsets = scratch_alloc.obtain<uint32_t>(num_digit_counters);
+    _scratch.is_trivial_pass = scratch_alloc.obtain<uint32_t>(config::num_passes);
+    _scratch.tile_counter = scratch_alloc.obtain<uint32_t>(1);
+    _scratch.tile_status =
+        scratch_alloc.obtain<scanning::detail::status>(num_tile_states);
+    _scratch.tile_aggregate = scratch_alloc.obtain<uint32_t>(num_tile_states);
+    _scratch.tile_inclusive_prefix =
+        scratch_alloc.obtain<uint32_t>(num_tile_states);
+  }
+
+  template<class KeySrc>
+  void compute_digit_offsets(KeySrc keys) {
+    radix_sort_scratch scratch = _scratch;
+    std::size_t problem_size = _problem_size;
+
+    submit([=](sycl::handler& cgh){
+      cgh.parallel_for(sycl::range<1>{config::num_passes * radix_buckets},
+                       [=](sycl::id<1> idx) {
+                         scratch.digit_offsets[idx[0]] = 0;
+                       });
+    });
+
+    if(_is_host) {
+      submit([=](sycl::handler& cgh){
+        cgh.parallel_for(sycl::range<1>{_num_tiles}, [=](sycl::id<1> idx) {
+          host_histogram_kernel<KeyTraits>(idx[0], problem_size,
+                                           scratch.digit_offsets, keys);
+        });
+      });
+    } else {
+      submit([=](sycl::handler& cgh){
+        sycl::local_accessor<uint32_t> local_counts{
+            config::num_passes * radix_buckets, cgh};
+        cgh.parallel_for(
+            sycl::nd_range<1>{_num_tiles * config::group_size,
+                              config::group_size},
+            [=](sycl::nd_item<1> idx) {
+              histogram_kernel<KeyTraits>(idx, problem_size,
+                                          scratch.digit_offsets,
+                                          &(local_counts[0]), keys);
+            });
+      });
+    }
+
+    submit([=](sycl::handler& cgh){
+      cgh.single_task([=](){
+        for(int pass = 0; pass < config::num_passes; ++pass) {
+          uint32_t* counts = scratch.digit_offsets + pass * radix_buckets;
+          uint32_t current_offset = 0;
+          scratch.is_trivial_pass[pass] = 0;
+          for(int d = 0; d < radix_buckets; ++d) {
+            uint32_t count = counts[d];
+            if(count == problem_size)
+              scratch.is_trivial_pass[pass] = 1;
+            counts[d] = current_offset;
+            current_offset += count;
+          }
+        }
+      });
+    });
+  }
+
+  template <class KeySrc, class KeyDst, class ValueSrc, class ValueDst>
+  void run_pass(int pass, KeySrc key_src, KeyDst key_dst, ValueSrc value_src,
+                ValueDst value_dst) {
+    radix_sort_scratch scratch = _scratch;
+    std::size_t problem_size = _problem_size;
+    std::size_t num_tiles = _num_tiles;
+
+    submit([=](sycl::handler& cgh){
+      cgh.parallel_for(sycl::range<1>{radix_buckets * num_tiles},
+                       [=](sycl::id<1> idx) {
+                         scratch.tile_status[idx[0]] =
+                             scanning::detail::status::invalid;
+                         if(idx[0] == 0)
+                           *scratch.tile_counter = 0;
+                       });
+    });
+
+    if(_is_host) {
+      submit([=](sycl::handler& cgh){
+        cgh.parallel_for(sycl::range<1>{num_tiles}, [=](sycl::id<1>) {
+          host_onesweep_kernel<KeyTraits>(problem_size, num_tiles, pass,
+                                          scratch, key_src, key_dst,
+                                          value_src, value_dst);
+        });
+      });
+    } else {
+      submit([=](sycl::handler& cgh){
+        sycl::local_accessor<bits_type> keys{config::tile_size, cgh};
+        sycl::local_accessor<uint16_t> indices{config::tile_size, cgh};
+        sycl::local_accessor<uint32_t> counters{
+            config::group_size + 2 * radix_buckets, cgh};
+        sycl::local_accessor<std::size_t> digit_base{radix_buckets, cgh};
+
+        cgh.parallel_for(
+            sycl::nd_range<1>{num_tiles * config::group_size,
+                              config::group_size},
+            [=](sycl::nd_item<1> idx) {
+              onesweep_local_memory<bits_type> mem;
+              mem.keys = &(keys[0]);
+              mem.indices = &(indices[0]);
+              mem.scan = &(counters[0]);
+              mem.digit_begin = mem.scan + config::group_size;
+              mem.digit_end = mem.digit_begin + radix_buckets;
+              mem.digit_base = &(digit_base[0]);
+
+              onesweep_kernel<KeyTraits>(idx, problem_size, num_tiles, pass,
+                                         scratch, mem, key_src, key_dst,
+                                         value_src, value_dst);
+            });
+      });
+    }
+  }
+
+  template <class KeySrc, class KeyDst, class ValueSrc, class ValueDst>
+  void copy(KeySrc key_src, KeyDst key_dst, ValueSrc value_src,
+            ValueDst value_dst) {
+    submit([=](sycl::handler& cgh){
+      cgh.parallel_for(sycl::range<1>{_problem_size}, [=](sycl::id<1> idx) {
+        key_dst.store(idx[0], key_src.load(idx[0]));
+        value_dst.store(idx[0], value_src.load(idx[0]));
+      });
+    });
+  }
+
+  sycl::event get_event() const {
+    return _most_recent_event;
+  }
+private:
+  template<class F>
+  void submit(F&& cgf) {
+    _most_recent_event = _q.submit([&](sycl::handler& cgh){
+      if(_is_first_kernel)
+        cgh.depends_on(_deps);
+      else if(!_q.is_in_order())
+        cgh.depends_on(_most_recent_event);
+      cgf(cgh);
+    });
+    _is_first_kernel = false;
+  }
+
+  sycl::queue& _q;
+  std::size_t _problem_size;
+  const std::vector<sycl::event>& _deps;
+  bool _is_host;
+  std::size_t _num_tiles;
+  radix_sort_scratch _scratch;
+
+  sycl::event _most_recent_event;
+  bool _is_first_kernel = true;
+};
+
+template <class KeyTraits, class KeyIt, class ValueAccess,
+          class ValueBufferAccess>
+sycl::event radix_sort(sycl::queue &q, util::allocation_group &scratch_alloc,
+                       KeyIt keys_first, std::size_t problem_size,
+                       ValueAccess values, ValueBufferAccess value_buffer0,
+                       ValueBufferAccess value_buffer1,
+                       const std::vector<sycl::event> &deps) {
+  using bits_type = typename KeyTraits::bits_type;
+  constexpr int num_passes = radix_sort_config<bits_type>::num_passes;
+
+  radix_sort_launcher<KeyTraits> launcher{q, scratch_alloc, problem_size, deps};
+
+  iterator_key_access<KeyTraits, KeyIt> keys{keys_first};
+  buffer_key_access<bits_type> key_buffers[2] = {
+      {scratch_alloc.obtain<bits_type>(problem_size)},
+      {num_passes > 2 ? scratch_alloc.obtain<bits_type>(problem_size)
+                      : nullptr}};
+  ValueBufferAccess value_buffers[2] = {value_buffer0, value_buffer1};
+
+  launcher.compute_digit_offsets(keys);
+
+  // Intermediate results are stored as bits in scratch memory. The first
+  // pass reads from the input, and the last pass writes back to it.
+  launcher.run_pass(0, keys, key_buffers[0], values, value_buffers[0]);
+  for(int pass = 1; pass < num_passes - 1; ++pass)
+    launcher.run_pass(pass, key_buffers[(pass - 1) % 2], key_buffers[pass % 2],
+                      value_buffers[(pass - 1) % 2], value_buffers[pass % 2]);
+
+  if constexpr(num_passes > 1)
+    launcher.run_pass(num_passes - 1, key_buffers[num_passes % 2], keys,
+                      value_buffers[num_passes % 2], values);
+  else
+    launcher.copy(key_buffers[0], keys, value_buffers[0], values);
+
+  return launcher.get_event();
+}
+
+} // detail
+
+/// Whether \c radix_sort can be used to sort elements of type \c T
+/// with the given comparator. This is the case for arithmetic types,
+/// if they are compared using \c std::less or \c std::greater.
+template <class T, class Compare>
+constexpr bool is_radix_sortable() {
+  using traits = detail::radix_sort_order<T, Compare>;
+  if constexpr (std::is_same_v<T, bool> || !std::is_arithmetic_v<T>)
+    return false;
+  else if constexpr (std::is_floating_point_v<T> &&
+                     !(sizeof(T) == 4 || sizeof(T) == 8))
+    return false;
+  else
+    return traits::is_supported;
+}
+
+/// Returns the largest problem size that \c radix_sort can handle.
+constexpr std::size_t get_max_radix_sort_size() {
+  return std::numeric_limits<uint32_t>::max();
+}
+
+/// Sorts the range using a least-significant-digit radix sort. The sort is
+/// stable with respect to the bit patterns of the keys, which is not the
+/// same as being stable under \c Compare for floating-point keys: -0.0 and
+/// 0.0 compare equal, but are ordered by their sign. Each pass over a digit
+/// is carried out by a single kernel using decoupled lookback to determine
+/// the global offsets of the digits in each tile (Adinets, Merrill (2022):
+/// Onesweep).
+///
+/// Requires \c is_radix_sortable<T,Compare>() and a problem size of at most
+/// \c get_max_radix_sort_size(). Scratch memory is obtained from
+/// \c scratch_alloc, which needs to provide device-accessible memory.
+template <class RandomIt, class Compare>
+sycl::event radix_sort(sycl::queue &q, util::allocation_group &scratch_alloc,
+                       RandomIt first, RandomIt last, Compare comp,
+                       const std::vector<sycl::event> &deps = {}) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  static_assert(is_radix_sortable<T, Compare>(),
+                "radix_sort requires arithmetic keys, compared by std::less "
+                "or std::greater");
+
+  std::size_t problem_size = std::distance(first, last);
+  if(problem_size == 0)
+    return sycl::event{};
+
+  using key_traits =
+      detail::radix_key_traits<T,
+                               detail::radix_sort_order<T, Compare>::is_descending>;
+  return detail::radix_sort<key_traits>(
+      q, scratch_alloc, first, problem_size, detail::no_value_access{},
+      detail::no_value_access{}, detail::no_value_access{}, deps);
+}
+
+/// Like \c radix_sort, but additionally reorders the values starting at
+/// \c values_first in the same way as the keys. As for \c radix_sort,
+/// values of equal floating-point keys with different signs of zero are
+/// not kept in their original order.
+template <class KeyIt, class ValueIt, class Compare>
+sycl::event radix_sort_by_key(sycl::queue &q,
+                              util::allocation_group &scratch_alloc,
+                              KeyIt keys_first, KeyIt keys_last,
+                              ValueIt values_first, Compare comp,
+                              const std::vector<sycl::event> &deps = {}) {
+  using T = typename std::iterator_traits<KeyIt>::value_type;
+  using V = typename std::iterator_traits<ValueIt>::value_type;
+  static_assert(is_radix_sortable<T, Compare>(),
+                "radix_sort_by_key requires arithmetic keys, compared by "
+                "std::less or std::greater");
+
+  std::size_t problem_size = std::distance(keys_first, keys_last);
+  if(problem_size == 0)
+    return sycl::event{};
+
+  using key_traits =
+      detail::radix_key_traits<T,
+                               detail::radix_sort_order<T, Compare>::is_descending>;
+  constexpr int num_passes =
+      detail::radix_sort_config<typename key_traits::bits_type>::num_passes;
+
+  detail::buffer_value_access<V> value_buffer0{
+      scratch_alloc.obtain<V>(problem_size)};
+  detail::buffer_value_access<V> value_buffer1{
+      num_passes > 2 ? scratch_alloc.obtain<V>(problem_size) : nullptr};
+  return detail::radix_sort<key_traits>(
+      q, scratch_alloc, keys_first, problem_size,
+      detail::iterator_value_access<ValueIt>{values_first}, value_buffer0,
+      value_buffer1, deps);
+}
+
+}
+
+#endif
@@ -21,6 +21,7 @@
 #include <set>
 #include <array>
 #include <cassert>
+#include <thread>
 
 
 namespace hipsycl::common {
@@ -84,11 +85,25 @@ protected:
   }
 };
 
+// Levels from leaf to root. The lower 48 bits, which contain user space
+// addresses on common platforms, are resolved by a 16-entry leaf level and
+// 32-entry intermediate levels. The upper 16 bits, which are typically zero,
+// are resolved by two 256-entry levels whose nodes are shared by all such
+// addresses.
 template<class UntypedAllocatorT>
 using allocation_map_bit_tree_config = bit_tree<UntypedAllocatorT, uint64_t, 
-  4, 4, 4, 4,  4, 4, 4, 4,
-  4, 4, 4, 4,  4, 4, 4, 4>;
-
+  4, 5, 5, 5,  5, 5, 5, 5,
+  5, 4, 8, 8>;
+
+/// Maps address ranges of allocations to a user payload.
+///
+/// Lookups do not take any locks: Nodes that are removed by erase() are only
+/// freed once all lookups that may still access them have completed, which
+/// is tracked using two reader epochs. Removed nodes are freed in batches to
+/// amortize waiting for readers. Additionally, each thread caches the most
+/// recent lookup result, which remains valid until the next erase().
+///
+/// Insertions may run concurrently with each other, but not with erase().
 template <class UserPayload, class UntypedAllocatorT = stdlib_untyped_allocator>
 class allocation_map : public allocation_map_bit_tree_config<UntypedAllocatorT> {
 public:
@@ -98,7 +113,8 @@ public:
   static_assert(std::is_trivial_v<UserPayload>, "UserPayload must be trivial type");
 
   allocation_map()
-  : _num_in_progress_operations{0} {}
+  : _num_in_progress_operations{0}, _epoch{0}, _reader_shards{},
+    _id{get_next_id()}, _generation{0}, _num_retired_nodes{0} {}
 
   struct value_type : public UserPayload {
     std::size_t allocation_size;
@@ -107,16 +123,37 @@ public:
   // Access entry of allocation that address belongs to, or nullptr if the address
   // does not belong to a known allocation.
   value_type* get_entry(uint64_t address, uint64_t& root_address) noexcept {
-    insert_or_get_entry_lock lock{_num_in_progress_operations};
+    last_hit& hit = get_last_hit();
+    const uint64_t generation = _generation.load(std::memory_order_acquire);
+    if (hit.map_id == _id && hit.generation == generation &&
+        address - hit.root_address < hit.allocation_size) {
+      root_address = hit.root_address;
+      return hit.entry;
+    }
+
+    read_guard guard{*this};
     root_address = 0;
     int num_leaf_attempts = 0;
-    return get_entry(_root, address, num_leaf_attempts, root_address);
+    value_type *entry =
+        get_entry(_root, address, num_leaf_attempts, root_address);
+    if (entry)
+      hit = last_hit{_id, generation, root_address,
+                     __atomic_load_n(&(entry->allocation_size),
+                                     __ATOMIC_ACQUIRE),
+                     entry};
+    return entry;
   }
 
   // Access entry of allocation that has the given address. Unlike get_entry(),
   // this does not succeed if the address does not point to the base of the allocation.
   value_type* get_entry_of_root_address(uint64_t address) noexcept {
-    insert_or_get_entry_lock lock{_num_in_progress_operations};
+    last_hit& hit = get_last_hit();
+    if (hit.map_id == _id &&
+        hit.generation == _generation.load(std::memory_order_acquire) &&
+        address == hit.root_address)
+      return hit.entry;
+
+    read_guard guard{*this};
     return get_entry_of_root_address(_root, address);
   }
 
@@ -125,21 +162,28 @@ public:
   // ~0ull is unsupported, because then non-zero allocation
   // ranges cannot be expressed.
   bool insert(uint64_t address, const value_type& v) {
-    insert_or_get_entry_lock lock{_num_in_progress_operations};
+    insert_lock lock{_num_in_progress_operations};
     return insert(_root, address, v);
   }
 
   bool erase(uint64_t address) {
     erase_lock lock{_num_in_progress_operations};
-    return erase(_root, address);
+    bool result = erase(_root, address);
+    // Invalidates the cached lookup results of all threads. This must
+    // happen after the entry is gone, so that lookups cannot cache it again.
+    _generation.fetch_add(1, std::memory_order_acq_rel);
+    return result;
   }
 
   ~allocation_map() {
+    free_retired_nodes();
     for (int i = 0;
          i < this->get_num_entries_in_level(bit_tree_t::root_level_idx); ++i) {
       auto* ptr = _root.children[i].load(std::memory_order_acquire);
-      if(ptr)
+      if(ptr) {
         release(*ptr);
+        this->free(ptr);
+      }
     }
   }
     
@@ -166,15 +210,55 @@ private:
     ostr << "\n";
   }
 
+  // Tracks which slots of a node are in use, so that lookups can find the
+  // preceding used slot without probing every slot. May transiently be
+  // out of date while a slot is inserted or erased, so slots still have
+  // to be checked.
+  template<int Level>
+  struct occupancy_mask {
+    static constexpr int num_words =
+        (bit_tree_t::get_num_entries_in_level(Level) + 63) / 64;
+
+    void set(int index) {
+      words[index / 64].fetch_or(1ull << (index % 64),
+                                 std::memory_order_acq_rel);
+    }
+
+    void clear(int index) {
+      words[index / 64].fetch_and(~(1ull << (index % 64)),
+                                  std::memory_order_acq_rel);
+    }
+
+    // Returns the largest set index that is not larger than index,
+    // or -1 if there is none.
+    int find_prev(int index) const {
+      if(index < 0)
+        return -1;
+      int word = index / 64;
+      uint64_t bits = words[word].load(std::memory_order_acquire) &
+                      bit_tree_t::get_n_low_bits_set(index % 64 + 1);
+      for(;;) {
+        if(bits)
+          return word * 64 + 63 - __builtin_clzll(bits);
+        if(--word < 0)
+          return -1;
+        bits = words[word].load(std::memory_order_acquire);
+      }
+    }
+
+    std::atomic<uint64_t> words[num_words];
+  };
+
   struct leaf_node {
     leaf_node()
-    : num_entries {} {
+    : occupancy{}, num_entries {} {
       for(int i = 0; i < bit_tree_t::get_num_entries_in_level(0); ++i) {
         entries[i].allocation_size = 0;
       }
     }
 
     value_type entries [bit_tree_t::get_num_entries_in_level(0)];
+    occupancy_mask<0> occupancy;
     std::atomic<int> num_entries;
   };
 
@@ -188,11 +272,12 @@ private:
     }
   public:
     intermediate_node()
-    : children{}, num_entries{} {}
+    : children{}, occupancy{}, num_entries{} {}
 
     using child_type = decltype(make_child());
 
     std::atomic<child_type*> children [bit_tree_t::get_num_entries_in_level(Level)];
+    occupancy_mask<Level> occupancy;
     std::atomic<int> num_entries;
   };
 
@@ -210,7 +295,7 @@ private:
       start_address = bit_tree_t::get_index_in_level(address, 0);
 
     for (int local_address = start_address; local_address >= 0;
-         --local_address) {
+         local_address = current_node.occupancy.find_prev(local_address - 1)) {
       
       auto& element = current_node.entries[local_address];
 
@@ -267,8 +352,10 @@ private:
     else
       start_address = bit_tree_t::get_index_in_level(address, Level);
 
-    for (int local_address = start_address;
-         local_address >= 0; --local_address) {
+    // The child on the path of the address is the most likely hit, and can be
+    // checked without touching the occupancy mask.
+    for (int local_address = start_address; local_address >= 0;
+         local_address = current_node.occupancy.find_prev(local_address - 1)) {
       
       auto *ptr = current_node.children[local_address].load(
           std::memory_order_acquire);
@@ -339,8 +426,11 @@ private:
       return false;
     }
     
-    __atomic_store_n(allocation_size_ptr, v.allocation_size, __ATOMIC_RELEASE);
+    // Publish the payload together with the allocation size,
+    // since lookups may observe the entry immediately.
     current_node.entries[local_address].UserPayload::operator=(v);
+    __atomic_store_n(allocation_size_ptr, v.allocation_size, __ATOMIC_RELEASE);
+    current_node.occupancy.set(local_address);
     
     current_node.num_entries.fetch_add(
         1, std::memory_order_acq_rel);
@@ -369,6 +459,7 @@ private:
         destroy(*new_child);
         this->free(new_child);
       } else {
+        current_node.occupancy.set(local_address);
         current_node.num_entries.fetch_add(
             1, std::memory_order_acq_rel);
         ptr = new_child;
@@ -388,6 +479,7 @@ private:
       return false;
 
     __atomic_store_n(allocation_size_ptr, 0, __ATOMIC_RELEASE);
+    current_node.occupancy.clear(local_address);
 
     current_node.num_entries.fetch_sub(
         1, std::memory_order_acq_rel);
@@ -409,12 +501,10 @@ private:
       if(ptr->num_entries.load(std::memory_order_acquire) == 0) {
         auto *current_ptr = current_node.children[local_address].exchange(
             nullptr, std::memory_order_acq_rel);
-        // TODO: We could potentially get erase() lock-free
-        // by counting by how many ops each node is currently used,
-        // and waiting here until the count turns to 0.
         if(current_ptr) {
-          destroy(*current_ptr);
-          this->free(current_ptr);
+          current_node.occupancy.clear(local_address);
+          // Lookups may still be traversing the node
+          retire(current_ptr);
           current_node.num_entries.fetch_sub(
               1, std::memory_order_acq_rel);
         }
@@ -448,13 +538,114 @@ private:
     node.~intermediate_node<Level>();
   }
 
+  // Nodes are only unlinked once they are empty, so that
+  // they do not own any children anymore.
+  template<class Node>
+  static void delete_retired_node(allocation_map* map, void* node) {
+    map->destroy(*static_cast<Node*>(node));
+    map->free(node);
+  }
+
+  template<class Node>
+  void retire(Node* node) {
+    if(_num_retired_nodes == max_num_retired_nodes) {
+      wait_for_readers();
+      free_retired_nodes();
+    }
+    _retired_nodes[_num_retired_nodes++] =
+        retired_node{node, &delete_retired_node<Node>};
+  }
+
+  void free_retired_nodes() {
+    for(int i = 0; i < _num_retired_nodes; ++i)
+      _retired_nodes[i].deleter(this, _retired_nodes[i].node);
+    _num_retired_nodes = 0;
+  }
+
+  // Waits until all lookups that started before have completed.
+  // Lookups register in the reader counter of the epoch that was current
+  // when they started, so after advancing the epoch, it suffices to wait
+  // until the counters of the previous epoch have drained.
+  void wait_for_readers() {
+    uint64_t previous_epoch = _epoch.fetch_add(1, std::memory_order_seq_cst);
+    for(auto& shard : _reader_shards) {
+      // Lookups are short, so spin briefly before giving up the core
+      // to readers that might have been preempted.
+      for(int num_spins = 0; shard.num_readers[previous_epoch % 2].load(
+                                 std::memory_order_seq_cst) != 0;
+          ++num_spins) {
+        if(num_spins < max_num_reader_spins)
+          pause();
+        else
+          std::this_thread::yield();
+      }
+    }
+  }
+
+  static void pause() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+  }
+
+  static int get_reader_shard_index() {
+    static std::atomic<int> next_index{0};
+    static thread_local int index =
+        next_index.fetch_add(1, std::memory_order_relaxed) % num_reader_shards;
+    return index;
+  }
+
+  class read_guard {
+  public:
+    read_guard(allocation_map& map) {
+      reader_shard &shard = map._reader_shards[get_reader_shard_index()];
+      for(;;) {
+        uint64_t epoch = map._epoch.load(std::memory_order_seq_cst);
+        _num_readers = &(shard.num_readers[epoch % 2]);
+        _num_readers->fetch_add(1, std::memory_order_seq_cst);
+        // If the epoch has advanced in the meantime, the writer may
+        // not have seen us, so register with the new epoch instead.
+        if(map._epoch.load(std::memory_order_seq_cst) == epoch)
+          return;
+        _num_readers->fetch_sub(1, std::memory_order_release);
+      }
+    }
+
+    ~read_guard() {
+      _num_readers->fetch_sub(1, std::memory_order_release);
+    }
+  private:
+    std::atomic<int>* _num_readers;
+  };
+
+  struct last_hit {
+    uint64_t map_id;
+    uint64_t generation;
+    uint64_t root_address;
+    std::size_t allocation_size;
+    value_type* entry;
+  };
+
+  static last_hit& get_last_hit() {
+    static thread_local last_hit hit{};
+    return hit;
+  }
+
+  static uint64_t get_next_id() {
+    // Ids start at 1, such that they never match an unused last_hit
+    static std::atomic<uint64_t> next_id{1};
+    return next_id.fetch_add(1, std::memory_order_relaxed);
+  }
+
   struct erase_lock {
   public:
     erase_lock(std::atomic<int>& op_counter)
     : _op_counter{op_counter} {
       int expected = 0;
       while (!_op_counter.compare_exchange_strong(
-          expected, -1, std::memory_order_release, std::memory_order_relaxed)) {
+          expected, -1, std::memory_order_acq_rel, std::memory_order_relaxed)) {
         expected = 0;
       }
     }
@@ -466,30 +657,54 @@ private:
     std::atomic<int>& _op_counter;
   };
 
-  struct insert_or_get_entry_lock {
+  struct insert_lock {
   public:
-    insert_or_get_entry_lock(std::atomic<int>& op_counter)
+    insert_lock(std::atomic<int>& op_counter)
     : _op_counter{op_counter} {
       int expected = std::max(0, _op_counter.load(std::memory_order_acquire));
       while (!_op_counter.compare_exchange_strong(
-          expected, expected+1, std::memory_order_release,
+          expected, expected+1, std::memory_order_acq_rel,
           std::memory_order_relaxed)) {
         if(expected < 0)
           expected = 0;
       }
     }
 
-    ~insert_or_get_entry_lock() {
+    ~insert_lock() {
       _op_counter.fetch_sub(1, std::memory_order_acq_rel);
     }
   private:
    std::atomic<int>& _op_counter;
   };
 
+  struct alignas(64) reader_shard {
+    std::atomic<int> num_readers[2];
+  };
+
+  struct retired_node {
+    void* node;
+    void (*deleter)(allocation_map*, void*);
+  };
+
+  static constexpr int num_reader_shards = 16;
+  static constexpr int max_num_retired_nodes = 64;
+  static constexpr int max_num_reader_spins = 64;
+
   intermediate_node<bit_tree_t::root_level_idx> _root;
+  // Only used by insert() and erase()
   std::atomic<int> _num_in_progress_operations;
-};
 
+  std::atomic<uint64_t> _epoch;
+  reader_shard _reader_shards[num_reader_shards];
+
+  const uint64_t _id;
+  // Incremented after each erase()
+  std::atomic<uint64_t> _generation;
+
+  // Only accessed by erase() and the destructor
+  retired_node _retired_nodes[max_num_retired_nodes];
+  int _num_retired_nodes;
+};
 
 }
 
@@ -12,7 +12,9 @@
 #define HIPSYCL_COMMON_APP_DB_HPP
 
 #include <unordered_map>
+#include <unordered_set>
 #include <atomic>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <ostream>
@@ -78,30 +80,144 @@ struct kernel_entry {
 };
 
 struct binary_entry {
-  std::string jit_cache_filename;
+  // The content_version of the last application run that
+  // used the binary from the persistent JIT cache.
+  uint64_t last_used_run = 0;
 
   template<class T>
   void pack(T &pack) {
-    pack(jit_cache_filename);
+    pack(last_used_run);
   }
 
   void dump(std::ostream& ostr, int indentation_level=0) const;
 };
 
+struct memcpy_entry {
+  // Fitted transfer parameters of a (source, destination) device pair
+  double latency = 0.0; // in ns
+  double bandwidth = 0.0; // in bytes/ns
+
+  template<class T>
+  void pack(T &pack) {
+    pack(latency);
+    pack(bandwidth);
+  }
+
+  void dump(std::ostream& ostr, int indentation_level=0) const;
+};
+
+struct tuning_candidate {
+  // Launch parameters of the candidate
+  uint64_t group_size_x = 0;
+  uint64_t group_size_y = 0;
+  uint64_t group_size_z = 0;
+  uint64_t coarsening_factor = 0;
+  // Whether barriers are lowered to fiber switches instead of
+  // continuation-based synchronization
+  bool fiber_barriers = false;
+
+  // Fastest measured execution time in ns
+  double best_time = 0.0;
+  uint64_t num_samples = 0;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(group_size_x);
+    pack(group_size_y);
+    pack(group_size_z);
+    pack(coarsening_factor);
+    pack(fiber_barriers);
+    pack(best_time);
+    pack(num_samples);
+  }
+
+  void dump(std::ostream& ostr, int indentation_level=0) const;
+};
+
+struct kernel_tuning_entry {
+  std::vector<tuning_candidate> candidates;
+  bool coarsening_candidates_added = false;
+  // Whether the kernel contains work-group barriers, as reported
+  // by the JIT compiler
+  bool uses_barriers = false;
+  bool barrier_candidates_added = false;
+  bool is_tuned = false;
+  // Index of the fastest candidate once tuning is complete
+  uint64_t selected_candidate = 0;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(candidates);
+    pack(coarsening_candidates_added);
+    pack(uses_barriers);
+    pack(barrier_candidates_added);
+    pack(is_tuned);
+    pack(selected_candidate);
+  }
+
+  void dump(std::ostream& ostr, int indentation_level=0) const;
+};
+
+/// A map that remembers which entries were accessed for writing,
+/// such that only these need to be persisted by the next sync.
+/// Entries can only be modified through operator[].
+template <class Key, class Value, class Hash = std::hash<Key>>
+class tracked_map {
+public:
+  using map_type = std::unordered_map<Key, Value, Hash>;
+  using key_set = std::unordered_set<Key, Hash>;
+  using const_iterator = typename map_type::const_iterator;
+
+  Value& operator[](const Key& key) {
+    _modified_keys.insert(key);
+    return _entries[key];
+  }
+
+  const_iterator find(const Key& key) const { return _entries.find(key); }
+  const_iterator begin() const { return _entries.begin(); }
+  const_iterator end() const { return _entries.end(); }
+  std::size_t size() const { return _entries.size(); }
+
+  /// Returns the keys of all entries accessed for writing since the
+  /// previous call, and resets the tracking.
+  key_set take_modified_keys() {
+    key_set result;
+    std::swap(result, _modified_keys);
+    return result;
+  }
+
+  /// Direct access to the entries, bypassing the tracking. Only
+  /// intended for (de)serialization and loading.
+  map_type& get_entries() { return _entries; }
+  const map_type& get_entries() const { return _entries; }
+private:
+  map_type _entries;
+  key_set _modified_keys;
+};
+
 struct appdb_data {
   std::size_t content_version = 0;
 
-  std::unordered_map<rt::kernel_configuration::id_type, kernel_entry,
-                     rt::kernel_id_hash>
+  tracked_map<rt::kernel_configuration::id_type, kernel_entry,
+              rt::kernel_id_hash>
       kernels;
-  std::unordered_map<rt::kernel_configuration::id_type, binary_entry,
-                     rt::kernel_id_hash>
+  tracked_map<rt::kernel_configuration::id_type, binary_entry,
+              rt::kernel_id_hash>
       binaries;
+  // Keyed by "<source device>-><dest device>"
+  tracked_map<std::string, memcpy_entry> memcpy_models;
+  // Launch parameter auto-tuning results of the OpenMP backend
+  tracked_map<rt::kernel_configuration::id_type, kernel_tuning_entry,
+              rt::kernel_id_hash>
+      kernel_tunings;
 
   template<class T>
   void pack(T &pack) {
-    pack(kernels);
-    pack(binaries);
+    // The tracking state is not serialized.
+    pack(kernels.get_entries());
+    pack(binaries.get_entries());
+    pack(memcpy_models.get_entries());
+    pack(kernel_tunings.get_entries());
     pack(content_version);
   }
 
@@ -109,28 +225,50 @@ struct appdb_data {
 };
 
 
+/// The application database is persisted as a msgpack snapshot of
+/// \c appdb_data, together with an append-only journal next to it.
+/// Each journal record contains the entries that were modified since the
+/// previous sync, and is applied on top of the snapshot when loading.
+/// Records are appended periodically and at shutdown, so that statistics
+/// survive if the process is killed. Multiple processes can share the same
+/// database: their records are merged entry by entry, and the most recently
+/// appended record of an entry wins. Once the journal has grown large enough,
+/// it is compacted into a new snapshot.
+///
+/// The database is only read from disk upon first access.
 class appdb  {
 public:
   // DO NOT FORGET TO INCREMENT THIS WHEN ADDING/REMOVING
   // FIELDS OR OTHERWISE CHANGING THE DATA LAYOUT!
-  static const uint64_t format_version = 4;
+  static const uint64_t format_version = 9;
 
   appdb(const std::string& db_path);
   ~appdb();
 
   template<class F>
   auto read_access(F&& handler) const{
+    ensure_loaded();
     read_lock lock {_lock};
     return handler(_data);
   }
 
   template<class F>
   auto read_write_access(F&& handler) {
+    ensure_loaded();
+    // Must be destroyed after the write lock has been released
+    periodic_sync_guard sync_guard{this};
     write_lock lock {_lock};
     _was_modified = true;
     return handler(_data);
   }
 
+  /// Appends all entries that were modified since the previous
+  /// sync to the journal.
+  void sync();
+
+  /// Removes the database at the given path, including its journal.
+  static void remove(const std::string& db_path);
+
 private:
   
   struct write_lock {
@@ -171,12 +309,39 @@ private:
    std::atomic<int>& _op_counter;
   };
 
+  struct periodic_sync_guard {
+    periodic_sync_guard(appdb* db)
+    : _db{db} {}
+
+    ~periodic_sync_guard() {
+      _db->sync_if_due();
+    }
+  private:
+    appdb* _db;
+  };
+
+  void ensure_loaded() const;
+  void load();
+  void sync_if_due();
+  void compact();
+
   mutable std::atomic<int> _lock;
-  bool _was_modified;
+  std::atomic<bool> _was_modified;
 
   std::string _db_path;
+  std::string _journal_path;
+  std::string _lock_path;
 
+  mutable std::once_flag _load_flag;
+  // Loaded lazily upon first access
   appdb_data _data;
+
+  // Protects the state below, which is only used for syncing
+  std::mutex _sync_mutex;
+  std::atomic<uint64_t> _last_sync_time;
+  std::size_t _persisted_content_version = 0;
+  // The journal is known to consist of intact records up to this offset
+  std::size_t _verified_journal_size = 0;
 };
 
 
@@ -12,9 +12,11 @@
 #define HIPSYCL_COMMON_FILESYSTEM_HPP
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 #include <atomic>
+#include <cstdint>
 
 #include "appdb.hpp"
 
@@ -41,11 +43,82 @@ std::vector<std::string> list_regular_files(const std::string &directory,
                                             const std::string &extension);
 
 /// Writes data atomically to filename
-bool atomic_write(const std::string& filename, const std::string& data);
+bool atomic_write(const std::string& filename, std::string_view data);
+
+/// Appends data to filename, creating the file if it does not exist.
+/// Returns once the data has been flushed to disk.
+bool append(const std::string& filename, std::string_view data);
+
+/// Truncates or extends a file to the given size in bytes.
+bool truncate(const std::string& filename, std::size_t size);
+
+/// Returns the size of a file in bytes, or 0 if it does not exist.
+std::size_t file_size(const std::string& filename);
+
+/// Identifies a version of a file: A file that is replaced gets a new
+/// inode, and a file that is modified in place a new modification time.
+struct file_status {
+  std::size_t size = 0;
+  // Always 0 on platforms without inodes
+  uint64_t inode = 0;
+  // In ns since the epoch
+  int64_t modification_time = 0;
+
+  friend bool operator==(const file_status &a, const file_status &b) {
+    return a.size == b.size && a.inode == b.inode &&
+           a.modification_time == b.modification_time;
+  }
+  friend bool operator!=(const file_status &a, const file_status &b) {
+    return !(a == b);
+  }
+};
+
+/// Returns the status of a file, which is all zero if it does not exist.
+file_status get_file_status(const std::string& filename);
 
 /// Removes a file, returns true if successful.
 bool remove(const std::string &filename);
 
+/// Read-only view of the content of a file, which is memory-mapped
+/// where supported. Data may be appended to the file while it is mapped,
+/// but it must not be truncated.
+class mapped_file {
+public:
+  mapped_file(const std::string& path);
+  ~mapped_file();
+
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+
+  const uint8_t* data() const { return _data; }
+  std::size_t size() const { return _size; }
+  /// Status of the file at the time it was mapped
+  const file_status& get_status() const { return _status; }
+
+  /// Hints that the given byte range will be accessed soon,
+  /// so that it can be read in the background.
+  void prefetch(std::size_t offset, std::size_t size) const;
+private:
+  const uint8_t* _data = nullptr;
+  std::size_t _size = 0;
+  file_status _status;
+  // Only used if memory-mapping is not supported
+  std::vector<uint8_t> _content;
+};
+
+/// Advisory lock on a file that coordinates accesses of multiple
+/// processes. Does nothing on platforms without flock().
+class file_lock {
+public:
+  file_lock(const std::string& path, bool exclusive);
+  ~file_lock();
+
+  file_lock(const file_lock&) = delete;
+  file_lock& operator=(const file_lock&) = delete;
+private:
+  int _fd = -1;
+};
+
 class persistent_storage {
 public:
   static persistent_storage& get() {
@@ -405,7 +405,8 @@ void Packer::pack_type(const float &value) {
   double integral_part;
   auto fractional_remainder = float(modf(value, &integral_part));
 
-  if (fractional_remainder == 0) { // Just pack as int
+  // Integral values outside of the int64 range are packed as floats
+  if (fractional_remainder == 0 && fabs(integral_part) < 0x1p63) { // Just pack as int
     pack_type(int64_t(integral_part));
   } else {
     static_assert(std::numeric_limits<float>::radix == 2); // TODO: Handle decimal floats
@@ -438,7 +439,8 @@ void Packer::pack_type(const double &value) {
   double integral_part;
   double fractional_remainder = modf(value, &integral_part);
 
-  if (fractional_remainder == 0) { // Just pack as int
+  // Integral values outside of the int64 range are packed as floats
+  if (fractional_remainder == 0 && fabs(integral_part) < 0x1p63) { // Just pack as int
     pack_type(int64_t(integral_part));
   } else {
     static_assert(std::numeric_limits<float>::radix == 2); // TODO: Handle decimal floats
@@ -724,7 +726,8 @@ void Unpacker::unpack_type(int16_t &value) {
     unpack_type(val);
     value = val;
   } else {
-    value = safe_data();
+    // Positive or negative fixint
+    value = int8_t(safe_data());
     safe_increment();
   }
 }
@@ -753,7 +756,8 @@ void Unpacker::unpack_type(int32_t &value) {
     unpack_type(val);
     value = val;
   } else {
-    value = safe_data();
+    // Positive or negative fixint
+    value = int8_t(safe_data());
     safe_increment();
   }
 }
@@ -786,7 +790,8 @@ void Unpacker::unpack_type(int64_t &value) {
     unpack_type(val);
     value = val;
   } else {
-    value = safe_data();
+    // Positive or negative fixint
+    value = int8_t(safe_data());
     safe_increment();
   }
 }
@@ -809,8 +814,9 @@ inline
 void Unpacker::unpack_type(uint16_t &value) {
   if (safe_data() == uint16) {
     safe_increment();
+    value = 0;
     for (auto i = sizeof(uint16_t); i > 0; --i) {
-      value += safe_data() << 8 * (i - 1);
+      value |= uint16_t(safe_data()) << 8 * (i - 1);
       safe_increment();
     }
   } else if (safe_data() == uint8) {
@@ -828,14 +834,16 @@ inline
 void Unpacker::unpack_type(uint32_t &value) {
   if (safe_data() == uint32) {
     safe_increment();
+    value = 0;
     for (auto i = sizeof(uint32_t); i > 0; --i) {
-      value += safe_data() << 8 * (i - 1);
+      value |= uint32_t(safe_data()) << 8 * (i - 1);
       safe_increment();
     }
   } else if (safe_data() == uint16) {
     safe_increment();
+    value = 0;
     for (auto i = sizeof(uint16_t); i > 0; --i) {
-      value += safe_data() << 8 * (i - 1);
+      value |= uint32_t(safe_data()) << 8 * (i - 1);
       safe_increment();
     }
   } else if (safe_data() == uint8) {
@@ -853,20 +861,23 @@ inline
 void Unpacker::unpack_type(uint64_t &value) {
   if (safe_data() == uint64) {
     safe_increment();
+    value = 0;
     for (auto i = sizeof(uint64_t); i > 0; --i) {
-      value += uint64_t(safe_data()) << 8 * (i - 1);
+      value |= uint64_t(safe_data()) << 8 * (i - 1);
       safe_increment();
     }
   } else if (safe_data() == uint32) {
     safe_increment();
+    value = 0;
     for (auto i = sizeof(uint32_t); i > 0; --i) {
-      value += uint64_t(safe_data()) << 8 * (i - 1);
+      value |= uint64_t(safe_data()) << 8 * (i - 1);
       safe_increment();
     }
   } else if (safe_data() == uint16) {
     safe_increment();
+    value = 0;
     for (auto i = sizeof(uint16_t); i > 0; --i) {
-      value += uint64_t(safe_data()) << 8 * (i - 1);
+      value |= uint64_t(safe_data()) << 8 * (i - 1);
       safe_increment();
     }
   } else if (safe_data() == uint8) {
@@ -899,7 +910,7 @@ void Unpacker::unpack_type(float &value) {
     safe_increment();
     uint32_t data = 0;
     for (auto i = sizeof(uint32_t); i > 0; --i) {
-      data += safe_data() << 8 * (i - 1);
+      data += uint32_t(safe_data()) << 8 * (i - 1);
       safe_increment();
     }
     auto bits = std::bitset<32>(data);
@@ -961,11 +972,11 @@ void Unpacker::unpack_type(double &value) {
     if (safe_data() == int8 || safe_data() == int16 || safe_data() == int32 || safe_data() == int64) {
       int64_t val = 0;
       unpack_type(val);
-      value = float(val);
+      value = double(val);
     } else {
       uint64_t val = 0;
       unpack_type(val);
-      value = float(val);
+      value = double(val);
     }
   }
 }
@@ -0,0 +1,111 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_PACKED_BINARY_CACHE_HPP
+#define HIPSYCL_PACKED_BINARY_CACHE_HPP
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "hipSYCL/common/filesystem.hpp"
+#include "hipSYCL/common/unordered_dense.hpp"
+#include "hipSYCL/runtime/kernel_configuration.hpp"
+
+namespace hipsycl {
+namespace common {
+
+/// A persistent cache of binaries that are stored in a single, append-only
+/// file. Each record consists of a header with the id, size and checksum
+/// of a binary, followed by the binary itself. The headers are scanned into
+/// an in-memory hash index when the cache is first accessed, and binaries
+/// are handed out as views into a memory mapping of the file without
+/// copying them.
+///
+/// Multiple processes can share a cache file. Appends are serialized using
+/// a lock file, while lookups do not need to lock since records are never
+/// modified once written. If the cache needs to be shrunk, the file is
+/// replaced atomically by a new one, so mappings of the old file remain valid.
+///
+/// This class is thread-safe.
+class packed_binary_cache {
+public:
+  using id_type = rt::kernel_configuration::id_type;
+
+  packed_binary_cache(const std::string& path);
+
+  packed_binary_cache(const packed_binary_cache&) = delete;
+  packed_binary_cache& operator=(const packed_binary_cache&) = delete;
+
+  /// A binary handed out by the cache. The view remains valid as long
+  /// as the object is alive, since it keeps the memory mapping that the
+  /// view points into alive. The view is followed by a null byte, so that
+  /// textual formats can be passed to APIs expecting C strings.
+  struct binary {
+    std::string_view data;
+    std::shared_ptr<const filesystem::mapped_file> mapping;
+  };
+
+  /// Looks up a binary.
+  bool lookup(const id_type& id, binary& out);
+
+  /// Appends a binary to the cache file.
+  /// \return whether the binary was stored successfully.
+  bool store(const id_type& id, std::string_view binary);
+
+  /// Hints that the binary will be looked up soon, so that it can
+  /// be read from disk in the background.
+  void prefetch(const id_type& id);
+
+  /// \return The size of the cache file in bytes
+  std::size_t get_size() const;
+
+  /// If the cache file is larger than \c max_size, rewrites it so that it
+  /// only contains the binaries with the highest priority as returned
+  /// by \c get_priority.
+  void shrink(std::size_t max_size,
+              const std::function<uint64_t(const id_type &)> &get_priority);
+
+  /// Removes the cache file at the given path
+  static void remove(const std::string& path);
+private:
+  // Offsets refer to the current mapping
+  struct entry {
+    std::size_t offset;
+    std::size_t size;
+    bool is_verified;
+  };
+
+  // Maps the file again if it has changed, and indexes new records.
+  // Requires _mutex to be locked.
+  void refresh();
+
+  std::string_view get_binary(const entry& e) const;
+
+  std::string _path;
+  std::string _lock_path;
+
+  mutable std::mutex _mutex;
+  // Mapping of the entire file as of the last refresh. Previous mappings
+  // are released once no binary that was handed out uses them anymore.
+  std::shared_ptr<const filesystem::mapped_file> _mapping;
+  uint64_t _generation = 0;
+  std::size_t _indexed_size = 0;
+  ankerl::unordered_dense::map<id_type, entry, rt::kernel_id_hash> _index;
+};
+
+}
+}
+
+#endif
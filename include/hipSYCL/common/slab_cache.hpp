@@ -0,0 +1,384 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_COMMON_SLAB_CACHE_HPP
+#define HIPSYCL_COMMON_SLAB_CACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "spin_lock.hpp"
+
+namespace hipsycl {
+namespace common {
+
+/// Serves small allocations from slabs, in power-of-two size classes.
+///
+/// Each thread caches free blocks of every size class, so that allocation and
+/// deallocation usually only touch a thread-local free list. Blocks freed by
+/// a different thread than the one that allocated them are returned in
+/// batches to a shared free list once the cache of the freeing thread is
+/// full.
+///
+/// Once all blocks of a slab are back in the shared free list, the slab is
+/// released, apart from one empty slab per size class that is kept for
+/// reuse. Blocks cached by a thread keep their slab alive until the cache
+/// spills or the thread exits.
+///
+/// All state is static and exists once per \c SlabSource, such that it
+/// remains valid while threads exit during or after static destruction.
+///
+/// \c SlabSource provides the slabs, and must define
+/// - \c min_block_size, \c num_size_classes and \c slab_size, where
+///   \c slab_size is a power of two;
+/// - \c static void* allocate_slab(std::size_t size_class), which returns
+///   \c slab_size bytes aligned to \c slab_size, or nullptr;
+/// - \c static void release_slab(void* slab, std::size_t size_class).
+template <class SlabSource> class slab_cache {
+public:
+  static constexpr std::size_t min_block_size = SlabSource::min_block_size;
+  static constexpr std::size_t num_size_classes = SlabSource::num_size_classes;
+  static constexpr std::size_t max_block_size =
+      min_block_size << (num_size_classes - 1);
+  static constexpr std::size_t slab_size = SlabSource::slab_size;
+
+  static_assert((slab_size & (slab_size - 1)) == 0,
+                "Slab size must be a power of two");
+
+  static std::size_t get_size_class(std::size_t size) {
+    std::size_t size_class = 0;
+    for (std::size_t block_size = min_block_size; block_size < size;
+         block_size *= 2)
+      ++size_class;
+    return size_class;
+  }
+
+  static constexpr std::size_t get_block_size(std::size_t size_class) {
+    return min_block_size << size_class;
+  }
+
+  /// \return nullptr if no slab is available.
+  static void *allocate(std::size_t size_class) {
+    if (is_thread_cache_released()) {
+      free_list list{nullptr, 0};
+      if (!refill(list, size_class))
+        return nullptr;
+      free_block *block = split_batch(list, 1);
+      if (list.size > 0)
+        return_to_shared_list(size_class, list.head);
+      return block;
+    }
+
+    free_list &cache = get_thread_caches()[size_class];
+    if (!cache.head) {
+      register_thread_cache_releaser();
+      if (!refill(cache, size_class))
+        return nullptr;
+    }
+    free_block *block = cache.head;
+    cache.head = block->next;
+    --cache.size;
+    return block;
+  }
+
+  static void deallocate(void *ptr, std::size_t size_class) noexcept {
+    free_block *block = static_cast<free_block *>(ptr);
+    if (is_thread_cache_released()) {
+      block->next = nullptr;
+      return_to_shared_list(size_class, block);
+      return;
+    }
+
+    free_list &cache = get_thread_caches()[size_class];
+    if (cache.size == 0)
+      register_thread_cache_releaser();
+    block->next = cache.head;
+    cache.head = block;
+    if (++cache.size > max_cached_blocks)
+      spill_to_shared_list(cache, size_class, max_cached_blocks - batch_size);
+  }
+
+  /// Number of slabs that are currently allocated.
+  static std::size_t get_num_slabs() noexcept {
+    return get_slab_counter().load(std::memory_order_relaxed);
+  }
+
+private:
+  // Number of blocks that are moved between a thread cache
+  // and the shared free list at once
+  static constexpr std::size_t batch_size = 32;
+  static constexpr std::size_t max_cached_blocks = 2 * batch_size;
+  // Number of slabs per size class without any allocated blocks that are
+  // kept instead of being released, so that allocating and freeing around
+  // a slab boundary does not allocate a new slab every time.
+  static constexpr std::size_t max_empty_slabs = 1;
+
+  struct free_block {
+    free_block *next;
+  };
+
+  struct free_list {
+    free_block *head;
+    std::size_t size;
+  };
+
+  // Located at the start of each slab
+  struct slab_header {
+    slab_header *prev;
+    slab_header *next;
+    // Blocks of this slab that are in the shared free list
+    free_block *free_blocks;
+    std::size_t num_free;
+  };
+
+  // Blocks that are not cached by any thread are kept in the free list of
+  // their slab. Only slabs with at least one free block are linked here.
+  struct shared_free_list {
+    spin_lock lock;
+    slab_header *slabs = nullptr;
+    slab_header *last_slab = nullptr;
+    std::size_t num_empty_slabs = 0;
+  };
+
+  static std::size_t get_first_block_offset(std::size_t size_class) {
+    const std::size_t block_size = get_block_size(size_class);
+    return (sizeof(slab_header) + block_size - 1) / block_size * block_size;
+  }
+
+  static std::size_t get_num_blocks_per_slab(std::size_t size_class) {
+    return (slab_size - get_first_block_offset(size_class)) /
+           get_block_size(size_class);
+  }
+
+  static slab_header *get_slab(free_block *block) {
+    return reinterpret_cast<slab_header *>(
+        reinterpret_cast<std::uintptr_t>(block) & ~(slab_size - 1));
+  }
+
+  static slab_header *allocate_slab(std::size_t size_class) {
+    void *mem = SlabSource::allocate_slab(size_class);
+    if (!mem)
+      return nullptr;
+    get_slab_counter().fetch_add(1, std::memory_order_relaxed);
+
+    slab_header *slab = static_cast<slab_header *>(mem);
+    slab->prev = nullptr;
+    slab->next = nullptr;
+    slab->free_blocks = nullptr;
+    slab->num_free = 0;
+
+    const std::size_t block_size = get_block_size(size_class);
+    char *blocks =
+        static_cast<char *>(mem) + get_first_block_offset(size_class);
+    for (std::size_t i = 0; i < get_num_blocks_per_slab(size_class); ++i) {
+      free_block *block =
+          reinterpret_cast<free_block *>(blocks + i * block_size);
+      block->next = slab->free_blocks;
+      slab->free_blocks = block;
+      ++slab->num_free;
+    }
+    return slab;
+  }
+
+  static void release_slab(slab_header *slab, std::size_t size_class) {
+    get_slab_counter().fetch_sub(1, std::memory_order_relaxed);
+    SlabSource::release_slab(slab, size_class);
+  }
+
+  static void link_front(shared_free_list &shared, slab_header *slab) {
+    slab->prev = nullptr;
+    slab->next = shared.slabs;
+    if (shared.slabs)
+      shared.slabs->prev = slab;
+    else
+      shared.last_slab = slab;
+    shared.slabs = slab;
+  }
+
+  static void link_back(shared_free_list &shared, slab_header *slab) {
+    slab->prev = shared.last_slab;
+    slab->next = nullptr;
+    if (shared.last_slab)
+      shared.last_slab->next = slab;
+    else
+      shared.slabs = slab;
+    shared.last_slab = slab;
+  }
+
+  static void unlink(shared_free_list &shared, slab_header *slab) {
+    if (slab->prev)
+      slab->prev->next = slab->next;
+    else
+      shared.slabs = slab->next;
+    if (slab->next)
+      slab->next->prev = slab->prev;
+    else
+      shared.last_slab = slab->prev;
+  }
+
+  /// Moves up to n blocks from the shared free list to the list.
+  /// Requires the lock of the shared free list.
+  static void take_from_shared_list(shared_free_list &shared,
+                                    std::size_t size_class, free_list &list,
+                                    std::size_t n) {
+    const std::size_t blocks_per_slab = get_num_blocks_per_slab(size_class);
+    while (shared.slabs && list.size < n) {
+      slab_header *slab = shared.slabs;
+      if (slab->num_free == blocks_per_slab)
+        --shared.num_empty_slabs;
+      for (; slab->free_blocks && list.size < n; ++list.size) {
+        free_block *block = slab->free_blocks;
+        slab->free_blocks = block->next;
+        --slab->num_free;
+        block->next = list.head;
+        list.head = block;
+      }
+      if (slab->num_free == 0)
+        unlink(shared, slab);
+    }
+  }
+
+  /// Returns the first n blocks of the list and advances the list
+  /// to the remaining blocks.
+  static free_block *split_batch(free_list &list, std::size_t n) {
+    free_block *batch = list.head;
+    free_block *tail = batch;
+    for (std::size_t i = 1; i < n; ++i)
+      tail = tail->next;
+    list.head = tail->next;
+    list.size -= n;
+    tail->next = nullptr;
+    return batch;
+  }
+
+  static void return_to_shared_list(std::size_t size_class,
+                                    free_block *batch) {
+    shared_free_list &shared = get_shared_free_lists()[size_class];
+    const std::size_t blocks_per_slab = get_num_blocks_per_slab(size_class);
+    // Released after unlocking, linked through their next pointer
+    slab_header *unused_slabs = nullptr;
+    {
+      spin_lock_guard lock{shared.lock};
+      while (batch) {
+        free_block *block = batch;
+        batch = block->next;
+
+        slab_header *slab = get_slab(block);
+        block->next = slab->free_blocks;
+        slab->free_blocks = block;
+        if (slab->num_free++ == 0)
+          link_front(shared, slab);
+
+        if (slab->num_free == blocks_per_slab) {
+          unlink(shared, slab);
+          if (shared.num_empty_slabs < max_empty_slabs) {
+            // Prefer handing out blocks of partially used slabs, so that
+            // these can become empty as well.
+            link_back(shared, slab);
+            ++shared.num_empty_slabs;
+          } else {
+            slab->next = unused_slabs;
+            unused_slabs = slab;
+          }
+        }
+      }
+    }
+    while (unused_slabs) {
+      slab_header *slab = unused_slabs;
+      unused_slabs = slab->next;
+      release_slab(slab, size_class);
+    }
+  }
+
+  /// Moves all but the first n blocks of the list to the shared free list.
+  /// The first blocks are the most recently freed ones, which are most
+  /// likely still in cache.
+  static void spill_to_shared_list(free_list &list, std::size_t size_class,
+                                   std::size_t n) {
+    free_block *last_kept = list.head;
+    for (std::size_t i = 1; i < n; ++i)
+      last_kept = last_kept->next;
+
+    free_block *rest = last_kept->next;
+    last_kept->next = nullptr;
+    list.size = n;
+    return_to_shared_list(size_class, rest);
+  }
+
+  struct thread_cache_releaser {
+    ~thread_cache_releaser() {
+      is_thread_cache_released() = true;
+      for (std::size_t i = 0; i < num_size_classes; ++i) {
+        free_list &cache = get_thread_caches()[i];
+        if (cache.size > 0)
+          return_to_shared_list(i, split_batch(cache, cache.size));
+      }
+    }
+  };
+
+  static void register_thread_cache_releaser() {
+    static thread_local thread_cache_releaser releaser;
+    (void)releaser;
+  }
+
+  /// \return false if the list remains empty, because no new slab
+  /// is available.
+  static bool refill(free_list &cache, std::size_t size_class) {
+    shared_free_list &shared = get_shared_free_lists()[size_class];
+    {
+      spin_lock_guard lock{shared.lock};
+      take_from_shared_list(shared, size_class, cache, batch_size);
+    }
+    if (cache.size > 0)
+      return true;
+
+    // Only keep one batch in the thread cache, and make the remainder of the
+    // slab available to other threads.
+    slab_header *slab = allocate_slab(size_class);
+    if (!slab)
+      return false;
+    spin_lock_guard lock{shared.lock};
+    link_back(shared, slab);
+    ++shared.num_empty_slabs;
+    take_from_shared_list(shared, size_class, cache, batch_size);
+    return true;
+  }
+
+  // Trivially destructible and not allocated with operator new, so that
+  // threads can return their cached blocks during static destruction, and
+  // the cache can serve the allocations of a replaced operator new.
+  static shared_free_list *get_shared_free_lists() {
+    static shared_free_list lists[num_size_classes];
+    return lists;
+  }
+
+  // Trivially destructible, so that they remain usable while other
+  // thread_local objects of the exiting thread are destroyed.
+  static free_list *get_thread_caches() {
+    static thread_local free_list caches[num_size_classes] = {};
+    return caches;
+  }
+
+  static bool &is_thread_cache_released() {
+    static thread_local bool is_released = false;
+    return is_released;
+  }
+
+  static std::atomic<std::size_t> &get_slab_counter() {
+    static std::atomic<std::size_t> num_slabs{0};
+    return num_slabs;
+  }
+};
+
+}
+}
+
+#endif
@@ -30,6 +30,8 @@ struct MDKind {
   static constexpr const char InnerLoop[] = "hipSYCL.loop.inner";
   static constexpr const char WorkItemLoop[] = "hipSYCL.loop.workitem";
   static constexpr const char LoopState[] = "hipSYCL.loop_state";
+  static constexpr const char SubGroupShared[] = "hipSYCL.sub_group_shared";
+  static constexpr const char SubGroupUniform[] = "hipSYCL.sub_group_uniform";
 };
 
 namespace cbs {
@@ -58,6 +60,13 @@ static constexpr const char NumGroupsGlobalNameZ[] = "__acpp_cbs_num_groups_z";
 static const std::array<const char *, 3> NumGroupsGlobalNames{
     NumGroupsGlobalNameX, NumGroupsGlobalNameY, NumGroupsGlobalNameZ};
 
+static constexpr const char SubGroupOriginGlobalNameX[] = "__acpp_cbs_sub_group_origin_x";
+static constexpr const char SubGroupOriginGlobalNameY[] = "__acpp_cbs_sub_group_origin_y";
+static constexpr const char SubGroupOriginGlobalNameZ[] = "__acpp_cbs_sub_group_origin_z";
+static const std::array<const char *, 3> SubGroupOriginGlobalNames{
+    SubGroupOriginGlobalNameX, SubGroupOriginGlobalNameY, SubGroupOriginGlobalNameZ};
+static constexpr const char SubGroupSizeGlobalName[] = "__acpp_cbs_sub_group_size";
+
 static constexpr const char SscpDynamicLocalMemoryPtrName[] = "__acpp_cbs_sscp_dynamic_local_memory";
 static constexpr const char SscpInternalLocalMemoryPtrName[] = "__acpp_cbs_sscp_internal_local_memory";
 } // namespace cbs
@@ -27,6 +27,8 @@ using OptLevel = llvm::OptimizationLevel;
 void registerCBSPipelineLegacy(llvm::legacy::PassManagerBase &PM);
 
 // build the CBS pipeline for the new PM
-void registerCBSPipeline(llvm::ModulePassManager &MPM, OptLevel Opt, bool IsSscp);
+// SubGroupSize > 1 maps the sub-groups of SSCP kernels to that many SIMD lanes where possible
+void registerCBSPipeline(llvm::ModulePassManager &MPM, OptLevel Opt, bool IsSscp,
+                         int SubGroupSize = 0);
 } // namespace hipsycl::compiler
 #endif // HIPSYCL_PIPELINEBUILDER_HPP
@@ -20,6 +20,9 @@ namespace compiler {
 constexpr size_t EntryBarrierId = 0;
 constexpr size_t ExitBarrierId = -1;
 
+// returns the dimensionality of the kernel's nd_range
+std::size_t getRangeDim(llvm::Function &F);
+
 // performs the main CBS transformation
 class SubCfgFormationPassLegacy : public llvm::FunctionPass {
 public:
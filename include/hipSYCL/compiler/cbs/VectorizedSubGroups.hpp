@@ -0,0 +1,61 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_VECTORIZEDSUBGROUPS_HPP
+#define HIPSYCL_VECTORIZEDSUBGROUPS_HPP
+
+#include "llvm/IR/PassManager.h"
+
+namespace hipsycl::compiler {
+
+/// Function attribute holding the number of SIMD lanes that form a sub-group
+/// of an SSCP kernel. Without it, sub-groups consist of a single work item.
+static constexpr const char VectorizedSubGroupSizeAttr[] = "acpp-cbs-sub-group-size";
+
+/// Returns the sub-group size of a kernel with vectorized sub-groups, or 0.
+int getVectorizedSubGroupSize(const llvm::Function &F);
+
+/// Decides per SSCP kernel whether its sub-groups can be mapped to SubGroupSize
+/// SIMD lanes. This is the case for kernels without work-group barriers whose
+/// sub-group builtins are all supported by VectorizedSubGroupLoweringPass.
+/// The kernel is flattened, and the sub-group builtin calls are redirected to
+/// declarations, such that they survive the kernel flattening of the CBS pipeline.
+class VectorizedSubGroupPreparationPass
+    : public llvm::PassInfoMixin<VectorizedSubGroupPreparationPass> {
+  int SubGroupSize_;
+
+public:
+  explicit VectorizedSubGroupPreparationPass(int SubGroupSize) : SubGroupSize_(SubGroupSize) {}
+
+  llvm::PreservedAnalyses run(llvm::Function &F, llvm::FunctionAnalysisManager &AM);
+  static bool isRequired() { return true; }
+};
+
+/// Lowers the sub-group builtins of kernels with vectorized sub-groups.
+/// Work items are only distinguished by their lane within the sub-group from
+/// here on: sub-group collectives exchange values through a lane buffer
+/// between two barriers, and SubCfgFormationPass creates the work-item loops
+/// over the lanes of a single sub-group only.
+class VectorizedSubGroupLoweringPass : public llvm::PassInfoMixin<VectorizedSubGroupLoweringPass> {
+public:
+  explicit VectorizedSubGroupLoweringPass() {}
+
+  llvm::PreservedAnalyses run(llvm::Function &F, llvm::FunctionAnalysisManager &AM);
+  static bool isRequired() { return true; }
+};
+
+/// Moves the per sub-group computations of lowered sub-group collectives out of
+/// the work-item loops into the loop preheaders. Vector instructions in the loop
+/// body would otherwise prevent vectorization of the work-item loops.
+void hoistSubGroupUniformValues(llvm::Function &F);
+
+} // namespace hipsycl::compiler
+
+#endif // HIPSYCL_VECTORIZEDSUBGROUPS_HPP
@@ -0,0 +1,30 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_HOST_JIT_HPP
+#define HIPSYCL_HOST_JIT_HPP
+
+#include <llvm/Support/Error.h>
+#include <llvm/Target/TargetMachine.h>
+
+#include <memory>
+
+namespace hipsycl {
+namespace compiler {
+
+/// Creates a target machine for the host, which emits position-independent
+/// relocatable objects suitable for loadHostObject(). Targets the
+/// host CPU unless AdaptiveCpp was configured without native CPU support.
+llvm::Expected<std::unique_ptr<llvm::TargetMachine>> createHostTargetMachine();
+
+} // namespace compiler
+} // namespace hipsycl
+
+#endif
@@ -16,15 +16,23 @@
 namespace hipsycl {
 namespace compiler {
 
+/// Function attribute of kernels that contain work-group barriers,
+/// attached before barriers are lowered.
+static constexpr const char HostKernelUsesBarriersAttr[] = "acpp-host-uses-barriers";
+
 class HostKernelWrapperPass : public llvm::PassInfoMixin<HostKernelWrapperPass> {
   std::int64_t DynamicLocalMemSize;
   std::array<int, 3> KnownWgSize;
+  int GroupCoarseningFactor;
+  bool UseFiberBarriers;
 
 public:
   explicit HostKernelWrapperPass(std::int64_t DynamicLocalMemSize, int KnownGroupSizeX,
-                                 int KnownGroupSizeY, int KnownGroupSizeZ)
+                                 int KnownGroupSizeY, int KnownGroupSizeZ,
+                                 int GroupCoarseningFactor = 1, bool UseFiberBarriers = false)
       : DynamicLocalMemSize{DynamicLocalMemSize},
-        KnownWgSize{KnownGroupSizeX, KnownGroupSizeY, KnownGroupSizeZ} {}
+        KnownWgSize{KnownGroupSizeX, KnownGroupSizeY, KnownGroupSizeZ},
+        GroupCoarseningFactor{GroupCoarseningFactor}, UseFiberBarriers{UseFiberBarriers} {}
 
   llvm::PreservedAnalyses run(llvm::Function &F, llvm::FunctionAnalysisManager &AM);
   static bool isRequired() { return true; }
@@ -31,11 +31,21 @@ public:
   virtual bool translateToBackendFormat(llvm::Module &FlavoredModule, std::string &out) override;
 protected:
   virtual bool applyBuildOption(const std::string &Option, const std::string &Value) override;
+  virtual bool applyBuildFlag(const std::string &Flag) override;
   virtual bool isKernelAfterFlavoring(llvm::Function& F) override;
   virtual AddressSpaceMap getAddressSpaceMap() const override;
   virtual void migrateKernelProperties(llvm::Function* From, llvm::Function* To) override;
 private:
   std::vector<std::string> KernelNames;
+  // Number of consecutive work groups in x direction that are executed
+  // per kernel invocation
+  int GroupCoarseningFactor = 1;
+  // Whether kernels with barriers are executed as one fiber per work item
+  // instead of being split into work item loops between barriers
+  bool UseFiberBarriers = false;
+  // Whether the sub-groups of kernels without barriers are mapped to the
+  // SIMD lanes of the host instead of single work items
+  bool UseVectorizedSubGroups = false;
 };
 
 }
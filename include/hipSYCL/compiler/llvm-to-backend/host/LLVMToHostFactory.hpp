@@ -11,9 +11,11 @@
 #ifndef HIPSYCL_LLVM_TO_HOST_FACTORY_HPP
 #define HIPSYCL_LLVM_TO_HOST_FACTORY_HPP
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <string>
+#include <string_view>
 #include "../LLVMToBackend.hpp"
 
 namespace hipsycl {
@@ -22,6 +24,39 @@ namespace compiler {
 std::unique_ptr<LLVMToBackendTranslator>
 createLLVMToHostTranslator(const std::vector<std::string> &KernelNames);
 
+/// For each kernel, the translator emits a 32-bit constant with this prefix
+/// holding HostKernelFlags, which describe what the kernel needs to be
+/// set up at launch.
+static constexpr const char HostKernelFlagsPrefix[] = "__acpp_sscp_host_kernel_flags_";
+
+enum HostKernelFlags : std::uint32_t {
+  UsesLocalMemory = 1u << 0,
+  UsesInternalLocalMemory = 1u << 1,
+  // The kernel contains work-group barriers
+  UsesBarriers = 1u << 2,
+  // The kernel was lowered to one invocation per work item, which need to
+  // execute as fibers that synchronize at barriers through the barrier
+  // callback of the work-group info.
+  UsesFiberBarriers = 1u << 3
+};
+
+/// A relocatable object produced by the host translator that has been
+/// linked into executable memory of the current process.
+/// Its code remains valid until the object is destroyed.
+class LoadedHostObject {
+public:
+  virtual ~LoadedHostObject() {}
+  /// Returns the address of the given symbol, or nullptr if the object
+  /// does not define it.
+  virtual void *getSymbol(const std::string &Name) const = 0;
+};
+
+/// Loads the relocatable object Object. Symbols that are not defined in the
+/// object are resolved against the current process.
+/// Returns nullptr and sets ErrorMessage if the object cannot be loaded.
+std::unique_ptr<LoadedHostObject> loadHostObject(std::string_view Object,
+                                                 std::string &ErrorMessage);
+
 }
 }
 
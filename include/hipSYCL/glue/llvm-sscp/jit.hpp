@@ -405,19 +405,22 @@ inline rt::result compile_kernel(compiler::LLVMToBackendTranslator *translator,
 
   assert(translator->getKernels().size() == 1);
 
-  rt::result err = rt::make_success();
-
-  common::filesystem::persistent_storage::get()
-      .get_this_app_db()
-      .read_write_access([&](common::db::appdb_data &appdb) {
-        std::vector<int> *retained_args =
-            &(appdb.kernels[binary_id].retained_argument_indices);
-
-        translator->enableDeadArgumentElminiation(translator->getKernels()[0],
-                                                  retained_args);
-        err = compile(translator, hcf_object, image_name, config, refl_map,
-                      output);
-      });
+  // Don't hold the appdb lock while compiling, so that multiple
+  // kernels can be compiled concurrently.
+  std::vector<int> retained_args;
+  translator->enableDeadArgumentElminiation(translator->getKernels()[0],
+                                            &retained_args);
+  rt::result err =
+      compile(translator, hcf_object, image_name, config, refl_map, output);
+
+  if(err.is_success()) {
+    common::filesystem::persistent_storage::get()
+        .get_this_app_db()
+        .read_write_access([&](common::db::appdb_data &appdb) {
+          appdb.kernels[binary_id].retained_argument_indices =
+              std::move(retained_args);
+        });
+  }
 
   return err;
 }
@@ -316,26 +316,15 @@ public:
       }
       auto *invoker = sscp_invoker.value();
 
-      auto selected_group_size = launch_config.group_size;
-      if (launch_config.group_size.size() == 0)
-        selected_group_size = invoker->select_group_size(
-            launch_config.global_size, launch_config.group_size);
-
-      rt::range<3> num_groups;
-      for(int i = 0; i < 3; ++i) {
-        num_groups[i] = (launch_config.global_size[i] + selected_group_size[i] - 1) /
-                        selected_group_size[i];
-      }
-
       std::array<const void*, 1> args{launch_config.kernel_args.data()};
       std::size_t arg_size = launch_config.kernel_args.size();
 
-      return invoker->submit_kernel(
-          *kernel_op, launch_config.sscp_hcf_object_id, num_groups,
-          selected_group_size, launch_config.local_mem_size,
-          const_cast<void **>(args.data()), &arg_size, args.size(),
-          launch_config.sscp_kernel_id, launch_config.kernel_info,
-          kernel_config);
+      return invoker->submit_kernel_for_global_range(
+          *kernel_op, launch_config.sscp_hcf_object_id,
+          launch_config.global_size, launch_config.group_size,
+          launch_config.local_mem_size, const_cast<void **>(args.data()),
+          &arg_size, args.size(), launch_config.sscp_kernel_id,
+          launch_config.kernel_info, kernel_config);
     }
   }
 
@@ -11,6 +11,7 @@
 #ifndef HIPSYCL_ADAPTIVITY_ENGINE_HPP
 #define HIPSYCL_ADAPTIVITY_ENGINE_HPP
 
+#include <optional>
 
 #include "hipSYCL/glue/llvm-sscp/jit.hpp"
 #include "hipSYCL/runtime/kernel_configuration.hpp"
@@ -37,6 +38,12 @@ public:
   kernel_configuration::id_type
   finalize_binary_configuration(kernel_configuration &config);
 
+  /// If finalize_binary_configuration() has specialized the configuration
+  /// based on statistics gathered from previous invocations, returns the
+  /// configuration without these specializations. Kernels can be launched
+  /// using this configuration while the specialized kernel is not available.
+  const std::optional<kernel_configuration>& get_fallback_configuration() const;
+
   std::string select_image_and_kernels(std::vector<std::string>* kernel_names_out);
 private:
   hcf_object_id _hcf;
@@ -51,6 +58,7 @@ private:
   std::size_t _local_mem_size;
 
   int _adaptivity_level;
+  std::optional<kernel_configuration> _fallback_config;
 };
 
 }
@@ -59,6 +59,30 @@ public:
     }
     return selected_group_size;
   }
+
+  /// Submits a kernel for the given global range. If \c group_size is
+  /// empty, the group size is chosen by the invoker.
+  virtual result submit_kernel_for_global_range(
+      const kernel_operation &op, hcf_object_id hcf_object,
+      const rt::range<3> &global_range, const rt::range<3> &group_size,
+      unsigned local_mem_size, void **args, std::size_t *arg_sizes,
+      std::size_t num_args, std::string_view kernel_name,
+      const rt::hcf_kernel_info *kernel_info,
+      const kernel_configuration &config) {
+    rt::range<3> selected_group_size = group_size;
+    if (group_size.size() == 0)
+      selected_group_size = select_group_size(global_range, group_size);
+
+    rt::range<3> num_groups;
+    for(int i = 0; i < 3; ++i) {
+      num_groups[i] = (global_range[i] + selected_group_size[i] - 1) /
+                      selected_group_size[i];
+    }
+
+    return submit_kernel(op, hcf_object, num_groups, selected_group_size,
+                         local_mem_size, args, arg_sizes, num_args,
+                         kernel_name, kernel_info, config);
+  }
   
   virtual ~sscp_code_object_invoker(){}
 };
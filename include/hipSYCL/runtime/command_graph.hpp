@@ -0,0 +1,86 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_COMMAND_GRAPH_HPP
+#define HIPSYCL_COMMAND_GRAPH_HPP
+
+#include <cstddef>
+#include <memory>
+#include <typeindex>
+#include <vector>
+
+#include "dag_node.hpp"
+#include "device_id.hpp"
+#include "error.hpp"
+#include "hints.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+class backend_executor;
+class operation;
+class runtime;
+
+/// A recorded sequence of operations that can be submitted again without
+/// going through the DAG builder and scheduler.
+///
+/// Nodes are recorded after they have been scheduled regularly. Their
+/// dependencies within the graph, their devices and the executors (for
+/// multi-queue executors, the executor of the lane) that they were scheduled
+/// to are stored, so that a replay only needs to create the new nodes and hand
+/// them to the recorded executors.
+///
+/// Only operations without memory requirements can be recorded, since the
+/// data state of buffers would need to be tracked across replays.
+class command_graph {
+public:
+  command_graph(runtime *rt);
+
+  /// Records a node. Nodes must be recorded in submission order, and must
+  /// have been submitted.
+  result record(const dag_node_ptr &node);
+
+  std::size_t get_num_nodes() const;
+
+  /// Prepares a new replay. Replays of the same graph must not overlap.
+  void begin_replay();
+  /// Submits the operation corresponding to the next recorded node.
+  ///
+  /// \param additional_requirements Dependencies of the new operation in
+  /// addition to the recorded ones, e.g. nodes outside of the graph.
+  result replay_next(std::unique_ptr<operation> op,
+                     const execution_hints &hints,
+                     const node_list_t &additional_requirements,
+                     dag_node_ptr &node_out);
+  /// Completes the replay and returns the nodes that no other node of the
+  /// graph depends on. Waiting for them waits for the whole replay.
+  result end_replay(node_list_t &sinks_out);
+
+private:
+  struct recorded_node {
+    backend_executor *executor;
+    device_id device;
+    std::type_index operation_type;
+    // Indices of earlier nodes of the graph
+    std::vector<std::size_t> dependencies;
+    bool is_sink;
+  };
+
+  runtime *_rt;
+  std::vector<recorded_node> _nodes;
+  std::vector<dag_node_ptr> _recorded_nodes;
+  // Nodes of the current replay
+  std::vector<dag_node_ptr> _replayed_nodes;
+};
+
+}
+}
+
+#endif
@@ -13,6 +13,7 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 
 #include "hipSYCL/runtime/kernel_configuration.hpp"
 #include "hipSYCL/runtime/error.hpp"
@@ -69,7 +70,7 @@ private:
 
 class cuda_sscp_executable_object : public cuda_executable_object {
 public:
-  cuda_sscp_executable_object(const std::string &ptx_source,
+  cuda_sscp_executable_object(std::string_view ptx_source,
                               const std::string &target_arch,
                               hcf_object_id hcf_source,
                               const std::vector<std::string> &kernel_names,
@@ -96,7 +97,7 @@ public:
 
   // Only for adaptivity level >= 1
 private:
-  result build(const std::string& source);
+  result build(std::string_view source);
 
   std::string _target_arch;
   hcf_object_id _hcf;
@@ -45,6 +45,10 @@ public:
   node_list_t get_group(std::size_t node_group_id);
 
   void register_submitted_ops(dag_node_ptr);
+  // Registers a node that has been submitted without going through
+  // the DAG. This keeps it alive until completion, and makes waiting
+  // take it into account.
+  void register_external_submission(const dag_node_ptr& node);
 private:
   void trigger_flush_opportunity();
 
@@ -16,6 +16,7 @@
 
 #include "hints.hpp"
 #include "event.hpp"
+#include "slab_allocator.hpp"
 #include "hipSYCL/common/small_vector.hpp"
 
 
@@ -73,6 +74,12 @@ public:
   /// but for_each_executed_operation() will recognize that this was
   /// the operation that was actually executed.
   void assign_effective_operation(std::unique_ptr<operation> op);
+  /// Only to be called by the backend executor/scheduler.
+  /// Attaches a node that carries out part of the work of this node,
+  /// e.g. one of several data transfers needed to satisfy a requirement.
+  /// The subnode is added as a requirement and kept alive together
+  /// with this node.
+  void add_subnode(dag_node_ptr subnode);
 
   device_id get_assigned_device() const;
   backend_executor *get_assigned_executor() const;
@@ -107,6 +114,8 @@ public:
   template<class Handler>
   void for_each_executed_operation(Handler h) {
     assert(is_submitted());
+    for(const auto& subnode : _subnodes)
+      subnode->for_each_executed_operation(h);
     if(_replacement_executed_operation)
       h(_replacement_executed_operation.get());
     else
@@ -130,6 +139,7 @@ private:
   /// API consisting of subnodes to properly handle
   /// dependencies for multi-operation cases
   std::unique_ptr<operation> _replacement_executed_operation;
+  node_list_t _subnodes;
 
   std::atomic<bool> _is_submitted;
   mutable std::atomic<bool> _is_complete;
@@ -140,6 +150,13 @@ private:
 
 };
 
+/// Creates a node, with the node and its reference count in a single
+/// allocation from the slab allocator.
+template <class... Args> dag_node_ptr make_dag_node(Args &&...args) {
+  return std::allocate_shared<dag_node>(slab_std_allocator<dag_node>{},
+                                        std::forward<Args>(args)...);
+}
+
 }
 }
 
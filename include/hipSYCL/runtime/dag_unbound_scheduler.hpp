@@ -11,21 +11,88 @@
 #ifndef HIPSYCL_DAG_UNBOUND_SCHEDULER_HPP
 #define HIPSYCL_DAG_UNBOUND_SCHEDULER_HPP
 
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "dag_node.hpp"
 #include "dag_direct_scheduler.hpp"
+#include "hw_model/cost.hpp"
 
 namespace hipsycl {
 namespace rt {
 
 class runtime;
 
+/// Schedules nodes that are not bound to a particular device.
+///
+/// Devices are selected HEFT-style: for each eligible device, the earliest
+/// finish time of the node is estimated from the time at which the device
+/// becomes available, the cost of transferring outdated data to the device,
+/// and the execution time of the kernel on that device as measured for
+/// previous invocations. The node is then bound to the device
+/// with the earliest estimated finish time.
 class dag_unbound_scheduler {
 public:
   dag_unbound_scheduler(runtime* rt);
 
   void submit(dag_node_ptr node);
 private:
+  struct in_flight_node {
+    std::weak_ptr<dag_node> node;
+    // Empty if the node is not a kernel
+    std::string kernel_key;
+  };
+
+  struct device_state {
+    // Estimated time (in ns, steady clock) at which all work that was
+    // scheduled to the device has completed
+    uint64_t available_time = 0;
+    // Nodes scheduled to the device that have not been seen to complete,
+    // in submission order
+    std::deque<in_flight_node> in_flight_nodes;
+  };
+
+  struct kernel_runtime {
+    // Exponential moving average of the kernel runtime in ns, or
+    // negative if no runtime has been measured yet.
+    double average = -1.0;
+    // Number of launches for which a measurement was requested
+    std::size_t num_requested_samples = 0;
+  };
+
+  struct kernel_statistics {
+    std::vector<kernel_runtime> devices;
+    std::size_t num_launches = 0;
+    // Value of _num_submissions at the last launch, used for aging
+    uint64_t last_use = 0;
+  };
+
+  void initialize_devices();
+  std::size_t get_device_index(device_id dev);
+  void update_device_states(uint64_t now);
+  void update_kernel_runtime(const dag_node_ptr &node,
+                             const std::string &kernel_key,
+                             std::size_t device_index);
+
+  cost_type estimate_data_transfer_cost(const dag_node_ptr &node,
+                                        device_id dev) const;
+  // Returns a negative value if no runtime has been measured yet.
+  cost_type estimate_execution_cost(const kernel_statistics &stats,
+                                    std::size_t device_index) const;
+  bool needs_runtime_measurement(kernel_statistics &stats,
+                                 std::size_t device_index) const;
+  kernel_statistics &get_kernel_statistics(const std::string &kernel_key);
+  void evict_unused_kernel_statistics();
+
   std::vector<device_id> _devices;
+  std::vector<device_state> _device_states;
+  std::unordered_map<std::string, kernel_statistics> _kernel_statistics;
+  uint64_t _num_submissions = 0;
+
   rt::dag_direct_scheduler _direct_scheduler;
   runtime* _rt;
 };
@@ -28,6 +28,10 @@
 namespace hipsycl {
 namespace rt {
 
+/// Tracks which entries of a 3D grid (typically pages of a buffer)
+/// are in the \c available state. The available entries are stored as
+/// a list of disjoint rects, such that the cost of all operations scales
+/// with the number of fragments instead of the number of entries.
 class range_store
 {
 public:
@@ -47,6 +51,8 @@ public:
 
   range<3> get_size() const;
 
+  /// Writes a set of disjoint rects to \c out that together cover
+  /// exactly the entries of \c r that are in \c desired_state.
   void intersections_with(const rect& r, 
                           data_state desired_state,
                           std::vector<rect>& out) const;
@@ -67,132 +73,19 @@ public:
   bool entire_range_empty(const rect& r) const
   { return entire_range_equals(r, data_state::empty); }
 
-private:
-  template<class Entry_selection_predicate>
-  range<3> find_max_contiguous_rect_extent(
-    id<3> begin,
-    id<3> search_range_end,
-    Entry_selection_predicate p) const
-  {
-    // Find out length of longest contiguous row
-    size_t z_size = 
-      find_z_size(begin, search_range_end, p);
-
-    // Now go to 2D and find out width of surface
-    size_t y_size = 1;
-    if(_size[1] > 1)
-      y_size = find_y_size(begin, search_range_end, z_size, p);
-
-    // Now 3D
-    size_t x_size = 1;
-    if(_size[0] > 1)
-      x_size = find_x_size(begin, search_range_end, z_size, y_size, p);
-
-    return range<3>{x_size, y_size, z_size};
-    
-  }
-
-  template<class Entry_selection_predicate>
-  size_t find_x_size(id<3> begin,
-                     id<3> search_range_end,
-                     size_t z_size,
-                     size_t y_size,
-                     Entry_selection_predicate p) const
-  {
-    for(size_t x_offset = 0; x_offset < search_range_end[0]-begin[0]; ++x_offset){
-      id<3> surface_begin = begin;
-      surface_begin[0] += x_offset;
-
-      if(find_y_size(surface_begin, search_range_end, z_size, p) != y_size){
-        return x_offset;
-      }
-    }
-    return search_range_end[0] - begin[0];
-  }
-
-  template<class Entry_selection_predicate>
-  size_t find_y_size(id<3> begin,
-                    id<3> search_range_end,
-                    size_t z_size,
-                    Entry_selection_predicate p) const
-  {
-    for(size_t y_offset = 0; y_offset < search_range_end[1]-begin[1]; ++y_offset){
-      id<3> row_begin = begin;
-      row_begin[1] += y_offset;
-
-      if(find_z_size(row_begin, search_range_end, p) != z_size){
-        return y_offset;
-      }
-    }
-    return search_range_end[1] - begin[1];
-  }
-
-  template<class Entry_selection_predicate>
-  size_t find_z_size(id<3> begin,
-                    id<3> search_range_end,
-                    Entry_selection_predicate p) const
-  {
-    size_t base_pos = get_index(begin);
-    size_t max_length = search_range_end[2] - begin[2];
-    for(size_t offset = 0; offset < max_length; ++offset)
-    {
-      if(!p(base_pos + offset))
-        return offset;
-    }
-    return max_length;
-  }
+  /// \return The number of disjoint rects that the available
+  /// entries are currently made up of.
+  std::size_t get_num_fragments() const
+  { return _available_rects.size(); }
 
-  template<class Function>
-  void for_each_element_in_range(const rect& r,
-    std::vector<data_state>& v,
-    Function f) const
-  {
-    for(size_t x = r.first[0]; x < r.second[0]+r.first[0]; ++x){
-      for(size_t y = r.first[1]; y < r.second[1]+r.first[1]; ++y){
-        for(size_t z = r.first[2]; z < r.second[2]+r.first[2]; ++z){
-
-          id<3> idx{x,y,z};
-          size_t pos = get_index(idx);
-          assert(pos < v.size());
-          f(id<3>{x,y,z}, v[pos]);
-        }
-      }
-    }
-  }
-
-  template<class Function>
-  void for_each_element_in_range(const rect& r, 
-    const std::vector<data_state>& v, 
-    Function f) const
-  {
-    for(size_t x = r.first[0]; x < r.second[0]+r.first[0]; ++x){
-      for(size_t y = r.first[1]; y < r.second[1]+r.first[1]; ++y){
-        for(size_t z = r.first[2]; z < r.second[2]+r.first[2]; ++z){
-
-          id<3> idx{x,y,z};
-          size_t pos = get_index(idx);
-          assert(pos < v.size());
-          f(id<3>{x,y,z}, v[pos]);
-        }
-      }
-    }
-  }
-
-  template<class Function>
-  void for_each_element_in_range(const rect& r, Function f) const
-  { for_each_element_in_range(r, _contained_data, f); }
-
-  template<class Function>
-  void for_each_element_in_range(const rect& r, Function f)
-  { for_each_element_in_range(r, _contained_data, f); }
-
-  size_t get_index(id<3> pos) const
-  {
-    return pos[0] * _size[1] * _size[2] + pos[1] * _size[2] + pos[2]; 
-  }
+private:
+  /// Merges rects that share a face into larger rects. The result
+  /// is not necessarily the smallest possible set of rects.
+  static void coalesce(std::vector<rect>& rects);
 
   range<3> _size;
-  std::vector<data_state> _contained_data;
+  // Disjoint rects, covering exactly all available entries
+  std::vector<rect> _available_rects;
 };
 
 
@@ -206,13 +99,22 @@ struct data_user
 };
 
 
+/// Tracks the operations that access a data region.
+///
+/// Users are indexed by the pages they access, such that finding the users
+/// that may conflict with a new access only visits users in the vicinity of
+/// the accessed pages instead of all users. The page grid is coarsened into at
+/// most \c max_num_buckets buckets. Users that span many buckets (e.g.
+/// accesses to the entire buffer) are kept in a separate list that is visited
+/// by every query.
 class data_user_tracker
 {
 public:
-  using user_iterator = std::vector<data_user>::iterator;
-  using const_user_iterator = std::vector<data_user>::const_iterator;
+  static constexpr std::size_t max_num_buckets = 4096;
+  static constexpr std::size_t max_buckets_per_user = 16;
 
-  data_user_tracker() = default;
+  data_user_tracker();
+  data_user_tracker(range<3> num_elements, range<3> page_size);
   data_user_tracker(const data_user_tracker& other);
   data_user_tracker(data_user_tracker&& other);
   data_user_tracker& operator=(data_user_tracker other);
@@ -220,23 +122,36 @@ public:
 
   const std::vector<data_user> get_users() const;
 
+  std::size_t get_num_users() const;
+
   template<class F>
   void for_each_user(F f){
     std::lock_guard<std::mutex> lock{_lock};
-    // Iterate in reverse order over the users since
-    // this will iterate over the newest users first.
-    // This is a more advantageous pattern e.g. during
-    // DAG construction as it allows finding the relevant users
-    // quicker.
-    for(int i = _users.size() - 1; i >= 0; --i) {
-      f(_users[i]);
+    for(std::size_t i = 0; i < _entries.size(); ++i) {
+      if(_entries[i].is_used)
+        f(_entries[i].user);
     }
   }
 
+  /// Invokes \c f for all users whose accessed pages may intersect the
+  /// pages of the given element range. \c f is also invoked for some users
+  /// that do not intersect, so it still has to check the access ranges.
+  template<class F>
+  void for_each_overlapping_user(id<3> offset, range<3> range, F f) {
+    std::lock_guard<std::mutex> lock{_lock};
+    for_each_candidate(offset, range, [&](std::size_t entry) {
+      f(_entries[entry].user);
+    });
+  }
+
   bool has_user(dag_node_ptr user) const;
 
   void release_dead_users();
 
+  /// Adds a new user. Existing users for which \c replaces_user returns
+  /// true are removed. Since a user can only be replaced by an access that
+  /// contains it, \c replaces_user is only invoked for users that intersect
+  /// the new access.
   template<class Predicate>
   void add_user(dag_node_ptr user, 
                 sycl::access::mode mode, 
@@ -246,15 +161,87 @@ public:
                 Predicate replaces_user) {
     std::lock_guard<std::mutex> lock{_lock};
 
-    _users.erase(std::remove_if(_users.begin(), _users.end(), replaces_user), 
-      _users.end());
+    _replaced_entries.clear();
+    for_each_candidate(offset, range, [&](std::size_t entry) {
+      if(replaces_user(_entries[entry].user))
+        _replaced_entries.push_back(entry);
+    });
+    for(std::size_t entry : _replaced_entries)
+      remove_entry(entry);
 
-    _users.push_back(
+    insert_entry(
       data_user{std::weak_ptr<dag_node>(user), mode, target, offset, range});
   }
 
 private:
-  std::vector<data_user> _users;
+  struct user_entry {
+    data_user user;
+    // Id of the last query that has visited this entry, to avoid
+    // visiting users multiple times that are stored in multiple buckets.
+    std::size_t visit_id;
+    bool is_used;
+  };
+
+  using bucket_rect = std::pair<id<3>, range<3>>;
+
+  /// Calculates the buckets that the pages of an element range fall into.
+  /// \return false if the range is empty.
+  bool get_bucket_rect(id<3> offset, range<3> range, bucket_rect& out) const;
+  std::size_t get_bucket_index(id<3> bucket) const;
+
+  template<class F>
+  void for_each_bucket(const bucket_rect& r, F f) {
+    for(std::size_t x = r.first[0]; x < r.first[0] + r.second[0]; ++x)
+      for(std::size_t y = r.first[1]; y < r.first[1] + r.second[1]; ++y)
+        for(std::size_t z = r.first[2]; z < r.first[2] + r.second[2]; ++z)
+          f(_buckets[get_bucket_index(id<3>{x, y, z})]);
+  }
+
+  /// Visits every entry that may intersect the given element range once.
+  /// Requires _lock to be held.
+  template<class F>
+  void for_each_candidate(id<3> offset, range<3> range, F f) {
+    bucket_rect r;
+    if(!get_bucket_rect(offset, range, r)) {
+      // Empty ranges are not indexed
+      for(std::size_t i = 0; i < _entries.size(); ++i)
+        if(_entries[i].is_used)
+          f(i);
+      return;
+    }
+
+    // Entries in this list are not stored in any bucket
+    for(std::size_t entry : _unindexed_entries)
+      f(entry);
+
+    const std::size_t visit_id = ++_current_visit_id;
+    for_each_bucket(r, [&](const std::vector<std::size_t>& bucket) {
+      for(std::size_t entry : bucket) {
+        if(_entries[entry].visit_id != visit_id) {
+          _entries[entry].visit_id = visit_id;
+          f(entry);
+        }
+      }
+    });
+  }
+
+  void insert_entry(const data_user& user);
+  void remove_entry(std::size_t entry);
+  void move_from(data_user_tracker& other);
+
+  range<3> _pages_per_bucket;
+  range<3> _num_buckets;
+  range<3> _page_size;
+
+  std::vector<user_entry> _entries;
+  std::vector<std::size_t> _free_entries;
+  std::vector<std::vector<std::size_t>> _buckets;
+  // Users with empty ranges or that span too many buckets
+  std::vector<std::size_t> _unindexed_entries;
+  std::vector<std::size_t> _replaced_entries;
+  std::size_t _current_visit_id = 0;
+  std::size_t _num_users = 0;
+
   mutable std::mutex _lock;
 };
 
@@ -390,7 +377,7 @@ public:
   data_region(
       range<3> num_elements, std::size_t element_size, range<3> page_size)
       : _element_size{element_size}, _page_size{page_size},
-        _num_elements{num_elements} {
+        _num_elements{num_elements}, _user_tracker{num_elements, page_size} {
 
     for(std::size_t i = 0; i < 3; ++i){
       assert(page_size[i] > 0);
@@ -549,21 +536,8 @@ public:
     
     // Convert back to num elements
     for(range_store::rect& r : out) {
-      for(int i = 0; i < 3; ++i) {
-        r.first[i] *= _page_size[i];
-        r.second[i] *= _page_size[i];
-
-        // Clamp result range to data range. This is necessary
-        // if the number of elements is not divisible by the page
-        // size, in which case we can end up out of bounds when mapping
-        // pages back to elements.
-        r.first[i] = std::min(r.first[i], _num_elements[i]);
-
-        std::size_t max_range = _num_elements[i] - r.first[i];
-        r.second[i] = std::min(r.second[i], max_range);
-
-        assert(r.first[i]+r.second[i] <= _num_elements[i]);
-      }
+      r = pages_to_elements(
+          r, std::make_pair(id<3>{0, 0, 0}, _num_elements));
     }
   }
 
@@ -586,11 +560,74 @@ public:
       }
       return true;
     });
-    if(update_sources.empty()){
-      assert(false && "Could not find valid data source for updating data buffer - "
-              "this can happen if several data transfers are required to update accessed range, "
-              "which is not yet supported.");
+  }
+
+  /// Splits the given range (in elements) into fragments that can each be
+  /// updated on device \c d from a single other allocation. This is needed
+  /// if no allocation holds the entire range, e.g. after different parts of
+  /// a buffer have been written on different devices.
+  ///
+  /// Allocations are considered in the order of increasing
+  /// \c source_cost(device), and each fragment is taken from the first
+  /// allocation that holds it. Parts of the range that are not valid on
+  /// any other allocation do not appear in \c fragments.
+  ///
+  /// \return whether the fragments cover the entire range
+  template <class SourceCostFunction>
+  bool get_update_source_fragments(
+      const device_id &d, const range_store::rect &data_range,
+      SourceCostFunction &&source_cost,
+      std::vector<std::pair<device_id, range_store::rect>> &fragments) const {
+    fragments.clear();
+
+    page_range pr = get_page_range(data_range.first, data_range.second);
+
+    std::vector<std::pair<device_id, std::vector<range_store::rect>>>
+        candidates;
+
+    default_allocation_selector selector{d};
+    _allocations.for_each_allocation_while([&](const auto &alloc) {
+      if (!selector(alloc)) {
+        std::vector<range_store::rect> valid_pages;
+        alloc.invalid_pages.inverted_intersections_with(pr, valid_pages);
+        if (!valid_pages.empty())
+          candidates.push_back(
+              std::make_pair(alloc.dev, std::move(valid_pages)));
+      }
+      return true;
+    });
+
+    std::vector<decltype(source_cost(d))> costs;
+    for (const auto &c : candidates)
+      costs.push_back(source_cost(c.first));
+
+    std::vector<std::size_t> order(candidates.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+      order[i] = i;
+    std::stable_sort(order.begin(), order.end(),
+                     [&](std::size_t a, std::size_t b) {
+                       return costs[a] < costs[b];
+                     });
+
+    range_store remaining{_num_pages};
+    remaining.add(pr);
+
+    std::vector<range_store::rect> taken_pages;
+    for (std::size_t candidate_index : order) {
+      const auto &candidate = candidates[candidate_index];
+      for (const range_store::rect &valid : candidate.second) {
+        remaining.intersections_with(valid, taken_pages);
+        for (const range_store::rect &r : taken_pages) {
+          remaining.remove(r);
+          range_store::rect fragment = pages_to_elements(r, data_range);
+          if (fragment.second.size() > 0)
+            fragments.push_back(std::make_pair(candidate.first, fragment));
+        }
+      }
+      if (remaining.entire_range_empty(pr))
+        return true;
     }
+    return remaining.entire_range_empty(pr);
   }
 
   data_user_tracker& get_users()
@@ -680,6 +717,28 @@ private:
 
   allocation_list<Memory_descriptor> _allocations;
 
+  /// Converts a page rect back to elements, clamped to \c bounds (in elements).
+  /// Clamping is necessary if the number of elements is not divisible by the
+  /// page size, in which case we can end up out of bounds when mapping
+  /// pages back to elements.
+  range_store::rect pages_to_elements(range_store::rect r,
+                                      const range_store::rect &bounds) const {
+    for(int i = 0; i < 3; ++i) {
+      std::size_t begin = r.first[i] * _page_size[i];
+      std::size_t end = begin + r.second[i] * _page_size[i];
+
+      std::size_t bounds_end = bounds.first[i] + bounds.second[i];
+      begin = std::min(std::max(begin, bounds.first[i]), bounds_end);
+      end = std::max(begin, std::min(end, bounds_end));
+
+      r.first[i] = begin;
+      r.second[i] = end - begin;
+
+      assert(r.first[i] + r.second[i] <= _num_elements[i]);
+    }
+    return r;
+  }
+
   enum class initial_data_state {
     valid,
     invalid
@@ -16,12 +16,188 @@
 #include <condition_variable>
 #include <mutex>
 #include <functional>
-#include <queue>
+#include <deque>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
 
 
 namespace hipsycl {
 namespace rt {
 
+namespace detail {
+
+/// A move-only, type-erased nullary task. Callables that fit into the
+/// inline storage are constructed in-place, larger ones are moved to the heap.
+/// Unlike std::function, this does not allocate for the lambdas that
+/// are typically submitted to worker threads.
+class worker_task {
+public:
+  static constexpr std::size_t inline_storage_size = 112;
+
+  worker_task() noexcept = default;
+
+  template <class F, std::enable_if_t<!std::is_same_v<std::decay_t<F>,
+                                                      worker_task>,
+                                      int> = 0>
+  worker_task(F &&f) {
+    using callable_type = std::decay_t<F>;
+    if constexpr (is_stored_inline<callable_type>()) {
+      new (&_storage) callable_type(std::forward<F>(f));
+      _invoke = [](void *storage) {
+        (*static_cast<callable_type *>(storage))();
+      };
+      _manage = [](operation op, void *storage, void *other) noexcept {
+        auto *self = static_cast<callable_type *>(storage);
+        if (op == operation::relocate)
+          new (other) callable_type(std::move(*self));
+        self->~callable_type();
+      };
+    } else {
+      auto heap_callable = std::make_unique<callable_type>(std::forward<F>(f));
+      new (&_storage) callable_type *(heap_callable.release());
+      _invoke = [](void *storage) {
+        (**static_cast<callable_type **>(storage))();
+      };
+      _manage = [](operation op, void *storage, void *other) noexcept {
+        auto **self = static_cast<callable_type **>(storage);
+        if (op == operation::relocate)
+          new (other) callable_type *(*self);
+        else
+          delete *self;
+      };
+    }
+  }
+
+  worker_task(worker_task &&other) noexcept { take(other); }
+
+  worker_task &operator=(worker_task &&other) noexcept {
+    if (this != &other) {
+      reset();
+      take(other);
+    }
+    return *this;
+  }
+
+  worker_task(const worker_task &) = delete;
+  worker_task &operator=(const worker_task &) = delete;
+
+  ~worker_task() { reset(); }
+
+  explicit operator bool() const noexcept { return _invoke != nullptr; }
+
+  void operator()() { _invoke(&_storage); }
+
+  void reset() noexcept {
+    if (_manage)
+      _manage(operation::destroy, &_storage, nullptr);
+    _invoke = nullptr;
+    _manage = nullptr;
+  }
+
+private:
+  enum class operation { relocate, destroy };
+
+  template <class T> static constexpr bool is_stored_inline() {
+    return sizeof(T) <= inline_storage_size &&
+           alignof(T) <= alignof(std::max_align_t) &&
+           std::is_nothrow_move_constructible_v<T>;
+  }
+
+  void take(worker_task &other) noexcept {
+    if (other._manage)
+      other._manage(operation::relocate, &other._storage, &_storage);
+    _invoke = other._invoke;
+    _manage = other._manage;
+    other._invoke = nullptr;
+    other._manage = nullptr;
+  }
+
+  using invoke_function = void (*)(void *);
+  using manage_function = void (*)(operation, void *, void *) noexcept;
+
+  alignas(std::max_align_t) unsigned char _storage[inline_storage_size];
+  invoke_function _invoke = nullptr;
+  manage_function _manage = nullptr;
+};
+
+/// Bounded lock-free multi-producer/single-consumer ring of worker tasks.
+/// Each slot carries a sequence number that producers and the consumer use
+/// to hand over ownership of the slot (D. Vyukov's bounded queue design,
+/// restricted to a single consumer).
+class mpsc_task_ring {
+public:
+  static constexpr std::size_t capacity = 256;
+
+  mpsc_task_ring() {
+    for (std::size_t i = 0; i < capacity; ++i)
+      _slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  mpsc_task_ring(const mpsc_task_ring &) = delete;
+  mpsc_task_ring &operator=(const mpsc_task_ring &) = delete;
+
+  /// Can be called concurrently from any number of threads.
+  /// \return false if the ring is full, in which case \c t is untouched.
+  bool try_push(worker_task &t) noexcept {
+    std::size_t pos = _tail.load(std::memory_order_relaxed);
+    slot *s = nullptr;
+    for (;;) {
+      s = &_slots[pos % capacity];
+      std::size_t seq = s->sequence.load(std::memory_order_acquire);
+      auto diff =
+          static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (_tail.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_seq_cst,
+                                        std::memory_order_relaxed))
+          break;
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = _tail.load(std::memory_order_relaxed);
+      }
+    }
+    s->task = std::move(t);
+    s->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Must only be called from the consumer thread.
+  /// \return false if the slot at the head of the ring has not been
+  /// published yet.
+  bool try_pop(worker_task &out) noexcept {
+    slot &s = _slots[_head % capacity];
+    std::size_t seq = s.sequence.load(std::memory_order_acquire);
+    if (seq != _head + 1)
+      return false;
+    out = std::move(s.task);
+    s.sequence.store(_head + capacity, std::memory_order_release);
+    ++_head;
+    return true;
+  }
+
+  /// Must only be called from the consumer thread.
+  /// \return whether no producer has claimed a slot that was not popped yet.
+  bool is_drained() const noexcept {
+    return _tail.load(std::memory_order_seq_cst) == _head;
+  }
+
+private:
+  struct alignas(64) slot {
+    std::atomic<std::size_t> sequence;
+    worker_task task;
+  };
+
+  slot _slots[capacity];
+  alignas(64) std::atomic<std::size_t> _tail{0};
+  alignas(64) std::size_t _head = 0;
+};
+
+}
+
 /// A worker thread that processes a queue in the background.
 class worker_thread
 {
@@ -40,9 +216,15 @@ public:
   void wait();
 
   /// Enqueues a user-specified function for asynchronous
-  /// execution in the worker thread.
+  /// execution in the worker thread. Callables up to
+  /// \c detail::worker_task::inline_storage_size bytes are stored
+  /// without additional heap allocation.
   /// \param f The function to enqueue for execution
-  void operator()(async_function f);
+  template<class F>
+  void operator()(F&& f) {
+    detail::worker_task t{std::forward<F>(f)};
+    enqueue(t);
+  }
 
   /// \return The number of enqueued operations
   std::size_t queue_size() const;
@@ -52,18 +234,37 @@ public:
 private:
 
   /// Starts the worker thread, which will execute the supplied
-  /// tasks. If no tasks are available, waits until a new task is
-  /// supplied.
+  /// tasks. If no tasks are available, spins briefly and then
+  /// parks until a new task is supplied.
   void work();
 
+  void enqueue(detail::worker_task& t);
+  bool try_dequeue(detail::worker_task& out);
+  void notify_task_completed();
+
   std::thread _worker_thread;
 
   std::atomic<bool> _continue;
 
-  std::condition_variable _condition_wait;
+  // Number of tasks that have been enqueued but have not completed yet,
+  // including the task that is currently executing.
+  std::atomic<std::size_t> _num_pending_tasks;
+  std::atomic<bool> _is_worker_parked;
+  std::atomic<int> _num_waiting_threads;
+
+  std::condition_variable _work_available;
+  std::condition_variable _queue_drained;
   mutable std::mutex _mutex;
 
-  std::queue<async_function> _enqueued_operations;
+  detail::mpsc_task_ring _ring;
+
+  // If the ring is full, tasks spill over into this queue. As long as
+  // it is non-empty, all new tasks are appended here to preserve the
+  // submission order of each thread.
+  std::atomic<bool> _is_overflow_active;
+  std::mutex _overflow_mutex;
+  std::deque<detail::worker_task> _overflow_operations;
+  std::deque<detail::worker_task> _drained_overflow_operations;
 };
 
 }
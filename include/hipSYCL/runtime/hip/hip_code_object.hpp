@@ -13,6 +13,7 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 
 #include "hipSYCL/runtime/kernel_configuration.hpp"
 #include "hipSYCL/runtime/error.hpp"
@@ -68,7 +69,7 @@ private:
 class hip_sscp_executable_object : public hip_executable_object {
 public:
   virtual ~hip_sscp_executable_object();
-  hip_sscp_executable_object(const std::string &hip_fat_binary,
+  hip_sscp_executable_object(std::string_view hip_fat_binary,
                              const std::string &target_arch,
                              hcf_object_id source,
                              const std::vector<std::string> &kernel_name,
@@ -92,7 +93,7 @@ public:
   virtual ihipModule_t* get_module() const override;
   virtual int get_device() const override;
 private:
-  result build(const std::string& hip_fat_binary);
+  result build(std::string_view hip_fat_binary);
 
   std::string _target;
   hcf_object_id _origin;
@@ -12,31 +12,80 @@
 #define HIPSYCL_MEMCPY_HPP
 
 #include <vector>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include "../generic/async_worker.hpp"
 #include "../operations.hpp"
 #include "../util.hpp"
+#include "hipSYCL/common/small_map.hpp"
 
 namespace hipsycl {
 namespace rt {
 
 class backend_manager;
 
+/// Estimates the cost of data transfers between devices.
+///
+/// Transfers are modeled as latency + bytes / bandwidth. The parameters for
+/// each (source, destination) device pair are measured once by a small
+/// micro-benchmark in the background when the pair is first queried, and are
+/// then persisted in the application database so that subsequent runs can
+/// reuse them. Until the measurement has completed, default estimates are
+/// used. Costs are expressed in nanoseconds.
 class memcpy_model
 {
 public:
-  memcpy_model(backend_manager* mgr){}
+  memcpy_model(backend_manager* mgr);
 
   cost_type estimate_runtime_cost(const memory_location &source,
                                   const memory_location &dest,
                                   range<3> num_elements) const;
 
+  /// \return The estimated time in ns to copy \c num_bytes from
+  /// \c source to \c dest
+  cost_type estimate_transfer_time(device_id source, device_id dest,
+                                   std::size_t num_bytes) const;
+
   memory_location
   choose_source(const std::vector<memory_location> &candidate_sources,
                 const memory_location &target, range<3> num_elements) const;
 
+  struct transfer_parameters {
+    // in ns
+    double latency;
+    // in bytes/ns
+    double bandwidth;
+  };
+
+  transfer_parameters get_transfer_parameters(device_id source,
+                                              device_id dest) const;
+
+  /// Waits until all calibrations that have been started have completed.
+  void wait_for_calibration() const;
+
+private:
+  transfer_parameters get_default_parameters(device_id source,
+                                             device_id dest) const;
+  bool calibrate(device_id source, device_id dest,
+                 transfer_parameters &out) const;
+  std::string get_device_key(device_id dev) const;
+
+  backend_manager* _backends;
+
+  using device_pair = std::pair<device_id, device_id>;
+
+  mutable std::mutex _mutex;
+  // Few device pairs are ever queried, so a linear search is fastest.
+  mutable common::small_map<device_pair, transfer_parameters> _parameters;
+  // Declared last, so that running calibrations complete before
+  // the other members are destroyed.
+  mutable std::unique_ptr<worker_thread> _calibration_worker;
 };
 
 
 }
 }
 
-#endif
\ No newline at end of file
+#endif
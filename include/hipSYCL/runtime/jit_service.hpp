@@ -0,0 +1,103 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_JIT_SERVICE_HPP
+#define HIPSYCL_JIT_SERVICE_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "hipSYCL/common/unordered_dense.hpp"
+#include "hipSYCL/runtime/generic/async_worker.hpp"
+#include "hipSYCL/runtime/kernel_configuration.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+/// Carries out JIT compilations, either on the requesting thread or in the
+/// background on a pool of compiler threads. Distinct binaries are compiled
+/// concurrently, while requests for a binary that is already being compiled
+/// are deduplicated and share the result of the compilation in flight.
+///
+/// Results are kept until they are forgotten explicitly, so that every
+/// thread that requests a binary can collect it. Failed compilations are
+/// never forgotten, so that they are not retried.
+///
+/// This class is thread-safe.
+class jit_service {
+public:
+  using binary_id = kernel_configuration::id_type;
+  using binary_ptr = std::shared_ptr<const std::string>;
+  /// Compiles a binary into the string argument, returns false on error.
+  using compilation_task = std::function<bool(std::string &)>;
+
+  enum class status {
+    not_requested,
+    in_flight,
+    failed,
+    ready
+  };
+
+  jit_service();
+  ~jit_service();
+
+  jit_service(const jit_service&) = delete;
+  jit_service& operator=(const jit_service&) = delete;
+
+  /// Compiles the binary on the calling thread. If the binary is already
+  /// being compiled, waits for that compilation instead.
+  /// \return The binary, or nullptr if compilation failed.
+  binary_ptr compile(binary_id id, const compilation_task &task);
+
+  /// Enqueues compilation of the binary on the compiler threads, unless
+  /// it has already been requested. \c task must not reference data
+  /// that might no longer be alive once it executes.
+  void compile_async(binary_id id, compilation_task task);
+
+  /// Queries the state of an asynchronous compilation. If the binary is
+  /// ready, it is returned in \c out.
+  status try_get(binary_id id, binary_ptr& out);
+
+  /// Releases a binary that has been compiled successfully, e.g. once it
+  /// can be obtained from the persistent cache. Later requests compile the
+  /// binary again.
+  void forget(binary_id id);
+
+  /// Waits until all asynchronous compilations have finished.
+  void wait();
+private:
+  struct request {
+    status state = status::in_flight;
+    binary_ptr binary;
+  };
+
+  void finish(const std::shared_ptr<request>& r, bool success,
+              std::string&& binary);
+
+  std::mutex _mutex;
+  std::condition_variable _request_finished;
+  ankerl::unordered_dense::map<binary_id, std::shared_ptr<request>,
+                               kernel_id_hash>
+      _requests;
+
+  // Created upon the first asynchronous request
+  std::vector<std::unique_ptr<worker_thread>> _compiler_threads;
+  std::size_t _next_compiler_thread = 0;
+};
+
+}
+}
+
+#endif
@@ -8,6 +8,7 @@
  * See file LICENSE in the project root for full license details.
  */
 // SPDX-License-Identifier: BSD-2-Clause
+#include <atomic>
 #include <cstdint>
 #include <string>
 #include <unordered_map>
@@ -16,13 +17,16 @@
 #include <memory>
 #include <optional>
 #include <array>
+#include <string_view>
 #include "hipSYCL/common/hcf_container.hpp"
+#include "hipSYCL/common/packed_binary_cache.hpp"
 #include "hipSYCL/common/small_map.hpp"
 #include "hipSYCL/common/unordered_dense.hpp"
 #include "hipSYCL/common/stable_running_hash.hpp"
 #include "hipSYCL/runtime/kernel_configuration.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/jit_service.hpp"
 
 #ifndef HIPSYCL_RT_KERNEL_CACHE_HPP
 #define HIPSYCL_RT_KERNEL_CACHE_HPP
@@ -297,51 +301,98 @@ public:
   /// might be persistently cached on-disk.
   /// \c id_of_code_object: The full id of the backend code object that the user wants to obtain.
   /// This id may depend on values which vary between application runs, such as cl_context.
-  /// \c j Has signature bool(std::string&). Will be invoked when JIT compilation is triggered, and
-  /// is expected to carry out JIT compilation.
-  /// Should return true if the compilation was successful. The binary output of JIT compilation
-  /// should be stored in the string reference.
+  /// \c make_jit_compiler Will be invoked when JIT compilation is triggered, and is expected
+  /// to return a JIT compiler with signature bool(std::string&). The compiler
+  /// should return true if the compilation was successful. The binary output of JIT compilation
+  /// should be stored in the string reference. The compiler must not reference
+  /// the stack frame of the caller, since it might be executed on a different thread.
   /// \c c Is expected to turn the JIT-compiled binary into a code_object*. Has signature
-  /// code_object*(const std::string&). It is expected to return nullptr on error. The JIT-compiled
-  /// binary will be passed in as string reference.
-  template <class CodeObjectConstructor, class JitCompiler>
-  const code_object *get_or_construct_jit_code_object(code_object_id id_of_code_object,
-                                                      code_object_id id_of_binary,
-                                                      JitCompiler &&jit_compile,
-                                                      CodeObjectConstructor &&c) {
+  /// code_object*(std::string_view). It is expected to return nullptr on error. The JIT-compiled
+  /// binary will be passed in as a view, which might point directly into the memory-mapped
+  /// persistent cache. The view is only valid during the call, and is followed by a null byte.
+  ///
+  /// Binaries with different ids are compiled concurrently if requested
+  /// from multiple threads.
+  template <class CodeObjectConstructor, class JitCompilerFactory>
+  const code_object *
+  get_or_construct_jit_code_object(code_object_id id_of_code_object,
+                                   code_object_id id_of_binary,
+                                   JitCompilerFactory &&make_jit_compiler,
+                                   CodeObjectConstructor &&c) {
     if(auto* code_object = get_code_object(id_of_code_object)) {
       HIPSYCL_DEBUG_INFO << "kernel_cache: Cache hit for id "
                          << kernel_configuration::to_string(id_of_code_object) << "\n";
       return code_object;
     }
+    if(has_construction_failed(id_of_code_object))
+      return nullptr;
     HIPSYCL_DEBUG_INFO << "kernel_cache: Cache MISS for id "
                       << kernel_configuration::to_string(id_of_code_object) << "\n";
     
-    std::string compiled_binary;
-    // TODO: We might want to allow JIT compilation in parallel at some point
-    std::lock_guard<std::mutex> lock{_mutex};
-
-    if(!persistent_cache_lookup(id_of_binary, compiled_binary)){
-      if(!jit_compile(compiled_binary))
+    jit_service::binary_ptr compiled_binary;
+    common::packed_binary_cache::binary cached_binary;
+    std::string_view binary;
+
+    if(persistent_cache_lookup(id_of_binary, cached_binary)) {
+      binary = cached_binary.data;
+    } else {
+      compiled_binary = _jit_service.compile(
+          id_of_binary, make_jit_task(id_of_binary, make_jit_compiler()));
+      if(!compiled_binary)
         return nullptr;
+      binary = *compiled_binary;
+    }
+    
+    const code_object *new_object =
+        construct_jit_code_object(id_of_code_object, binary, c);
+    if(compiled_binary)
+      release_compiled_binary(id_of_binary);
+    return new_object;
+  }
 
-      if(_is_first_jit_compilation) {
-        _is_first_jit_compilation = false;
-        HIPSYCL_DEBUG_WARNING
-            << "kernel_cache: This application run has resulted in new "
-               "binaries being JIT-compiled. This indicates that the runtime "
-               "optimization process has not yet reached peak performance. You "
-               "may want to run the application again until this warning no "
-               "longer appears to achieve optimal performance."
-            << std::endl;
+  /// Like \c get_or_construct_jit_code_object(), except that the binary is
+  /// JIT-compiled in the background if it is not available yet. In this case,
+  /// nullptr is returned, and the caller is expected to fall back to a different
+  /// code object. Once compilation has finished, subsequent calls
+  /// return the new code object.
+  template <class CodeObjectConstructor, class JitCompilerFactory>
+  const code_object *
+  get_or_construct_jit_code_object_async(code_object_id id_of_code_object,
+                                         code_object_id id_of_binary,
+                                         JitCompilerFactory &&make_jit_compiler,
+                                         CodeObjectConstructor &&c) {
+    if(auto* code_object = get_code_object(id_of_code_object))
+      return code_object;
+    if(has_construction_failed(id_of_code_object))
+      return nullptr;
+
+    jit_service::binary_ptr compiled_binary;
+    common::packed_binary_cache::binary cached_binary;
+    std::string_view binary;
+
+    switch(_jit_service.try_get(id_of_binary, compiled_binary)) {
+    case jit_service::status::ready:
+      HIPSYCL_DEBUG_INFO << "kernel_cache: Background compilation of "
+                         << kernel_configuration::to_string(id_of_binary)
+                         << " has finished" << std::endl;
+      binary = *compiled_binary;
+      break;
+    case jit_service::status::not_requested:
+      if(!persistent_cache_lookup(id_of_binary, cached_binary)) {
+        _jit_service.compile_async(
+            id_of_binary, make_jit_task(id_of_binary, make_jit_compiler()));
+        return nullptr;
       }
-      persistent_cache_store(id_of_binary, compiled_binary);
+      binary = cached_binary.data;
+      break;
+    default:
+      return nullptr;
     }
-    
-    const code_object* new_object = c(compiled_binary);
-    if(new_object)
-      _code_objects[id_of_code_object] = code_object_ptr{new_object};
-    
+
+    const code_object *new_object =
+        construct_jit_code_object(id_of_code_object, binary, c);
+    if(compiled_binary)
+      release_compiled_binary(id_of_binary);
     return new_object;
   }
 
@@ -349,10 +400,53 @@ public:
   void unload();
 
   // Stitches together the persisten cache path with the id of the binary to a unique path.
+  // Binaries themselves are stored in a single file, but this path can be used
+  // for files derived from them.
   static std::string get_persistent_cache_file(code_object_id id_of_binary);
+protected:
+  kernel_cache();
 private:
-  bool persistent_cache_lookup(code_object_id id_of_binary, std::string& out) const;
-  void persistent_cache_store(code_object_id id_of_binary, const std::string& data) const;
+  bool persistent_cache_lookup(code_object_id id_of_binary,
+                               common::packed_binary_cache::binary &out);
+  void persistent_cache_store(code_object_id id_of_binary, std::string_view data);
+
+  // Called from the thread that has carried out the JIT compilation
+  void on_jit_compilation_finished(code_object_id id_of_binary,
+                                   const std::string &binary);
+  // Lets the JIT service drop a binary once other threads can obtain it
+  // from the persistent cache.
+  void release_compiled_binary(code_object_id id_of_binary);
+
+  bool has_construction_failed(code_object_id id) const;
+
+  template <class JitCompiler>
+  jit_service::compilation_task make_jit_task(code_object_id id_of_binary,
+                                              JitCompiler &&compiler) {
+    return [this, id_of_binary, compiler = std::forward<JitCompiler>(compiler)](
+               std::string &out) mutable {
+      if(!compiler(out))
+        return false;
+      on_jit_compilation_finished(id_of_binary, out);
+      return true;
+    };
+  }
+
+  template <class Constructor>
+  const code_object *construct_jit_code_object(code_object_id id,
+                                               std::string_view binary,
+                                               Constructor &&c) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    // Another thread might have been faster
+    if(auto* existing_code_object = get_code_object_impl(id))
+      return existing_code_object;
+
+    const code_object* new_object = c(binary);
+    if(new_object)
+      _code_objects[id] = code_object_ptr{new_object};
+    else
+      _failed_code_objects.insert(id);
+    return new_object;
+  }
   
   const code_object* get_code_object_impl(code_object_id id) const;
 
@@ -379,8 +473,18 @@ private:
 
   ankerl::unordered_dense::map<code_object_id, code_object_ptr, rt::kernel_id_hash>
       _code_objects;
+  // JIT code objects whose construction has failed, so that they are
+  // not constructed again on every launch
+  ankerl::unordered_dense::set<code_object_id, rt::kernel_id_hash>
+      _failed_code_objects;
+
+  common::packed_binary_cache _persistent_cache;
+  // The current application run as tracked by the appdb
+  uint64_t _application_run;
   
-  bool _is_first_jit_compilation = true;
+  std::atomic<bool> _is_first_jit_compilation = true;
+
+  jit_service _jit_service;
 };
 
 namespace detail {
@@ -55,7 +55,9 @@ enum class kernel_build_option : int {
   amdgpu_rocm_device_libs_path,
   amdgpu_rocm_path,
 
-  spirv_dynamic_local_mem_allocation_size
+  spirv_dynamic_local_mem_allocation_size,
+
+  host_group_coarsening_factor
 };
 
 enum class kernel_build_flag : int {
@@ -66,7 +68,10 @@ enum class kernel_build_flag : int {
   ptx_approx_div,
   ptx_approx_sqrt,
 
-  spirv_enable_intel_llvm_spirv_options
+  spirv_enable_intel_llvm_spirv_options,
+
+  host_fiber_barriers,
+  host_vectorized_subgroups
 };
 
 enum class kernel_param_flag : int {
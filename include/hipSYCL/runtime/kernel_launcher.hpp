@@ -24,6 +24,7 @@
 #include "hipSYCL/runtime/util.hpp"
 #include "hipSYCL/runtime/kernel_configuration.hpp"
 #include "hipSYCL/runtime/kernel_type.hpp"
+#include "hipSYCL/runtime/slab_allocator.hpp"
 #include "hipSYCL/glue/kernel_launcher_data.hpp"
 
 #include "backend.hpp"
@@ -61,7 +62,7 @@ private:
   sscp_code_object_invoker* _sscp_invoker = nullptr;
 };
 
-class backend_kernel_launcher
+class backend_kernel_launcher : public slab_allocated
 {
 public:
   virtual ~backend_kernel_launcher(){}
@@ -124,6 +125,10 @@ public:
   const kernel_configuration& get_kernel_configuration() const {
     return _kernel_config;
   }
+
+  const glue::kernel_launcher_data& get_launch_data() const {
+    return _static_data;
+  }
 private:
   
   common::auto_small_vector<std::unique_ptr<backend_kernel_launcher>>
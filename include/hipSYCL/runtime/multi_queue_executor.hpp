@@ -142,6 +142,9 @@ public:
   virtual bool is_submitted_by_me(const dag_node_ptr& node) const override;
 
   bool find_assigned_lane_index(const dag_node_ptr& node, std::size_t& index_out) const;
+  // Returns the executor of the lane that the node has been submitted to,
+  // or nullptr if the node was not submitted by this executor.
+  inorder_executor* get_assigned_lane_executor(const dag_node_ptr& node) const;
 private:
   
 
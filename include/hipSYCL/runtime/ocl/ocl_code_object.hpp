@@ -12,6 +12,7 @@
 #define HIPSYCL_OCL_CODE_OBJECT_HPP
 
 #include <string>
+#include <string_view>
 
 #include <CL/opencl.hpp>
 
@@ -49,7 +50,7 @@ private:
 class ocl_executable_object : public code_object {
 public:
   ocl_executable_object(const cl::Context &ctx, cl::Device &dev,
-                        hcf_object_id source, const std::string &code_image,
+                        hcf_object_id source, std::string_view code_image,
                         const kernel_configuration &config);
   virtual ~ocl_executable_object();
 
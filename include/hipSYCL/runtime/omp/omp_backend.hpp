@@ -15,6 +15,11 @@
 #include "../multi_queue_executor.hpp"
 #include "omp_allocator.hpp"
 #include "omp_hardware_manager.hpp"
+#include "omp_thread_pool.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 namespace hipsycl {
 namespace rt {
@@ -39,9 +44,23 @@ public:
 
   std::unique_ptr<backend_executor>
   create_inorder_executor(device_id dev, int priority) override;
+
+  /// \return The persistent kernel thread pool, which is constructed
+  /// on first use. nullptr if work stealing is disabled in the settings.
+  omp_thread_pool* get_thread_pool();
+
+  /// Assigns execution lanes to newly created queues in
+  /// round-robin fashion.
+  std::size_t assign_execution_lane();
 private:
   mutable omp_allocator _allocator;
   mutable omp_hardware_manager _hw;
+
+  // Must outlive the executor, whose queues submit work to the pool
+  std::once_flag _thread_pool_init_flag;
+  std::unique_ptr<omp_thread_pool> _thread_pool;
+  std::atomic<std::size_t> _num_assigned_lanes;
+
   mutable lazily_constructed_executor<multi_queue_executor> _executor;
 };
 
@@ -11,7 +11,9 @@
 #ifndef HIPSYCL_OMP_CODE_OBJECT_HPP
 #define HIPSYCL_OMP_CODE_OBJECT_HPP
 
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "hipSYCL/runtime/kernel_configuration.hpp"
@@ -22,6 +24,10 @@
 
 
 namespace hipsycl {
+namespace compiler {
+class LoadedHostObject;
+}
+
 namespace rt {
 
 class omp_sscp_executable_object : public code_object {
@@ -33,18 +39,37 @@ public:
                     void *internal_local_memory)
         : _num_groups(num_groups), _group_id(group_id), _local_size(local_size),
           _local_memory(local_memory),
-          _internal_local_memory(internal_local_memory) {}
+          _internal_local_memory(internal_local_memory),
+          _local_id{0, 0, 0}, _barrier{nullptr}, _barrier_context{nullptr} {}
 
     rt::range<3> _num_groups;
     rt::range<3> _group_id;
     rt::range<3> _local_size;
     void* _local_memory;
     void* _internal_local_memory;
+
+    // Only used by kernels with fiber barriers, which execute the
+    // work item _local_id, and invoke _barrier(_barrier_context)
+    // at work-group barriers.
+    rt::range<3> _local_id;
+    void (*_barrier)(void *);
+    void* _barrier_context;
   };
 
   using omp_sscp_kernel = void(const work_group_info *, void **);
 
-  omp_sscp_executable_object(const std::string &shared_lib_path,
+  // What a kernel needs to be set up at launch. The corresponding flags
+  // are emitted by the host kernel wrapper pass.
+  struct kernel_properties {
+    bool uses_local_memory = true;
+    bool uses_internal_local_memory = true;
+    bool uses_barriers = true;
+    // The kernel executes a single work item and needs to be launched
+    // as one fiber per work item.
+    bool uses_fiber_barriers = false;
+  };
+
+  omp_sscp_executable_object(std::string_view binary,
                              hcf_object_id hcf_source,
                              const std::vector<std::string> &kernel_names,
                              const kernel_configuration &config);
@@ -66,19 +91,21 @@ public:
 
   virtual void *get_module() const;
   virtual omp_sscp_kernel *get_kernel(std::string_view backend_kernel_name) const;
+  kernel_properties
+  get_kernel_properties(std::string_view backend_kernel_name) const;
 
 private:
-  result build(const std::string &source, const std::vector<std::string> &kernel_names);
+  result build(std::string_view source, const std::vector<std::string> &kernel_names);
 
   hcf_object_id _hcf;
   kernel_configuration::id_type _id;
-  std::string _kernel_cache_path;
 
   result _build_result;
-  void *_module;
+  std::unique_ptr<compiler::LoadedHostObject> _module;
 
   std::vector<std::string> _kernel_names;
   std::unordered_map<std::string_view, omp_sscp_kernel*> _kernels;
+  std::unordered_map<std::string_view, kernel_properties> _kernel_properties;
 };
 
 } // namespace rt
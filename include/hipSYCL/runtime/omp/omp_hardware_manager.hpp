@@ -13,12 +13,26 @@
 
 #include "../hardware.hpp"
 
+#include <vector>
+
 namespace hipsycl {
 namespace rt {
 
+/// A subset of the CPU cores available to the process. Kernels
+/// submitted to different execution lanes can run concurrently.
+struct omp_execution_lane {
+  /// Logical processor ids of the OS that belong to this lane
+  std::vector<int> cores;
+  /// The NUMA node that the cores belong to, or -1 if unknown
+  /// or if the lane spans multiple NUMA nodes.
+  int numa_node = -1;
+};
+
 class omp_hardware_context : public hardware_context
 {
 public:
+  omp_hardware_context();
+
   virtual bool is_cpu() const override;
   virtual bool is_gpu() const override;
 
@@ -42,7 +56,13 @@ public:
 
   virtual std::size_t get_platform_index() const override;
 
+  /// \return The disjoint core subsets that kernels are executed on.
+  /// Kernel concurrency of the device equals the number of lanes.
+  const std::vector<omp_execution_lane>& get_execution_lanes() const;
+
   virtual ~omp_hardware_context() {}
+private:
+  std::vector<omp_execution_lane> _execution_lanes;
 };
 
 class omp_hardware_manager : public backend_hardware_manager
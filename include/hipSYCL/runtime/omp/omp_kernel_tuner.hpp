@@ -0,0 +1,93 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_OMP_KERNEL_TUNER_HPP
+#define HIPSYCL_OMP_KERNEL_TUNER_HPP
+
+#include <cstddef>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+#include "hipSYCL/common/appdb.hpp"
+#include "hipSYCL/runtime/kernel_configuration.hpp"
+#include "hipSYCL/runtime/util.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+/// Auto-tunes the launch parameters of SSCP kernels on the OpenMP backend,
+/// i.e. the work-group size (if not chosen by the user) and the number of
+/// consecutive work-groups that a single invocation of the coarsened kernel
+/// executes. Every candidate is launched a couple of times, and the fastest
+/// one is selected for all subsequent launches. Measurements are stored in
+/// the appdb, so tuning carries over to subsequent application runs.
+///
+/// Tuning is carried out per kernel and problem size, where problem sizes
+/// are bucketed by the power of two of their group count. It first searches the
+/// group size for coarsening factor 1, and then the coarsening factor for the
+/// fastest group size. For kernels with work-group barriers, it finally
+/// compares the continuation-based (CBS) barrier lowering against executing
+/// work items as fibers.
+class omp_kernel_tuner {
+public:
+  struct selection {
+    kernel_configuration::id_type key = {};
+    std::size_t candidate = 0;
+    range<3> group_size;
+    std::size_t coarsening_factor = 1;
+    // Whether the kernel should be compiled with fiber barriers
+    bool fiber_barriers = false;
+    // Whether the runtime of the launch should be recorded
+    bool is_tuning = false;
+  };
+
+  static omp_kernel_tuner &get();
+
+  /// Selects the launch parameters of the next launch of a kernel.
+  /// \param group_size The group size requested by the user, or an empty
+  /// range if the tuner may choose the group size.
+  /// \param default_group_size The group size that the backend would
+  /// select without tuning.
+  /// \param concurrency The number of threads that execute the kernel.
+  selection select(std::string_view kernel_name, const range<3> &global_range,
+                   const range<3> &group_size,
+                   const range<3> &default_group_size,
+                   std::size_t concurrency);
+
+  /// Records the runtime of a launch with parameters obtained from select().
+  /// \param uses_barriers Whether the launched kernel contains work-group
+  /// barriers, such that both barrier lowerings are worth comparing.
+  void record(const selection &s, double time_ns, bool uses_barriers);
+
+private:
+  omp_kernel_tuner();
+
+  static constexpr std::size_t samples_per_candidate = 4;
+
+  void add_coarsening_candidates(common::db::kernel_tuning_entry &entry,
+                                 const range<3> &global_range,
+                                 std::size_t concurrency) const;
+  void finish_tuning(common::db::kernel_tuning_entry &entry) const;
+
+  common::db::kernel_tuning_entry &
+  get_entry(const kernel_configuration::id_type &key);
+
+  std::mutex _mutex;
+  common::db::appdb &_appdb;
+  std::unordered_map<kernel_configuration::id_type,
+                     common::db::kernel_tuning_entry, kernel_id_hash>
+      _entries;
+};
+
+}
+}
+
+#endif
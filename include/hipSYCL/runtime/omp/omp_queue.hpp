@@ -15,6 +15,7 @@
 #include "../executor.hpp"
 #include "../inorder_queue.hpp"
 #include "../device_id.hpp"
+#include "omp_kernel_tuner.hpp"
 #include "hipSYCL/common/spin_lock.hpp"
 #include "hipSYCL/glue/llvm-sscp/jit.hpp"
 #include "hipSYCL/glue/llvm-sscp/jit-reflection/reflection_map.hpp"
@@ -42,9 +43,17 @@ public:
                                const rt::hcf_kernel_info* kernel_info,
                                const kernel_configuration& config) override;
   
-  virtual rt::range<3> select_group_size(const rt::range<3> &num_groups,
+  virtual rt::range<3> select_group_size(const rt::range<3> &global_range,
                                          const rt::range<3> &group_size) const override;
 
+  virtual result submit_kernel_for_global_range(
+      const kernel_operation &op, hcf_object_id hcf_object,
+      const rt::range<3> &global_range, const rt::range<3> &group_size,
+      unsigned local_mem_size, void **args, std::size_t *arg_sizes,
+      std::size_t num_args, std::string_view kernel_name,
+      const rt::hcf_kernel_info *kernel_info,
+      const kernel_configuration &config) override;
+
 private:
   omp_queue* _queue;
 };
@@ -82,11 +91,20 @@ public:
       const rt::hcf_kernel_info *kernel_info, const rt::range<3> &num_groups,
       const rt::range<3> &group_size, unsigned local_mem_size, void **args,
       std::size_t *arg_sizes, std::size_t num_args,
-      const kernel_configuration &config);
+      const kernel_configuration &config,
+      const omp_kernel_tuner::selection *tuning = nullptr);
 
   worker_thread& get_worker();
+
+  /// \return The number of threads that kernels submitted to this
+  /// queue execute on.
+  std::size_t get_kernel_concurrency() const;
 private:
   const backend_id _backend_id;
+  omp_backend* _backend;
+  // The execution lane of the backend thread pool that kernels
+  // submitted to this queue run on
+  const std::size_t _execution_lane;
   worker_thread _worker;
 
   omp_sscp_code_object_invoker _sscp_code_object_invoker;
@@ -0,0 +1,115 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_OMP_THREAD_POOL_HPP
+#define HIPSYCL_OMP_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "hipSYCL/common/spin_lock.hpp"
+#include "omp_hardware_manager.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+/// A persistent pool of CPU threads, partitioned into the execution lanes
+/// of the OpenMP backend. Each lane runs one parallel loop at a time
+/// on its own core subset, so loops submitted to different lanes
+/// execute concurrently.
+///
+/// Within a lane, the iteration space is initially split evenly between
+/// participating threads. Each thread claims geometrically shrinking chunks
+/// from its own range, and steals half of the remaining range of another
+/// thread once its own range is exhausted.
+class omp_thread_pool {
+public:
+  omp_thread_pool(const std::vector<omp_execution_lane>& lanes);
+  ~omp_thread_pool();
+
+  omp_thread_pool(const omp_thread_pool&) = delete;
+  omp_thread_pool& operator=(const omp_thread_pool&) = delete;
+
+  std::size_t get_num_lanes() const;
+
+  /// \return The number of threads that execute loops submitted to the
+  /// given lane, including the submitting thread.
+  std::size_t get_lane_concurrency(std::size_t lane) const;
+
+  /// Executes f(begin, end) for disjoint chunks covering [0, num_items)
+  /// on the threads of the given lane, and returns once all chunks
+  /// have completed. The calling thread participates in the execution.
+  /// Concurrent calls for the same lane are serialized.
+  template <class F>
+  void parallel_for(std::size_t lane, std::size_t num_items, F &&f) {
+    chunk_function chunk_f{
+        static_cast<void *>(&f), [](void *ctx, std::size_t begin,
+                                    std::size_t end) {
+          (*static_cast<std::remove_reference_t<F> *>(ctx))(begin, end);
+        }};
+    run(lane, num_items, chunk_f);
+  }
+
+private:
+  struct chunk_function {
+    void* context;
+    void (*invoke)(void*, std::size_t, std::size_t);
+  };
+
+  struct alignas(64) work_range {
+    common::spin_lock lock;
+    std::size_t begin = 0;
+    std::size_t end = 0;
+  };
+
+  struct lane_state {
+    std::vector<int> cores;
+    std::vector<std::thread> threads;
+    // One range per participant; index 0 belongs to the submitting thread.
+    std::unique_ptr<work_range[]> ranges;
+    std::size_t num_participants = 0;
+
+    std::mutex submission_mutex;
+    chunk_function current_function;
+
+    std::atomic<std::uint64_t> job_generation{0};
+    std::atomic<bool> is_job_open{false};
+    // Number of pool threads currently working on the job
+    std::atomic<int> num_busy_threads{0};
+    std::atomic<int> num_parked_threads{0};
+    std::atomic<bool> shutdown{false};
+
+    std::mutex park_mutex;
+    std::condition_variable job_available;
+    std::condition_variable job_finished;
+  };
+
+  void run(std::size_t lane, std::size_t num_items, chunk_function f);
+  void thread_main(lane_state* lane, std::size_t participant_index);
+  void participate(lane_state* lane, std::size_t participant_index);
+
+  bool claim_chunk(lane_state *lane, std::size_t participant_index,
+                   std::size_t &begin, std::size_t &end);
+  bool steal(lane_state* lane, std::size_t participant_index);
+
+  std::vector<std::unique_ptr<lane_state>> _lanes;
+};
+
+}
+}
+
+#endif
@@ -23,6 +23,7 @@
 #include "instrumentation.hpp"
 #include "device_id.hpp"
 #include "kernel_launcher.hpp"
+#include "slab_allocator.hpp"
 #include "util.hpp"
 #include "error.hpp"
 #include "hw_model/cost.hpp"
@@ -62,7 +63,9 @@ public:
   virtual ~operation_dispatcher(){}
 };
 
-class operation
+// Operations are created for every submission, so they
+// come from the slab allocator.
+class operation : public slab_allocated
 {
 public:
   operation() = default;
@@ -104,11 +104,17 @@ enum class setting {
   ocl_no_shared_context,
   ocl_show_all_devices,
   no_jit_cache_population,
+  jit_cache_max_size,
+  async_jit,
+  jit_compiler_threads,
   adaptivity_level,
   jitopt_iads_relative_threshold,
   jitopt_iads_relative_eviction_threshold,
   jitopt_iads_relative_threshold_min_data,
-  enable_allocation_tracking
+  enable_allocation_tracking,
+  omp_execution_lanes,
+  omp_work_stealing,
+  memcpy_calibration
 };
 
 template <setting S> struct setting_trait {};
@@ -141,6 +147,9 @@ HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::gc_trigger_batch_size, "rt_gc_trigger_bat
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::ocl_no_shared_context, "rt_ocl_no_shared_context", bool)
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::ocl_show_all_devices, "rt_ocl_show_all_devices", bool)
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::no_jit_cache_population, "rt_no_jit_cache_population", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jit_cache_max_size, "rt_jit_cache_max_size", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::async_jit, "rt_async_jit", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jit_compiler_threads, "rt_jit_compiler_threads", std::size_t)
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::adaptivity_level, "adaptivity_level", int)
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_iads_relative_threshold, "jitopt_iads_relative_threshold", double)
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_iads_relative_eviction_threshold, "jitopt_iads_relative_eviction_threshold", double)
@@ -148,6 +157,9 @@ HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_iads_relative_threshold_min_data,
                               "jitopt_iads_relative_threshold_min_data",
                               std::size_t)
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::enable_allocation_tracking, "allocation_tracking", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::omp_execution_lanes, "rt_omp_execution_lanes", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::omp_work_stealing, "rt_omp_work_stealing", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::memcpy_calibration, "rt_memcpy_calibration", bool)
 
 class settings
 {
@@ -184,6 +196,12 @@ public:
       return _ocl_show_all_devices;
     } else if constexpr(S == setting::no_jit_cache_population) {
       return _no_jit_cache_population;
+    } else if constexpr(S == setting::jit_cache_max_size) {
+      return _jit_cache_max_size;
+    } else if constexpr(S == setting::async_jit) {
+      return _async_jit;
+    } else if constexpr(S == setting::jit_compiler_threads) {
+      return _jit_compiler_threads;
     } else if constexpr(S == setting::adaptivity_level) {
       return _adaptivity_level;
     } else if constexpr(S == setting::jitopt_iads_relative_threshold) {
@@ -194,6 +212,12 @@ public:
       return _jitopt_iads_relative_eviction_threshold;
     } else if constexpr(S == setting::enable_allocation_tracking) {
       return _enable_allocation_tracking;
+    } else if constexpr(S == setting::omp_execution_lanes) {
+      return _omp_execution_lanes;
+    } else if constexpr(S == setting::omp_work_stealing) {
+      return _omp_work_stealing;
+    } else if constexpr(S == setting::memcpy_calibration) {
+      return _memcpy_calibration;
     }
     return typename setting_trait<S>::type{};
   }
@@ -237,6 +261,13 @@ public:
         get_environment_variable_or_default<setting::ocl_show_all_devices>(false);
     _no_jit_cache_population =
         get_environment_variable_or_default<setting::no_jit_cache_population>(false);
+    _jit_cache_max_size =
+        get_environment_variable_or_default<setting::jit_cache_max_size>(
+            std::size_t{1024} * 1024 * 1024);
+    _async_jit =
+        get_environment_variable_or_default<setting::async_jit>(true);
+    _jit_compiler_threads =
+        get_environment_variable_or_default<setting::jit_compiler_threads>(0);
     _adaptivity_level =
         get_environment_variable_or_default<setting::adaptivity_level>(1);
     
@@ -248,6 +279,12 @@ public:
         get_environment_variable_or_default<setting::jitopt_iads_relative_threshold_min_data>(1024);
     _enable_allocation_tracking =
         get_environment_variable_or_default<setting::enable_allocation_tracking>(false);
+    _omp_execution_lanes =
+        get_environment_variable_or_default<setting::omp_execution_lanes>(0);
+    _omp_work_stealing =
+        get_environment_variable_or_default<setting::omp_work_stealing>(true);
+    _memcpy_calibration =
+        get_environment_variable_or_default<setting::memcpy_calibration>(true);
   }
 
 private:
@@ -275,11 +312,17 @@ private:
   bool _ocl_no_shared_context;
   bool _ocl_show_all_devices;
   bool _no_jit_cache_population;
+  std::size_t _jit_cache_max_size;
+  bool _async_jit;
+  std::size_t _jit_compiler_threads;
   int _adaptivity_level;
   double _jitopt_iads_relative_threshold;
   double _jitopt_iads_relative_eviction_threshold;
   std::size_t _jitopt_iads_relative_threshold_min_data;
   bool _enable_allocation_tracking;
+  std::size_t _omp_execution_lanes;
+  bool _omp_work_stealing;
+  bool _memcpy_calibration;
 };
 
 }
@@ -0,0 +1,104 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_SLAB_ALLOCATOR_HPP
+#define HIPSYCL_SLAB_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+
+namespace hipsycl {
+namespace rt {
+
+/// Allocator for the small, short-lived objects that are created for every
+/// submission, such as DAG nodes and operations. Slabs are allocated from
+/// the heap and blocks are cached per thread by \c common::slab_cache,
+/// which also handles nodes that are released by a backend worker thread
+/// instead of the thread that created them.
+///
+/// The allocator is shared by all runtime instances of the process, since
+/// objects may still be freed after the runtime that created them, or
+/// during static destruction.
+class slab_allocator {
+public:
+  /// Requests larger than this are forwarded to \c ::operator new.
+  static constexpr std::size_t max_size = 1024;
+
+  static void *allocate(std::size_t size);
+  /// \c size must be the same as for the corresponding allocate() call.
+  static void deallocate(void *ptr, std::size_t size) noexcept;
+
+  /// Number of slabs that are currently allocated.
+  static std::size_t get_num_slabs() noexcept;
+};
+
+/// Standard allocator interface for slab_allocator, e.g. for
+/// \c std::allocate_shared.
+template <class T> class slab_std_allocator {
+public:
+  using value_type = T;
+
+  slab_std_allocator() noexcept = default;
+  template <class U>
+  slab_std_allocator(const slab_std_allocator<U> &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+      return static_cast<T *>(
+          ::operator new(n * sizeof(T), std::align_val_t{alignof(T)}));
+    else
+      return static_cast<T *>(slab_allocator::allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T *ptr, std::size_t n) noexcept {
+    if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+      ::operator delete(ptr, std::align_val_t{alignof(T)});
+    else
+      slab_allocator::deallocate(ptr, n * sizeof(T));
+  }
+
+  template <class U>
+  bool operator==(const slab_std_allocator<U> &) const noexcept {
+    return true;
+  }
+  template <class U>
+  bool operator!=(const slab_std_allocator<U> &) const noexcept {
+    return false;
+  }
+};
+
+/// Base class that makes \c new and \c delete of a polymorphic class
+/// hierarchy use the slab_allocator. Requires a virtual destructor, such that
+/// sized deallocation receives the size of the most derived type.
+class slab_allocated {
+public:
+  static void *operator new(std::size_t size) {
+    return slab_allocator::allocate(size);
+  }
+
+  static void operator delete(void *ptr, std::size_t size) noexcept {
+    slab_allocator::deallocate(ptr, size);
+  }
+
+  // Over-aligned types are rare here; leave them to the global allocator.
+  static void *operator new(std::size_t size, std::align_val_t alignment) {
+    return ::operator new(size, alignment);
+  }
+
+  static void operator delete(void *ptr, std::size_t,
+                              std::align_val_t alignment) noexcept {
+    ::operator delete(ptr, alignment);
+  }
+};
+
+}
+}
+
+#endif
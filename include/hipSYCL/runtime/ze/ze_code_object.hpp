@@ -12,6 +12,7 @@
 #define HIPSYCL_ZE_CODE_OBJECT_HPP
 
 #include <string>
+#include <string_view>
 
 #include <level_zero/ze_api.h>
 
@@ -54,7 +55,7 @@ enum class ze_source_format {
 class ze_executable_object : public code_object {
 public:
   ze_executable_object(ze_context_handle_t ctx, ze_device_handle_t dev,
-    hcf_object_id source, ze_source_format fmt, const std::string& code_image);
+    hcf_object_id source, ze_source_format fmt, std::string_view code_image);
   virtual ~ze_executable_object();
 
   result get_build_result() const;
@@ -94,7 +95,7 @@ class ze_sscp_executable_object : public ze_executable_object {
 public:
   ze_sscp_executable_object(ze_context_handle_t ctx, ze_device_handle_t dev,
                             hcf_object_id source,
-                            const std::string &spirv_image,
+                            std::string_view spirv_image,
                             const kernel_configuration &config);
   ~ze_sscp_executable_object() {}
 
@@ -92,20 +92,88 @@ HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2
 replace_copy_if(hipsycl::stdpar::par_unseq, ForwardIt1 first, ForwardIt1 last,
                 ForwardIt2 d_first, UnaryPredicate p, const T &new_value);
 
-/*
 template <class ForwardIt, class T>
-HIPSYCL_STDPAR_ENTRYPOINT ForwardIt find(hipsycl::stdpar::par_unseq, ForwardIt first,
-                                         ForwardIt last, const T &value);
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt find(hipsycl::stdpar::par_unseq, ForwardIt first, ForwardIt last,
+               const T &value);
+
+template <class ForwardIt, class UnaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt find_if(hipsycl::stdpar::par_unseq, ForwardIt first, ForwardIt last,
+                  UnaryPredicate p);
 
 template <class ForwardIt, class UnaryPredicate>
-HIPSYCL_STDPAR_ENTRYPOINT ForwardIt find_if(hipsycl::stdpar::par_unseq,
-                                            ForwardIt first, ForwardIt last,
-                                            UnaryPredicate p);
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt find_if_not(hipsycl::stdpar::par_unseq, ForwardIt first,
+                      ForwardIt last, UnaryPredicate p);
+
+template <class ForwardIt>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt adjacent_find(hipsycl::stdpar::par_unseq, ForwardIt first,
+                        ForwardIt last);
+
+template <class ForwardIt, class BinaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt adjacent_find(hipsycl::stdpar::par_unseq, ForwardIt first,
+                        ForwardIt last, BinaryPredicate p);
+
+template <class ForwardIt1, class ForwardIt2>
+HIPSYCL_STDPAR_ENTRYPOINT
+std::pair<ForwardIt1, ForwardIt2> mismatch(hipsycl::stdpar::par_unseq,
+                                           ForwardIt1 first1, ForwardIt1 last1,
+                                           ForwardIt2 first2);
+
+template <class ForwardIt1, class ForwardIt2, class BinaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT
+std::pair<ForwardIt1, ForwardIt2> mismatch(hipsycl::stdpar::par_unseq,
+                                           ForwardIt1 first1, ForwardIt1 last1,
+                                           ForwardIt2 first2,
+                                           BinaryPredicate p);
+
+template <class ForwardIt1, class ForwardIt2>
+HIPSYCL_STDPAR_ENTRYPOINT
+std::pair<ForwardIt1, ForwardIt2> mismatch(hipsycl::stdpar::par_unseq,
+                                           ForwardIt1 first1, ForwardIt1 last1,
+                                           ForwardIt2 first2, ForwardIt2 last2);
+
+template <class ForwardIt1, class ForwardIt2, class BinaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT
+std::pair<ForwardIt1, ForwardIt2> mismatch(hipsycl::stdpar::par_unseq,
+                                           ForwardIt1 first1, ForwardIt1 last1,
+                                           ForwardIt2 first2, ForwardIt2 last2,
+                                           BinaryPredicate p);
+
+template <class ForwardIt, class T>
+HIPSYCL_STDPAR_ENTRYPOINT
+typename std::iterator_traits<ForwardIt>::difference_type
+count(hipsycl::stdpar::par_unseq, ForwardIt first, ForwardIt last,
+      const T &value);
 
 template <class ForwardIt, class UnaryPredicate>
-HIPSYCL_STDPAR_ENTRYPOINT ForwardIt find_if_not(hipsycl::stdpar::par_unseq,
-                                                ForwardIt first, ForwardIt last,
-                                                UnaryPredicate q); */
+HIPSYCL_STDPAR_ENTRYPOINT
+typename std::iterator_traits<ForwardIt>::difference_type
+count_if(hipsycl::stdpar::par_unseq, ForwardIt first, ForwardIt last,
+         UnaryPredicate p);
+
+template <class ForwardIt>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt min_element(hipsycl::stdpar::par_unseq, ForwardIt first,
+                      ForwardIt last);
+
+template <class ForwardIt, class Compare>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt min_element(hipsycl::stdpar::par_unseq, ForwardIt first,
+                      ForwardIt last, Compare comp);
+
+template <class ForwardIt>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt max_element(hipsycl::stdpar::par_unseq, ForwardIt first,
+                      ForwardIt last);
+
+template <class ForwardIt, class Compare>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt max_element(hipsycl::stdpar::par_unseq, ForwardIt first,
+                      ForwardIt last, Compare comp);
 
 
 template<class ForwardIt, class UnaryPredicate>
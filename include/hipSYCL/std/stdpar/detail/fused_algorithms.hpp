@@ -0,0 +1,217 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_PSTL_FUSED_ALGORITHMS_HPP
+#define HIPSYCL_PSTL_FUSED_ALGORITHMS_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "hipSYCL/algorithms/algorithm.hpp"
+#include "hipSYCL/algorithms/numeric.hpp"
+#include "hipSYCL/algorithms/util/allocation_cache.hpp"
+#include "hipSYCL/sycl/queue.hpp"
+#include "offload.hpp"
+
+// Algorithms with the same semantics as the corresponding functions in
+// hipSYCL/algorithms, but which are submitted through the kernel fuser if
+// kernel fusion is enabled. Element-wise algorithms may then be deferred and
+// merged with subsequent ones, and transform_reduce carries out deferred
+// element-wise algorithms in its reduction kernel.
+namespace hipsycl::stdpar::fused {
+
+namespace detail {
+
+inline bool is_fusion_enabled() {
+  return stdpar::detail::stdpar_tls_runtime::get()
+      .get_kernel_fuser()
+      .is_enabled();
+}
+
+}
+
+template <class ForwardIt, class UnaryFunction2>
+void for_each(sycl::queue &q, ForwardIt first, ForwardIt last,
+              UnaryFunction2 f) {
+  if(!detail::is_fusion_enabled()) {
+    algorithms::for_each(q, first, last, f);
+    return;
+  }
+  stdpar::detail::submit_element_wise(
+      q, std::distance(first, last),
+      algorithms::detail::for_each_kernel(first, f));
+}
+
+template <class ForwardIt, class Size, class UnaryFunction2>
+void for_each_n(sycl::queue &q, ForwardIt first, Size n, UnaryFunction2 f) {
+  if(!detail::is_fusion_enabled()) {
+    algorithms::for_each_n(q, first, n, f);
+    return;
+  }
+  if(n <= 0)
+    return;
+  stdpar::detail::submit_element_wise(
+      q, static_cast<std::size_t>(n),
+      algorithms::detail::for_each_kernel(first, f));
+}
+
+template <class ForwardIt1, class ForwardIt2, class UnaryOperation>
+void transform(sycl::queue &q, ForwardIt1 first1, ForwardIt1 last1,
+               ForwardIt2 d_first, UnaryOperation unary_op) {
+  if(!detail::is_fusion_enabled()) {
+    algorithms::transform(q, first1, last1, d_first, unary_op);
+    return;
+  }
+  stdpar::detail::submit_element_wise(
+      q, std::distance(first1, last1),
+      algorithms::detail::transform_kernel(first1, d_first, unary_op));
+}
+
+template <class ForwardIt1, class ForwardIt2, class ForwardIt3,
+          class BinaryOperation>
+void transform(sycl::queue &q, ForwardIt1 first1, ForwardIt1 last1,
+               ForwardIt2 first2, ForwardIt3 d_first,
+               BinaryOperation binary_op) {
+  if(!detail::is_fusion_enabled()) {
+    algorithms::transform(q, first1, last1, first2, d_first, binary_op);
+    return;
+  }
+  stdpar::detail::submit_element_wise(
+      q, std::distance(first1, last1),
+      algorithms::detail::transform_kernel(first1, first2, d_first,
+                                           binary_op));
+}
+
+template <class ForwardIt, class Generator>
+void generate(sycl::queue &q, ForwardIt first, ForwardIt last, Generator g) {
+  if(!detail::is_fusion_enabled()) {
+    algorithms::generate(q, first, last, g);
+    return;
+  }
+  stdpar::detail::submit_element_wise(
+      q, std::distance(first, last),
+      algorithms::detail::generate_kernel(first, g));
+}
+
+template <class ForwardIt, class Size, class Generator>
+void generate_n(sycl::queue &q, ForwardIt first, Size count, Generator g) {
+  if(!detail::is_fusion_enabled()) {
+    algorithms::generate_n(q, first, count, g);
+    return;
+  }
+  if(count <= 0)
+    return;
+  stdpar::detail::submit_element_wise(
+      q, static_cast<std::size_t>(count),
+      algorithms::detail::generate_kernel(first, g));
+}
+
+template <class ForwardIt, class T>
+void replace(sycl::queue &q, ForwardIt first, ForwardIt last,
+             const T &old_value, const T &new_value) {
+  if(!detail::is_fusion_enabled()) {
+    algorithms::replace(q, first, last, old_value, new_value);
+    return;
+  }
+  stdpar::detail::submit_element_wise(
+      q, std::distance(first, last),
+      algorithms::detail::replace_kernel(first, old_value, new_value));
+}
+
+template <class ForwardIt, class UnaryPredicate, class T>
+void replace_if(sycl::queue &q, ForwardIt first, ForwardIt last,
+                UnaryPredicate p, const T &new_value) {
+  if(!detail::is_fusion_enabled()) {
+    algorithms::replace_if(q, first, last, p, new_value);
+    return;
+  }
+  stdpar::detail::submit_element_wise(
+      q, std::distance(first, last),
+      algorithms::detail::replace_if_kernel(first, p, new_value));
+}
+
+template <class ForwardIt1, class ForwardIt2, class UnaryPredicate, class T>
+void replace_copy_if(sycl::queue &q, ForwardIt1 first, ForwardIt1 last,
+                     ForwardIt2 d_first, UnaryPredicate p, const T &new_value) {
+  if(!detail::is_fusion_enabled()) {
+    algorithms::replace_copy_if(q, first, last, d_first, p, new_value);
+    return;
+  }
+  stdpar::detail::submit_element_wise(
+      q, std::distance(first, last),
+      algorithms::detail::replace_copy_if_kernel(first, d_first, p,
+                                                 new_value));
+}
+
+template <class ForwardIt1, class ForwardIt2, class T>
+void replace_copy(sycl::queue &q, ForwardIt1 first, ForwardIt1 last,
+                  ForwardIt2 d_first, const T &old_value, const T &new_value) {
+  fused::replace_copy_if(
+      q, first, last, d_first, [=](const auto &x) { return x == old_value; },
+      new_value);
+}
+
+template <class ForwardIt1, class ForwardIt2, class T, class BinaryReductionOp,
+          class BinaryTransformOp>
+void transform_reduce(sycl::queue &q,
+                      algorithms::util::allocation_group &scratch_allocations,
+                      ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 first2,
+                      T *out, T init, BinaryReductionOp reduce,
+                      BinaryTransformOp transform) {
+  if(!detail::is_fusion_enabled() || first1 == last1) {
+    algorithms::transform_reduce(q, scratch_allocations, first1, last1, first2,
+                                 out, init, reduce, transform);
+    return;
+  }
+  std::size_t n = std::distance(first1, last1);
+  auto kernel =
+      algorithms::detail::transform_reduce_kernel(first1, first2, transform);
+  stdpar::detail::stdpar_tls_runtime::get().get_kernel_fuser().submit_consumer(
+      q, n, [&](auto fuse) {
+        algorithms::detail::transform_reduce_impl(
+            q, scratch_allocations, out, init, n, fuse(kernel), reduce,
+            std::vector<sycl::event>{});
+      });
+}
+
+template <class ForwardIt1, class ForwardIt2, class T>
+void transform_reduce(sycl::queue &q,
+                      algorithms::util::allocation_group &scratch_allocations,
+                      ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 first2,
+                      T *out, T init) {
+  fused::transform_reduce(q, scratch_allocations, first1, last1, first2, out,
+                          init, std::plus<T>{}, std::multiplies<T>{});
+}
+
+template <class ForwardIt, class T, class BinaryReductionOp,
+          class UnaryTransformOp>
+void transform_reduce(sycl::queue &q,
+                      algorithms::util::allocation_group &scratch_allocations,
+                      ForwardIt first, ForwardIt last, T *out, T init,
+                      BinaryReductionOp reduce, UnaryTransformOp transform) {
+  if(!detail::is_fusion_enabled() || first == last) {
+    algorithms::transform_reduce(q, scratch_allocations, first, last, out,
+                                 init, reduce, transform);
+    return;
+  }
+  std::size_t n = std::distance(first, last);
+  auto kernel = algorithms::detail::transform_reduce_kernel(first, transform);
+  stdpar::detail::stdpar_tls_runtime::get().get_kernel_fuser().submit_consumer(
+      q, n, [&](auto fuse) {
+        algorithms::detail::transform_reduce_impl(
+            q, scratch_allocations, out, init, n, fuse(kernel), reduce,
+            std::vector<sycl::event>{});
+      });
+}
+
+}
+
+#endif
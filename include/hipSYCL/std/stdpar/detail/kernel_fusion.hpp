@@ -0,0 +1,298 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_PSTL_KERNEL_FUSION_HPP
+#define HIPSYCL_PSTL_KERNEL_FUSION_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <type_traits>
+#include <vector>
+
+#include "hipSYCL/runtime/settings.hpp"
+#include "hipSYCL/sycl/queue.hpp"
+#include "hipSYCL/sycl/jit.hpp"
+#include "hipSYCL/std/stdpar/detail/allocation_map.hpp"
+#include "hipSYCL/std/stdpar/detail/offload_heuristic_db.hpp"
+
+// Fused kernels are assembled at JIT time using dynamic functions,
+// which are only available if all kernels are compiled for the generic
+// SSCP target.
+#if ACPP_LIBKERNEL_IS_DEVICE_PASS_SSCP &&                                      \
+    !ACPP_LIBKERNEL_COMPILER_SUPPORTS_CUDA &&                                  \
+    !ACPP_LIBKERNEL_COMPILER_SUPPORTS_HIP &&                                   \
+    !defined(__ACPP_ENABLE_OMPHOST_TARGET__) &&                                \
+    !defined(__ACPP_USE_ACCELERATED_CPU__)
+#define HIPSYCL_STDPAR_KERNEL_FUSION_SUPPORTED 1
+#else
+#define HIPSYCL_STDPAR_KERNEL_FUSION_SUPPORTED 0
+#endif
+
+namespace hipsycl::stdpar {
+
+template<class AlgorithmCategory>
+struct is_element_wise_algorithm : public std::false_type {};
+
+#define HIPSYCL_STDPAR_DECLARE_ELEMENT_WISE_ALGORITHM(category)                \
+  template <>                                                                  \
+  struct is_element_wise_algorithm<algorithm_category::category>               \
+      : public std::true_type {};
+
+HIPSYCL_STDPAR_DECLARE_ELEMENT_WISE_ALGORITHM(for_each)
+HIPSYCL_STDPAR_DECLARE_ELEMENT_WISE_ALGORITHM(for_each_n)
+HIPSYCL_STDPAR_DECLARE_ELEMENT_WISE_ALGORITHM(transform)
+HIPSYCL_STDPAR_DECLARE_ELEMENT_WISE_ALGORITHM(generate)
+HIPSYCL_STDPAR_DECLARE_ELEMENT_WISE_ALGORITHM(generate_n)
+HIPSYCL_STDPAR_DECLARE_ELEMENT_WISE_ALGORITHM(replace)
+HIPSYCL_STDPAR_DECLARE_ELEMENT_WISE_ALGORITHM(replace_if)
+HIPSYCL_STDPAR_DECLARE_ELEMENT_WISE_ALGORITHM(replace_copy)
+HIPSYCL_STDPAR_DECLARE_ELEMENT_WISE_ALGORITHM(replace_copy_if)
+
+#undef HIPSYCL_STDPAR_DECLARE_ELEMENT_WISE_ALGORITHM
+
+/// Algorithms that process each element once, and which can therefore
+/// carry out deferred element-wise operations for the element beforehand
+/// in the same kernel.
+template<class AlgorithmCategory>
+struct is_fusion_consumer_algorithm
+    : public is_element_wise_algorithm<AlgorithmCategory> {};
+
+template <>
+struct is_fusion_consumer_algorithm<algorithm_category::transform_reduce>
+    : public std::true_type {};
+
+namespace detail {
+
+/// Holds the function objects of all operations of a fused kernel.
+/// It is passed to the fused kernel by value, so no additional memory
+/// needs to be managed for it.
+struct fused_operations_storage {
+  static constexpr std::size_t max_operations = 8;
+  static constexpr std::size_t max_size = 1024;
+
+  alignas(16) unsigned char data[max_size];
+  uint32_t offsets[max_operations];
+};
+
+#if HIPSYCL_STDPAR_KERNEL_FUSION_SUPPORTED
+
+/// Placeholder, calls to it are replaced at JIT time with the sequence
+/// of operations of the fused kernel.
+void __acpp_stdpar_fused_operations(std::size_t idx,
+                                    const fused_operations_storage *storage);
+
+template <class F, std::size_t Slot>
+[[clang::annotate("hipsycl_sscp_outlining")]]
+void invoke_fused_operation(std::size_t idx,
+                            const fused_operations_storage *storage) {
+  const F *f = reinterpret_cast<const F *>(storage->data +
+                                           storage->offsets[Slot]);
+  (*f)(idx);
+}
+
+#endif
+
+/// Defers the submission of element-wise operations, such that consecutive
+/// operations with the same problem size are executed by a single kernel
+/// in which each work item carries out all operations for its element.
+/// This is only correct if operations do not access other elements than
+/// their own, which is why fusion needs to be enabled explicitly.
+///
+/// Deferred operations are submitted in flush(), which needs to happen
+/// before any other operation is submitted to the queue, and before
+/// waiting for the queue.
+class kernel_fuser {
+public:
+  kernel_fuser() {
+#if HIPSYCL_STDPAR_KERNEL_FUSION_SUPPORTED
+    bool is_requested = false;
+    if(rt::try_get_environment_variable("stdpar_kernel_fusion", is_requested))
+      _is_enabled = is_requested;
+#endif
+  }
+
+  bool is_enabled() const {
+#if HIPSYCL_STDPAR_KERNEL_FUSION_SUPPORTED
+    return _is_enabled;
+#else
+    return false;
+#endif
+  }
+
+  /// Submits f, a callable of signature void(std::size_t), for each index
+  /// in [0, problem_size). If expect_successor is false, there is
+  /// no point in waiting for further operations to fuse with.
+  template <class F>
+  void submit(sycl::queue &q, std::size_t problem_size, F f,
+              bool expect_successor = true) {
+    if(problem_size == 0)
+      return;
+#if HIPSYCL_STDPAR_KERNEL_FUSION_SUPPORTED
+    if constexpr (std::is_trivially_copyable_v<F> &&
+                  sizeof(F) <= fused_operations_storage::max_size &&
+                  alignof(F) <= alignof(fused_operations_storage)) {
+      if(_is_enabled) {
+        if(_num_operations > 0 &&
+           (problem_size != _problem_size || !can_append<F>()))
+          flush(q);
+        append(problem_size, f);
+        if(!expect_successor ||
+           _num_operations == fused_operations_storage::max_operations)
+          flush(q);
+        return;
+      }
+    }
+#endif
+    flush(q);
+    q.parallel_for(sycl::range<1>{problem_size},
+                   [=](sycl::id<1> idx) { f(idx[0]); });
+  }
+
+  /// Submits all deferred operations.
+  void flush(sycl::queue &q) {
+#if HIPSYCL_STDPAR_KERNEL_FUSION_SUPPORTED
+    if(_num_operations == 0)
+      return;
+
+    std::size_t problem_size = _problem_size;
+    take_deferred_operations([&](auto fuse) {
+      q.parallel_for(sycl::range<1>{problem_size},
+                     fuse([](sycl::id<1>) {}));
+    });
+#endif
+  }
+
+  /// Submits a kernel that processes each index in [0, problem_size) once,
+  /// such as the main kernel of a reduction. Deferred operations of the same
+  /// problem size are carried out for each index at the beginning of it.
+  ///
+  /// \param submit_kernel Submits the kernel. It is invoked with a callable
+  /// which, given a kernel body that is invoked with the index as
+  /// \c sycl::id<1> as first argument, returns the body that should be
+  /// submitted instead.
+  template <class Submission>
+  void submit_consumer(sycl::queue &q, std::size_t problem_size,
+                       Submission submit_kernel) {
+#if HIPSYCL_STDPAR_KERNEL_FUSION_SUPPORTED
+    if(_num_operations > 0 && _problem_size == problem_size) {
+      take_deferred_operations(submit_kernel);
+      return;
+    }
+#endif
+    flush(q);
+    submit_kernel([](auto k) { return k; });
+  }
+  std::size_t get_num_deferred_operations() const {
+    return _num_operations;
+  }
+
+private:
+#if HIPSYCL_STDPAR_KERNEL_FUSION_SUPPORTED
+  using function_type = sycl::AdaptiveCpp_jit::dynamic_function<
+      void, std::size_t, const fused_operations_storage *>;
+  using definition_type = sycl::AdaptiveCpp_jit::dynamic_function_definition<
+      void, std::size_t, const fused_operations_storage *>;
+  using definition_list =
+      std::array<const char *, fused_operations_storage::max_operations>;
+
+  template <class F>
+  static std::size_t get_offset(std::size_t storage_size) {
+    return (storage_size + alignof(F) - 1) / alignof(F) * alignof(F);
+  }
+
+  template <class F> bool can_append() const {
+    return _num_operations < fused_operations_storage::max_operations &&
+           get_offset<F>(_storage_size) + sizeof(F) <=
+               fused_operations_storage::max_size;
+  }
+
+  template <class F, std::size_t Slot = 0>
+  static definition_type get_definition(std::size_t slot) {
+    if constexpr (Slot + 1 < fused_operations_storage::max_operations) {
+      if (slot != Slot)
+        return get_definition<F, Slot + 1>(slot);
+    }
+    return definition_type{&invoke_fused_operation<F, Slot>};
+  }
+
+  /// Resets the fuser, and invokes submit_kernel with a callable that
+  /// prepends the deferred operations to a kernel body.
+  template <class Submission>
+  void take_deferred_operations(Submission submit_kernel) {
+    fused_operations_storage storage = _storage;
+    auto &config = get_config();
+
+    _num_operations = 0;
+    _storage_size = 0;
+    _problem_size = 0;
+    _definitions = {};
+
+    submit_kernel([&config, storage](auto k) {
+      return config.apply([=](sycl::id<1> idx, auto &&...args) {
+        __acpp_stdpar_fused_operations(idx[0], &storage);
+        k(idx, args...);
+      });
+    });
+  }
+
+  template <class F> void append(std::size_t problem_size, const F &f) {
+    std::size_t offset = get_offset<F>(_storage_size);
+    std::memcpy(_storage.data + offset, &f, sizeof(F));
+    _storage.offsets[_num_operations] = static_cast<uint32_t>(offset);
+    _storage_size = offset + sizeof(F);
+
+    _definitions[_num_operations] =
+        get_definition<F>(_num_operations).function_name();
+    _problem_size = problem_size;
+    ++_num_operations;
+  }
+
+  sycl::AdaptiveCpp_jit::dynamic_function_config &get_config() {
+    // Configurations need to outlive the kernels that use them, and reusing
+    // them avoids rebuilding the JIT configuration for recurring sequences.
+    auto it = _configs.find(_definitions);
+    if(it != _configs.end())
+      return it->second;
+
+    using sycl::AdaptiveCpp_jit::dynamic_function_id;
+    std::vector<dynamic_function_id> sequence;
+    for(std::size_t i = 0; i < _num_operations; ++i)
+      sequence.push_back(dynamic_function_id{
+          reinterpret_cast<const dynamic_function_id::__handle *>(
+              _definitions[i])});
+
+    function_type fused_operations{&__acpp_stdpar_fused_operations};
+    auto &config = _configs[_definitions];
+    config.define_as_call_sequence(fused_operations.id(), sequence);
+    return config;
+  }
+
+  fused_operations_storage _storage;
+  std::size_t _storage_size = 0;
+  definition_list _definitions = {};
+  std::map<definition_list, sycl::AdaptiveCpp_jit::dynamic_function_config,
+           std::less<definition_list>,
+           libc_allocator<std::pair<const definition_list,
+                                    sycl::AdaptiveCpp_jit::dynamic_function_config>>>
+      _configs;
+#endif
+  std::size_t _num_operations = 0;
+  std::size_t _problem_size = 0;
+  bool _is_enabled = false;
+};
+
+}
+}
+
+#endif
@@ -181,6 +181,11 @@ inline void prefetch(sycl::queue& q, const void* ptr, std::size_t bytes) noexcep
 template<class AlgorithmType, class Size, typename... Args>
 void prepare_offloading(AlgorithmType type, Size problem_size, const Args&... args) {
   auto& q = detail::single_device_dispatch::get_queue();
+
+  // Operations that cannot be fused must not overtake deferred ones.
+  if constexpr (!is_fusion_consumer_algorithm<
+                    typename AlgorithmType::algorithm_category>::value)
+    stdpar_tls_runtime::get().flush_fused_operations();
   std::size_t current_batch_id = stdpar::detail::stdpar_tls_runtime::get()
                                      .get_current_offloading_batch_id();
 
@@ -301,6 +306,10 @@ struct offload_heuristic_state {
     return it->second;
   }
 
+  std::optional<op_id> predict_next() const {
+    return predict_next(_previous_op);
+  }
+
   void set_offloading(bool offloading) {
     _is_currently_offloading = offloading;
 
@@ -436,8 +445,10 @@ bool should_offload(AlgorithmType type, Size n, const Args &...args) {
 
   auto decide_offloading_viability = [&](std::optional<bool> is_currently_offloading = {}){
 
-    // Instead of hardcoding peak PCIe speeds, this should be measured
-    double data_transfer_time_estimate = 0;
+    // Estimated time to migrate the used memory to the host and
+    // to the offload device, respectively
+    double data_to_host_time_estimate = 0;
+    double data_to_device_time_estimate = 0;
 
 #if !defined(__ACPP_STDPAR_ASSUME_SYSTEM_USM__)
     std::size_t used_memory = 0;
@@ -445,12 +456,18 @@ bool should_offload(AlgorithmType type, Size n, const Args &...args) {
       unified_shared_memory::allocation_lookup_result lookup_result;
   
       if(ptr && unified_shared_memory::allocation_lookup(ptr, lookup_result)) {
-        used_memory += lookup_result.info->allocation_size;
+        used_memory +=
+            unified_shared_memory::get_used_size(ptr, lookup_result);
       }
     }, args...);
 
-    if(detail::stdpar_tls_runtime::get().get_current_offloading_batch_id() > 0)
-      data_transfer_time_estimate = used_memory / 32.0;
+    auto& tls_rt = detail::stdpar_tls_runtime::get();
+    if(tls_rt.get_current_offloading_batch_id() > 0 && used_memory > 0) {
+      data_to_host_time_estimate =
+          tls_rt.estimate_data_transfer_time(used_memory, true);
+      data_to_device_time_estimate =
+          tls_rt.estimate_data_transfer_time(used_memory, false);
+    }
 #endif
 
     double host_time_estimate = 0.0;
@@ -485,9 +502,9 @@ bool should_offload(AlgorithmType type, Size n, const Args &...args) {
     
     if(is_currently_offloading.has_value()){
       if(is_currently_offloading.value()) {
-        host_time_estimate += data_transfer_time_estimate;
+        host_time_estimate += data_to_host_time_estimate;
       } else {
-        offload_time_estimate += data_transfer_time_estimate;
+        offload_time_estimate += data_to_device_time_estimate;
       }
 
       double ratio = host_time_estimate / offload_time_estimate;
@@ -525,6 +542,23 @@ bool should_offload(AlgorithmType type, Size n, const Args &...args) {
 #endif
 }
 
+/// Submits an element-wise operation, i.e. f(i) for each index i in
+/// [0, problem_size), through the kernel fuser of the current thread.
+/// Only used if kernel fusion is enabled.
+template <class F>
+void submit_element_wise(sycl::queue &q, std::size_t problem_size, F f) {
+  bool expect_successor = true;
+#ifndef __ACPP_STDPAR_UNCONDITIONAL_OFFLOAD__
+  // Only hold back the kernel if the operation that followed the last time
+  // has the same problem size, and might therefore be fused with it.
+  auto next = offload_heuristic_state::get().predict_next();
+  if(next.has_value())
+    expect_successor = next->second == problem_size;
+#endif
+  stdpar_tls_runtime::get().get_kernel_fuser().submit(q, problem_size, f,
+                                                      expect_successor);
+}
+
 struct host_invocation_measurement {
   host_invocation_measurement(uint64_t hash, std::size_t problem_size)
   : _hash{hash}, _problem_size{problem_size} {}
@@ -47,10 +47,17 @@ struct replace_copy_if {};
 struct find {};
 struct find_if {};
 struct find_if_not {};
+struct adjacent_find {};
+struct mismatch {};
+struct count {};
+struct count_if {};
+struct min_element {};
+struct max_element {};
 struct all_of {};
 struct any_of {};
 struct none_of {};
 struct sort {};
+struct stable_sort {};
 struct merge {};
 struct inclusive_scan {};
 struct exclusive_scan {};
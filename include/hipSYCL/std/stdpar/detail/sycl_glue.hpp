@@ -15,6 +15,7 @@
 
 
 #include <atomic>
+#include <cassert>
 #include <cstdint>
 #include <cstdlib>
 #include <new>
@@ -32,8 +33,12 @@
 
 
 #include "allocation_map.hpp"
+#include "hipSYCL/common/slab_cache.hpp"
 #include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/backend.hpp"
+#include "hipSYCL/runtime/hw_model/hw_model.hpp"
 #include "offload_heuristic_db.hpp"
+#include "kernel_fusion.hpp"
 #include "hipSYCL/runtime/settings.hpp"
 #include "hipSYCL/sycl/info/device.hpp"
 
@@ -75,6 +80,12 @@ private:
         }
 
   ~stdpar_tls_runtime() {
+    // Operations deferred for kernel fusion have not been
+    // submitted yet and would otherwise be lost.
+    flush_fused_operations();
+    // Operations that were offloaded without waiting
+    // might still use scratch allocations.
+    _queue.wait();
     _device_scratch_cache.purge();
     _shared_scratch_cache.purge();
     _host_scratch_cache.purge();
@@ -88,6 +99,7 @@ private:
   bool _has_independent_work_item_forward_progress = false;
 
   offload_heuristic_db _offload_db;
+  kernel_fuser _kernel_fuser;
   std::vector<uint64_t, libc_allocator<uint64_t>> _instrumented_ops_in_batch;
   std::vector<std::size_t, libc_allocator<std::size_t>> _instrumented_op_problem_sizes_in_batch;
   uint64_t _batch_start_timestamp = 0;
@@ -113,6 +125,30 @@ public:
     return _queue;
   }
 
+  kernel_fuser& get_kernel_fuser() {
+    return _kernel_fuser;
+  }
+
+  /// Submits operations that have been deferred for kernel fusion.
+  void flush_fused_operations() {
+    _kernel_fuser.flush(_queue);
+  }
+
+  /// \return The estimated time in ns to migrate \c num_bytes between
+  /// the host and the offload device, in the given direction.
+  double estimate_data_transfer_time(std::size_t num_bytes, bool to_host) {
+    rt::device_id host_dev = sycl::detail::get_host_device();
+    rt::device_id offload_dev = _queue.get_device().AdaptiveCpp_device_id();
+    const rt::memcpy_model *model = _queue.get_context()
+                                        .AdaptiveCpp_runtime()
+                                        ->backends()
+                                        .hardware_model()
+                                        .get_memcpy_model();
+    if (to_host)
+      return model->estimate_transfer_time(offload_dev, host_dev, num_bytes);
+    return model->estimate_transfer_time(host_dev, offload_dev, num_bytes);
+  }
+
   bool device_has_work_item_independent_forward_progress() const {
     return _has_independent_work_item_forward_progress;
   }
@@ -175,6 +211,18 @@ public:
         &cache, get_queue().get_device().AdaptiveCpp_device_id()};
   }
 
+  /// Like \c make_scratch_group(), for operations that are submitted to
+  /// \c q without waiting for them. The group may then be destroyed while
+  /// the operations still use its allocations. This is only safe because the
+  /// scratch caches are exclusively used with this thread's in-order queue,
+  /// such that any operation reusing the allocations runs afterwards.
+  template<algorithms::util::allocation_type AT>
+  algorithms::util::allocation_group
+  make_nonblocking_scratch_group(const sycl::queue& q) {
+    assert(q == _queue && q.is_in_order());
+    return make_scratch_group<AT>();
+  }
+
   static stdpar_tls_runtime& get() {
     static thread_local stdpar_tls_runtime rt;
     return rt;
@@ -222,6 +270,23 @@ private:
 
 namespace hipsycl::stdpar {
 
+class memory_pool;
+
+/// Slabs for small allocations, which are carved out of the memory pool.
+struct memory_pool_slabs {
+  static constexpr std::size_t min_block_size = 16;
+  static constexpr std::size_t num_size_classes = 8;
+  static constexpr std::size_t slab_size = 64 * 1024;
+
+  static void* allocate_slab(std::size_t size_class);
+  static void release_slab(void* slab, std::size_t size_class);
+
+  // There is only one memory pool, which sets this on construction.
+  inline static memory_pool* pool = nullptr;
+};
+
+using size_class_cache = common::slab_cache<memory_pool_slabs>;
+
 class memory_pool {
 private:
   uint64_t ceil_division(uint64_t a, uint64_t b) {
@@ -232,17 +297,30 @@ private:
     return ceil_division(a, b) * b;
   }
 public:
-  memory_pool(std::size_t size)
+  /// \param on_new_slab Invoked with the address and size of each slab
+  /// that is created to serve small allocations.
+  /// \param on_released_slab Invoked with the address of each such slab
+  /// before it is returned to the pool.
+  memory_pool(std::size_t size, void (*on_new_slab)(void *, std::size_t),
+              void (*on_released_slab)(void *))
       : _pool_size{size}, _pool{nullptr},
         _free_space_map{size > 0 ? size : 1024},
-        _page_size{static_cast<std::size_t>(sysconf(_SC_PAGESIZE))} {
+        _page_size{static_cast<std::size_t>(sysconf(_SC_PAGESIZE))},
+        _slab_size_classes{nullptr}, _on_new_slab{on_new_slab},
+        _on_released_slab{on_released_slab} {
     init();
+    memory_pool_slabs::pool = this;
   }
 
   void* claim(std::size_t size) {
     if(_pool_size == 0)
       return nullptr;
 
+    if(size <= size_class_cache::max_block_size) {
+      return size_class_cache::allocate(
+          size_class_cache::get_size_class(size));
+    }
+
     if(size < _page_size)
       size = _page_size;
 
@@ -277,6 +355,25 @@ public:
     }
   }
 
+  /// Whether ptr was returned by claim() for a small allocation. Such
+  /// allocations must be released using release_small().
+  bool is_small_allocation(void* ptr) const {
+    return is_from_pool(ptr) && _slab_size_classes[get_slab_index(ptr)] != 0;
+  }
+
+  void release_small(void* ptr) {
+    assert(is_small_allocation(ptr));
+    size_class_cache::deallocate(ptr,
+                                 _slab_size_classes[get_slab_index(ptr)] - 1);
+  }
+
+  /// \return The size of the block that a small allocation occupies.
+  std::size_t get_small_allocation_size(void* ptr) const {
+    assert(is_small_allocation(ptr));
+    return size_class_cache::get_block_size(
+        _slab_size_classes[get_slab_index(ptr)] - 1);
+  }
+
   ~memory_pool() {
     // Memory pool might be destroyed after runtime shutdown, so rely on OS
     // to clean up for now
@@ -293,8 +390,46 @@ public:
     void* pool_end = (char*)_base_address + _pool_size;
     return ptr >= _base_address && ptr < pool_end;
   }
+
+  /// Slabs for small allocations are claimed and released through
+  /// size_class_cache only.
+  void* claim_slab(std::size_t size_class) {
+    uint64_t address = 0;
+    if(!_free_space_map.claim(size_class_cache::slab_size, address))
+      return nullptr;
+
+    void* slab = static_cast<void*>((char*)_base_address + address);
+    assert(reinterpret_cast<uintptr_t>(slab) % size_class_cache::slab_size ==
+           0);
+    _slab_size_classes[get_slab_index(slab)] =
+        static_cast<uint8_t>(size_class + 1);
+
+    // The runtime and the allocation map track the slab as a whole instead
+    // of the individual allocations in it.
+    rt::application::event_handler_layer().on_new_allocation(
+        slab, size_class_cache::slab_size,
+        rt::allocation_info{_dev,
+                            rt::allocation_info::allocation_type::shared});
+    _on_new_slab(slab, size_class_cache::slab_size);
+    return slab;
+  }
+
+  void release_slab(void* slab) {
+    _on_released_slab(slab);
+    rt::application::event_handler_layer().on_deallocation(slab);
+    // Must be reset before the space can be claimed again
+    _slab_size_classes[get_slab_index(slab)] = 0;
+
+    uint64_t address = reinterpret_cast<uint64_t>(slab) -
+                       reinterpret_cast<uint64_t>(_base_address);
+    _free_space_map.release(address, size_class_cache::slab_size);
+  }
 private:
 
+  std::size_t get_slab_index(void* ptr) const {
+    return ((char*)ptr - (char*)_base_address) / size_class_cache::slab_size;
+  }
+
   void* raw_malloc_shared(std::size_t bytes, sycl::queue& q) {
     auto *allocator = sycl::detail::select_usm_allocator(q.get_context(),
                                                          q.get_device());
@@ -311,12 +446,22 @@ private:
     // We need to call raw_allocate_usm so that we can inform the runtime's allocation
     // tracking mechanism of actual user allocations, not just of the memory pool as a 
     // whole.
-    // Make sure to allocate an additional page so that we can fix alignment if needed
-    _pool = raw_malloc_shared(_pool_size + _page_size, q);
-
-    uint64_t aligned_pool_base = next_multiple_of((uint64_t)_pool, _page_size);
+    // Slabs are found by masking block addresses, so the pool base needs to
+    // be aligned to the slab size, not just to a page. Make sure to allocate
+    // additional space so that we can fix alignment if needed.
+    std::size_t alignment =
+        std::max(_page_size, size_class_cache::slab_size);
+    _pool = raw_malloc_shared(_pool_size + alignment, q);
+
+    uint64_t aligned_pool_base = next_multiple_of((uint64_t)_pool, alignment);
     _base_address = (void*)aligned_pool_base;
     assert(aligned_pool_base % _page_size == 0);
+    assert(aligned_pool_base % size_class_cache::slab_size == 0);
+
+    std::size_t num_slabs =
+        ceil_division(_pool_size, size_class_cache::slab_size);
+    _slab_size_classes = static_cast<uint8_t *>(__libc_malloc(num_slabs));
+    std::fill(_slab_size_classes, _slab_size_classes + num_slabs, 0);
   }
 
 
@@ -326,8 +471,23 @@ private:
   free_space_map _free_space_map;
   std::size_t _page_size;
   rt::device_id _dev;
+  // For each slab-sized part of the pool, the size class + 1 if it is
+  // used as slab for small allocations, or 0 otherwise.
+  uint8_t* _slab_size_classes;
+  void (*_on_new_slab)(void *, std::size_t);
+  void (*_on_released_slab)(void *);
 };
 
+inline void* memory_pool_slabs::allocate_slab(std::size_t size_class) {
+  return pool->claim_slab(size_class);
+}
+
+inline void memory_pool_slabs::release_slab(void* slab, std::size_t) {
+  // Once the runtime has shut down, the pool is left to the OS to clean up.
+  if(detail::usm_context::is_alive())
+    pool->release_slab(slab);
+}
+
 class unified_shared_memory {
   
   struct allocation_map_payload {
@@ -356,6 +516,7 @@ public:
     if(thread_local_storage::get().disabled_stack == 0) {
       
       void* ptr = nullptr;
+      bool is_registered = false;
       push_disabled();
       if (alignment != 0) {
         ptr = sycl::aligned_alloc_shared(alignment, n,
@@ -373,6 +534,8 @@ public:
 
         if(n < mem_pool->get_size() / 2) {
           ptr = mem_pool->claim(n);
+          // Small allocations are registered together with their slab
+          is_registered = ptr && mem_pool->is_small_allocation(ptr);
         }
         // ptr will still be nullptr if pool was not used, or pool allocation
         // failed.
@@ -383,7 +546,7 @@ public:
       get()._is_initialized = true;
       pop_disabled();
 
-      if(ptr) {
+      if(ptr && !is_registered) {
         allocation_map_t::value_type v;
         v.allocation_size = n;
         v.most_recent_offload_batch = -1;
@@ -421,6 +584,15 @@ public:
         return;
 
       push_disabled();
+      memory_pool* mem_pool = get().get_memory_pool();
+      // Must be checked first, since small allocations are not in the
+      // allocation map themselves, only the slab that contains them.
+      if(mem_pool && mem_pool->is_small_allocation(ptr)) {
+        mem_pool->release_small(ptr);
+        pop_disabled();
+        return;
+      }
+
       auto* map_entry = get()._allocation_map.get_entry_of_root_address(
               reinterpret_cast<uint64_t>(ptr));
       if (!map_entry) {
@@ -429,7 +601,6 @@ public:
         uint64_t allocation_size = map_entry->allocation_size;
 
         get()._allocation_map.erase(reinterpret_cast<uint64_t>(ptr));
-        memory_pool* mem_pool = get().get_memory_pool();
         if(mem_pool && mem_pool->is_from_pool(ptr)) {
           mem_pool->release(ptr, allocation_size);
         } else {
@@ -457,6 +628,18 @@ public:
     result.info = ret;
     return true;
   }
+
+  /// \return The number of bytes used by the allocation that contains ptr.
+  /// Unlike the allocation_size of the allocation_lookup() result, which
+  /// describes the whole slab for small allocations, this is the size of
+  /// their block.
+  static std::size_t get_used_size(void* ptr,
+                                   const allocation_lookup_result& result) {
+    memory_pool* mem_pool = get().get_memory_pool();
+    if(mem_pool && mem_pool->is_small_allocation(ptr))
+      return mem_pool->get_small_allocation_size(ptr);
+    return result.info->allocation_size;
+  }
 private:
   memory_pool* get_memory_pool() const {
     return __atomic_load_n(&_memory_pool, __ATOMIC_ACQUIRE);
@@ -468,13 +651,24 @@ private:
       memory_pool* mem_pool = (memory_pool *)__libc_malloc(sizeof(memory_pool));
       std::size_t pool_size = get_mem_pool_size_gb() * 1024 * 1024 * 1024;
 
-      new (mem_pool) memory_pool{pool_size};
+      new (mem_pool) memory_pool{pool_size, &register_slab, &unregister_slab};
       __atomic_store_n(&_memory_pool,
                        mem_pool,
                        __ATOMIC_RELEASE);
     }
   }
 
+  static void register_slab(void* slab, std::size_t size) {
+    allocation_map_t::value_type v;
+    v.allocation_size = size;
+    v.most_recent_offload_batch = -1;
+    get()._allocation_map.insert(reinterpret_cast<uint64_t>(slab), v);
+  }
+
+  static void unregister_slab(void* slab) {
+    get()._allocation_map.erase(reinterpret_cast<uint64_t>(slab));
+  }
+
   double get_mem_pool_size_gb() {
     auto dev = detail::single_device_dispatch::get_queue().get_device();
 
@@ -18,6 +18,7 @@
 #include "../detail/sycl_glue.hpp"
 #include "../detail/stdpar_builtins.hpp"
 #include "../detail/offload.hpp"
+#include "../detail/fused_algorithms.hpp"
 #include "hipSYCL/algorithms/util/allocation_cache.hpp"
 #include "hipSYCL/algorithms/numeric.hpp"
 #include <iterator>
@@ -51,8 +52,8 @@ T transform_reduce(hipsycl::stdpar::par_unseq,
                 hipsycl::algorithms::util::allocation_type::device>();
     
     T* output = output_scratch_group.obtain<T>(1);
-    hipsycl::algorithms::transform_reduce(queue, reduction_scratch_group, first1,
-                                            last1, first2, output, init);
+    hipsycl::stdpar::fused::transform_reduce(queue, reduction_scratch_group, first1,
+                                               last1, first2, output, init);
     // We need to wait in any case here, so cannot elide synchronization
     queue.wait();
     
@@ -96,9 +97,9 @@ T transform_reduce(hipsycl::stdpar::par_unseq,
                 hipsycl::algorithms::util::allocation_type::device>();
     
     T* output = output_scratch_group.obtain<T>(1);
-    hipsycl::algorithms::transform_reduce(queue, reduction_scratch_group, first1,
-                                          last1, first2, output, init, reduce,
-                                          transform);
+    hipsycl::stdpar::fused::transform_reduce(queue, reduction_scratch_group, first1,
+                                             last1, first2, output, init, reduce,
+                                             transform);
     // We need to wait in any case here, so cannot elide synchronization
     queue.wait();
     
@@ -143,8 +144,8 @@ T transform_reduce(hipsycl::stdpar::par_unseq,
                 hipsycl::algorithms::util::allocation_type::device>();
     
     T* output = output_scratch_group.obtain<T>(1);
-    hipsycl::algorithms::transform_reduce(queue, reduction_scratch_group, first, last,
-                                          output, init, reduce, transform);
+    hipsycl::stdpar::fused::transform_reduce(queue, reduction_scratch_group, first, last,
+                                             output, init, reduce, transform);
     // We need to wait in any case here, so cannot elide synchronization
     queue.wait();
     
@@ -604,8 +605,8 @@ T transform_reduce(hipsycl::stdpar::par,
                 hipsycl::algorithms::util::allocation_type::device>();
     
     T* output = output_scratch_group.obtain<T>(1);
-    hipsycl::algorithms::transform_reduce(queue, reduction_scratch_group, first1,
-                                            last1, first2, output, init);
+    hipsycl::stdpar::fused::transform_reduce(queue, reduction_scratch_group, first1,
+                                               last1, first2, output, init);
     // We need to wait in any case here, so cannot elide synchronization
     queue.wait();
     
@@ -649,9 +650,9 @@ T transform_reduce(hipsycl::stdpar::par,
                 hipsycl::algorithms::util::allocation_type::device>();
     
     T* output = output_scratch_group.obtain<T>(1);
-    hipsycl::algorithms::transform_reduce(queue, reduction_scratch_group, first1,
-                                          last1, first2, output, init, reduce,
-                                          transform);
+    hipsycl::stdpar::fused::transform_reduce(queue, reduction_scratch_group, first1,
+                                             last1, first2, output, init, reduce,
+                                             transform);
     // We need to wait in any case here, so cannot elide synchronization
     queue.wait();
     
@@ -696,8 +697,8 @@ T transform_reduce(hipsycl::stdpar::par,
                 hipsycl::algorithms::util::allocation_type::device>();
     
     T* output = output_scratch_group.obtain<T>(1);
-    hipsycl::algorithms::transform_reduce(queue, reduction_scratch_group, first, last,
-                                          output, init, reduce, transform);
+    hipsycl::stdpar::fused::transform_reduce(queue, reduction_scratch_group, first, last,
+                                             output, init, reduce, transform);
     // We need to wait in any case here, so cannot elide synchronization
     queue.wait();
     
@@ -76,6 +76,7 @@
 #define ACPP_EXT_DYNAMIC_FUNCTIONS
 #define ACPP_EXT_RESTRICT_PTR
 #define ACPP_EXT_JIT_COMPILE_IF
+#define ACPP_EXT_COMMAND_GRAPH
 
 // KHR extensions
 
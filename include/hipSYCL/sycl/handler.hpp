@@ -42,12 +42,14 @@
 #include "hipSYCL/runtime/kernel_launcher.hpp"
 #include "hipSYCL/runtime/operations.hpp"
 #include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/command_graph.hpp"
 #include "hipSYCL/runtime/dag_manager.hpp"
 #include "hipSYCL/runtime/dag_node.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/executor.hpp"
 #include "hipSYCL/runtime/util.hpp"
 #include "hipSYCL/glue/embedded_pointer.hpp"
+#include "hipSYCL/glue/error.hpp"
 #include "hipSYCL/glue/kernel_launcher_factory.hpp"
 #include "hipSYCL/glue/kernel_names.hpp"
 #include "hipSYCL/glue/generic/code_object.hpp"
@@ -1165,6 +1167,25 @@ private:
   rt::dag_node_ptr create_task(std::unique_ptr<rt::operation> op,
                                const rt::execution_hints &hints,
                                const rt::requirements_list& requirements) {
+    if(_replayed_graph) {
+      // The graph has precomputed the scheduling decisions, bypass the DAG
+      rt::dag_node_ptr node;
+      rt::result err = _replayed_graph->replay_next(std::move(op), hints,
+                                                    requirements.get(), node);
+      if(!err.is_success())
+        std::rethrow_exception(glue::throw_result(err));
+      return node;
+    }
+
+    rt::dag_node_ptr node = submit_task(std::move(op), hints, requirements);
+    if(_recorded_nodes)
+      _recorded_nodes->push_back(node);
+    return node;
+  }
+
+  rt::dag_node_ptr submit_task(std::unique_ptr<rt::operation> op,
+                               const rt::execution_hints &hints,
+                               const rt::requirements_list& requirements) {
 
     bool uses_buffers = false;
     bool has_non_instant_dependency = false;
@@ -1203,7 +1224,7 @@ private:
 #endif
     } else {
 
-      rt::dag_node_ptr node = std::make_shared<rt::dag_node>(
+      rt::dag_node_ptr node = rt::make_dag_node(
           hints, requirements.get(), std::move(op), _rt);
       node->assign_to_device(
           hints.get_hint<rt::hints::bind_to_device>()->get_device_id());
@@ -1239,6 +1260,11 @@ private:
 
   bool _contains_non_instant_nodes = false;
 
+  // Set by the queue while recording or replaying an
+  // AdaptiveCpp_command_graph
+  std::vector<rt::dag_node_ptr>* _recorded_nodes = nullptr;
+  rt::command_graph* _replayed_graph = nullptr;
+
   algorithms::util::allocation_cache* _allocation_cache;
 
   std::weak_ptr<rt::dag_node>* _most_recent_reduction_kernel;
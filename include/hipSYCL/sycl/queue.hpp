@@ -15,6 +15,7 @@
 #include "hipSYCL/common/debug.hpp"
 #include "hipSYCL/glue/error.hpp"
 #include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/command_graph.hpp"
 #include "hipSYCL/runtime/dag_node.hpp"
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/hints.hpp"
@@ -37,6 +38,7 @@
 
 #include <cstddef>
 #include <exception>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <atomic>
@@ -119,6 +121,28 @@ using hipSYCL_priority = AdaptiveCpp_priority;
 }
 
 
+class queue;
+
+/// A sequence of command groups that has been recorded with
+/// queue::AdaptiveCpp_record_graph(), see ACPP_EXT_COMMAND_GRAPH.
+class AdaptiveCpp_command_graph {
+public:
+  std::size_t get_num_nodes() const { return _graph->get_num_nodes(); }
+
+private:
+  friend class queue;
+
+  AdaptiveCpp_command_graph(std::function<void(queue &)> record_function,
+                            std::shared_ptr<rt::command_graph> graph,
+                            std::weak_ptr<void> recording_queue)
+      : _record_function{std::move(record_function)}, _graph{std::move(graph)},
+        _recording_queue{std::move(recording_queue)} {}
+
+  std::function<void(queue &)> _record_function;
+  std::shared_ptr<rt::command_graph> _graph;
+  std::weak_ptr<void> _recording_queue;
+};
+
 class queue : public detail::property_carrying_object
 {
   struct queue_impl {
@@ -155,6 +179,10 @@ class queue : public detail::property_carrying_object
     std::shared_ptr<rt::kernel_cache> kernel_cache;
     // For non-emulated in-order queues only
     std::atomic<bool> has_non_instant_operations = false;
+
+    // Set while recording or replaying an AdaptiveCpp_command_graph
+    std::vector<rt::dag_node_ptr>* recorded_nodes = nullptr;
+    rt::command_graph* replayed_graph = nullptr;
   };
 
   template<typename, int, access::mode, access::target>
@@ -445,6 +473,9 @@ public:
 
     this->get_hooks()->run_all(cgh);
 
+    cgh._recorded_nodes = _impl->recorded_nodes;
+    cgh._replayed_graph = _impl->replayed_graph;
+
     rt::dag_node_ptr node = execute_submission(cgf, cgh);
     
     return event{node, _impl->handler};
@@ -540,6 +571,67 @@ public:
     }
   }
 
+  /// Records the command groups that f submits to this queue into a
+  /// graph. The command groups are executed as usual while recording.
+  ///
+  /// Replaying the graph invokes f again, but its submissions bypass
+  /// the DAG and reuse the recorded dependencies and execution lanes.
+  /// Kernel arguments can therefore change between replays, but f
+  /// must submit the same sequence of operations every time.
+  template <class F>
+  AdaptiveCpp_command_graph AdaptiveCpp_record_graph(F f) {
+    std::vector<rt::dag_node_ptr> nodes;
+    set_command_graph_state(&nodes, nullptr);
+    try {
+      f(*this);
+    } catch (...) {
+      set_command_graph_state(nullptr, nullptr);
+      throw;
+    }
+    set_command_graph_state(nullptr, nullptr);
+
+    // Executors and lanes are only known once the nodes are scheduled
+    _impl->requires_runtime.get()->dag().flush_sync();
+
+    auto graph = std::make_shared<rt::command_graph>(
+        _impl->requires_runtime.get());
+    for (const auto &node : nodes) {
+      rt::result err = graph->record(node);
+      if (!err.is_success())
+        std::rethrow_exception(glue::throw_result(err));
+    }
+    return AdaptiveCpp_command_graph{f, graph, _impl};
+  }
+
+  /// Submits the command groups of a graph that has been recorded
+  /// on this queue. Returns events for the final operations of the graph.
+  std::vector<event>
+  AdaptiveCpp_replay_graph(AdaptiveCpp_command_graph &graph) {
+    if (graph._recording_queue.lock() != _impl)
+      throw exception{make_error_code(errc::invalid),
+                      "queue: Command graph was not recorded on this queue"};
+
+    graph._graph->begin_replay();
+    set_command_graph_state(nullptr, graph._graph.get());
+    try {
+      graph._record_function(*this);
+    } catch (...) {
+      set_command_graph_state(nullptr, nullptr);
+      throw;
+    }
+    set_command_graph_state(nullptr, nullptr);
+
+    rt::node_list_t sinks;
+    rt::result err = graph._graph->end_replay(sinks);
+    if (!err.is_success())
+      std::rethrow_exception(glue::throw_result(err));
+
+    std::vector<event> evts;
+    for (const auto &node : sinks)
+      evts.push_back(event{node, _impl->handler});
+    return evts;
+  }
+
   // ---- Queue shortcuts ------
 
   template <typename KernelName = __acpp_unnamed_kernel, typename KernelType>
@@ -1088,6 +1180,17 @@ private:
     return false;
   }
 
+  void set_command_graph_state(std::vector<rt::dag_node_ptr> *recorded_nodes,
+                               rt::command_graph *replayed_graph) {
+    std::lock_guard<std::mutex> lock{_impl->lock};
+    if ((recorded_nodes || replayed_graph) &&
+        (_impl->recorded_nodes || _impl->replayed_graph))
+      throw exception{make_error_code(errc::invalid),
+                      "queue: Already recording or replaying a command graph"};
+    _impl->recorded_nodes = recorded_nodes;
+    _impl->replayed_graph = replayed_graph;
+  }
+
   rt::dag_node_ptr extract_dag_node(sycl::handler& cgh) {
 
     const rt::node_list_t &dag_nodes = cgh.get_cg_nodes();
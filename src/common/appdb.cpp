@@ -11,14 +11,197 @@
 #include "hipSYCL/common/debug.hpp"
 #include "hipSYCL/common/appdb.hpp"
 #include "hipSYCL/common/filesystem.hpp"
+#include "hipSYCL/common/stable_running_hash.hpp"
 #include "hipSYCL/runtime/kernel_configuration.hpp"
-#include <fstream>
+#include <chrono>
+#include <cstring>
 #include <type_traits>
 
 namespace hipsycl::common::db {
 
 namespace {
 
+// Journal records are appended if the database was modified and
+// the previous sync is at least this long ago.
+constexpr uint64_t sync_interval_ns = 10ull * 1000 * 1000 * 1000;
+// The journal is compacted into the snapshot once it exceeds
+// this size as well as the size of the snapshot.
+constexpr std::size_t min_compaction_journal_size = 1024 * 1024;
+
+constexpr uint32_t journal_record_magic = 0x4a504341; // "ACPJ"
+
+struct journal_record_header {
+  uint32_t magic;
+  uint32_t payload_size;
+  uint64_t payload_hash;
+};
+
+uint64_t get_time_now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+uint64_t hash_bytes(const uint8_t* data, std::size_t size) {
+  stable_running_hash h;
+  h(data, size);
+  return h.get_current_hash();
+}
+
+template<class Map>
+void merge_entries(Map& target, Map& source) {
+  // Merging loaded data does not modify anything that
+  // needs to be persisted again.
+  auto& target_entries = target.get_entries();
+  for(auto& entry : source.get_entries())
+    target_entries[entry.first] = std::move(entry.second);
+}
+
+void merge(appdb_data& target, appdb_data& source) {
+  merge_entries(target.kernels, source.kernels);
+  merge_entries(target.binaries, source.binaries);
+  merge_entries(target.memcpy_models, source.memcpy_models);
+  merge_entries(target.kernel_tunings, source.kernel_tunings);
+  target.content_version =
+      std::max(target.content_version, source.content_version);
+}
+
+// Returns the total size of the record starting at the given offset
+// of the journal, or 0 if there is no intact record at this offset.
+std::size_t get_journal_record_size(const filesystem::mapped_file &journal,
+                                    std::size_t offset) {
+  if(offset + sizeof(journal_record_header) > journal.size())
+    return 0;
+
+  journal_record_header header;
+  std::memcpy(&header, journal.data() + offset, sizeof(header));
+  const uint8_t* payload = journal.data() + offset + sizeof(header);
+
+  if(header.magic != journal_record_magic ||
+     header.payload_size > journal.size() - offset - sizeof(header) ||
+     hash_bytes(payload, header.payload_size) != header.payload_hash)
+    return 0;
+  return sizeof(header) + header.payload_size;
+}
+
+// Invokes handler with the payload of all intact records of the journal.
+// Records that were only partially written, e.g. because the writing
+// process was killed, are skipped by searching for the next intact record.
+// Returns the end offset of the last intact record, or start_offset
+// if there is none behind it.
+template<class F>
+std::size_t for_each_journal_record(const filesystem::mapped_file &journal,
+                                    F &&handler, std::size_t start_offset = 0) {
+  std::size_t offset = start_offset;
+  std::size_t intact_end = start_offset;
+  while(offset + sizeof(journal_record_header) <= journal.size()) {
+    std::size_t record_size = get_journal_record_size(journal, offset);
+    if(record_size == 0) {
+      ++offset;
+      continue;
+    }
+    handler(journal.data() + offset + sizeof(journal_record_header),
+            record_size - sizeof(journal_record_header));
+    offset += record_size;
+    intact_end = offset;
+  }
+  return intact_end;
+}
+
+// Reads the snapshot and applies all intact journal records on top of it.
+// Returns the end offset of the last intact journal record.
+std::size_t read_database(const std::string &db_path,
+                          const std::string &journal_path, appdb_data &out) {
+  {
+    filesystem::mapped_file snapshot{db_path};
+    if(snapshot.size() > 0) {
+      std::error_code ec;
+      auto data =
+          msgpack::unpack<appdb_data>(snapshot.data(), snapshot.size(), ec);
+      // A broken snapshot is treated like an empty database
+      if(!ec)
+        out = std::move(data);
+    }
+  }
+
+  filesystem::mapped_file journal{journal_path};
+  return for_each_journal_record(
+      journal, [&](const uint8_t *payload, std::size_t payload_size) {
+        std::error_code ec;
+        auto record = msgpack::unpack<appdb_data>(payload, payload_size, ec);
+        if(!ec)
+          merge(out, record);
+      });
+}
+
+// Removes a partially written record at the end of the journal, which
+// a process that was killed while appending may have left behind.
+// verified_end is an offset up to which the journal is known to be intact,
+// and only the records behind it are verified. If these are not intact,
+// e.g. because another process has compacted the journal in the meantime,
+// the whole journal is verified. Upon success, verified_end is updated to
+// the size of the journal.
+// Must be called with the exclusive lock held.
+bool truncate_torn_journal_tail(const std::string &journal_path,
+                                std::size_t &verified_end) {
+  std::size_t size = filesystem::file_size(journal_path);
+  if(size == verified_end)
+    return true;
+
+  std::size_t intact_end = 0;
+  {
+    auto verify = [](const uint8_t *, std::size_t) {};
+    filesystem::mapped_file journal{journal_path};
+    size = journal.size();
+    if(verified_end < size)
+      intact_end = for_each_journal_record(journal, verify, verified_end);
+    if(intact_end != size)
+      intact_end = for_each_journal_record(journal, verify);
+  }
+  if(intact_end != size && !filesystem::truncate(journal_path, intact_end))
+    return false;
+  verified_end = intact_end;
+  return true;
+}
+
+bool append_journal_record(const std::string& journal_path,
+                           const std::vector<uint8_t>& payload,
+                           std::size_t& verified_end) {
+  journal_record_header header;
+  header.magic = journal_record_magic;
+  header.payload_size = static_cast<uint32_t>(payload.size());
+  header.payload_hash = hash_bytes(payload.data(), payload.size());
+
+  std::string record(sizeof(header) + payload.size(), '\0');
+  std::memcpy(record.data(), &header, sizeof(header));
+  std::memcpy(record.data() + sizeof(header), payload.data(), payload.size());
+
+  if(!filesystem::append(journal_path, record))
+    return false;
+  verified_end += record.size();
+  return true;
+}
+
+template<class Map>
+std::size_t collect_modified_entries(Map &current, Map &modified) {
+  auto keys = current.take_modified_keys();
+  auto& modified_entries = modified.get_entries();
+  for(const auto& key : keys) {
+    auto it = current.find(key);
+    if(it != current.end())
+      modified_entries[key] = it->second;
+  }
+  return keys.size();
+}
+
+// Marks the entries again as modified, so that they are
+// retried at the next sync.
+template<class Map>
+void remark_modified_entries(Map &current, const Map &modified) {
+  for(const auto& entry : modified)
+    current[entry.first];
+}
+
 template <class T>
 void print_key_value_pair(std::ostream &ostr, const std::string &key,
                           const T &val, int indentation_level) {
@@ -65,7 +248,37 @@ void kernel_entry::dump(std::ostream& ostr, int indentation_level) const {
 }
 
 void binary_entry::dump(std::ostream& ostr, int indentation_level) const {
-  print_key_value_pair(ostr, "jit_cache_filename", jit_cache_filename,
+  print_key_value_pair(ostr, "last_used_run", last_used_run,
+                       indentation_level);
+}
+
+void memcpy_entry::dump(std::ostream& ostr, int indentation_level) const {
+  print_key_value_pair(ostr, "latency", latency, indentation_level);
+  print_key_value_pair(ostr, "bandwidth", bandwidth, indentation_level);
+}
+
+void tuning_candidate::dump(std::ostream& ostr, int indentation_level) const {
+  print_key_value_pair(ostr, "group_size_x", group_size_x, indentation_level);
+  print_key_value_pair(ostr, "group_size_y", group_size_y, indentation_level);
+  print_key_value_pair(ostr, "group_size_z", group_size_z, indentation_level);
+  print_key_value_pair(ostr, "coarsening_factor", coarsening_factor,
+                       indentation_level);
+  print_key_value_pair(ostr, "fiber_barriers", fiber_barriers,
+                       indentation_level);
+  print_key_value_pair(ostr, "best_time", best_time, indentation_level);
+  print_key_value_pair(ostr, "num_samples", num_samples, indentation_level);
+}
+
+void kernel_tuning_entry::dump(std::ostream& ostr, int indentation_level) const {
+  print_array(ostr, "candidates", candidates, "tuning-candidate",
+              indentation_level);
+  print_key_value_pair(ostr, "coarsening_candidates_added",
+                       coarsening_candidates_added, indentation_level);
+  print_key_value_pair(ostr, "uses_barriers", uses_barriers, indentation_level);
+  print_key_value_pair(ostr, "barrier_candidates_added",
+                       barrier_candidates_added, indentation_level);
+  print_key_value_pair(ostr, "is_tuned", is_tuned, indentation_level);
+  print_key_value_pair(ostr, "selected_candidate", selected_candidate,
                        indentation_level);
 }
 
@@ -94,38 +307,144 @@ void appdb_data::dump(std::ostream& ostr, int indentation_level) const {
     print_key_value_pair(ostr, binary_name, "<binary-entry>", indentation_level+1);
     entry.second.dump(ostr, indentation_level+2);
   }
-}
 
-appdb::appdb(const std::string& db_path) 
-: _db_path{db_path}, _lock{0}, _was_modified{false} {
+  print_key_value_pair(ostr, "memcpy_models", "<map>", indentation_level);
 
-  if(filesystem::exists(db_path)) {
-    std::ifstream file{_db_path, std::ios::in | std::ios::binary | std::ios::ate};
-    if (!file.is_open())
-      return;
-    std::streamsize file_size = file.tellg();
-    
-    file.seekg(0, std::ios::beg);
+  for(const auto& entry : memcpy_models) {
+    print_key_value_pair(ostr, entry.first, "<memcpy-entry>", indentation_level+1);
+    entry.second.dump(ostr, indentation_level+2);
+  }
 
-    std::vector<uint8_t> file_content;
-    file_content.resize(file_size);
-    file.read(reinterpret_cast<char *>(file_content.data()), file_size);
+  print_key_value_pair(ostr, "kernel_tunings", "<map>", indentation_level);
 
-    _data = msgpack::unpack<appdb_data>(file_content);
+  for(const auto& entry : kernel_tunings) {
+    std::string tuning_name = get_id_string(entry.first);
+    print_key_value_pair(ostr, tuning_name, "<tuning-entry>", indentation_level+1);
+    entry.second.dump(ostr, indentation_level+2);
   }
 }
 
+appdb::appdb(const std::string& db_path)
+: _lock{0}, _was_modified{false}, _db_path{db_path},
+  _journal_path{db_path + ".journal"}, _lock_path{db_path + ".lock"},
+  _last_sync_time{get_time_now()} {}
+
 appdb::~appdb() {
-  if(_was_modified) {
-    ++_data.content_version;
+  sync();
+}
+
+void appdb::ensure_loaded() const {
+  std::call_once(_load_flag, [this]() {
+    // Loading initializes the data, which cannot be modified
+    // by anyone else at this point.
+    const_cast<appdb *>(this)->load();
+  });
+}
 
-    auto data = msgpack::pack(_data);
-    std::string data_string;
-    data_string.resize(data.size());
-    std::memcpy(data_string.data(), data.data(), data.size());
+void appdb::load() {
+  if(!filesystem::exists(_db_path) && !filesystem::exists(_journal_path))
+    return;
 
-    common::filesystem::atomic_write(_db_path, data_string);
+  std::size_t journal_end = 0;
+  {
+    filesystem::file_lock lock{_lock_path, false};
+    journal_end = read_database(_db_path, _journal_path, _data);
   }
+
+  std::lock_guard<std::mutex> sync_lock{_sync_mutex};
+  _persisted_content_version = _data.content_version;
+  _verified_journal_size = journal_end;
 }
 
-}
\ No newline at end of file
+void appdb::sync() {
+  if(!_was_modified.exchange(false))
+    return;
+
+  ensure_loaded();
+
+  std::lock_guard<std::mutex> sync_lock{_sync_mutex};
+  _last_sync_time = get_time_now();
+
+  appdb_data modified;
+  std::size_t num_modified = 0;
+  {
+    // Taking the modified keys resets the tracking state
+    write_lock lock{_lock};
+    num_modified += collect_modified_entries(_data.kernels, modified.kernels);
+    num_modified +=
+        collect_modified_entries(_data.binaries, modified.binaries);
+    num_modified +=
+        collect_modified_entries(_data.memcpy_models, modified.memcpy_models);
+    num_modified +=
+        collect_modified_entries(_data.kernel_tunings, modified.kernel_tunings);
+    // The in-memory content version identifies the current
+    // application run while it is executing, so only the
+    // persisted version is incremented.
+    modified.content_version = _data.content_version + 1;
+  }
+
+  if(num_modified == 0 &&
+     modified.content_version == _persisted_content_version)
+    return;
+  _persisted_content_version = modified.content_version;
+
+  {
+    filesystem::file_lock lock{_lock_path, true};
+    // Otherwise, the record would be appended behind the torn one
+    // and readers would have to skip over it forever.
+    if(!truncate_torn_journal_tail(_journal_path, _verified_journal_size) ||
+       !append_journal_record(_journal_path, msgpack::pack(modified),
+                              _verified_journal_size)) {
+      // Retry with the same entries at the next sync
+      {
+        write_lock lock{_lock};
+        remark_modified_entries(_data.kernels, modified.kernels);
+        remark_modified_entries(_data.binaries, modified.binaries);
+        remark_modified_entries(_data.memcpy_models, modified.memcpy_models);
+        remark_modified_entries(_data.kernel_tunings, modified.kernel_tunings);
+      }
+      _persisted_content_version = 0;
+      _was_modified = true;
+      return;
+    }
+  }
+
+  std::size_t journal_size = filesystem::file_size(_journal_path);
+  if (journal_size > min_compaction_journal_size &&
+      journal_size > filesystem::file_size(_db_path))
+    compact();
+}
+
+void appdb::sync_if_due() {
+  if(_was_modified &&
+     get_time_now() - _last_sync_time.load() > sync_interval_ns)
+    sync();
+}
+
+void appdb::compact() {
+  // Other processes may have appended records, so the snapshot
+  // needs to be rebuilt from what is on disk, not just from our data.
+  filesystem::file_lock lock{_lock_path, true};
+
+  appdb_data merged;
+  _verified_journal_size = read_database(_db_path, _journal_path, merged);
+
+  auto data = msgpack::pack(merged);
+  std::string_view data_string{reinterpret_cast<const char *>(data.data()),
+                               data.size()};
+
+  if(filesystem::atomic_write(_db_path, data_string)) {
+    // If we are killed before truncating, the journal records
+    // are applied again on top of the new snapshot, which is harmless.
+    if(filesystem::truncate(_journal_path, 0))
+      _verified_journal_size = 0;
+  }
+}
+
+void appdb::remove(const std::string& db_path) {
+  filesystem::remove(db_path);
+  filesystem::remove(db_path + ".journal");
+  filesystem::remove(db_path + ".lock");
+}
+
+}
@@ -16,6 +16,8 @@
 
 #include "hipSYCL/runtime/settings.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <memory>
 #include <random>
@@ -23,7 +25,11 @@
 
 #ifndef _WIN32
 #include <dlfcn.h>
+#include <fcntl.h>
 #include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <pwd.h>
 #include <limits.h>
@@ -51,6 +57,22 @@ inline T random_number() {
   return distribution(gen);
 }
 
+#ifndef _WIN32
+file_status make_file_status(const struct stat& st) {
+  file_status status;
+  status.size = static_cast<std::size_t>(st.st_size);
+  status.inode = static_cast<uint64_t>(st.st_ino);
+#ifdef __APPLE__
+  const struct timespec& mtime = st.st_mtimespec;
+#else
+  const struct timespec& mtime = st.st_mtim;
+#endif
+  status.modification_time =
+      static_cast<int64_t>(mtime.tv_sec) * 1000000000 + mtime.tv_nsec;
+  return status;
+}
+#endif
+
 }
 
 std::string get_install_directory() {
@@ -127,23 +149,103 @@ std::string absolute(const std::string& path) {
   return fs::absolute(path).string();
 }
 
-bool atomic_write(const std::string &filename, const std::string &data) {
+bool atomic_write(const std::string &filename, std::string_view data) {
   fs::path p{filename};
 
   std::string temp_file = std::to_string(random_number<std::size_t>())+".tmp";
   fs::path tmp_path = p.parent_path() / temp_file;
 
-  std::ofstream ostr{tmp_path, std::ios::binary|std::ios::out|std::ios::trunc};
-  
+  {
+    std::ofstream ostr{tmp_path,
+                       std::ios::binary | std::ios::out | std::ios::trunc};
+
+    if(!ostr.is_open())
+      return false;
+
+    ostr.write(data.data(), data.size());
+  }
+#ifndef _WIN32
+  // Callers may discard other copies of the data once this returns,
+  // so it needs to be on disk before it replaces the file.
+  int fd = open(tmp_path.c_str(), O_RDONLY);
+  if(fd >= 0) {
+    fsync(fd);
+    close(fd);
+  }
+#endif
+
+  fs::rename(tmp_path, p);
+
+  return true;
+}
+
+bool append(const std::string &filename, std::string_view data) {
+#ifndef _WIN32
+  int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+  if(fd < 0)
+    return false;
+
+  std::size_t written = 0;
+  while(written < data.size()) {
+    ssize_t result = write(fd, data.data() + written, data.size() - written);
+    if(result < 0) {
+      close(fd);
+      return false;
+    }
+    written += static_cast<std::size_t>(result);
+  }
+  // Make sure that the data has reached the disk before
+  // anyone relies on it, e.g. by compacting the file.
+  bool success = fsync(fd) == 0;
+  return close(fd) == 0 && success;
+#else
+  std::ofstream ostr{filename,
+                     std::ios::binary | std::ios::out | std::ios::app};
   if(!ostr.is_open())
     return false;
-  
+
   ostr.write(data.data(), data.size());
   ostr.close();
+  return ostr.good();
+#endif
+}
 
-  fs::rename(tmp_path, p);
+bool truncate(const std::string &filename, std::size_t size) {
+  std::error_code ec;
+  fs::resize_file(filename, size, ec);
+  return !ec;
+}
 
-  return true;
+std::size_t file_size(const std::string& filename) {
+  std::error_code ec;
+  auto size = fs::file_size(filename, ec);
+  if(ec)
+    return 0;
+  return static_cast<std::size_t>(size);
+}
+
+file_status get_file_status(const std::string& filename) {
+#ifndef _WIN32
+  struct stat st;
+  if(stat(filename.c_str(), &st) != 0)
+    return file_status{};
+  return make_file_status(st);
+#else
+  std::error_code ec;
+  file_status status;
+  auto size = fs::file_size(filename, ec);
+  if(ec)
+    return file_status{};
+  auto mtime = fs::last_write_time(filename, ec);
+  if(ec)
+    return file_status{};
+  status.size = static_cast<std::size_t>(size);
+  status.modification_time =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          mtime.time_since_epoch())
+          .count();
+  return status;
+#endif
 }
 
 bool remove(const std::string &filename) {
@@ -153,6 +255,74 @@ bool remove(const std::string &filename) {
   return false;
 }
 
+mapped_file::mapped_file(const std::string& path) {
+#ifndef _WIN32
+  int fd = open(path.c_str(), O_RDONLY);
+  if(fd < 0)
+    return;
+  struct stat st;
+  if(fstat(fd, &st) == 0)
+    _status = make_file_status(st);
+  if(_status.size > 0) {
+    void* ptr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(ptr != MAP_FAILED) {
+      _data = static_cast<const uint8_t*>(ptr);
+      _size = st.st_size;
+    }
+  }
+  close(fd);
+#else
+  std::ifstream file{path, std::ios::in | std::ios::binary | std::ios::ate};
+  if (!file.is_open())
+    return;
+  std::streamsize size = file.tellg();
+  file.seekg(0, std::ios::beg);
+  _content.resize(size);
+  file.read(reinterpret_cast<char *>(_content.data()), size);
+  _data = _content.data();
+  _size = _content.size();
+  _status = get_file_status(path);
+  _status.size = _size;
+#endif
+}
+
+mapped_file::~mapped_file() {
+#ifndef _WIN32
+  if(_data)
+    munmap(const_cast<uint8_t*>(_data), _size);
+#endif
+}
+
+void mapped_file::prefetch(std::size_t offset, std::size_t size) const {
+#ifndef _WIN32
+  if(!_data || offset >= _size)
+    return;
+  size = std::min(size, _size - offset);
+  // madvise() requires page-aligned addresses
+  std::size_t page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  std::size_t begin = offset / page_size * page_size;
+  madvise(const_cast<uint8_t *>(_data) + begin, offset + size - begin,
+          MADV_WILLNEED);
+#endif
+}
+
+file_lock::file_lock(const std::string& path, bool exclusive) {
+#ifndef _WIN32
+  _fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+  if(_fd >= 0)
+    flock(_fd, exclusive ? LOCK_EX : LOCK_SH);
+#endif
+}
+
+file_lock::~file_lock() {
+#ifndef _WIN32
+  if(_fd >= 0) {
+    flock(_fd, LOCK_UN);
+    close(_fd);
+  }
+#endif
+}
+
 persistent_storage::persistent_storage() {
 #ifndef _WIN32
 
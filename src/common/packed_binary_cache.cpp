@@ -0,0 +1,262 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/common/packed_binary_cache.hpp"
+#include "hipSYCL/common/stable_running_hash.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <random>
+
+namespace hipsycl {
+namespace common {
+
+namespace {
+
+constexpr uint32_t file_magic = 0x42504341;   // "ACPB"
+constexpr uint32_t record_magic = 0x52504341; // "ACPR"
+constexpr uint32_t file_format_version = 1;
+
+struct file_header {
+  uint32_t magic;
+  uint32_t version;
+  // Changes whenever the file is rewritten
+  uint64_t generation;
+};
+
+struct record_header {
+  uint32_t magic;
+  uint32_t reserved;
+  packed_binary_cache::id_type id;
+  uint64_t size;
+  uint64_t hash;
+};
+
+// Records are padded to keep headers aligned
+constexpr std::size_t record_alignment = 8;
+
+std::size_t get_record_size(std::size_t binary_size) {
+  // One additional byte for the null terminator
+  std::size_t size = sizeof(record_header) + binary_size + 1;
+  return (size + record_alignment - 1) / record_alignment * record_alignment;
+}
+
+uint64_t hash_binary(std::string_view binary) {
+  stable_running_hash h;
+  h(binary.data(), binary.size());
+  return h.get_current_hash();
+}
+
+uint64_t generate_generation() {
+  std::random_device rd;
+  uint64_t t = std::chrono::high_resolution_clock::now()
+                   .time_since_epoch()
+                   .count();
+  return (static_cast<uint64_t>(rd()) << 32) ^ rd() ^ t;
+}
+
+std::string make_file_header() {
+  file_header header;
+  header.magic = file_magic;
+  header.version = file_format_version;
+  header.generation = generate_generation();
+
+  std::string result(sizeof(header), '\0');
+  std::memcpy(result.data(), &header, sizeof(header));
+  return result;
+}
+
+void append_record(std::string &out, const packed_binary_cache::id_type &id,
+                   std::string_view binary) {
+  record_header header;
+  header.magic = record_magic;
+  header.reserved = 0;
+  header.id = id;
+  header.size = binary.size();
+  header.hash = hash_binary(binary);
+
+  std::size_t offset = out.size();
+  out.resize(offset + get_record_size(binary.size()), '\0');
+  std::memcpy(out.data() + offset, &header, sizeof(header));
+  std::memcpy(out.data() + offset + sizeof(header), binary.data(),
+              binary.size());
+}
+
+}
+
+packed_binary_cache::packed_binary_cache(const std::string& path)
+: _path{path}, _lock_path{path + ".lock"} {}
+
+bool packed_binary_cache::lookup(const id_type& id, binary& out) {
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  auto it = _index.find(id);
+  if(it == _index.end()) {
+    // Another process might have added the binary in the meantime
+    refresh();
+    it = _index.find(id);
+    if(it == _index.end())
+      return false;
+  }
+
+  entry& e = it->second;
+  std::string_view data = get_binary(e);
+  if(!e.is_verified) {
+    record_header header;
+    std::memcpy(&header, _mapping->data() + e.offset - sizeof(record_header),
+                sizeof(header));
+    if(hash_binary(data) != header.hash) {
+      _index.erase(it);
+      return false;
+    }
+    e.is_verified = true;
+  }
+
+  out.data = data;
+  out.mapping = _mapping;
+  return true;
+}
+
+bool packed_binary_cache::store(const id_type& id, std::string_view binary) {
+  std::string record;
+  append_record(record, id, binary);
+
+  filesystem::file_lock file_lock{_lock_path, true};
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  refresh();
+  std::size_t file_size = filesystem::file_size(_path);
+
+  bool success = false;
+  if(file_size == 0) {
+    success = filesystem::atomic_write(_path, make_file_header() + record);
+  } else if(file_size != _indexed_size) {
+    // The file ends with a record that was not written completely, so
+    // we cannot append to it. Start a new file with all intact records.
+    std::string content = make_file_header();
+    for(const auto& e : _index) {
+      if(e.first != id)
+        append_record(content, e.first, get_binary(e.second));
+    }
+    success = filesystem::atomic_write(_path, content + record);
+  } else {
+    success = filesystem::append(_path, record);
+  }
+
+  // The new record is indexed by the next refresh, i.e. when
+  // it is first looked up.
+  return success;
+}
+
+void packed_binary_cache::prefetch(const id_type& id) {
+  std::lock_guard<std::mutex> lock{_mutex};
+  if(!_mapping)
+    refresh();
+
+  auto it = _index.find(id);
+  if(it != _index.end())
+    _mapping->prefetch(it->second.offset, it->second.size);
+}
+
+std::size_t packed_binary_cache::get_size() const {
+  return filesystem::file_size(_path);
+}
+
+void packed_binary_cache::shrink(
+    std::size_t max_size,
+    const std::function<uint64_t(const id_type &)> &get_priority) {
+
+  filesystem::file_lock file_lock{_lock_path, true};
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  refresh();
+  if(filesystem::file_size(_path) <= max_size)
+    return;
+
+  std::vector<std::pair<uint64_t, const std::pair<id_type, entry>*>> entries;
+  for(const auto& e : _index)
+    entries.push_back(std::make_pair(get_priority(e.first), &e));
+  std::stable_sort(entries.begin(), entries.end(),
+                   [](const auto &a, const auto &b) { return a.first > b.first; });
+
+  std::string content = make_file_header();
+  for(const auto& e : entries) {
+    const entry& binary = e.second->second;
+    if(content.size() + get_record_size(binary.size) > max_size)
+      continue;
+    append_record(content, e.second->first, get_binary(binary));
+  }
+
+  filesystem::atomic_write(_path, content);
+  refresh();
+}
+
+void packed_binary_cache::remove(const std::string& path) {
+  filesystem::remove(path);
+  filesystem::remove(path + ".lock");
+}
+
+std::string_view packed_binary_cache::get_binary(const entry& e) const {
+  return std::string_view{
+      reinterpret_cast<const char *>(_mapping->data()) + e.offset, e.size};
+}
+
+void packed_binary_cache::refresh() {
+  filesystem::file_status status = filesystem::get_file_status(_path);
+  if(status.size < sizeof(file_header)) {
+    _index.clear();
+    _indexed_size = 0;
+    _mapping = nullptr;
+    return;
+  }
+  // A file of the same size can still have been replaced or rewritten,
+  // which changes its inode or modification time.
+  if(_mapping && _mapping->get_status() == status)
+    return;
+
+  auto mapping = std::make_shared<const filesystem::mapped_file>(_path);
+  if(mapping->size() < sizeof(file_header))
+    return;
+
+  file_header header;
+  std::memcpy(&header, mapping->data(), sizeof(header));
+  if(header.magic != file_magic || header.version != file_format_version)
+    return;
+
+  if(header.generation != _generation || _indexed_size == 0) {
+    // The file has been replaced, so all records need to be indexed again
+    _index.clear();
+    _generation = header.generation;
+    _indexed_size = sizeof(file_header);
+  }
+
+  const std::size_t size = mapping->size();
+  std::size_t offset = _indexed_size;
+  while(offset + sizeof(record_header) <= size) {
+    record_header record;
+    std::memcpy(&record, mapping->data() + offset, sizeof(record));
+    if(record.magic != record_magic ||
+       record.size > size - offset - sizeof(record_header) ||
+       offset + get_record_size(record.size) > size)
+      break;
+
+    // If a binary has been stored multiple times, the last record wins
+    _index[record.id] =
+        entry{offset + sizeof(record_header), record.size, false};
+    offset += get_record_size(record.size);
+  }
+  _indexed_size = offset;
+  // The new mapping covers all records of the previous one
+  _mapping = std::move(mapping);
+}
+
+}
+}
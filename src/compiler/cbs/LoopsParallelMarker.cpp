@@ -12,6 +12,7 @@
 
 #include "hipSYCL/compiler/cbs/IRUtils.hpp"
 #include "hipSYCL/compiler/cbs/SplitterAnnotationAnalysis.hpp"
+#include "hipSYCL/compiler/cbs/VectorizedSubGroups.hpp"
 
 #include "hipSYCL/common/debug.hpp"
 
@@ -69,8 +70,18 @@ void addVectorizationHints(const llvm::Function &F, const llvm::TargetTransformI
     PostTransformMD.push_back(MDVectorize);
   }
 
-  // enable scalable vectorization
-  if (TTI.supportsScalableVectors()) {
+  // the work-item loops of vectorized sub-groups iterate over the lanes of a single sub-group
+  if (const int SubGroupSize = getVectorizedSubGroupSize(F); SubGroupSize > 0) {
+    if (!llvm::findOptionMDForLoop(L, "llvm.loop.vectorize.width")) {
+      auto *MDWidth = llvm::MDNode::get(
+          F.getContext(),
+          {llvm::MDString::get(F.getContext(), "llvm.loop.vectorize.width"),
+           llvm::ConstantAsMetadata::get(llvm::ConstantInt::get(
+               llvm::IntegerType::get(F.getContext(), 32), SubGroupSize))});
+      PostTransformMD.push_back(MDWidth);
+    }
+  } else if (TTI.supportsScalableVectors()) {
+    // enable scalable vectorization
     if (!llvm::findOptionMDForLoop(L, "llvm.loop.vectorize.scalable.enable")) {
       auto *MDVectorize = llvm::MDNode::get(
           F.getContext(),
@@ -21,6 +21,7 @@
 #include "hipSYCL/compiler/cbs/SimplifyKernel.hpp"
 #include "hipSYCL/compiler/cbs/SplitterAnnotationAnalysis.hpp"
 #include "hipSYCL/compiler/cbs/SubCfgFormation.hpp"
+#include "hipSYCL/compiler/cbs/VectorizedSubGroups.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/host/HostKernelWrapperPass.hpp"
 
 #include <llvm/IR/LegacyPassManager.h>
@@ -58,10 +59,13 @@ void registerCBSPipelineLegacy(llvm::legacy::PassManagerBase &PM) {
 #define IS_ROCM_CLANG_VERSION_5_5_0
 #endif
 
-void registerCBSPipeline(llvm::ModulePassManager &MPM, OptLevel Opt, bool IsSscp) {
+void registerCBSPipeline(llvm::ModulePassManager &MPM, OptLevel Opt, bool IsSscp,
+                         int SubGroupSize) {
   MPM.addPass(SplitterAnnotationAnalysisCacher{});
 
   llvm::FunctionPassManager FPM;
+  if (IsSscp && SubGroupSize > 1)
+    FPM.addPass(VectorizedSubGroupPreparationPass{SubGroupSize});
   FPM.addPass(LoopSplitterInliningPass{});
 
   if (Opt != OptLevel::O0) {
@@ -89,6 +93,8 @@ void registerCBSPipeline(llvm::ModulePassManager &MPM, OptLevel Opt, bool IsSscp
 #endif
   FPM.addPass(llvm::LoopSimplifyPass{});
 
+  if (IsSscp && SubGroupSize > 1)
+    FPM.addPass(VectorizedSubGroupLoweringPass{});
   FPM.addPass(CanonicalizeBarriersPass{});
   if (IsSscp)
     FPM.addPass(KernelFlatteningPass{});
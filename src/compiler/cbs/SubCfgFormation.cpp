@@ -13,6 +13,7 @@
 #include "hipSYCL/compiler/cbs/IRUtils.hpp"
 #include "hipSYCL/compiler/cbs/SplitterAnnotationAnalysis.hpp"
 #include "hipSYCL/compiler/cbs/UniformityAnalysis.hpp"
+#include "hipSYCL/compiler/cbs/VectorizedSubGroups.hpp"
 
 #include "hipSYCL/compiler/utils/LLVMUtils.hpp"
 
@@ -91,6 +92,9 @@ llvm::LoadInst *mergeGVLoadsInEntry(llvm::Function &F, llvm::StringRef VarName)
   return Load;
 }
 
+} // namespace
+
+namespace hipsycl::compiler {
 // parses the range dimensionality from the mangled kernel name
 std::size_t getRangeDim(llvm::Function &F) {
   auto FName = F.getName();
@@ -119,6 +123,9 @@ std::size_t getRangeDim(llvm::Function &F) {
   }
   llvm_unreachable("[SubCFG] Could not deduce kernel dimensionality!");
 }
+} // namespace hipsycl::compiler
+
+namespace {
 
 // searches for llvm.var.annotation and returns the value that is annotated by it, as well the
 // annotation instruction
@@ -212,6 +219,12 @@ void loadSizeValuesFromArgument(llvm::Function &F, int Dim, llvm::Value *LocalSi
 // get the wg size values for the loop bounds
 llvm::SmallVector<llvm::Value *, 3> getLocalSizeValues(llvm::Function &F, int Dim,
                                                        bool isSscpKernel) {
+  // the work-item loops of vectorized sub-groups iterate over the lanes of a single sub-group
+  if (isSscpKernel && getVectorizedSubGroupSize(F) > 0) {
+    auto Load = getLoadForGlobalVariable(F, SubGroupSizeGlobalName);
+    Load->moveBefore(F.getEntryBlock().getTerminator());
+    return {Load};
+  }
   if (isSscpKernel) {
     llvm::SmallVector<llvm::Value *, 3> LocalSize(Dim);
     for (int I = 0; I < Dim; ++I) {
@@ -1145,6 +1158,8 @@ void arrayifyAllocas(llvm::BasicBlock *EntryBlock, llvm::DominatorTree &DT,
     if (auto *Alloca = llvm::dyn_cast<llvm::AllocaInst>(&I)) {
       if (Alloca->hasMetadata(hipsycl::compiler::MDKind::Arrayified))
         continue; // already arrayified
+      if (Alloca->hasMetadata(hipsycl::compiler::MDKind::SubGroupShared))
+        continue; // shared by the lanes of a sub-group
       if (utils::anyOfUsers<llvm::Instruction>(Alloca, [&SubCfgsBlocks](llvm::Instruction *UI) {
             return !SubCfgsBlocks.contains(UI->getParent());
           }))
@@ -1215,7 +1230,8 @@ void formSubCfgs(llvm::Function &F, llvm::LoopInfo &LI, llvm::DominatorTree &DT,
                  llvm::PostDominatorTree &PDT, const SplitterAnnotationInfo &SAA, bool IsSscp) {
   HIPSYCL_DEBUG_EXECUTE_VERBOSE(F.viewCFG();)
 
-  const std::size_t Dim = getRangeDim(F);
+  const int SubGroupSize = IsSscp ? getVectorizedSubGroupSize(F) : 0;
+  const std::size_t Dim = SubGroupSize > 0 ? 1 : getRangeDim(F);
   HIPSYCL_DEBUG_INFO << "[SubCFG] Kernel is " << Dim << "-dimensional\n";
 
   const auto LocalSize = getLocalSizeValues(F, Dim, IsSscp);
@@ -1226,6 +1242,9 @@ void formSubCfgs(llvm::Function &F, llvm::LoopInfo &LI, llvm::DominatorTree &DT,
   llvm::Value *ReqdArrayElements = LocalSize[0];
   for (size_t D = 1; D < LocalSize.size(); ++D)
     ReqdArrayElements = Builder.CreateMul(ReqdArrayElements, LocalSize[D]);
+  // the loop state of a sub-group fits into a fixed-size array
+  if (SubGroupSize > 0)
+    ReqdArrayElements = llvm::ConstantInt::get(LocalSize[0]->getType(), SubGroupSize);
 
   std::vector<llvm::BasicBlock *> Blocks;
   Blocks.reserve(std::distance(F.begin(), F.end()));
@@ -1344,7 +1363,7 @@ void createLoopsAroundKernel(llvm::Function &F, llvm::DominatorTree &DT, llvm::L
 
   moveAllocasToEntry(F, Blocks);
 
-  const auto Dim = getRangeDim(F);
+  const auto Dim = IsSscp && getVectorizedSubGroupSize(F) > 0 ? 1 : getRangeDim(F);
 
   // insert dummy induction variable that can be easily identified and replaced later
   llvm::IRBuilder Builder{F.getEntryBlock().getTerminator()};
@@ -1426,6 +1445,9 @@ llvm::PreservedAnalyses SubCfgFormationPass::run(llvm::Function &F,
   else
     createLoopsAroundKernel(F, DT, LI, PDT, IsSscp_);
 
+  if (IsSscp_ && getVectorizedSubGroupSize(F) > 0)
+    hoistSubGroupUniformValues(F);
+
   llvm::PreservedAnalyses PA;
   PA.preserve<SplitterAnnotationAnalysis>();
   return PA;
@@ -0,0 +1,766 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/compiler/cbs/VectorizedSubGroups.hpp"
+
+#include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/compiler/cbs/IRUtils.hpp"
+#include "hipSYCL/compiler/cbs/SplitterAnnotationAnalysis.hpp"
+#include "hipSYCL/compiler/cbs/SubCfgFormation.hpp"
+#include "hipSYCL/compiler/utils/LLVMUtils.hpp"
+
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/ADT/StringSwitch.h>
+#include <llvm/Analysis/LoopInfo.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Dominators.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/Intrinsics.h>
+#include <llvm/IR/Module.h>
+
+namespace {
+using namespace hipsycl::compiler;
+using namespace hipsycl::compiler::cbs;
+
+constexpr llvm::StringRef PassPrefix = "[VectorizedSubGroups]";
+constexpr llvm::StringRef SscpBuiltinPrefix = "__acpp_sscp_";
+constexpr llvm::StringRef LoweredBuiltinPrefix = "__acpp_cbs_";
+
+// same values as __acpp_sscp_algorithm_op
+enum class AlgorithmOp : uint64_t {
+  Plus,
+  Multiply,
+  Min,
+  Max,
+  BitAnd,
+  BitOr,
+  BitXor,
+  LogicalAnd,
+  LogicalOr
+};
+
+enum class SubGroupBuiltin {
+  LocalId,
+  Size,
+  MaxSize,
+  Id,
+  NumSubGroups,
+  Barrier,
+  Reduce,
+  InclusiveScan,
+  ExclusiveScan,
+  Broadcast,
+  Select,
+  Permute,
+  ShiftLeft,
+  ShiftRight,
+  Any,
+  All,
+  None,
+  Unsupported
+};
+
+struct BuiltinInfo {
+  SubGroupBuiltin Kind = SubGroupBuiltin::Unsupported;
+  // type suffix of typed builtins, e.g. 'u' for __acpp_sscp_sub_group_reduce_u32
+  char TypeClass = 0;
+};
+
+bool isSubGroupBuiltin(llvm::StringRef Name) {
+  return hipsycl::llvmutils::starts_with(Name, "__acpp_sscp_sub_group_") ||
+         hipsycl::llvmutils::starts_with(Name, "__acpp_sscp_get_subgroup_") ||
+         Name == "__acpp_sscp_get_num_subgroups";
+}
+
+// parses both the original and the redirected builtin names
+BuiltinInfo parseBuiltin(llvm::StringRef Name) {
+  BuiltinInfo Info;
+  if (!Name.consume_front(SscpBuiltinPrefix) && !Name.consume_front(LoweredBuiltinPrefix))
+    return Info;
+
+  Info.Kind = llvm::StringSwitch<SubGroupBuiltin>(Name)
+                  .Case("get_subgroup_local_id", SubGroupBuiltin::LocalId)
+                  .Case("get_subgroup_size", SubGroupBuiltin::Size)
+                  .Case("get_subgroup_max_size", SubGroupBuiltin::MaxSize)
+                  .Case("get_subgroup_id", SubGroupBuiltin::Id)
+                  .Case("get_num_subgroups", SubGroupBuiltin::NumSubGroups)
+                  .Case("sub_group_barrier", SubGroupBuiltin::Barrier)
+                  .Case("sub_group_any", SubGroupBuiltin::Any)
+                  .Case("sub_group_all", SubGroupBuiltin::All)
+                  .Case("sub_group_none", SubGroupBuiltin::None)
+                  .Default(SubGroupBuiltin::Unsupported);
+  if (Info.Kind != SubGroupBuiltin::Unsupported)
+    return Info;
+
+  const auto SuffixPos = Name.rfind('_');
+  if (SuffixPos == llvm::StringRef::npos || SuffixPos + 1 == Name.size())
+    return Info;
+  Info.Kind = llvm::StringSwitch<SubGroupBuiltin>(Name.take_front(SuffixPos))
+                  .Case("sub_group_reduce", SubGroupBuiltin::Reduce)
+                  .Case("sub_group_inclusive_scan", SubGroupBuiltin::InclusiveScan)
+                  .Case("sub_group_exclusive_scan", SubGroupBuiltin::ExclusiveScan)
+                  .Case("sub_group_broadcast", SubGroupBuiltin::Broadcast)
+                  .Case("sub_group_select", SubGroupBuiltin::Select)
+                  .Case("sub_group_permute", SubGroupBuiltin::Permute)
+                  .Case("sub_group_shl", SubGroupBuiltin::ShiftLeft)
+                  .Case("sub_group_shr", SubGroupBuiltin::ShiftRight)
+                  .Default(SubGroupBuiltin::Unsupported);
+  Info.TypeClass = Name[SuffixPos + 1];
+  return Info;
+}
+
+// the operand holding the value that is exchanged between the lanes
+unsigned getValueOperandIdx(SubGroupBuiltin Kind) {
+  switch (Kind) {
+  case SubGroupBuiltin::Reduce:
+  case SubGroupBuiltin::InclusiveScan:
+  case SubGroupBuiltin::ExclusiveScan:
+  case SubGroupBuiltin::Broadcast:
+    return 1;
+  default:
+    return 0;
+  }
+}
+
+bool hasValidValueType(const llvm::CallBase &CB, const BuiltinInfo &Info) {
+  const auto Idx = getValueOperandIdx(Info.Kind);
+  if (CB.arg_size() <= Idx)
+    return false;
+  auto *T = CB.getArgOperand(Idx)->getType();
+  // f16 values are passed as structs and are not supported
+  if (Info.TypeClass == 'f')
+    return T->isFloatTy() || T->isDoubleTy();
+  return T->isIntegerTy();
+}
+
+bool isLowerable(const llvm::CallBase &CB) {
+  const auto Info = parseBuiltin(CB.getCalledFunction()->getName());
+  switch (Info.Kind) {
+  case SubGroupBuiltin::Unsupported:
+    return false;
+  case SubGroupBuiltin::Reduce:
+  case SubGroupBuiltin::InclusiveScan:
+  case SubGroupBuiltin::ExclusiveScan: {
+    if (!hasValidValueType(CB, Info))
+      return false;
+    auto *OpC = llvm::dyn_cast<llvm::ConstantInt>(CB.getArgOperand(0));
+    if (!OpC)
+      return false;
+    const auto MaxOp = Info.TypeClass == 'f' ? AlgorithmOp::Max : AlgorithmOp::LogicalOr;
+    return OpC->getZExtValue() <= static_cast<uint64_t>(MaxOp);
+  }
+  case SubGroupBuiltin::Broadcast:
+  case SubGroupBuiltin::Select:
+  case SubGroupBuiltin::Permute:
+  case SubGroupBuiltin::ShiftLeft:
+  case SubGroupBuiltin::ShiftRight:
+    return CB.arg_size() == 2 && hasValidValueType(CB, Info);
+  case SubGroupBuiltin::Any:
+  case SubGroupBuiltin::All:
+  case SubGroupBuiltin::None:
+    return CB.arg_size() == 1 && CB.getArgOperand(0)->getType()->isIntegerTy();
+  default:
+    return true;
+  }
+}
+
+// checks whether F transitively calls sub-group builtins, and whether it calls anything that
+// prevents the sub-group vectorization: work-group barriers or unknown functions
+void analyzeCallees(llvm::Function &F, const SplitterAnnotationInfo &SAA,
+                    llvm::SmallPtrSetImpl<llvm::Function *> &Visited, bool &UsesSubGroups,
+                    bool &Vectorizable) {
+  if (!Visited.insert(&F).second)
+    return;
+  for (auto &I : llvm::instructions(F))
+    if (auto *CB = llvm::dyn_cast<llvm::CallBase>(&I)) {
+      auto *Callee = CB->getCalledFunction();
+      if (!Callee || SAA.isSplitterFunc(Callee) || Callee->getName() == BarrierIntrinsicName)
+        Vectorizable = false;
+      else if (isSubGroupBuiltin(Callee->getName()))
+        UsesSubGroups = true;
+      else
+        analyzeCallees(*Callee, SAA, Visited, UsesSubGroups, Vectorizable);
+    }
+}
+
+// like the KernelFlatteningPass, but keeps the calls to the sub-group builtins
+void inlineAllButSubGroupBuiltins(llvm::Function &F) {
+  bool Changed;
+  do {
+    Changed = false;
+    for (auto &I : llvm::instructions(F))
+      if (auto *CB = llvm::dyn_cast<llvm::CallBase>(&I))
+        if (auto *Callee = CB->getCalledFunction();
+            Callee && !Callee->isDeclaration() && !isSubGroupBuiltin(Callee->getName()) &&
+            utils::checkedInlineFunction(CB, PassPrefix, HIPSYCL_DEBUG_LEVEL_INFO)) {
+          Changed = true;
+          break;
+        }
+  } while (Changed);
+}
+
+llvm::Function *getLoweredBuiltinDecl(llvm::Function &Builtin) {
+  auto *M = Builtin.getParent();
+  const auto Name =
+      (LoweredBuiltinPrefix + Builtin.getName().drop_front(SscpBuiltinPrefix.size())).str();
+  auto *Decl = llvm::cast<llvm::Function>(
+      M->getOrInsertFunction(Name, Builtin.getFunctionType()).getCallee());
+  Decl->addFnAttr(llvm::Attribute::Convergent);
+  Decl->addFnAttr(llvm::Attribute::NoUnwind);
+  return Decl;
+}
+
+// Lowers the sub-group builtins of a single kernel. Collectives are implemented as
+//   store value -> buffer[lane]; barrier; compute result; barrier
+// The sub-group barriers separate the work-item loops over the lanes, so the buffer
+// is complete once the result is computed, and it is not overwritten before all lanes
+// have computed their result. Values that are the same for all lanes are computed on
+// vectors of the whole buffer and tagged, so they can be hoisted out of the work-item
+// loop later on.
+class SubGroupLowering {
+  llvm::Function &F;
+  SplitterAnnotationInfo &SAA;
+  const unsigned SubGroupSize;
+  llvm::Type *SizeT;
+  llvm::MDNode *UniformMD;
+  llvm::MDNode *SharedMD;
+
+  llvm::Value *Lane = nullptr;
+  llvm::Value *ActiveLanes = nullptr;
+  std::array<llvm::Value *, 3> Origin{};
+  std::array<llvm::Value *, 3> LocalSize{};
+
+  using UniformBuilderT = llvm::IRBuilder<llvm::ConstantFolder, llvm::IRBuilderCallbackInserter>;
+
+  llvm::LoadInst *loadInEntry(llvm::StringRef GlobalVarName) {
+    auto *GV = F.getParent()->getOrInsertGlobal(GlobalVarName, SizeT);
+    llvm::IRBuilder<> Builder{&*F.getEntryBlock().getFirstInsertionPt()};
+    return Builder.CreateLoad(SizeT, GV, "cbs.load." + GlobalVarName);
+  }
+
+  llvm::Value *getLocalSize(int D) {
+    if (!LocalSize[D])
+      LocalSize[D] = loadInEntry(LocalSizeGlobalNames[D]);
+    return LocalSize[D];
+  }
+
+  llvm::AllocaInst *createLaneBuffer(llvm::Type *T, const llvm::Twine &Name) {
+    llvm::IRBuilder<> Builder{&*F.getEntryBlock().getFirstInsertionPt()};
+    auto *Alloca = Builder.CreateAlloca(llvm::ArrayType::get(T, SubGroupSize), nullptr, Name);
+    Alloca->setAlignment(llvm::Align{DefaultAlignment});
+    Alloca->setMetadata(MDKind::SubGroupShared, SharedMD);
+    return Alloca;
+  }
+
+  llvm::Value *createLaneGEP(llvm::IRBuilderBase &Builder, llvm::AllocaInst *Buffer,
+                             llvm::Value *Idx) {
+    return Builder.CreateInBoundsGEP(Buffer->getAllocatedType(), Buffer,
+                                     {llvm::ConstantInt::get(SizeT, 0), Idx});
+  }
+
+  llvm::Value *getVectorPtr(llvm::IRBuilderBase &Builder, llvm::AllocaInst *Buffer) {
+    auto *ElementT = Buffer->getAllocatedType()->getArrayElementType();
+    return Builder.CreatePointerCast(
+        Buffer, llvm::PointerType::get(llvm::FixedVectorType::get(ElementT, SubGroupSize),
+                                       Buffer->getType()->getPointerAddressSpace()));
+  }
+
+  llvm::Value *loadLaneVector(llvm::IRBuilderBase &Builder, llvm::AllocaInst *Buffer) {
+    auto *VecT = llvm::FixedVectorType::get(Buffer->getAllocatedType()->getArrayElementType(),
+                                            SubGroupSize);
+    return Builder.CreateAlignedLoad(VecT, getVectorPtr(Builder, Buffer),
+                                     llvm::Align{DefaultAlignment}, "sg.lanes");
+  }
+
+  // lanes beyond the end of the local range in x direction are inactive
+  llvm::Value *createActiveLaneMask(llvm::IRBuilderBase &Builder) {
+    llvm::SmallVector<llvm::Constant *, 16> LaneIds;
+    for (unsigned I = 0; I < SubGroupSize; ++I)
+      LaneIds.push_back(Builder.getInt32(I));
+    auto *NumActive =
+        Builder.CreateVectorSplat(SubGroupSize, Builder.CreateTrunc(ActiveLanes, Builder.getInt32Ty()));
+    return Builder.CreateICmpULT(llvm::ConstantVector::get(LaneIds), NumActive, "sg.active");
+  }
+
+  // tags all instructions created through it as uniform
+  llvm::IRBuilderCallbackInserter createUniformInserter() {
+    return llvm::IRBuilderCallbackInserter{
+        [this](llvm::Instruction *I) { I->setMetadata(MDKind::SubGroupUniform, UniformMD); }};
+  }
+
+  void replaceLocalIdLoads();
+
+  llvm::Value *lowerQuery(llvm::CallBase &CB, SubGroupBuiltin Kind);
+  llvm::Value *lowerCollective(llvm::CallBase &CB, const BuiltinInfo &Info);
+  llvm::Value *lowerReduce(llvm::IRBuilderBase &Builder, llvm::AllocaInst *Buffer, AlgorithmOp Op,
+                           bool IsSigned);
+  llvm::Value *lowerScan(llvm::IRBuilderBase &UniformBuilder, llvm::IRBuilderBase &Builder,
+                         llvm::AllocaInst *Buffer, AlgorithmOp Op, bool IsSigned,
+                         bool IsExclusive);
+  llvm::Value *lowerShuffle(llvm::IRBuilderBase &Builder, llvm::CallBase &CB,
+                            llvm::AllocaInst *Buffer, SubGroupBuiltin Kind);
+  llvm::Value *lowerPredicate(llvm::IRBuilderBase &Builder, llvm::AllocaInst *Buffer,
+                              SubGroupBuiltin Kind);
+
+public:
+  SubGroupLowering(llvm::Function &F, SplitterAnnotationInfo &SAA, int SubGroupSize)
+      : F(F), SAA(SAA), SubGroupSize(SubGroupSize),
+        SizeT(F.getParent()->getDataLayout().getLargestLegalIntType(F.getContext())),
+        UniformMD(llvm::MDNode::get(
+            F.getContext(), {llvm::MDString::get(F.getContext(), MDKind::SubGroupUniform)})),
+        SharedMD(llvm::MDNode::get(F.getContext(),
+                                   {llvm::MDString::get(F.getContext(), MDKind::SubGroupShared)})) {}
+
+  void run();
+};
+
+llvm::Constant *getIdentity(AlgorithmOp Op, llvm::Type *T, bool IsSigned) {
+  if (T->isFloatingPointTy()) {
+    switch (Op) {
+    case AlgorithmOp::Plus:
+      return llvm::ConstantFP::getNegativeZero(T);
+    case AlgorithmOp::Multiply:
+      return llvm::ConstantFP::get(T, 1.0);
+    case AlgorithmOp::Min:
+      return llvm::ConstantFP::getInfinity(T, false);
+    default:
+      return llvm::ConstantFP::getInfinity(T, true);
+    }
+  }
+
+  const auto Bits = T->getIntegerBitWidth();
+  switch (Op) {
+  case AlgorithmOp::Multiply:
+  case AlgorithmOp::LogicalAnd:
+    return llvm::ConstantInt::get(T, 1);
+  case AlgorithmOp::Min:
+    return llvm::ConstantInt::get(T, IsSigned ? llvm::APInt::getSignedMaxValue(Bits)
+                                              : llvm::APInt::getMaxValue(Bits));
+  case AlgorithmOp::Max:
+    return llvm::ConstantInt::get(T, IsSigned ? llvm::APInt::getSignedMinValue(Bits)
+                                              : llvm::APInt::getMinValue(Bits));
+  case AlgorithmOp::BitAnd:
+    return llvm::Constant::getAllOnesValue(T);
+  default:
+    return llvm::Constant::getNullValue(T);
+  }
+}
+
+// element-wise Op for scalars and vectors
+llvm::Value *createOp(llvm::IRBuilderBase &Builder, AlgorithmOp Op, llvm::Value *LHS,
+                      llvm::Value *RHS, bool IsSigned) {
+  if (LHS->getType()->isFPOrFPVectorTy()) {
+    switch (Op) {
+    case AlgorithmOp::Plus:
+      return Builder.CreateFAdd(LHS, RHS);
+    case AlgorithmOp::Multiply:
+      return Builder.CreateFMul(LHS, RHS);
+    case AlgorithmOp::Min:
+      return Builder.CreateMinNum(LHS, RHS);
+    default:
+      return Builder.CreateMaxNum(LHS, RHS);
+    }
+  }
+
+  switch (Op) {
+  case AlgorithmOp::Plus:
+    return Builder.CreateAdd(LHS, RHS);
+  case AlgorithmOp::Multiply:
+    return Builder.CreateMul(LHS, RHS);
+  case AlgorithmOp::Min:
+    return Builder.CreateBinaryIntrinsic(IsSigned ? llvm::Intrinsic::smin : llvm::Intrinsic::umin,
+                                         LHS, RHS);
+  case AlgorithmOp::Max:
+    return Builder.CreateBinaryIntrinsic(IsSigned ? llvm::Intrinsic::smax : llvm::Intrinsic::umax,
+                                         LHS, RHS);
+  case AlgorithmOp::BitAnd:
+    return Builder.CreateAnd(LHS, RHS);
+  case AlgorithmOp::BitOr:
+    return Builder.CreateOr(LHS, RHS);
+  case AlgorithmOp::BitXor:
+    return Builder.CreateXor(LHS, RHS);
+  case AlgorithmOp::LogicalAnd:
+    return Builder.CreateZExt(
+        Builder.CreateAnd(Builder.CreateIsNotNull(LHS), Builder.CreateIsNotNull(RHS)),
+        LHS->getType());
+  default:
+    return Builder.CreateZExt(
+        Builder.CreateOr(Builder.CreateIsNotNull(LHS), Builder.CreateIsNotNull(RHS)),
+        LHS->getType());
+  }
+}
+
+// horizontal Op over all elements of Vec
+llvm::Value *createReduction(llvm::IRBuilderBase &Builder, AlgorithmOp Op, llvm::Value *Vec,
+                             bool IsSigned) {
+  auto *T = llvm::cast<llvm::VectorType>(Vec->getType())->getElementType();
+  if (T->isFloatingPointTy()) {
+    // sub-group reductions don't guarantee an order of evaluation
+    llvm::IRBuilderBase::FastMathFlagGuard Guard{Builder};
+    llvm::FastMathFlags FMF;
+    FMF.setAllowReassoc();
+    Builder.setFastMathFlags(FMF);
+    switch (Op) {
+    case AlgorithmOp::Plus:
+      return Builder.CreateFAddReduce(getIdentity(Op, T, IsSigned), Vec);
+    case AlgorithmOp::Multiply:
+      return Builder.CreateFMulReduce(getIdentity(Op, T, IsSigned), Vec);
+    case AlgorithmOp::Min:
+      return Builder.CreateFPMinReduce(Vec);
+    default:
+      return Builder.CreateFPMaxReduce(Vec);
+    }
+  }
+
+  switch (Op) {
+  case AlgorithmOp::Plus:
+    return Builder.CreateAddReduce(Vec);
+  case AlgorithmOp::Multiply:
+    return Builder.CreateMulReduce(Vec);
+  case AlgorithmOp::Min:
+    return Builder.CreateIntMinReduce(Vec, IsSigned);
+  case AlgorithmOp::Max:
+    return Builder.CreateIntMaxReduce(Vec, IsSigned);
+  case AlgorithmOp::BitAnd:
+    return Builder.CreateAndReduce(Vec);
+  case AlgorithmOp::BitOr:
+    return Builder.CreateOrReduce(Vec);
+  case AlgorithmOp::BitXor:
+    return Builder.CreateXorReduce(Vec);
+  case AlgorithmOp::LogicalAnd:
+    return Builder.CreateZExt(Builder.CreateAndReduce(Builder.CreateIsNotNull(Vec)), T);
+  default:
+    return Builder.CreateZExt(Builder.CreateOrReduce(Builder.CreateIsNotNull(Vec)), T);
+  }
+}
+
+// The work-item loops only iterate over the lanes of a sub-group. The local id in x
+// direction is the sub-group origin plus the lane, the local ids in y and z are
+// given by the sub-group origin.
+void SubGroupLowering::replaceLocalIdLoads() {
+  std::array<llvm::SmallVector<llvm::LoadInst *, 4>, 3> LocalIdLoads;
+  for (int D = 0; D < 3; ++D)
+    if (auto *GV = F.getParent()->getGlobalVariable(LocalIdGlobalNames[D]))
+      for (auto *U : GV->users())
+        if (auto *LI = llvm::dyn_cast<llvm::LoadInst>(U); LI && LI->getFunction() == &F)
+          LocalIdLoads[D].push_back(LI);
+
+  for (int D = 2; D >= 0; --D)
+    Origin[D] = loadInEntry(SubGroupOriginGlobalNames[D]);
+  ActiveLanes = loadInEntry(SubGroupSizeGlobalName);
+  Lane = loadInEntry(LocalIdGlobalNameX);
+
+  llvm::IRBuilder<> Builder{F.getEntryBlock().getTerminator()};
+  std::array<llvm::Value *, 3> LocalId{
+      Builder.CreateAdd(Origin[0], Lane, "sg.local_id_x", true, true), Origin[1], Origin[2]};
+  for (int D = 0; D < 3; ++D)
+    for (auto *LI : LocalIdLoads[D]) {
+      LI->replaceAllUsesWith(LocalId[D]);
+      LI->eraseFromParent();
+    }
+}
+
+llvm::Value *SubGroupLowering::lowerQuery(llvm::CallBase &CB, SubGroupBuiltin Kind) {
+  llvm::IRBuilder<> Builder{&CB};
+  auto *RetT = CB.getType();
+  switch (Kind) {
+  case SubGroupBuiltin::LocalId:
+    return Builder.CreateZExtOrTrunc(Lane, RetT);
+  case SubGroupBuiltin::Size:
+    return Builder.CreateZExtOrTrunc(ActiveLanes, RetT);
+  case SubGroupBuiltin::MaxSize:
+    return llvm::ConstantInt::get(RetT, SubGroupSize);
+  default:
+    break;
+  }
+
+  // each row of the work group in x direction is tiled into sub-groups
+  auto *SubGroupsPerRow =
+      Builder.CreateUDiv(Builder.CreateAdd(getLocalSize(0), llvm::ConstantInt::get(SizeT, SubGroupSize - 1)),
+                         llvm::ConstantInt::get(SizeT, SubGroupSize));
+  llvm::Value *Result = nullptr;
+  if (Kind == SubGroupBuiltin::Id) {
+    auto *Row = Builder.CreateAdd(Builder.CreateMul(Origin[2], getLocalSize(1)), Origin[1]);
+    Result = Builder.CreateAdd(Builder.CreateMul(Row, SubGroupsPerRow),
+                               Builder.CreateUDiv(Origin[0], llvm::ConstantInt::get(SizeT, SubGroupSize)));
+  } else {
+    Result = Builder.CreateMul(SubGroupsPerRow, Builder.CreateMul(getLocalSize(1), getLocalSize(2)));
+  }
+  return Builder.CreateZExtOrTrunc(Result, RetT);
+}
+
+llvm::Value *SubGroupLowering::lowerReduce(llvm::IRBuilderBase &Builder, llvm::AllocaInst *Buffer,
+                                           AlgorithmOp Op, bool IsSigned) {
+  auto *Vec = loadLaneVector(Builder, Buffer);
+  auto *T = llvm::cast<llvm::VectorType>(Vec->getType())->getElementType();
+  Vec = Builder.CreateSelect(createActiveLaneMask(Builder), Vec,
+                             Builder.CreateVectorSplat(SubGroupSize, getIdentity(Op, T, IsSigned)));
+  return createReduction(Builder, Op, Vec, IsSigned);
+}
+
+// Hillis-Steele scan on the vector of all lanes. Inactive lanes only influence
+// the results of lanes with higher ids, so they don't need to be masked.
+llvm::Value *SubGroupLowering::lowerScan(llvm::IRBuilderBase &UniformBuilder,
+                                         llvm::IRBuilderBase &Builder, llvm::AllocaInst *Buffer,
+                                         AlgorithmOp Op, bool IsSigned, bool IsExclusive) {
+  auto *Vec = loadLaneVector(UniformBuilder, Buffer);
+  auto *T = llvm::cast<llvm::VectorType>(Vec->getType())->getElementType();
+  auto *Identity = UniformBuilder.CreateVectorSplat(SubGroupSize, getIdentity(Op, T, IsSigned));
+
+  auto ShiftUp = [&](llvm::Value *V, unsigned Offset) {
+    llvm::SmallVector<int, 16> Mask;
+    for (unsigned I = 0; I < SubGroupSize; ++I)
+      Mask.push_back(I >= Offset ? I - Offset : SubGroupSize + I);
+    return UniformBuilder.CreateShuffleVector(V, Identity, Mask);
+  };
+
+  for (unsigned Offset = 1; Offset < SubGroupSize; Offset *= 2)
+    Vec = createOp(UniformBuilder, Op, Vec, ShiftUp(Vec, Offset), IsSigned);
+  if (IsExclusive)
+    Vec = ShiftUp(Vec, 1);
+
+  auto *Result = createLaneBuffer(T, "sg.scan");
+  UniformBuilder.CreateAlignedStore(Vec, getVectorPtr(UniformBuilder, Result),
+                                    llvm::Align{DefaultAlignment});
+  return Builder.CreateLoad(T, createLaneGEP(Builder, Result, Lane));
+}
+
+// the lanes read from the buffer at the source lane, or their own value if the
+// source lane is not active.
+llvm::Value *SubGroupLowering::lowerShuffle(llvm::IRBuilderBase &Builder, llvm::CallBase &CB,
+                                            llvm::AllocaInst *Buffer, SubGroupBuiltin Kind) {
+  llvm::Value *Src = nullptr;
+  switch (Kind) {
+  case SubGroupBuiltin::Broadcast:
+    Src = Builder.CreateZExt(CB.getArgOperand(0), SizeT);
+    break;
+  case SubGroupBuiltin::Select:
+    Src = Builder.CreateZExt(CB.getArgOperand(1), SizeT);
+    break;
+  case SubGroupBuiltin::Permute:
+    Src = Builder.CreateXor(Lane, Builder.CreateZExt(CB.getArgOperand(1), SizeT));
+    break;
+  case SubGroupBuiltin::ShiftLeft:
+    Src = Builder.CreateAdd(Lane, Builder.CreateZExt(CB.getArgOperand(1), SizeT));
+    break;
+  default:
+    Src = Builder.CreateSub(Lane, Builder.CreateZExt(CB.getArgOperand(1), SizeT));
+    break;
+  }
+  Src = Builder.CreateSelect(Builder.CreateICmpULT(Src, ActiveLanes), Src, Lane, "sg.src");
+  return Builder.CreateLoad(Buffer->getAllocatedType()->getArrayElementType(),
+                            createLaneGEP(Builder, Buffer, Src));
+}
+
+// any, all and none are evaluated on the ballot mask of the active lanes
+llvm::Value *SubGroupLowering::lowerPredicate(llvm::IRBuilderBase &Builder,
+                                              llvm::AllocaInst *Buffer, SubGroupBuiltin Kind) {
+  auto *BallotT = Builder.getIntNTy(SubGroupSize);
+  auto *Active = createActiveLaneMask(Builder);
+  auto *Ballot = Builder.CreateBitCast(
+      Builder.CreateAnd(Builder.CreateIsNotNull(loadLaneVector(Builder, Buffer)), Active), BallotT,
+      "sg.ballot");
+  switch (Kind) {
+  case SubGroupBuiltin::Any:
+    return Builder.CreateIsNotNull(Ballot);
+  case SubGroupBuiltin::All:
+    return Builder.CreateICmpEQ(Ballot, Builder.CreateBitCast(Active, BallotT));
+  default:
+    return Builder.CreateIsNull(Ballot);
+  }
+}
+
+llvm::Value *SubGroupLowering::lowerCollective(llvm::CallBase &CB, const BuiltinInfo &Info) {
+  llvm::IRBuilder<> Builder{&CB};
+  llvm::Value *X = CB.getArgOperand(getValueOperandIdx(Info.Kind));
+  const bool IsPredicate = Info.Kind == SubGroupBuiltin::Any || Info.Kind == SubGroupBuiltin::All ||
+                           Info.Kind == SubGroupBuiltin::None;
+  if (IsPredicate)
+    X = Builder.CreateZExt(Builder.CreateIsNotNull(X), Builder.getInt8Ty());
+
+  auto *Buffer = createLaneBuffer(X->getType(), "sg.buffer");
+  Builder.CreateStore(X, createLaneGEP(Builder, Buffer, Lane));
+  utils::createBarrier(&CB, SAA);
+
+  UniformBuilderT UniformBuilder{F.getContext(), llvm::ConstantFolder{}, createUniformInserter()};
+  UniformBuilder.SetInsertPoint(&CB);
+  const bool IsSigned = Info.TypeClass == 'i';
+  llvm::Value *Result = nullptr;
+  switch (Info.Kind) {
+  case SubGroupBuiltin::Reduce:
+  case SubGroupBuiltin::InclusiveScan:
+  case SubGroupBuiltin::ExclusiveScan: {
+    const auto Op = static_cast<AlgorithmOp>(
+        llvm::cast<llvm::ConstantInt>(CB.getArgOperand(0))->getZExtValue());
+    if (Info.Kind == SubGroupBuiltin::Reduce) {
+      Result = lowerReduce(UniformBuilder, Buffer, Op, IsSigned);
+    } else {
+      const bool IsExclusive = Info.Kind == SubGroupBuiltin::ExclusiveScan;
+      Result = lowerScan(UniformBuilder, Builder, Buffer, Op, IsSigned, IsExclusive);
+      if (IsExclusive)
+        Result = createOp(Builder, Op, CB.getArgOperand(2), Result, IsSigned);
+    }
+    break;
+  }
+  case SubGroupBuiltin::Any:
+  case SubGroupBuiltin::All:
+  case SubGroupBuiltin::None:
+    Result = Builder.CreateZExtOrTrunc(lowerPredicate(UniformBuilder, Buffer, Info.Kind),
+                                       CB.getType());
+    break;
+  default:
+    Result = lowerShuffle(Builder, CB, Buffer, Info.Kind);
+    break;
+  }
+
+  utils::createBarrier(&CB, SAA);
+  return Result;
+}
+
+void SubGroupLowering::run() {
+  replaceLocalIdLoads();
+
+  llvm::SmallVector<llvm::CallBase *, 8> Builtins;
+  for (auto &I : llvm::instructions(F))
+    if (auto *CB = llvm::dyn_cast<llvm::CallBase>(&I))
+      if (auto *Callee = CB->getCalledFunction();
+          Callee && hipsycl::llvmutils::starts_with(Callee->getName(), LoweredBuiltinPrefix) &&
+          parseBuiltin(Callee->getName()).Kind != SubGroupBuiltin::Unsupported)
+        Builtins.push_back(CB);
+
+  for (auto *CB : Builtins) {
+    HIPSYCL_DEBUG_INFO << PassPrefix << " Lowering " << CB->getCalledFunction()->getName()
+                       << " in " << F.getName() << "\n";
+    const auto Info = parseBuiltin(CB->getCalledFunction()->getName());
+    llvm::Value *Result = nullptr;
+    switch (Info.Kind) {
+    case SubGroupBuiltin::LocalId:
+    case SubGroupBuiltin::Size:
+    case SubGroupBuiltin::MaxSize:
+    case SubGroupBuiltin::Id:
+    case SubGroupBuiltin::NumSubGroups:
+      Result = lowerQuery(*CB, Info.Kind);
+      break;
+    case SubGroupBuiltin::Barrier:
+      utils::createBarrier(CB, SAA);
+      break;
+    default:
+      Result = lowerCollective(*CB, Info);
+      break;
+    }
+    if (Result)
+      CB->replaceAllUsesWith(Result);
+    CB->eraseFromParent();
+  }
+}
+
+} // namespace
+
+namespace hipsycl::compiler {
+
+int getVectorizedSubGroupSize(const llvm::Function &F) {
+  auto Attr = F.getFnAttribute(VectorizedSubGroupSizeAttr);
+  int SubGroupSize = 0;
+  if (!Attr.isStringAttribute() || Attr.getValueAsString().getAsInteger(10, SubGroupSize))
+    return 0;
+  return SubGroupSize;
+}
+
+llvm::PreservedAnalyses VectorizedSubGroupPreparationPass::run(llvm::Function &F,
+                                                               llvm::FunctionAnalysisManager &AM) {
+  auto &MAM = AM.getResult<llvm::ModuleAnalysisManagerFunctionProxy>(F);
+  auto *SAA = MAM.getCachedResult<SplitterAnnotationAnalysis>(*F.getParent());
+  if (SubGroupSize_ < 2 || !SAA || !SAA->isKernelFunc(&F) || getRangeDim(F) == 0)
+    return llvm::PreservedAnalyses::all();
+
+  bool UsesSubGroups = false;
+  bool Vectorizable = true;
+  llvm::SmallPtrSet<llvm::Function *, 16> Visited;
+  analyzeCallees(F, *SAA, Visited, UsesSubGroups, Vectorizable);
+  if (!UsesSubGroups || !Vectorizable)
+    return llvm::PreservedAnalyses::all();
+
+  inlineAllButSubGroupBuiltins(F);
+
+  llvm::PreservedAnalyses PA;
+  PA.preserve<SplitterAnnotationAnalysis>();
+
+  llvm::SmallVector<llvm::CallBase *, 8> Builtins;
+  for (auto &I : llvm::instructions(F))
+    if (auto *CB = llvm::dyn_cast<llvm::CallBase>(&I))
+      if (CB->getCalledFunction() && isSubGroupBuiltin(CB->getCalledFunction()->getName())) {
+        if (!isLowerable(*CB)) {
+          HIPSYCL_DEBUG_INFO << PassPrefix << " Unsupported sub-group builtin "
+                             << CB->getCalledFunction()->getName() << ", " << F.getName()
+                             << " keeps sub-groups of size 1\n";
+          return PA;
+        }
+        Builtins.push_back(CB);
+      }
+
+  for (auto *CB : Builtins)
+    CB->setCalledFunction(getLoweredBuiltinDecl(*CB->getCalledFunction()));
+  F.addFnAttr(VectorizedSubGroupSizeAttr, std::to_string(SubGroupSize_));
+
+  HIPSYCL_DEBUG_INFO << PassPrefix << " " << F.getName() << " uses sub-groups of size "
+                     << SubGroupSize_ << "\n";
+  return PA;
+}
+
+llvm::PreservedAnalyses VectorizedSubGroupLoweringPass::run(llvm::Function &F,
+                                                            llvm::FunctionAnalysisManager &AM) {
+  auto &MAM = AM.getResult<llvm::ModuleAnalysisManagerFunctionProxy>(F);
+  auto *SAA = MAM.getCachedResult<SplitterAnnotationAnalysis>(*F.getParent());
+  const int SubGroupSize = getVectorizedSubGroupSize(F);
+  if (!SAA || !SAA->isKernelFunc(&F) || SubGroupSize == 0)
+    return llvm::PreservedAnalyses::all();
+
+  SubGroupLowering{F, *SAA, SubGroupSize}.run();
+
+  llvm::PreservedAnalyses PA;
+  PA.preserve<SplitterAnnotationAnalysis>();
+  return PA;
+}
+
+void hoistSubGroupUniformValues(llvm::Function &F) {
+  llvm::DominatorTree DT{F};
+  llvm::LoopInfo LI{DT};
+
+  llvm::SmallVector<llvm::Instruction *, 16> UniformInsts;
+  for (auto &I : llvm::instructions(F))
+    if (I.hasMetadata(MDKind::SubGroupUniform))
+      UniformInsts.push_back(&I);
+
+  // the instructions are visited in program order, so operands that are uniform
+  // as well have already been hoisted.
+  for (auto *I : UniformInsts) {
+    auto *L = LI.getLoopFor(I->getParent());
+    while (L && !utils::isWorkItemLoop(*L))
+      L = L->getParentLoop();
+    if (!L || !L->getLoopPreheader())
+      continue;
+
+    auto *IP = L->getLoopPreheader()->getTerminator();
+    if (llvm::all_of(I->operand_values(), [&](llvm::Value *V) {
+          auto *OpI = llvm::dyn_cast<llvm::Instruction>(V);
+          return !OpI || DT.dominates(OpI, IP);
+        })) {
+      HIPSYCL_DEBUG_INFO << PassPrefix << " Hoisting " << *I << "\n";
+      I->moveBefore(IP);
+    }
+  }
+}
+
+} // namespace hipsycl::compiler
@@ -42,12 +42,16 @@
 #include <llvm/Passes/PassBuilder.h>
 #include <llvm/Support/Error.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Transforms/IPO/AlwaysInliner.h>
 #include <string>
 #include <optional>
 #include <cstdlib>
 #include <sstream>
+#include <mutex>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace hipsycl {
@@ -132,6 +136,42 @@ void enableModuleStateDumping(llvm::Module &M, const std::string &PipelineStage,
   }
 }
 
+/// Keeps the contents of bitcode files, such as the builtin libraries that
+/// are linked on every JIT invocation, resident for the lifetime of the
+/// process. This avoids re-reading them from disk, and allows loading
+/// modules lazily from the buffers, such that only the functions which
+/// are actually linked need to be parsed.
+class ResidentBitcodeFiles {
+public:
+  static ResidentBitcodeFiles& get() {
+    // Never destroyed, as lazily loaded modules may refer to the buffers
+    // until the very end.
+    static ResidentBitcodeFiles* Files = new ResidentBitcodeFiles;
+    return *Files;
+  }
+
+  // Returns nullptr if the file cannot be read.
+  const llvm::MemoryBuffer* getOrLoad(const std::string& File) {
+    std::lock_guard<std::mutex> Lock{Mutex};
+
+    auto It = Buffers.find(File);
+    if(It != Buffers.end())
+      return It->second.get();
+
+    auto Buffer = llvm::MemoryBuffer::getFile(File);
+    if(Buffer.getError())
+      return nullptr;
+
+    HIPSYCL_DEBUG_INFO << "LLVMToBackend: Loaded bitcode file " << File << "\n";
+    const llvm::MemoryBuffer* Result = Buffer->get();
+    Buffers[File] = std::move(*Buffer);
+    return Result;
+  }
+private:
+  std::mutex Mutex;
+  std::unordered_map<std::string, std::unique_ptr<llvm::MemoryBuffer>> Buffers;
+};
+
 bool linkBitcode(llvm::Module &M, std::unique_ptr<llvm::Module> OtherM,
                    const std::string &ForcedTriple = "",
                    const std::string &ForcedDataLayout = "",
@@ -539,14 +579,46 @@ bool LLVMToBackendTranslator::linkBitcodeFile(llvm::Module &M, const std::string
                                               const std::string &ForcedTriple,
                                               const std::string &ForcedDataLayout,
                                               bool LinkOnlyNeeded) {
-  auto F = llvm::MemoryBuffer::getFile(BitcodeFile);
-  if(auto Err = F.getError()) {
+  // Previous behavior of re-reading and fully parsing the file on each
+  // invocation; mainly useful to measure what resident, lazy loading saves.
+  if(getEnvironmentVariableOrDefault<bool>("EAGER_BITCODE_LINKING", false)) {
+    auto F = llvm::MemoryBuffer::getFile(BitcodeFile);
+    if(auto Err = F.getError()) {
+      this->registerError("LLVMToBackend: Could not open file " + BitcodeFile);
+      return false;
+    }
+    HIPSYCL_DEBUG_INFO << "LLVMToBackend: Linking with bitcode file: " << BitcodeFile << "\n";
+    return linkBitcodeString(M, std::string{F.get()->getBuffer()}, ForcedTriple, ForcedDataLayout,
+                             LinkOnlyNeeded);
+  }
+
+  const llvm::MemoryBuffer* Buffer = ResidentBitcodeFiles::get().getOrLoad(BitcodeFile);
+  if(!Buffer) {
     this->registerError("LLVMToBackend: Could not open file " + BitcodeFile);
     return false;
   }
   HIPSYCL_DEBUG_INFO << "LLVMToBackend: Linking with bitcode file: " << BitcodeFile << "\n";
-  return linkBitcodeString(M, std::string{F.get()->getBuffer()}, ForcedTriple, ForcedDataLayout,
-                           LinkOnlyNeeded);
+
+  // Function bodies are only materialized once the linker needs them.
+  auto OtherModule = llvm::getLazyBitcodeModule(Buffer->getMemBufferRef(), M.getContext());
+  if(auto Err = OtherModule.takeError()) {
+    this->registerError("LLVMToBackend: Could not load LLVM module from " + BitcodeFile);
+    llvm::handleAllErrors(std::move(Err), [&](llvm::ErrorInfoBase &EIB) {
+      this->registerError(EIB.message());
+    });
+    return false;
+  }
+
+  llvm::Linker::Flags F = llvm::Linker::None;
+  if(LinkOnlyNeeded)
+    F = llvm::Linker::LinkOnlyNeeded;
+
+  if(!linkBitcode(M, std::move(*OtherModule), ForcedTriple, ForcedDataLayout, F)) {
+    this->registerError("LLVMToBackend: Linking module failed");
+    return false;
+  }
+
+  return true;
 }
 
 void LLVMToBackendTranslator::specializeKernelArgument(const std::string &KernelName, int ParamIndex,
@@ -0,0 +1,193 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/compiler/llvm-to-backend/host/HostJIT.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/host/LLVMToHostFactory.hpp"
+
+#include "hipSYCL/common/debug.hpp"
+
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/TargetSelect.h>
+#if LLVM_VERSION_MAJOR < 16
+#include <llvm/ADT/Triple.h>
+#include <llvm/Support/Host.h>
+#else
+#include <llvm/TargetParser/Host.h>
+#include <llvm/TargetParser/Triple.h>
+#endif
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace hipsycl {
+namespace compiler {
+
+namespace {
+
+llvm::Expected<llvm::orc::JITTargetMachineBuilder> getHostTargetMachineBuilder() {
+  static std::once_flag TargetInitialized;
+  std::call_once(TargetInitialized, []() {
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+  });
+
+  // HIPSYCL_HOST_CPU_FLAG is empty if the compiler does not support
+  // -march=native or -mcpu=native; generate code for the generic CPU then.
+  const bool UseHostCPU = !std::string_view{HIPSYCL_HOST_CPU_FLAG}.empty();
+
+  llvm::orc::JITTargetMachineBuilder JTMB{
+      llvm::Triple{llvm::sys::getProcessTriple()}};
+  if (UseHostCPU) {
+    auto HostJTMB = llvm::orc::JITTargetMachineBuilder::detectHost();
+    if (!HostJTMB)
+      return HostJTMB.takeError();
+    JTMB = std::move(*HostJTMB);
+  }
+
+  JTMB.setRelocationModel(llvm::Reloc::PIC_);
+#if LLVM_VERSION_MAJOR < 18
+  JTMB.setCodeGenOptLevel(llvm::CodeGenOpt::Aggressive);
+#else
+  JTMB.setCodeGenOptLevel(llvm::CodeGenOptLevel::Aggressive);
+#endif
+  return JTMB;
+}
+
+// LLJIT::lookup() returns JITEvaluatedSymbol in older LLVM versions,
+// and ExecutorAddr in newer ones.
+template <class Symbol>
+auto getSymbolAddress(const Symbol &S) -> decltype(S.getAddress()) {
+  return S.getAddress();
+}
+
+template <class Symbol>
+auto getSymbolAddress(const Symbol &S) -> decltype(S.getValue()) {
+  return S.getValue();
+}
+
+/// The JIT shared by all loaded objects. Each object is placed into its own
+/// JITDylib, since different specializations of the same kernels define
+/// the same symbols.
+struct SharedHostJIT {
+  std::unique_ptr<llvm::orc::LLJIT> JIT;
+  std::string InitError;
+  std::atomic<uint64_t> NextDylibId = 0;
+};
+
+SharedHostJIT &getSharedHostJIT() {
+  // Intentionally never destroyed: Loaded objects may be released by the
+  // runtime during static destruction.
+  static SharedHostJIT *SharedJIT = []() {
+    auto *S = new SharedHostJIT;
+
+    auto JTMB = getHostTargetMachineBuilder();
+    if (!JTMB) {
+      S->InitError = llvm::toString(JTMB.takeError());
+      return S;
+    }
+
+    auto JIT = llvm::orc::LLJITBuilder{}
+                   .setJITTargetMachineBuilder(std::move(*JTMB))
+                   .create();
+    if (!JIT) {
+      S->InitError = llvm::toString(JIT.takeError());
+      return S;
+    }
+    S->JIT = std::move(*JIT);
+    return S;
+  }();
+  return *SharedJIT;
+}
+
+class LLJITHostObject : public LoadedHostObject {
+public:
+  LLJITHostObject(llvm::orc::LLJIT &JIT, llvm::orc::JITDylib &JD)
+      : JIT{JIT}, JD{JD} {}
+
+  virtual ~LLJITHostObject() {
+    if (auto E = JIT.getExecutionSession().removeJITDylib(JD)) {
+      HIPSYCL_DEBUG_ERROR << "HostJIT: Could not release loaded object: "
+                          << llvm::toString(std::move(E)) << "\n";
+    }
+  }
+
+  virtual void *getSymbol(const std::string &Name) const override {
+    // The object is only linked on the first lookup, so this is also where
+    // e.g. unresolved symbols are reported.
+    auto Symbol = JIT.lookup(JD, Name);
+    if (!Symbol) {
+      HIPSYCL_DEBUG_ERROR << "HostJIT: Could not look up symbol " << Name
+                          << ": " << llvm::toString(Symbol.takeError())
+                          << "\n";
+      return nullptr;
+    }
+    return reinterpret_cast<void *>(
+        static_cast<uintptr_t>(getSymbolAddress(*Symbol)));
+  }
+
+private:
+  llvm::orc::LLJIT &JIT;
+  llvm::orc::JITDylib &JD;
+};
+
+} // namespace
+
+llvm::Expected<std::unique_ptr<llvm::TargetMachine>> createHostTargetMachine() {
+  auto JTMB = getHostTargetMachineBuilder();
+  if (!JTMB)
+    return JTMB.takeError();
+  return JTMB->createTargetMachine();
+}
+
+std::unique_ptr<LoadedHostObject> loadHostObject(std::string_view Object,
+                                                 std::string &ErrorMessage) {
+  SharedHostJIT &S = getSharedHostJIT();
+  if (!S.JIT) {
+    ErrorMessage = "Could not create JIT: " + S.InitError;
+    return nullptr;
+  }
+
+  std::string Name = "acpp-sscp-host-object-" + std::to_string(S.NextDylibId++);
+  auto JD = S.JIT->createJITDylib(Name);
+  if (!JD) {
+    ErrorMessage = llvm::toString(JD.takeError());
+    return nullptr;
+  }
+
+  // Builtins that were not inlined, as well as libc/libm functions, are
+  // resolved against the process.
+  auto ProcessSymbols =
+      llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+          S.JIT->getDataLayout().getGlobalPrefix());
+  if (!ProcessSymbols) {
+    ErrorMessage = llvm::toString(ProcessSymbols.takeError());
+    llvm::consumeError(S.JIT->getExecutionSession().removeJITDylib(*JD));
+    return nullptr;
+  }
+  JD->addGenerator(std::move(*ProcessSymbols));
+
+  auto Buffer = llvm::MemoryBuffer::getMemBufferCopy(
+      llvm::StringRef{Object.data(), Object.size()}, Name);
+  if (auto E = S.JIT->addObjectFile(*JD, std::move(Buffer))) {
+    ErrorMessage = llvm::toString(std::move(E));
+    llvm::consumeError(S.JIT->getExecutionSession().removeJITDylib(*JD));
+    return nullptr;
+  }
+
+  return std::make_unique<LLJITHostObject>(*S.JIT, *JD);
+}
+
+} // namespace compiler
+} // namespace hipsycl
@@ -13,6 +13,8 @@
 #include "hipSYCL/common/debug.hpp"
 #include "hipSYCL/compiler/cbs/IRUtils.hpp"
 #include "hipSYCL/compiler/cbs/SplitterAnnotationAnalysis.hpp"
+#include "hipSYCL/compiler/cbs/VectorizedSubGroups.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/host/LLVMToHostFactory.hpp"
 #include "hipSYCL/compiler/sscp/IRConstantReplacer.hpp"
 #include "hipSYCL/compiler/utils/LLVMUtils.hpp"
 
@@ -52,6 +54,104 @@ void replaceUsesOfGVWith(llvm::Function &F, llvm::StringRef GlobalVarName, llvm:
   utils::replaceUsesOfGVWith(F, GlobalVarName, To, PassPrefix);
 }
 
+void emitKernelFlags(llvm::Module &M, llvm::StringRef KernelName, std::uint32_t Flags) {
+  auto *FlagsT = llvm::Type::getInt32Ty(M.getContext());
+  auto *GV = new llvm::GlobalVariable(M, FlagsT, true, llvm::GlobalValue::ExternalLinkage,
+                                      llvm::ConstantInt::get(FlagsT, Flags),
+                                      HostKernelFlagsPrefix + KernelName);
+  GV->setVisibility(llvm::GlobalValue::DefaultVisibility);
+}
+
+// Layout of omp_sscp_executable_object::work_group_info
+llvm::StructType *getWorkGroupInfoType(llvm::Module &M) {
+  auto &Ctx = M.getContext();
+  auto SizeT = M.getDataLayout().getLargestLegalIntType(Ctx);
+  auto VoidPtrT = llvm::PointerType::getUnqual(llvm::Type::getInt8Ty(Ctx));
+  return llvm::StructType::get(llvm::ArrayType::get(SizeT, 3), // # groups
+                               llvm::ArrayType::get(SizeT, 3), // group id
+                               llvm::ArrayType::get(SizeT, 3), // local size
+                               VoidPtrT,                       // local memory ptr
+                               VoidPtrT,                       // internal local memory ptr
+                               llvm::ArrayType::get(SizeT, 3), // local id (fibers only)
+                               VoidPtrT,                       // barrier function (fibers only)
+                               VoidPtrT);                      // barrier context (fibers only)
+}
+
+/*
+ * Replaces all barriers in the kernel by calls to the barrier function of the
+ * work group info, which switches to the fibers of the other work items.
+ */
+void replaceBarriersWithFiberSwitches(llvm::Function &Wrapper, llvm::Value *BarrierFunction,
+                                      llvm::Value *BarrierContext) {
+  llvm::SmallVector<llvm::CallBase *> Barriers;
+  for (auto &BB : Wrapper)
+    for (auto &I : BB)
+      if (auto *CB = llvm::dyn_cast<llvm::CallBase>(&I))
+        if (CB->getCalledFunction() &&
+            CB->getCalledFunction()->getName() == cbs::BarrierIntrinsicName)
+          Barriers.push_back(CB);
+
+  auto BarrierT = llvm::FunctionType::get(llvm::Type::getVoidTy(Wrapper.getContext()),
+                                          {BarrierContext->getType()}, false);
+  for (auto *CB : Barriers) {
+    llvm::IRBuilder<> Bld{CB};
+    Bld.CreateCall(BarrierT,
+                   Bld.CreatePointerCast(BarrierFunction, llvm::PointerType::getUnqual(BarrierT)),
+                   {BarrierContext});
+    CB->eraseFromParent();
+  }
+}
+
+/*
+ * Emits a call to the kernel F for every sub-group of the work group, if the
+ * sub-groups of F are mapped to SIMD lanes. The sub-groups tile the work group
+ * in x direction, the last sub-group of each row may be smaller. The sub-group
+ * origin and size are passed to F through the globals read by the lowered
+ * sub-group builtins.
+ */
+llvm::CallInst *callPerSubGroup(llvm::IRBuilderBase &Bld, llvm::Function &F,
+                                llvm::ArrayRef<llvm::Value *> Args,
+                                const std::array<llvm::Value *, 3> &LocalSize, int SubGroupSize,
+                                bool IsKnownFullSubGroups,
+                                std::array<llvm::PHINode *, 3> &SubGroupOrigin,
+                                llvm::Value *&ActiveLanes) {
+  auto &Ctx = Bld.getContext();
+  auto Wrapper = Bld.GetInsertBlock()->getParent();
+  auto SizeT = LocalSize[0]->getType();
+  auto Zero = llvm::ConstantInt::get(SizeT, 0);
+  auto One = llvm::ConstantInt::get(SizeT, 1);
+  auto Width = llvm::ConstantInt::get(SizeT, SubGroupSize);
+
+  // the local sizes are at least 1, so every loop is executed at least once
+  std::array<llvm::BasicBlock *, 3> HeaderBBs;
+  for (int D = 2; D >= 0; --D) {
+    auto PreheaderBB = Bld.GetInsertBlock();
+    HeaderBBs[D] = llvm::BasicBlock::Create(Ctx, "sub_group." + llvm::Twine{"xyz"[D]}, Wrapper);
+    Bld.CreateBr(HeaderBBs[D]);
+    Bld.SetInsertPoint(HeaderBBs[D]);
+    SubGroupOrigin[D] = Bld.CreatePHI(SizeT, 2, "sub_group_origin_" + llvm::Twine{"xyz"[D]});
+    SubGroupOrigin[D]->addIncoming(Zero, PreheaderBB);
+  }
+
+  if (IsKnownFullSubGroups)
+    ActiveLanes = Width;
+  else
+    ActiveLanes = Bld.CreateBinaryIntrinsic(llvm::Intrinsic::umin, Width,
+                                            Bld.CreateSub(LocalSize[0], SubGroupOrigin[0]),
+                                            nullptr, "sub_group_size");
+  auto FCall = Bld.CreateCall(&F, Args);
+
+  for (int D = 0; D < 3; ++D) {
+    auto Next = Bld.CreateAdd(SubGroupOrigin[D], D == 0 ? Width : One,
+                              "next_sub_group_origin_" + llvm::Twine{"xyz"[D]}, true, true);
+    SubGroupOrigin[D]->addIncoming(Next, Bld.GetInsertBlock());
+    auto LatchBB = llvm::BasicBlock::Create(Ctx, "sub_group.latch", Wrapper);
+    Bld.CreateCondBr(Bld.CreateICmpULT(Next, LocalSize[D]), HeaderBBs[D], LatchBB);
+    Bld.SetInsertPoint(LatchBB);
+  }
+  return FCall;
+}
+
 /*
  * This creates a wrapper function for a kernel function that takes the following arguments:
  * - A pointer to a struct containing {num_groups, group_id, local_size, local_mem_ptr}
@@ -64,19 +164,15 @@ void replaceUsesOfGVWith(llvm::Function &F, llvm::StringRef GlobalVarName, llvm:
  * struct and the user arguments need to be passed to the wrapper.
  */
 llvm::Function *makeWrapperFunction(llvm::Function &F, std::int64_t DynamicLocalMemSize,
-                                    const std::array<int, 3> &KnownWgSize) {
+                                    const std::array<int, 3> &KnownWgSize,
+                                    bool UseFiberBarriers) {
   auto M = F.getParent();
   auto &Ctx = M->getContext();
 
   llvm::IRBuilder<> Bld(&F.getEntryBlock());
 
   auto SizeT = M->getDataLayout().getLargestLegalIntType(Ctx);
-  auto WorkGroupInfoT =
-      llvm::StructType::get(llvm::ArrayType::get(SizeT, 3),                 // # groups
-                            llvm::ArrayType::get(SizeT, 3),                 // group id
-                            llvm::ArrayType::get(SizeT, 3),                 // local size
-                            llvm::PointerType::getUnqual(Bld.getInt8Ty()), // local memory ptr
-                            llvm::PointerType::getUnqual(Bld.getInt8Ty())); // internal local memory ptr
+  auto WorkGroupInfoT = getWorkGroupInfoType(*M);
   auto VoidPtrT = llvm::PointerType::getUnqual(Bld.getInt8Ty());
   auto UserArgsT = llvm::PointerType::getUnqual(VoidPtrT);
 
@@ -131,6 +227,26 @@ llvm::Function *makeWrapperFunction(llvm::Function &F, std::int64_t DynamicLocal
       Bld.CreateInBoundsGEP(WorkGroupInfoT, Wrapper->getArg(0), {Bld.getInt64(0), Bld.getInt32(4)}),
       "internal_local_mem_ptr");
 
+  // With fiber barriers, the wrapper executes a single work item
+  std::array<llvm::Value *, 3> LocalIds{};
+  llvm::Value *BarrierFunction = nullptr;
+  llvm::Value *BarrierContext = nullptr;
+  if (UseFiberBarriers) {
+    LocalIds[0] = LoadFromContext(5, 0, "local_id_x");
+    LocalIds[1] = LoadFromContext(5, 1, "local_id_y");
+    LocalIds[2] = LoadFromContext(5, 2, "local_id_z");
+    BarrierFunction = Bld.CreateLoad(
+        VoidPtrT,
+        Bld.CreateInBoundsGEP(WorkGroupInfoT, Wrapper->getArg(0),
+                              {Bld.getInt64(0), Bld.getInt32(6)}),
+        "barrier");
+    BarrierContext = Bld.CreateLoad(
+        VoidPtrT,
+        Bld.CreateInBoundsGEP(WorkGroupInfoT, Wrapper->getArg(0),
+                              {Bld.getInt64(0), Bld.getInt32(7)}),
+        "barrier_context");
+  }
+
   llvm::SmallVector<llvm::Value *> Args;
 
   auto ArgArray = Wrapper->arg_begin() + 1;
@@ -153,7 +269,21 @@ llvm::Function *makeWrapperFunction(llvm::Function &F, std::int64_t DynamicLocal
 #endif
     }
   }
-  auto FCall = Bld.CreateCall(&F, Args);
+  // With vectorized sub-groups, the kernel executes a single sub-group
+  const int SubGroupSize = getVectorizedSubGroupSize(F);
+  std::array<llvm::PHINode *, 3> SubGroupOrigin{};
+  llvm::Value *ActiveLanes = nullptr;
+  llvm::CallInst *FCall = nullptr;
+  if (SubGroupSize > 0) {
+    std::array<llvm::Value *, 3> WgSize;
+    for (int I = 0; I < 3; ++I)
+      WgSize[I] = KnownWgSize[I] != 0 ? llvm::ConstantInt::get(SizeT, KnownWgSize[I]) : LocalSize[I];
+    FCall = callPerSubGroup(Bld, F, Args, WgSize, SubGroupSize,
+                            KnownWgSize[0] != 0 && KnownWgSize[0] % SubGroupSize == 0,
+                            SubGroupOrigin, ActiveLanes);
+  } else {
+    FCall = Bld.CreateCall(&F, Args);
+  }
   Bld.CreateRetVoid();
 
   utils::checkedInlineFunction(FCall, "HostKernelWrapperPass");
@@ -172,6 +302,31 @@ llvm::Function *makeWrapperFunction(llvm::Function &F, std::int64_t DynamicLocal
   replaceUsesOfGVWith(*Wrapper, cbs::SscpDynamicLocalMemoryPtrName, LocalMemPtr);
   replaceUsesOfGVWith(*Wrapper, cbs::SscpInternalLocalMemoryPtrName, InternalLocalMemPtr);
 
+  if (UseFiberBarriers) {
+    for (int I = 0; I < 3; ++I)
+      replaceUsesOfGVWith(*Wrapper, cbs::LocalIdGlobalNames[I], LocalIds[I]);
+    replaceBarriersWithFiberSwitches(*Wrapper, BarrierFunction, BarrierContext);
+  }
+
+  if (SubGroupSize > 0) {
+    for (int I = 0; I < 3; ++I)
+      replaceUsesOfGVWith(*Wrapper, cbs::SubGroupOriginGlobalNames[I], SubGroupOrigin[I]);
+    replaceUsesOfGVWith(*Wrapper, cbs::SubGroupSizeGlobalName, ActiveLanes);
+  }
+
+  // Kernels without group algorithms and local memory accessors, e.g. all
+  // basic parallel_for kernels, don't need any local memory to be set up.
+  std::uint32_t Flags = 0;
+  if (!LocalMemPtr->use_empty())
+    Flags |= HostKernelFlags::UsesLocalMemory;
+  if (!InternalLocalMemPtr->use_empty())
+    Flags |= HostKernelFlags::UsesInternalLocalMemory;
+  if (F.hasFnAttribute(HostKernelUsesBarriersAttr))
+    Flags |= HostKernelFlags::UsesBarriers;
+  if (UseFiberBarriers)
+    Flags |= HostKernelFlags::UsesFiberBarriers;
+  emitKernelFlags(*M, FName, Flags);
+
   F.setLinkage(llvm::GlobalValue::LinkageTypes::InternalLinkage);
   F.replaceAllUsesWith(Wrapper);
   // can't erase here, since the original function is still transformed.
@@ -179,6 +334,65 @@ llvm::Function *makeWrapperFunction(llvm::Function &F, std::int64_t DynamicLocal
   return Wrapper;
 }
 
+/*
+ * Turns the wrapper function into one that executes the work groups
+ * [group_id_x, min(group_id_x + Factor, num_groups_x)) in a loop, instead of
+ * only the work group group_id_x. This amortizes the cost of the call per
+ * work group for kernels with small work groups. The runtime then only
+ * invokes the kernel for every Factor-th work group in x direction.
+ */
+llvm::Function *coarsenWrapperFunction(llvm::Function *Wrapper, int Factor) {
+  auto M = Wrapper->getParent();
+  auto &Ctx = M->getContext();
+  auto SizeT = M->getDataLayout().getLargestLegalIntType(Ctx);
+  auto WorkGroupInfoT = getWorkGroupInfoType(*M);
+
+  std::string FName = Wrapper->getName().str();
+  Wrapper->setName(FName + "_single_group");
+
+  auto Coarsened = llvm::Function::Create(Wrapper->getFunctionType(),
+                                          llvm::GlobalValue::LinkageTypes::ExternalLinkage, FName, M);
+  Coarsened->setAttributes(Wrapper->getAttributes());
+  Wrapper->setLinkage(llvm::GlobalValue::LinkageTypes::InternalLinkage);
+
+  auto EntryBB = llvm::BasicBlock::Create(Ctx, "entry", Coarsened);
+  auto GroupBB = llvm::BasicBlock::Create(Ctx, "group", Coarsened);
+  auto ExitBB = llvm::BasicBlock::Create(Ctx, "exit", Coarsened);
+
+  llvm::IRBuilder<> Bld(EntryBB);
+  auto GetFromInfo = [&](llvm::Value *Info, int Array) {
+    return Bld.CreateInBoundsGEP(WorkGroupInfoT, Info,
+                                 {Bld.getInt64(0), Bld.getInt32(Array), Bld.getInt32(0)});
+  };
+  auto Info = Coarsened->getArg(0);
+  auto GroupInfo = Bld.CreateAlloca(WorkGroupInfoT, nullptr, "group_info");
+  Bld.CreateStore(Bld.CreateLoad(WorkGroupInfoT, Info), GroupInfo);
+
+  auto NumGroupsX = Bld.CreateLoad(SizeT, GetFromInfo(Info, 0), "num_groups_x");
+  auto FirstGroupX = Bld.CreateLoad(SizeT, GetFromInfo(Info, 1), "first_group_id_x");
+  auto EndGroupX = Bld.CreateAdd(FirstGroupX, llvm::ConstantInt::get(SizeT, Factor));
+  EndGroupX = Bld.CreateSelect(Bld.CreateICmpULT(EndGroupX, NumGroupsX), EndGroupX, NumGroupsX,
+                               "end_group_id_x");
+  Bld.CreateBr(GroupBB);
+
+  Bld.SetInsertPoint(GroupBB);
+  auto GroupX = Bld.CreatePHI(SizeT, 2, "group_id_x");
+  GroupX->addIncoming(FirstGroupX, EntryBB);
+  Bld.CreateStore(GroupX, GetFromInfo(GroupInfo, 1));
+  auto WrapperCall = Bld.CreateCall(Wrapper, {GroupInfo, Coarsened->getArg(1)});
+  auto NextGroupX = Bld.CreateAdd(GroupX, llvm::ConstantInt::get(SizeT, 1), "next_group_id_x",
+                                  true, false);
+  GroupX->addIncoming(NextGroupX, GroupBB);
+  Bld.CreateCondBr(Bld.CreateICmpULT(NextGroupX, EndGroupX), GroupBB, ExitBB);
+
+  Bld.SetInsertPoint(ExitBB);
+  Bld.CreateRetVoid();
+
+  utils::checkedInlineFunction(WrapperCall, "HostKernelWrapperPass");
+
+  return Coarsened;
+}
+
 } // namespace
 
 llvm::PreservedAnalyses HostKernelWrapperPass::run(llvm::Function &F,
@@ -189,7 +403,11 @@ llvm::PreservedAnalyses HostKernelWrapperPass::run(llvm::Function &F,
   if (!SAA || !SAA->isKernelFunc(&F))
     return llvm::PreservedAnalyses::all();
 
-  auto Wrapper = makeWrapperFunction(F, DynamicLocalMemSize, KnownWgSize);
+  auto Wrapper = makeWrapperFunction(F, DynamicLocalMemSize, KnownWgSize, UseFiberBarriers);
+  // Fibers of the same work item cannot execute several work groups, as
+  // work groups would no longer be separated by barriers.
+  if (GroupCoarseningFactor > 1 && !UseFiberBarriers)
+    Wrapper = coarsenWrapperFunction(Wrapper, GroupCoarseningFactor);
 
   HIPSYCL_DEBUG_INFO << PassPrefix << "Created kernel wrapper: " << Wrapper->getName() << "\n";
 
@@ -21,26 +21,30 @@
 #include "hipSYCL/compiler/llvm-to-backend/AddressSpaceInferencePass.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/AddressSpaceMap.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/Utils.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/host/HostJIT.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/host/HostKernelWrapperPass.hpp"
 #include "hipSYCL/compiler/sscp/IRConstantReplacer.hpp"
 #include "hipSYCL/glue/llvm-sscp/jit-reflection/queries.hpp"
 
+#include <llvm/ADT/SmallPtrSet.h>
 #include <llvm/ADT/SmallVector.h>
+#include <llvm/Analysis/TargetTransformInfo.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/IR/Attributes.h>
+#include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/CallingConv.h>
 #include <llvm/IR/DataLayout.h>
 #include <llvm/IR/DebugInfo.h>
 #include <llvm/IR/GlobalValue.h>
+#include <llvm/IR/InstIterator.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Metadata.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/PassManager.h>
 #include <llvm/Passes/PassBuilder.h>
-#include <llvm/Support/FileSystem.h>
-#include <llvm/Support/MemoryBuffer.h>
-#include <llvm/Support/Program.h>
+#include <llvm/Support/Error.h>
 #include <llvm/Support/raw_ostream.h>
+#include <llvm/Target/TargetMachine.h>
 #if LLVM_VERSION_MAJOR < 16
 #include <llvm/ADT/Triple.h>
 #include <llvm/Support/Host.h>
@@ -50,15 +54,57 @@
 #endif
 
 #include <cassert>
-#include <fstream>
 #include <memory>
 #include <string>
-#include <system_error>
 #include <vector>
 
 namespace hipsycl {
 namespace compiler {
 
+namespace {
+
+bool reachesBarrier(llvm::Function &F, llvm::SmallPtrSetImpl<llvm::Function *> &Visited) {
+  if (!Visited.insert(&F).second)
+    return false;
+  if (F.getName() == cbs::BarrierIntrinsicName)
+    return true;
+  for (auto &I : llvm::instructions(F))
+    if (auto *CB = llvm::dyn_cast<llvm::CallBase>(&I))
+      if (auto *Callee = CB->getCalledFunction())
+        if (reachesBarrier(*Callee, Visited))
+          return true;
+  return false;
+}
+
+// The number of 32 bit lanes of the host's fixed width vector registers, which
+// is used as the size of vectorized sub-groups. Returns 0 if the host has no
+// vector registers.
+int getNativeSubGroupSize(llvm::Module &M, const std::vector<std::string> &KernelNames) {
+  llvm::Function *Kernel = nullptr;
+  for (const auto &KernelName : KernelNames)
+    if ((Kernel = M.getFunction(KernelName)))
+      break;
+  if (!Kernel)
+    return 0;
+
+  auto TM = createHostTargetMachine();
+  if (auto E = TM.takeError()) {
+    HIPSYCL_DEBUG_WARNING << "LLVMToHost: Could not create target machine, sub-groups are not "
+                             "vectorized: "
+                          << llvm::toString(std::move(E)) << "\n";
+    return 0;
+  }
+  const auto VectorBits =
+      (*TM)
+          ->getTargetTransformInfo(*Kernel)
+          .getRegisterBitWidth(llvm::TargetTransformInfo::RGK_FixedWidthVector)
+          .getKnownMinValue();
+  const int SubGroupSize = VectorBits / 32;
+  return SubGroupSize > 1 ? SubGroupSize : 0;
+}
+
+} // namespace
+
 LLVMToHostTranslator::LLVMToHostTranslator(const std::vector<std::string> &KN)
     : LLVMToBackendTranslator{static_cast<int>(sycl::AdaptiveCpp_jit::compiler_backend::host), KN, KN},
       KernelNames{KN} {}
@@ -109,10 +155,37 @@ bool LLVMToHostTranslator::toBackendFlavor(llvm::Module &M, PassHandler &PH) {
     MAM.registerPass([] { return SplitterAnnotationAnalysis{}; });
   });
   PH.PassBuilder->registerModuleAnalyses(*PH.ModuleAnalysisManager);
-  registerCBSPipeline(MPM, hipsycl::compiler::OptLevel::O3, true);
+
+  // Barriers disappear during lowering, so remember which kernels contain
+  // them. The runtime only considers fiber barriers for these kernels.
+  for (auto KernelName : KernelNames) {
+    if (auto *F = M.getFunction(KernelName)) {
+      llvm::SmallPtrSet<llvm::Function *, 16> Visited;
+      if (reachesBarrier(*F, Visited))
+        F->addFnAttr(HostKernelUsesBarriersAttr);
+    }
+  }
+
+  if (UseFiberBarriers) {
+    // Each work item is executed by its own fiber, and barriers become
+    // fiber switches, so kernels only need to be flattened such that all
+    // barriers and work item queries end up in the kernel.
+    MPM.addPass(SplitterAnnotationAnalysisCacher{});
+    llvm::FunctionPassManager FlatteningFPM;
+    FlatteningFPM.addPass(KernelFlatteningPass{});
+    MPM.addPass(llvm::createModuleToFunctionPassAdaptor(std::move(FlatteningFPM)));
+  } else {
+    // Sub-groups of kernels without barriers can be mapped to SIMD lanes,
+    // otherwise they consist of a single work item.
+    int SubGroupSize = 0;
+    if (UseVectorizedSubGroups)
+      SubGroupSize = getNativeSubGroupSize(M, KernelNames);
+    registerCBSPipeline(MPM, hipsycl::compiler::OptLevel::O3, true, SubGroupSize);
+  }
 
   llvm::FunctionPassManager FPM;
-  FPM.addPass(HostKernelWrapperPass{KnownLocalMemSize, KnownGroupSizeX, KnownGroupSizeY, KnownGroupSizeZ});
+  FPM.addPass(HostKernelWrapperPass{KnownLocalMemSize, KnownGroupSizeX, KnownGroupSizeY,
+                                    KnownGroupSizeZ, GroupCoarseningFactor, UseFiberBarriers});
   MPM.addPass(llvm::createModuleToFunctionPassAdaptor(std::move(FPM)));
 
   MPM.run(M, *PH.ModuleAnalysisManager);
@@ -122,78 +195,83 @@ bool LLVMToHostTranslator::toBackendFlavor(llvm::Module &M, PassHandler &PH) {
 
 bool LLVMToHostTranslator::translateToBackendFormat(llvm::Module &FlavoredModule,
                                                     std::string &out) {
-  auto InputFile = llvm::sys::fs::TempFile::create("acpp-sscp-host-%%%%%%.bc");
-  auto OutputFile = llvm::sys::fs::TempFile::create("acpp-sscp-host-%%%%%%.so");
-
-  if (auto E = InputFile.takeError()) {
-    this->registerError("LLVMToHost: Could not create temp file: " + InputFile->TmpName);
+  // Code generation happens in-process; the resulting relocatable object
+  // is linked into executable memory by loadHostObject(), so that neither
+  // a compiler process nor temporary files are needed.
+  auto TM = createHostTargetMachine();
+  if (auto E = TM.takeError()) {
+    this->registerError("LLVMToHost: Could not create target machine: " +
+                        llvm::toString(std::move(E)));
     return false;
   }
 
-  if (auto E = OutputFile.takeError()) {
-    this->registerError("LLVMToHost: Could not create temp file: " + OutputFile->TmpName);
-    return false;
-  }
-
-  std::string OutputFilename = OutputFile->TmpName;
-
-  AtScopeExit DestroyInputFile([&]() {
-    if (InputFile->discard())
-      ;
-  });
-  AtScopeExit DestroyOutputFile([&]() {
-    if (OutputFile->discard())
-      ;
-  });
-
-  std::error_code EC;
-  llvm::raw_fd_ostream InputStream{InputFile->FD, false};
-
-  llvm::WriteBitcodeToFile(FlavoredModule, InputStream);
-  InputStream.flush();
-
-  const std::string ClangPath = HIPSYCL_CLANG_PATH;
-  const std::string CpuFlag = HIPSYCL_HOST_CPU_FLAG;
-
-  llvm::SmallVector<llvm::StringRef, 16> Invocation{ClangPath,
-                                                    "-O3",
-                                                    CpuFlag,
-                                                    "-x",
-                                                    "ir",
-                                                    "-shared",
-                                                    "-Wno-pass-failed",
-                                                    "-fPIC",
-                                                    "-o",
-                                                    OutputFilename,
-                                                    InputFile->TmpName};
-
-  std::string ArgString;
-  for (const auto &S : Invocation) {
-    ArgString += S;
-    ArgString += " ";
+#if LLVM_VERSION_MAJOR < 21
+  FlavoredModule.setTargetTriple((*TM)->getTargetTriple().str());
+#else
+  FlavoredModule.setTargetTriple((*TM)->getTargetTriple());
+#endif
+  FlavoredModule.setDataLayout((*TM)->createDataLayout());
+
+  // The module has already been optimized in toBackendFlavor(), but without
+  // knowledge of the target. Run the optimization pipeline again, such that
+  // in particular vectorization can take the host ISA into account.
+  {
+    llvm::LoopAnalysisManager LAM;
+    llvm::FunctionAnalysisManager FAM;
+    llvm::CGSCCAnalysisManager CGAM;
+    llvm::ModuleAnalysisManager MAM;
+    llvm::PassBuilder PB{TM->get()};
+
+    PB.registerModuleAnalyses(MAM);
+    PB.registerCGSCCAnalyses(CGAM);
+    PB.registerFunctionAnalyses(FAM);
+    PB.registerLoopAnalyses(LAM);
+    PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+
+    llvm::ModulePassManager MPM =
+        PB.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O3);
+    MPM.run(FlavoredModule, MAM);
   }
-  HIPSYCL_DEBUG_INFO << "LLVMToHost: Invoking " << ArgString << "\n";
 
-  int R = llvm::sys::ExecuteAndWait(ClangPath, Invocation);
-
-  if (R != 0) {
-    this->registerError("LLVMToHost: clang invocation failed with exit code " + std::to_string(R));
+  llvm::SmallVector<char, 0> ObjectBuffer;
+  llvm::raw_svector_ostream ObjectStream{ObjectBuffer};
+  llvm::legacy::PassManager CodeGenPM;
+#if LLVM_VERSION_MAJOR < 18
+  auto FileType = llvm::CGFT_ObjectFile;
+#else
+  auto FileType = llvm::CodeGenFileType::ObjectFile;
+#endif
+  if ((*TM)->addPassesToEmitFile(CodeGenPM, ObjectStream, nullptr, FileType)) {
+    this->registerError("LLVMToHost: Target machine cannot emit object files");
     return false;
   }
 
-  auto ReadResult = llvm::MemoryBuffer::getFile(OutputFile->TmpName, -1);
+  HIPSYCL_DEBUG_INFO << "LLVMToHost: Emitting object code for "
+                     << (*TM)->getTargetTriple().str() << ", CPU "
+                     << (*TM)->getTargetCPU().str() << "\n";
+  CodeGenPM.run(FlavoredModule);
 
-  if (auto Err = ReadResult.getError()) {
-    this->registerError("LLVMToHost: Could not read result file" + Err.message());
-    return false;
-  }
-
-  out = ReadResult->get()->getBuffer();
+  out.assign(ObjectBuffer.begin(), ObjectBuffer.end());
 
   return true;
 }
 
 bool LLVMToHostTranslator::applyBuildOption(const std::string &Option, const std::string &Value) {
+  if (Option == "host-group-coarsening-factor") {
+    this->GroupCoarseningFactor = std::stoi(Value);
+    return true;
+  }
+  return false;
+}
+
+bool LLVMToHostTranslator::applyBuildFlag(const std::string &Flag) {
+  if (Flag == "host-fiber-barriers") {
+    this->UseFiberBarriers = true;
+    return true;
+  } else if (Flag == "host-vectorized-subgroups") {
+    this->UseVectorizedSubGroups = true;
+    return true;
+  }
   return false;
 }
 
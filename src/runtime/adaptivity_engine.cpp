@@ -18,8 +18,12 @@
 #include "hipSYCL/runtime/application.hpp"
 #include "hipSYCL/common/filesystem.hpp"
 #include "hipSYCL/runtime/runtime_event_handlers.hpp"
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <limits>
+#include <mutex>
+#include <unordered_map>
 
 
 namespace hipsycl {
@@ -155,6 +159,109 @@ bool is_likely_invariant_argument(common::db::kernel_entry &kernel_entry,
   return false;
 }
 
+// Caches the appdb kernel statistics that are used to detect invariant
+// kernel arguments. Entries are distributed across shards with separate
+// locks, so that concurrent kernel launches only contend if their kernels
+// map to the same shard, instead of all serializing on the appdb lock.
+// Modified entries are merged back into the appdb periodically and at
+// shutdown.
+class kernel_statistics_cache {
+public:
+  static kernel_statistics_cache& get() {
+    static kernel_statistics_cache cache;
+    return cache;
+  }
+
+  ~kernel_statistics_cache() {
+    sync();
+  }
+
+  // Invokes handler(kernel_entry&, application_run) while holding
+  // the lock of the shard that contains the kernel.
+  template<class F>
+  void access(const kernel_configuration::id_type& id, F&& handler) {
+    shard& s = _shards[kernel_id_hash{}(id) % num_shards];
+    {
+      std::lock_guard<std::mutex> lock{s.mutex};
+      auto it = s.entries.find(id);
+      if(it == s.entries.end()) {
+        cached_entry new_entry;
+        _appdb.read_access([&](const common::db::appdb_data& data){
+          auto db_entry = data.kernels.find(id);
+          if(db_entry != data.kernels.end())
+            new_entry.entry = db_entry->second;
+        });
+        it = s.entries.emplace(id, std::move(new_entry)).first;
+      }
+      handler(it->second.entry, _application_run);
+      it->second.is_dirty = true;
+    }
+
+    if((_num_updates.fetch_add(1, std::memory_order_relaxed) + 1) %
+           sync_interval ==
+       0)
+      sync();
+  }
+
+  // Merges all modified entries into the appdb
+  void sync() {
+    std::vector<std::pair<kernel_configuration::id_type,
+                          common::db::kernel_entry>> modified_entries;
+    for(shard& s : _shards) {
+      std::lock_guard<std::mutex> lock{s.mutex};
+      for(auto& entry : s.entries) {
+        if(entry.second.is_dirty) {
+          modified_entries.push_back(
+              std::make_pair(entry.first, entry.second.entry));
+          entry.second.is_dirty = false;
+        }
+      }
+    }
+
+    if(modified_entries.empty())
+      return;
+
+    _appdb.read_write_access([&](common::db::appdb_data& data){
+      for(const auto& modified : modified_entries) {
+        // Only merge the statistics; other fields such as the retained
+        // argument indices are owned by the JIT compiler.
+        auto& db_entry = data.kernels[modified.first];
+        db_entry.kernel_args = modified.second.kernel_args;
+        db_entry.num_registered_invocations =
+            modified.second.num_registered_invocations;
+        db_entry.first_iads_invocation_run =
+            modified.second.first_iads_invocation_run;
+      }
+    });
+  }
+private:
+  kernel_statistics_cache()
+  : _appdb{common::filesystem::persistent_storage::get().get_this_app_db()} {
+    _application_run = _appdb.read_access(
+        [](const common::db::appdb_data &data) { return data.content_version; });
+  }
+
+  static constexpr std::size_t num_shards = 64;
+  static constexpr std::size_t sync_interval = 4096;
+
+  struct cached_entry {
+    common::db::kernel_entry entry;
+    bool is_dirty = false;
+  };
+
+  struct alignas(64) shard {
+    std::mutex mutex;
+    std::unordered_map<kernel_configuration::id_type, cached_entry,
+                       kernel_id_hash>
+        entries;
+  };
+
+  common::db::appdb& _appdb;
+  std::size_t _application_run;
+  std::array<shard, num_shards> _shards;
+  std::atomic<std::size_t> _num_updates{0};
+};
+
 int determine_ptr_alignment(uint64_t ptrval) {
   if(ptrval == 0)
     return 0;
@@ -337,16 +444,17 @@ kernel_adaptivity_engine::finalize_binary_configuration(
   if(_adaptivity_level > 1) {
 
     auto base_id = config.generate_id();
+    kernel_configuration unspecialized_config = config;
+    bool has_specialized_arguments = false;
     
     // Automatic application of specialization constants by detecting
     // invariant kernel arguments
-    auto& appdb = common::filesystem::persistent_storage::get().get_this_app_db();
-    appdb.read_write_access([&](common::db::appdb_data& data){
-      
-      auto& kernel_entry = data.kernels[base_id];
+    kernel_statistics_cache::get().access(base_id, [&](
+        common::db::kernel_entry &kernel_entry, std::size_t application_run) {
+
       if (kernel_entry.first_iads_invocation_run ==
           common::db::kernel_entry::no_usage) {
-        kernel_entry.first_iads_invocation_run = data.content_version;
+        kernel_entry.first_iads_invocation_run = application_run;
       }
       ++kernel_entry.num_registered_invocations;
 
@@ -360,7 +468,7 @@ kernel_adaptivity_engine::finalize_binary_configuration(
                     _kernel_info->get_argument_size(i));
         if (_kernel_info->get_argument_type(i) !=
                 hcf_kernel_info::argument_type::pointer &&
-            is_likely_invariant_argument(kernel_entry, i, data.content_version,
+            is_likely_invariant_argument(kernel_entry, i, application_run,
                                          arg_value) &&
             !has_annotation(_kernel_info, i,
                             hcf_kernel_info::annotation_type::specialized)) {
@@ -368,6 +476,7 @@ kernel_adaptivity_engine::finalize_binary_configuration(
                              << " is invariant or common, specializing."
                              << std::endl;
           config.set_specialized_kernel_argument(i, arg_value);
+          has_specialized_arguments = true;
         } else {
           HIPSYCL_DEBUG_INFO << "adaptivity_engine: Not specializing kernel argument " << i
                              << std::endl;
@@ -384,11 +493,19 @@ kernel_adaptivity_engine::finalize_binary_configuration(
         }
       }
     });
+
+    if(has_specialized_arguments)
+      _fallback_config = std::move(unspecialized_config);
   }
 
   return config.generate_id();
 }
 
+const std::optional<kernel_configuration> &
+kernel_adaptivity_engine::get_fallback_configuration() const {
+  return _fallback_config;
+}
+
 std::string kernel_adaptivity_engine::select_image_and_kernels(
     std::vector<std::string> *kernel_names_out) {
   if(_adaptivity_level > 0) {
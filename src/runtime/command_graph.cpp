@@ -0,0 +1,180 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include <algorithm>
+
+#include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/runtime/command_graph.hpp"
+#include "hipSYCL/runtime/dag_manager.hpp"
+#include "hipSYCL/runtime/executor.hpp"
+#include "hipSYCL/runtime/inorder_executor.hpp"
+#include "hipSYCL/runtime/multi_queue_executor.hpp"
+#include "hipSYCL/runtime/operations.hpp"
+#include "hipSYCL/runtime/runtime.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+result make_unsupported_error(const std::string &msg) {
+  return make_error(__acpp_here(),
+                    error_info{"command_graph: " + msg,
+                               error_type::feature_not_supported});
+}
+
+}
+
+command_graph::command_graph(runtime *rt)
+: _rt{rt} {}
+
+result command_graph::record(const dag_node_ptr &node) {
+  if (!node->is_submitted() || node->is_virtual() || node->is_cancelled())
+    return make_unsupported_error(
+        "Only nodes that have been submitted for execution can be recorded");
+
+  operation *op = node->get_operation();
+  if (op->is_requirement())
+    return make_unsupported_error(
+        "Operations with memory requirements (e.g. buffer accessors) cannot "
+        "be recorded");
+
+  backend_executor *executor = node->get_assigned_executor();
+  if (!executor)
+    return make_unsupported_error("Node has not been assigned to an executor");
+
+  // Pin the lane, so that replays don't need to select it again
+  if (auto *multi_queue = dynamic_cast<multi_queue_executor *>(executor)) {
+    executor = multi_queue->get_assigned_lane_executor(node);
+    if (!executor)
+      return make_unsupported_error(
+          "Could not determine execution lane of node");
+  }
+
+  recorded_node recorded{executor, node->get_assigned_device(),
+                         std::type_index{typeid(*op)}, {}, true};
+
+  for (const auto &weak_req : node->get_requirements()) {
+    auto req = weak_req.lock();
+    if (!req)
+      continue;
+    if (req->get_operation()->is_requirement())
+      return make_unsupported_error(
+          "Operations with memory requirements (e.g. buffer accessors) cannot "
+          "be recorded");
+
+    auto it = std::find(_recorded_nodes.begin(), _recorded_nodes.end(), req);
+    // Dependencies on nodes outside of the graph only apply to the
+    // recording, replays have to provide them again.
+    if (it != _recorded_nodes.end()) {
+      std::size_t index = it - _recorded_nodes.begin();
+      recorded.dependencies.push_back(index);
+      _nodes[index].is_sink = false;
+    }
+  }
+
+  _nodes.push_back(std::move(recorded));
+  _recorded_nodes.push_back(node);
+  return make_success();
+}
+
+std::size_t command_graph::get_num_nodes() const { return _nodes.size(); }
+
+void command_graph::begin_replay() {
+  // Recorded nodes are only needed to resolve dependencies while recording
+  _recorded_nodes.clear();
+  _replayed_nodes.clear();
+  _replayed_nodes.reserve(_nodes.size());
+}
+
+result command_graph::replay_next(std::unique_ptr<operation> op,
+                                  const execution_hints &hints,
+                                  const node_list_t &additional_requirements,
+                                  dag_node_ptr &node_out) {
+  const std::size_t index = _replayed_nodes.size();
+  if (index >= _nodes.size())
+    return make_unsupported_error(
+        "Replay submits more operations than have been recorded");
+
+  const recorded_node &recorded = _nodes[index];
+  if (std::type_index{typeid(*op)} != recorded.operation_type)
+    return make_unsupported_error(
+        "Replay submits a different kind of operation than has been recorded");
+
+  node_list_t reqs;
+  for (std::size_t dep : recorded.dependencies) {
+    const dag_node_ptr &req = _replayed_nodes[dep];
+    if (!req->is_known_complete())
+      reqs.push_back(req);
+  }
+  bool has_unsubmitted_requirement = false;
+  for (const auto &req : additional_requirements) {
+    if (req->get_operation()->is_requirement())
+      return make_unsupported_error(
+          "Operations with memory requirements (e.g. buffer accessors) cannot "
+          "be replayed");
+    if (!req->is_submitted())
+      has_unsubmitted_requirement = true;
+  }
+  // The executor can only synchronize with nodes that have been submitted,
+  // so nodes that are still waiting in the DAG need to be flushed first.
+  if (has_unsubmitted_requirement)
+    _rt->dag().flush_sync();
+
+  auto add_requirement = [&](const dag_node_ptr &req) {
+    if (!req->is_known_complete() &&
+        std::find(reqs.begin(), reqs.end(), req) == reqs.end())
+      reqs.push_back(req);
+  };
+  for (const auto &req : additional_requirements) {
+    if (req->is_virtual())
+      req->for_each_nonvirtual_requirement(add_requirement);
+    else
+      add_requirement(req);
+  }
+  for (const auto &req : reqs) {
+    if (!req->is_submitted())
+      return make_error(
+          __acpp_here(),
+          error_info{"command_graph: Dependency of replayed operation could "
+                     "not be submitted"});
+  }
+
+  operation *op_ptr = op.get();
+  dag_node_ptr node = make_dag_node(hints, reqs, std::move(op), _rt);
+  node->assign_to_device(recorded.device);
+  node->assign_to_executor(recorded.executor);
+
+  recorded.executor->submit_directly(node, op_ptr, reqs);
+  op_ptr->get_instrumentations().mark_set_complete();
+  // Operations are referenced by the backend until they have completed
+  _rt->dag().register_external_submission(node);
+
+  _replayed_nodes.push_back(node);
+  node_out = node;
+  return make_success();
+}
+
+result command_graph::end_replay(node_list_t &sinks_out) {
+  if (_replayed_nodes.size() != _nodes.size())
+    return make_unsupported_error(
+        "Replay submits fewer operations than have been recorded");
+
+  for (std::size_t i = 0; i < _nodes.size(); ++i)
+    if (_nodes[i].is_sink)
+      sinks_out.push_back(_replayed_nodes[i]);
+
+  HIPSYCL_DEBUG_INFO << "command_graph: Replayed " << _nodes.size()
+                     << " operations" << std::endl;
+  return make_success();
+}
+
+}
+}
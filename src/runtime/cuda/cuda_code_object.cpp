@@ -63,7 +63,7 @@ void unload_cuda_module(CUmod_st* module, int device) {
 }
 
 result build_cuda_module_from_ptx(CUmod_st *&module, int device,
-                                  const std::string &source) {
+                                  std::string_view source) {
 
   cuda_device_manager::get().activate_device(device);
   // This guarantees that the CUDA runtime API initializes the CUDA
@@ -203,7 +203,7 @@ int cuda_multipass_executable_object::get_device() const {
 }
 
 cuda_sscp_executable_object::cuda_sscp_executable_object(
-    const std::string &ptx_source, const std::string &target_arch,
+    std::string_view ptx_source, const std::string &target_arch,
     hcf_object_id hcf_source, const std::vector<std::string> &kernel_names,
     int device, const kernel_configuration &config)
     : _target_arch{target_arch}, _hcf{hcf_source}, _kernel_names{kernel_names},
@@ -256,7 +256,7 @@ int cuda_sscp_executable_object::get_device() const {
   return _device;
 }
 
-result cuda_sscp_executable_object::build(const std::string& source) {
+result cuda_sscp_executable_object::build(std::string_view source) {
   if (_module != nullptr)
     return make_success();
 
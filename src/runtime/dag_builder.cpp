@@ -166,7 +166,10 @@ dag_node_ptr dag_builder::build_node(std::unique_ptr<operation> op,
           data_user_tracker &user_tracker =
               buff_req->get_data_region()->get_users();
 
-          user_tracker.for_each_user([&](data_user &user) {
+          // Only users that access the same pages can conflict
+          user_tracker.for_each_overlapping_user(
+              mem_req->get_access_offset3d(), mem_req->get_access_range3d(),
+              [&](data_user &user) {
             auto user_ptr = user.user.lock();
             if(user_ptr && is_conflicting_access(mem_req, user))
             {
@@ -180,7 +183,7 @@ dag_node_ptr dag_builder::build_node(std::unique_ptr<operation> op,
     }
   };
 
-  auto operation_node = std::make_shared<dag_node>(
+  auto operation_node = make_dag_node(
       hints, requirements.get(), std::move(op), _rt);
   
   bool is_req = operation_node->get_operation()->is_requirement();
@@ -22,6 +22,7 @@
 #include "hipSYCL/runtime/generic/multi_event.hpp"
 #include "hipSYCL/runtime/serialization/serialization.hpp"
 #include "hipSYCL/runtime/allocator.hpp"
+#include "hipSYCL/runtime/hw_model/hw_model.hpp"
 
 namespace hipsycl {
 namespace rt {
@@ -107,30 +108,78 @@ result ensure_allocation_exists(runtime *rt,
   return make_success();
 }
 
+// Invokes the handler for every operation that needs to be executed for
+// the node. For requirements, this may result in multiple data transfers
+// if the accessed range is assembled from several sources. All but the last
+// of these transfers are wrapped in subnodes of the requirement, which
+// the handler receives as target node.
 void for_each_explicit_operation(
-    dag_node_ptr node, std::function<void(operation *)> explicit_op_handler) {
+    dag_node_ptr node,
+    std::function<void(dag_node_ptr, operation *)> explicit_op_handler) {
   if (node->is_submitted())
     return;
   
   if (!node->get_operation()->is_requirement()) {
-    explicit_op_handler(node->get_operation());
+    explicit_op_handler(node, node->get_operation());
     return;
   } else {
     execute_if_buffer_requirement(node,
                                   [&](buffer_memory_requirement *bmem_req) {
           
           device_id target_device = node->get_assigned_device();
+          std::shared_ptr<buffer_data_region> data =
+              bmem_req->get_data_region();
+          const memcpy_model *model = node->get_runtime()
+                                          ->backends()
+                                          .hardware_model()
+                                          .get_memcpy_model();
 
           std::vector<range_store::rect> outdated_regions;
-          bmem_req->get_data_region()->get_outdated_regions(
+          data->get_outdated_regions(
               target_device, bmem_req->get_access_offset3d(),
               bmem_req->get_access_range3d(), outdated_regions);
 
+          std::vector<std::unique_ptr<operation>> ops;
           for (range_store::rect region : outdated_regions) {
-            std::vector<std::pair<device_id, range_store::rect>> update_sources;
+            memory_location dest{target_device, region.first, data};
 
-            bmem_req->get_data_region()->get_update_source_candidates(
-                target_device, region, update_sources);
+            std::vector<std::pair<device_id, range_store::rect>> update_sources;
+            data->get_update_source_candidates(target_device, region,
+                                               update_sources);
+
+            if (!update_sources.empty()) {
+              std::vector<memory_location> candidates;
+              for (const auto &source : update_sources)
+                candidates.push_back(
+                    memory_location{source.first, region.first, data});
+
+              memory_location src =
+                  model->choose_source(candidates, dest, region.second);
+              ops.push_back(
+                  std::make_unique<memcpy_operation>(src, dest, region.second));
+            } else {
+              // No single allocation holds the entire region, so assemble
+              // it from the cheapest sources that hold parts of it. If parts
+              // are not valid anywhere, the requirement cannot be satisfied.
+              if (!data->get_update_source_fragments(
+                      target_device, region,
+                      [&](device_id source_dev) {
+                        return model->estimate_runtime_cost(
+                            memory_location{source_dev, region.first, data},
+                            dest, region.second);
+                      },
+                      update_sources))
+                update_sources.clear();
+
+              for (const auto &fragment : update_sources) {
+                memory_location fragment_src{fragment.first,
+                                             fragment.second.first, data};
+                memory_location fragment_dest{target_device,
+                                              fragment.second.first, data};
+                ops.push_back(std::make_unique<memcpy_operation>(
+                    fragment_src, fragment_dest, fragment.second.second));
+              }
+            }
 
             if (update_sources.empty()) {
               register_error(
@@ -141,19 +190,27 @@ void for_each_explicit_operation(
               node->cancel();
               return;
             }
+          }
 
-            // Just use first source for now:
-            memory_location src{update_sources[0].first,
-                                update_sources[0].second.first,
-                                bmem_req->get_data_region()};
-            memory_location dest{target_device, region.first,
-                                 bmem_req->get_data_region()};
-            std::unique_ptr<operation> op =
-                std::make_unique<memcpy_operation>(src, dest, region.second);
-
-            explicit_op_handler(op.get());
-            /// TODO This has to be changed once we support multi-operation nodes
-            node->assign_effective_operation(std::move(op));
+          for (std::size_t i = 0; i < ops.size(); ++i) {
+            if (i + 1 < ops.size()) {
+              node_list_t subnode_reqs;
+              for (auto weak_req : node->get_requirements())
+                if (auto req = weak_req.lock())
+                  subnode_reqs.push_back(req);
+
+              operation *op = ops[i].get();
+              auto subnode = make_dag_node(
+                  node->get_execution_hints(), subnode_reqs, std::move(ops[i]),
+                  node->get_runtime());
+              subnode->assign_to_device(target_device);
+
+              explicit_op_handler(subnode, op);
+              node->add_subnode(subnode);
+            } else {
+              explicit_op_handler(node, ops[i].get());
+              node->assign_effective_operation(std::move(ops[i]));
+            }
           }
         });
   }
@@ -254,7 +311,8 @@ result submit_requirement(runtime* rt, dag_node_ptr req) {
                   bmem_req->get_access_range3d());
         });
     if(has_initialized_content){
-      for_each_explicit_operation(req, [&](operation *op) {
+      for_each_explicit_operation(req, [&](dag_node_ptr target,
+                                           operation *op) {
         if (!op->is_data_transfer()) {
           res = make_error(
               __acpp_here(),
@@ -264,7 +322,7 @@ result submit_requirement(runtime* rt, dag_node_ptr req) {
                   error_type::feature_not_supported});
         } else {
           std::pair<backend_executor *, device_id> execution_config =
-              select_executor(rt, req, op);
+              select_executor(rt, target, op);
           // TODO What if we need to copy between two device backends through
           // host?
           
@@ -291,9 +349,9 @@ result submit_requirement(runtime* rt, dag_node_ptr req) {
           // We CANNOT assign_to_device the original device after the submit call,
           // since the executors need to know which device actually has processed
           // the operation to setup dependencies correctly.
-          auto original_device = req->get_assigned_device();
-          req->assign_to_device(execution_config.second);
-          submit(execution_config.first, req, op);
+          auto original_device = target->get_assigned_device();
+          target->assign_to_device(execution_config.second);
+          submit(execution_config.first, target, op);
         }
       });
     }
@@ -157,6 +157,14 @@ void dag_manager::register_submitted_ops(dag_node_ptr node) {
   this->_submitted_ops.update_with_submission(node);
 }
 
+void dag_manager::register_external_submission(const dag_node_ptr &node) {
+  this->register_submitted_ops(node);
+
+  if (this->_submitted_ops.get_num_nodes() >
+      application::get_settings().get<setting::gc_trigger_batch_size>())
+    this->_submitted_ops.async_wait_and_unregister();
+}
+
 void dag_manager::trigger_flush_opportunity()
 {
   HIPSYCL_DEBUG_INFO << "dag_manager: Checking DAG flush opportunity..."
@@ -114,6 +114,12 @@ void dag_node::assign_effective_operation(std::unique_ptr<operation> op)
   _replacement_executed_operation = std::move(op);
 }
 
+void dag_node::add_subnode(dag_node_ptr subnode)
+{
+  _subnodes.push_back(subnode);
+  _requirements.push_back(subnode);
+}
+
 std::size_t dag_node::get_assigned_execution_index() const
 {
   return this->_assigned_execution_index;
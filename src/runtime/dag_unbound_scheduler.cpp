@@ -16,10 +16,53 @@
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/hints.hpp"
 #include "hipSYCL/runtime/hardware.hpp"
+#include "hipSYCL/runtime/instrumentation.hpp"
+#include "hipSYCL/runtime/operations.hpp"
+#include "hipSYCL/runtime/hw_model/hw_model.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
 
 namespace hipsycl {
 namespace rt {
 
+namespace {
+
+uint64_t get_time_now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Kernel runtimes are tracked separately for each problem size,
+// if the problem size is known.
+std::string get_kernel_key(const dag_node_ptr& node) {
+  auto *kernel_op = dynamic_cast<kernel_operation *>(node->get_operation());
+  if(!kernel_op)
+    return {};
+
+  const char* name = kernel_op->get_global_kernel_name();
+  std::string key = name ? name : "<unnamed kernel>";
+  key += "@" + std::to_string(
+                   kernel_op->get_launcher().get_launch_data().global_size.size());
+  return key;
+}
+
+// Weight of a new runtime sample in the moving average
+constexpr double runtime_sample_weight = 0.25;
+// Every launch of a kernel is measured on a device until this many
+// measurements have been requested there. Afterwards, only every
+// runtime_resampling_interval-th launch of the kernel is measured to
+// follow changes in the runtime.
+constexpr std::size_t min_runtime_samples = 4;
+constexpr std::size_t runtime_resampling_interval = 64;
+// Once statistics for more kernels are tracked, the least recently
+// launched half of them is discarded.
+constexpr std::size_t max_tracked_kernels = 1024;
+
+}
+
 dag_unbound_scheduler::dag_unbound_scheduler(runtime* rt)
 : _direct_scheduler{rt}, _rt{rt} {}
 
@@ -29,14 +72,13 @@ void dag_unbound_scheduler::submit(dag_node_ptr node) {
     // when schedulers are constructed the runtime is typically
     // locked because it is just starting up, so this would
     // create a deadlock
-    _rt->backends().for_each_backend([this](backend *b) {
-      std::size_t num_devs = b->get_hardware_manager()->get_num_devices();
-      for (std::size_t i = 0; i < num_devs; ++i) {
-        this->_devices.push_back(b->get_hardware_manager()->get_device_id(i));
-      }
-    });
+    initialize_devices();
   }
 
+  uint64_t now = get_time_now();
+  update_device_states(now);
+  ++_num_submissions;
+
   if(!node->get_execution_hints().has_hint<hints::bind_to_device>()){
     std::vector<rt::device_id> eligible_devices;
     if(node->get_execution_hints().has_hint<hints::bind_to_device_group>()) {
@@ -56,18 +98,263 @@ void dag_unbound_scheduler::submit(dag_node_ptr node) {
       node->cancel();
       return;
     }
-    // Round-robin as placeholder. This is not intended
-    // for anything practical, it's a _placeholder_
-    static std::size_t dev = 0;
-    ++dev;
 
-    rt::device_id target_dev = eligible_devices[dev % eligible_devices.size()];
+    // With a single candidate there is no placement decision to make, so
+    // runtimes are neither needed nor measured.
+    std::string kernel_key;
+    kernel_statistics* stats = nullptr;
+    if(eligible_devices.size() > 1) {
+      kernel_key = get_kernel_key(node);
+      if(!kernel_key.empty())
+        stats = &get_kernel_statistics(kernel_key);
+    }
+
+    std::size_t best_device_index = 0;
+    cost_type best_finish_time = std::numeric_limits<cost_type>::max();
+
+    for(const device_id& dev : eligible_devices) {
+      std::size_t dev_index = get_device_index(dev);
+      const device_state& state = _device_states[dev_index];
+
+      cost_type execution_cost = 0.0;
+      if(stats) {
+        // Without measurements, assume that the kernel is fast on this
+        // device, so that every eligible device is tried eventually.
+        execution_cost =
+            std::max(estimate_execution_cost(*stats, dev_index), 0.0);
+      }
+
+      cost_type start_time =
+          static_cast<cost_type>(std::max(now, state.available_time) - now);
+      cost_type finish_time = start_time +
+                              estimate_data_transfer_cost(node, dev) +
+                              execution_cost;
+
+      bool is_better = finish_time < best_finish_time;
+      if(finish_time == best_finish_time)
+        is_better = state.in_flight_nodes.size() <
+                    _device_states[best_device_index].in_flight_nodes.size();
+      if(is_better) {
+        best_finish_time = finish_time;
+        best_device_index = dev_index;
+      }
+    }
+
+    HIPSYCL_DEBUG_INFO << "dag_unbound_scheduler: Binding node " << node.get()
+                       << " to device " << best_device_index
+                       << ", estimated finish time: " << best_finish_time
+                       << " ns" << std::endl;
+
+    device_state& target_state = _device_states[best_device_index];
+    target_state.available_time =
+        now + static_cast<uint64_t>(best_finish_time);
+
+    // Measure the kernel runtime to improve future estimates
+    if(stats && needs_runtime_measurement(*stats, best_device_index)) {
+      node->get_execution_hints().set_hint(
+          hints::request_instrumentation_start_timestamp{});
+      node->get_execution_hints().set_hint(
+          hints::request_instrumentation_finish_timestamp{});
+    } else {
+      kernel_key.clear();
+    }
+    target_state.in_flight_nodes.push_back(
+        in_flight_node{node, std::move(kernel_key)});
+
+    rt::device_id target_dev = _devices[best_device_index];
     node->get_execution_hints().set_hint(rt::hints::bind_to_device{target_dev});
   }
 
   _direct_scheduler.submit(node);
 }
 
+void dag_unbound_scheduler::initialize_devices() {
+  _rt->backends().for_each_backend([this](backend *b) {
+    std::size_t num_devs = b->get_hardware_manager()->get_num_devices();
+    for (std::size_t i = 0; i < num_devs; ++i) {
+      this->_devices.push_back(b->get_hardware_manager()->get_device_id(i));
+    }
+  });
+  _device_states.resize(_devices.size());
+}
+
+std::size_t dag_unbound_scheduler::get_device_index(device_id dev) {
+  auto it = std::find(_devices.begin(), _devices.end(), dev);
+  if(it != _devices.end())
+    return std::distance(_devices.begin(), it);
+
+  _devices.push_back(dev);
+  _device_states.push_back(device_state{});
+  return _devices.size() - 1;
+}
+
+void dag_unbound_scheduler::update_device_states(uint64_t now) {
+  for(std::size_t i = 0; i < _device_states.size(); ++i) {
+    device_state &state = _device_states[i];
+    if(state.in_flight_nodes.empty())
+      continue;
+    // Nodes mostly complete in the order in which they were submitted to
+    // a device, so only poll until the first incomplete node. Nodes that
+    // completed out of order are retired once the nodes before them have
+    // completed.
+    while(!state.in_flight_nodes.empty()) {
+      const in_flight_node &entry = state.in_flight_nodes.front();
+      dag_node_ptr node = entry.node.lock();
+      if(node && !node->is_complete())
+        break;
+      if(node && !node->is_cancelled() && !entry.kernel_key.empty())
+        update_kernel_runtime(node, entry.kernel_key, i);
+      state.in_flight_nodes.pop_front();
+    }
+    // Once everything has completed, the device is idle regardless
+    // of what we have estimated previously.
+    if(state.in_flight_nodes.empty())
+      state.available_time = now;
+  }
 }
+
+void dag_unbound_scheduler::update_kernel_runtime(const dag_node_ptr &node,
+                                                  const std::string &kernel_key,
+                                                  std::size_t device_index) {
+  const instrumentation_set &instr =
+      node->get_operation()->get_instrumentations();
+  auto start = instr.get<instrumentations::execution_start_timestamp>();
+  auto finish = instr.get<instrumentations::execution_finish_timestamp>();
+  if(!start || !finish)
+    return;
+
+  double runtime =
+      static_cast<double>(profiler_clock::ns_ticks(finish->get_time_point())) -
+      static_cast<double>(profiler_clock::ns_ticks(start->get_time_point()));
+
+  // The statistics may have been evicted in the meantime
+  auto it = _kernel_statistics.find(kernel_key);
+  if(it == _kernel_statistics.end())
+    return;
+
+  std::vector<kernel_runtime> &runtimes = it->second.devices;
+  if(runtimes.size() < _devices.size())
+    runtimes.resize(_devices.size());
+
+  double &average = runtimes[device_index].average;
+  if(average < 0.0)
+    average = runtime;
+  else
+    average = (1.0 - runtime_sample_weight) * average +
+              runtime_sample_weight * runtime;
 }
 
+cost_type
+dag_unbound_scheduler::estimate_data_transfer_cost(const dag_node_ptr &node,
+                                                   device_id dev) const {
+  const memcpy_model *model =
+      _rt->backends().hardware_model().get_memcpy_model();
+
+  cost_type cost = 0.0;
+  for(auto weak_req : node->get_requirements()) {
+    dag_node_ptr req = weak_req.lock();
+    if(!req || !req->get_operation()->is_requirement())
+      continue;
+    if(!cast<requirement>(req->get_operation())->is_memory_requirement())
+      continue;
+    auto *mem_req = cast<memory_requirement>(req->get_operation());
+    if(!mem_req->is_buffer_requirement())
+      continue;
+    auto *bmem_req = cast<buffer_memory_requirement>(mem_req);
+
+    sycl::access::mode mode = bmem_req->get_access_mode();
+    if(mode == sycl::access::mode::discard_write ||
+       mode == sycl::access::mode::discard_read_write)
+      continue;
+
+    std::shared_ptr<buffer_data_region> data = bmem_req->get_data_region();
+    id<3> offset = bmem_req->get_access_offset3d();
+    range<3> size = bmem_req->get_access_range3d();
+    if(!data->has_initialized_content(offset, size))
+      continue;
+
+    std::vector<range_store::rect> outdated_regions;
+    if(data->has_allocation(dev))
+      data->get_outdated_regions(dev, offset, size, outdated_regions);
+    else
+      outdated_regions.push_back(std::make_pair(offset, size));
+
+    std::vector<std::pair<device_id, range_store::rect>> fragments;
+    for(const range_store::rect& region : outdated_regions) {
+      std::size_t region_bytes = region.second.size() * data->get_element_size();
+      data->get_update_source_fragments(
+          dev, region,
+          [&](device_id source) {
+            return model->estimate_transfer_time(source, dev, region_bytes);
+          },
+          fragments);
+      for(const auto& fragment : fragments)
+        cost += model->estimate_transfer_time(
+            fragment.first, dev,
+            fragment.second.second.size() * data->get_element_size());
+    }
+  }
+  return cost;
+}
+
+cost_type
+dag_unbound_scheduler::estimate_execution_cost(const kernel_statistics &stats,
+                                               std::size_t device_index) const {
+  if(device_index >= stats.devices.size())
+    return -1.0;
+  return stats.devices[device_index].average;
+}
+
+bool dag_unbound_scheduler::needs_runtime_measurement(
+    kernel_statistics &stats, std::size_t device_index) const {
+  if(stats.devices.size() < _devices.size())
+    stats.devices.resize(_devices.size());
+
+  std::size_t &num_requested =
+      stats.devices[device_index].num_requested_samples;
+  if(num_requested < min_runtime_samples ||
+     stats.num_launches % runtime_resampling_interval == 0) {
+    ++num_requested;
+    return true;
+  }
+  return false;
+}
+
+dag_unbound_scheduler::kernel_statistics &
+dag_unbound_scheduler::get_kernel_statistics(const std::string &kernel_key) {
+  auto it = _kernel_statistics.find(kernel_key);
+  if(it == _kernel_statistics.end()) {
+    if(_kernel_statistics.size() >= max_tracked_kernels)
+      evict_unused_kernel_statistics();
+    it = _kernel_statistics.emplace(kernel_key, kernel_statistics{}).first;
+  }
+  kernel_statistics &stats = it->second;
+  ++stats.num_launches;
+  stats.last_use = _num_submissions;
+  return stats;
+}
+
+void dag_unbound_scheduler::evict_unused_kernel_statistics() {
+  std::vector<uint64_t> last_uses;
+  last_uses.reserve(_kernel_statistics.size());
+  for(const auto& entry : _kernel_statistics)
+    last_uses.push_back(entry.second.last_use);
+
+  auto median = last_uses.begin() + last_uses.size() / 2;
+  std::nth_element(last_uses.begin(), median, last_uses.end());
+  uint64_t threshold = *median;
+
+  HIPSYCL_DEBUG_INFO << "dag_unbound_scheduler: Discarding runtime statistics "
+                        "of kernels not launched since submission "
+                     << threshold << std::endl;
+
+  for(auto it = _kernel_statistics.begin(); it != _kernel_statistics.end();) {
+    if(it->second.last_use < threshold)
+      it = _kernel_statistics.erase(it);
+    else
+      ++it;
+  }
+}
+
+}
+}
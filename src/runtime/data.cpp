@@ -18,76 +18,504 @@
 namespace hipsycl {
 namespace rt {
 
+data_user_tracker::data_user_tracker()
+: data_user_tracker{range<3>{1, 1, 1}, range<3>{1, 1, 1}} {}
+
+data_user_tracker::data_user_tracker(range<3> num_elements, range<3> page_size)
+: _page_size{page_size} {
+  range<3> num_pages;
+  int num_partitioned_dims = 0;
+  for(int i = 0; i < 3; ++i) {
+    assert(page_size[i] > 0);
+    num_pages[i] = std::max<std::size_t>(
+        (num_elements[i] + page_size[i] - 1) / page_size[i], 1);
+    if(num_pages[i] > 1)
+      ++num_partitioned_dims;
+  }
+
+  // Distribute the bucket budget evenly among the dimensions
+  // that consist of multiple pages
+  std::size_t max_buckets_per_dim = max_num_buckets;
+  if(num_partitioned_dims > 1) {
+    max_buckets_per_dim = 1;
+    auto budget_used = [&](std::size_t n) {
+      std::size_t total = 1;
+      for(int i = 0; i < num_partitioned_dims; ++i)
+        total *= n;
+      return total;
+    };
+    while(budget_used(max_buckets_per_dim + 1) <= max_num_buckets)
+      ++max_buckets_per_dim;
+  }
+
+  for(int i = 0; i < 3; ++i) {
+    std::size_t num_buckets = std::min(num_pages[i], max_buckets_per_dim);
+    _pages_per_bucket[i] = (num_pages[i] + num_buckets - 1) / num_buckets;
+    _num_buckets[i] =
+        (num_pages[i] + _pages_per_bucket[i] - 1) / _pages_per_bucket[i];
+  }
+  _buckets.resize(_num_buckets.size());
+}
+
 data_user_tracker::data_user_tracker(const data_user_tracker& other){
-  _users = other._users;
+  std::lock_guard<std::mutex> lock{other._lock};
+  _pages_per_bucket = other._pages_per_bucket;
+  _num_buckets = other._num_buckets;
+  _page_size = other._page_size;
+  _entries = other._entries;
+  _free_entries = other._free_entries;
+  _buckets = other._buckets;
+  _unindexed_entries = other._unindexed_entries;
+  _current_visit_id = other._current_visit_id;
+  _num_users = other._num_users;
 }
 
 data_user_tracker::data_user_tracker(data_user_tracker&& other)
-: _users{std::move(other._users)}
 {
-  _users = other._users;
+  move_from(other);
 }
 
 data_user_tracker& 
 data_user_tracker::operator=(data_user_tracker other){
-  _users = other._users;
+  move_from(other);
   return *this;
 }
 
 
 data_user_tracker& 
 data_user_tracker::operator=(data_user_tracker&& other){
-  _users = std::move(other._users);
+  move_from(other);
   return *this;
 }
 
+void data_user_tracker::move_from(data_user_tracker& other) {
+  std::lock_guard<std::mutex> lock{_lock};
+  _pages_per_bucket = other._pages_per_bucket;
+  _num_buckets = other._num_buckets;
+  _page_size = other._page_size;
+  _entries = std::move(other._entries);
+  _free_entries = std::move(other._free_entries);
+  _buckets = std::move(other._buckets);
+  _unindexed_entries = std::move(other._unindexed_entries);
+  _current_visit_id = other._current_visit_id;
+  _num_users = other._num_users;
+}
+
 const std::vector<data_user>
 data_user_tracker::get_users() const
 { 
   std::lock_guard<std::mutex> lock{_lock};
-  return _users;
+  std::vector<data_user> users;
+  users.reserve(_num_users);
+  for(const user_entry& entry : _entries)
+    if(entry.is_used)
+      users.push_back(entry.user);
+  return users;
 }
 
+std::size_t data_user_tracker::get_num_users() const {
+  std::lock_guard<std::mutex> lock{_lock};
+  return _num_users;
+}
 
 bool data_user_tracker::has_user(dag_node_ptr user) const
 {
   std::lock_guard<std::mutex> lock{_lock};
-  return std::find_if(_users.begin(), _users.end(), [user](const data_user &u) {
-           return u.user.lock() == user;
-         }) != _users.end();
+  return std::find_if(_entries.begin(), _entries.end(),
+                      [user](const user_entry &e) {
+                        return e.is_used && e.user.user.lock() == user;
+                      }) != _entries.end();
 }
 
 void data_user_tracker::release_dead_users()
 {
   std::lock_guard<std::mutex> lock{_lock};
-  _users.erase(std::remove_if(_users.begin(), _users.end(),
-                              [](const data_user &user) -> bool {
-                                auto u = user.user.lock();
-                                if (!u)
-                                  return true;
-                                return u->is_known_complete();
-                              }),
-               _users.end());
+  for(std::size_t i = 0; i < _entries.size(); ++i) {
+    if(_entries[i].is_used) {
+      auto u = _entries[i].user.user.lock();
+      if(!u || u->is_known_complete())
+        remove_entry(i);
+    }
+  }
+}
+
+bool data_user_tracker::get_bucket_rect(id<3> offset, range<3> range,
+                                        bucket_rect &out) const {
+  for(int i = 0; i < 3; ++i) {
+    if(range[i] == 0)
+      return false;
+    std::size_t page_begin = offset[i] / _page_size[i];
+    std::size_t page_end =
+        (offset[i] + range[i] + _page_size[i] - 1) / _page_size[i];
+
+    // Clamping preserves the overlap between ranges, so out-of-bounds
+    // accesses are still found.
+    std::size_t bucket_begin =
+        std::min(page_begin / _pages_per_bucket[i], _num_buckets[i] - 1);
+    std::size_t bucket_end = std::min(
+        (page_end + _pages_per_bucket[i] - 1) / _pages_per_bucket[i],
+        _num_buckets[i]);
+    out.first[i] = bucket_begin;
+    out.second[i] = bucket_end - bucket_begin;
+  }
+  return true;
+}
+
+std::size_t data_user_tracker::get_bucket_index(id<3> bucket) const {
+  return bucket[0] * _num_buckets[1] * _num_buckets[2] +
+         bucket[1] * _num_buckets[2] + bucket[2];
+}
+
+void data_user_tracker::insert_entry(const data_user& user) {
+  std::size_t entry;
+  if(!_free_entries.empty()) {
+    entry = _free_entries.back();
+    _free_entries.pop_back();
+    _entries[entry] = user_entry{user, 0, true};
+  } else {
+    entry = _entries.size();
+    _entries.push_back(user_entry{user, 0, true});
+  }
+  ++_num_users;
+
+  bucket_rect r;
+  if(!get_bucket_rect(user.offset, user.range, r) ||
+     r.second.size() > max_buckets_per_user) {
+    _unindexed_entries.push_back(entry);
+    return;
+  }
+  for_each_bucket(r, [&](std::vector<std::size_t>& bucket) {
+    bucket.push_back(entry);
+  });
+}
+
+void data_user_tracker::remove_entry(std::size_t entry) {
+  auto remove_from = [entry](std::vector<std::size_t>& entries) {
+    auto it = std::find(entries.begin(), entries.end(), entry);
+    assert(it != entries.end());
+    *it = entries.back();
+    entries.pop_back();
+  };
+
+  const data_user& user = _entries[entry].user;
+  bucket_rect r;
+  if(!get_bucket_rect(user.offset, user.range, r) ||
+     r.second.size() > max_buckets_per_user)
+    remove_from(_unindexed_entries);
+  else
+    for_each_bucket(r, remove_from);
+
+  _entries[entry].is_used = false;
+  _entries[entry].user = data_user{};
+  _free_entries.push_back(entry);
+  --_num_users;
+}
+
+namespace {
+
+using rect = range_store::rect;
+
+bool is_empty_rect(const rect& r) {
+  return r.second[0] == 0 || r.second[1] == 0 || r.second[2] == 0;
+}
+
+std::size_t get_volume(const rect& r) {
+  return r.second[0] * r.second[1] * r.second[2];
+}
+
+bool get_overlap(const rect& a, const rect& b, rect& out) {
+  for(int i = 0; i < 3; ++i) {
+    std::size_t begin = std::max(a.first[i], b.first[i]);
+    std::size_t end = std::min(a.first[i] + a.second[i],
+                               b.first[i] + b.second[i]);
+    if(begin >= end)
+      return false;
+    out.first[i] = begin;
+    out.second[i] = end - begin;
+  }
+  return true;
+}
+
+bool overlaps(const rect& a, const rect& b) {
+  rect unused;
+  return get_overlap(a, b, unused);
+}
+
+// Returns true if a and b share part of a face, i.e. if they might
+// be mergeable after other rects have been merged with them.
+bool touches(const rect& a, const rect& b) {
+  int num_adjacent_dims = 0;
+  for(int i = 0; i < 3; ++i) {
+    std::size_t a_end = a.first[i] + a.second[i];
+    std::size_t b_end = b.first[i] + b.second[i];
+    if(a_end == b.first[i] || b_end == a.first[i])
+      ++num_adjacent_dims;
+    else if(a_end < b.first[i] || b_end < a.first[i])
+      return false;
+  }
+  return num_adjacent_dims == 1;
+}
+
+// Appends the pieces of a that are not covered by b to out. Generates
+// at most six pieces by slicing off the parts of a that lie before and
+// after b in each dimension.
+void subtract(const rect& a, const rect& b, std::vector<rect>& out) {
+  rect overlap;
+  if(!get_overlap(a, b, overlap)) {
+    out.push_back(a);
+    return;
+  }
+
+  rect remainder = a;
+  for(int i = 0; i < 3; ++i) {
+    std::size_t remainder_end = remainder.first[i] + remainder.second[i];
+    std::size_t overlap_end = overlap.first[i] + overlap.second[i];
+
+    if(overlap.first[i] > remainder.first[i]) {
+      rect before = remainder;
+      before.second[i] = overlap.first[i] - remainder.first[i];
+      out.push_back(before);
+    }
+    if(overlap_end < remainder_end) {
+      rect after = remainder;
+      after.first[i] = overlap_end;
+      after.second[i] = remainder_end - overlap_end;
+      out.push_back(after);
+    }
+    remainder.first[i] = overlap.first[i];
+    remainder.second[i] = overlap.second[i];
+  }
+}
+
+// Appends the parts of r that are not covered by any of the given disjoint
+// rects, which must lie within r. r is swept along dim, and split into slabs
+// at the faces of the covered rects. Each slab is then processed along the
+// next dimension with the covered rects that span it. Every covered rect
+// is only visited for the slabs it spans, unlike when subtracting the
+// covered rects one by one from all pieces produced so far.
+void complement_within(const rect& r, std::vector<rect>& covered, int dim,
+                       std::vector<rect>& out) {
+  if(covered.empty()) {
+    out.push_back(r);
+    return;
+  }
+
+  auto end_of = [dim](const rect &c) { return c.first[dim] + c.second[dim]; };
+
+  std::sort(covered.begin(), covered.end(), [dim](const rect& a, const rect& b){
+    return a.first[dim] < b.first[dim];
+  });
+
+  // In the last dimension, the covered rects span r in all other dimensions
+  // and are disjoint, so the gaps between them are what remains.
+  if(dim == 2) {
+    std::size_t gap_begin = r.first[dim];
+    for(const rect& c : covered) {
+      if(c.first[dim] > gap_begin) {
+        rect gap = r;
+        gap.first[dim] = gap_begin;
+        gap.second[dim] = c.first[dim] - gap_begin;
+        out.push_back(gap);
+      }
+      gap_begin = end_of(c);
+    }
+    if(gap_begin < end_of(r)) {
+      rect gap = r;
+      gap.first[dim] = gap_begin;
+      gap.second[dim] = end_of(r) - gap_begin;
+      out.push_back(gap);
+    }
+    return;
+  }
+
+  std::vector<rect> active;
+  std::vector<rect> spanning;
+  std::size_t next = 0;
+  std::size_t slab_begin = r.first[dim];
+  std::size_t previous_pieces_begin = 0;
+  std::size_t previous_pieces_end = 0;
+  std::size_t num_previous_pieces = 0;
+  const std::size_t r_end = end_of(r);
+  while(slab_begin < r_end) {
+    active.erase(std::remove_if(active.begin(), active.end(),
+                                [&](const rect &c) {
+                                  return end_of(c) <= slab_begin;
+                                }),
+                 active.end());
+    for(; next < covered.size() && covered[next].first[dim] <= slab_begin;
+        ++next)
+      active.push_back(covered[next]);
+
+    std::size_t slab_end = r_end;
+    if(next < covered.size())
+      slab_end = std::min(slab_end, covered[next].first[dim]);
+    for(const rect& c : active)
+      slab_end = std::min(slab_end, end_of(c));
+
+    rect slab = r;
+    slab.first[dim] = slab_begin;
+    slab.second[dim] = slab_end - slab_begin;
+
+    spanning.clear();
+    for(rect c : active) {
+      c.first[dim] = slab.first[dim];
+      c.second[dim] = slab.second[dim];
+      spanning.push_back(c);
+    }
+    std::size_t slab_pieces_begin = out.size();
+    complement_within(slab, spanning, dim + 1, out);
+
+    // If this slab has the same cross-section as the previous one, extend
+    // the pieces of the previous slab instead.
+    std::size_t num_slab_pieces = out.size() - slab_pieces_begin;
+    bool extends_previous = num_slab_pieces > 0 &&
+                            num_slab_pieces == num_previous_pieces &&
+                            previous_pieces_end == slab_pieces_begin;
+    for(std::size_t i = 0; i < num_slab_pieces && extends_previous; ++i) {
+      const rect &previous = out[previous_pieces_begin + i];
+      const rect &current = out[slab_pieces_begin + i];
+      for(int j = 0; j < 3; ++j)
+        if(j != dim && (previous.first[j] != current.first[j] ||
+                        previous.second[j] != current.second[j]))
+          extends_previous = false;
+      if(end_of(previous) != current.first[dim])
+        extends_previous = false;
+    }
+    if(extends_previous) {
+      for(std::size_t i = 0; i < num_slab_pieces; ++i)
+        out[previous_pieces_begin + i].second[dim] += slab.second[dim];
+      out.resize(slab_pieces_begin);
+    } else {
+      previous_pieces_begin = slab_pieces_begin;
+      num_previous_pieces = num_slab_pieces;
+      previous_pieces_end = out.size();
+    }
+
+    slab_begin = slab_end;
+  }
+}
+
+// Merges rects that are adjacent along dimension dim and have the same
+// extent in the other dimensions. Returns whether any rects were merged.
+bool merge_along(std::vector<rect>& rects, int dim) {
+  if(rects.size() < 2)
+    return false;
+
+  auto same_extent_in_other_dims = [dim](const rect &a, const rect &b) {
+    for(int i = 0; i < 3; ++i)
+      if(i != dim && (a.first[i] != b.first[i] || a.second[i] != b.second[i]))
+        return false;
+    return true;
+  };
+  // Orders rects by their extent in the other dimensions first, so that
+  // rects that may be merged end up next to each other.
+  const int d0 = dim == 0 ? 1 : 0;
+  const int d1 = dim == 2 ? 1 : 2;
+  std::sort(rects.begin(), rects.end(), [=](const rect &a, const rect &b) {
+    if(a.first[d0] != b.first[d0])
+      return a.first[d0] < b.first[d0];
+    if(a.first[d1] != b.first[d1])
+      return a.first[d1] < b.first[d1];
+    if(a.second[d0] != b.second[d0])
+      return a.second[d0] < b.second[d0];
+    if(a.second[d1] != b.second[d1])
+      return a.second[d1] < b.second[d1];
+    return a.first[dim] < b.first[dim];
+  });
+
+  std::size_t last = 0;
+  for(std::size_t i = 1; i < rects.size(); ++i) {
+    rect& current = rects[last];
+    if(same_extent_in_other_dims(current, rects[i]) &&
+       current.first[dim] + current.second[dim] == rects[i].first[dim]) {
+      current.second[dim] += rects[i].second[dim];
+    } else {
+      rects[++last] = rects[i];
+    }
+  }
+  bool has_merged = last + 1 < rects.size();
+  rects.resize(last + 1);
+  return has_merged;
+}
+
 }
 
 range_store::range_store(range<3> size)
-: _size{size}, _contained_data(size.size())
+: _size{size}
 {}
 
+void range_store::coalesce(std::vector<rect>& rects)
+{
+  // Each round sweeps once along every dimension. Merging along one
+  // dimension can enable merges along another, but coalescing does not need
+  // to be maximal, so the number of rounds is bounded to keep the cost
+  // at O(f log f) for f rects.
+  constexpr int max_rounds = 2;
+  for(int round = 0; round < max_rounds; ++round) {
+    bool has_merged = false;
+    for(int dim = 2; dim >= 0; --dim)
+      has_merged |= merge_along(rects, dim);
+    if(!has_merged)
+      return;
+  }
+}
+
 void range_store::add(const rect& r)
 {
-  this->for_each_element_in_range(r,
-    [](id<3>, data_state& s){
-      s = data_state::available;
-    });
+  if(is_empty_rect(r))
+    return;
+
+  remove(r);
+  // The existing rects have already been coalesced, so only rects that
+  // touch the new rect, or the rects it has been merged with, need to be
+  // considered. Like coalesce(), this is bounded to a few rounds.
+  std::vector<rect> neighborhood{r};
+  constexpr int max_rounds = 2;
+  for(int round = 0; round < max_rounds; ++round) {
+    std::size_t num_neighbors = neighborhood.size();
+    for(std::size_t i = 0; i < _available_rects.size();) {
+      bool is_touching = false;
+      for(std::size_t j = 0; j < num_neighbors && !is_touching; ++j)
+        is_touching = touches(_available_rects[i], neighborhood[j]);
+      if(is_touching) {
+        neighborhood.push_back(_available_rects[i]);
+        _available_rects[i] = _available_rects.back();
+        _available_rects.pop_back();
+      } else {
+        ++i;
+      }
+    }
+    if(neighborhood.size() == num_neighbors)
+      break;
+    coalesce(neighborhood);
+  }
+  _available_rects.insert(_available_rects.end(), neighborhood.begin(),
+                          neighborhood.end());
 }
 
 void range_store::remove(const rect& r)
 {
-  this->for_each_element_in_range(r, 
-    [](id<3>, data_state& s){
-      s = data_state::empty;
-    });
+  if(is_empty_rect(r))
+    return;
+
+  std::vector<rect> remaining;
+  remaining.reserve(_available_rects.size());
+  std::vector<rect> pieces;
+  bool was_modified = false;
+  for(const rect& current : _available_rects) {
+    if(overlaps(current, r)) {
+      subtract(current, r, pieces);
+      was_modified = true;
+    } else {
+      remaining.push_back(current);
+    }
+  }
+
+  if(was_modified) {
+    coalesce(pieces);
+    remaining.insert(remaining.end(), pieces.begin(), pieces.end());
+    _available_rects = std::move(remaining);
+  }
 }
 
 range<3> range_store::get_size() const
@@ -98,63 +526,58 @@ void range_store::intersections_with(const rect& r,
                                     std::vector<rect>& out) const
 {
   out.clear();
-  
-  id<3> rect_begin = r.first;
-  id<3> rect_max = 
-    rect_begin + id<3>{r.second[0], r.second[1], r.second[2]};
-
-
-  std::vector<data_state> visited_entries(_contained_data.size(), data_state::empty);
-
-  this->for_each_element_in_range(r, [&](id<3> pos, const data_state& entry){
-    size_t linear_pos = get_index(pos);
-    // Look for a potential new rect, if
-    // * the starting position is of the state desired by the user
-    // * the start position isn't covered already by another rect
-    //   that was found previously
-    if(entry == desired_state && 
-      visited_entries[linear_pos] == data_state::empty) {
-        
-      // Find the largest contiguous rect for which all entries
-      // are both of \c desired_state and unvisited
-      range<3> rect_size = 
-        find_max_contiguous_rect_extent(pos, rect_max, 
-          [this,&visited_entries,desired_state](size_t linear_pos){
-            return this->_contained_data[linear_pos] == desired_state
-              && visited_entries[linear_pos] == data_state::empty;
-          });
-
-      rect found_rect = std::make_pair(pos, rect_size);
-      out.push_back(found_rect);
-
-      // Mark all pages inside the rect as visited
-      this->for_each_element_in_range(
-        found_rect, 
-        visited_entries,
-        [&](id<3> pos, data_state& entry){
-
-          entry = data_state::available;
-      });
+
+  if(is_empty_rect(r))
+    return;
+
+  if(desired_state == data_state::available) {
+    rect overlap;
+    bool is_clipped = false;
+    for(const rect& current : _available_rects) {
+      if(get_overlap(current, r, overlap)) {
+        out.push_back(overlap);
+        is_clipped |= !(overlap == current);
+      }
     }
-  });
+    // Unclipped rects have already been coalesced
+    if(!is_clipped)
+      return;
+  } else {
+    std::vector<rect> covered;
+    rect overlap;
+    for(const rect& current : _available_rects) {
+      if(get_overlap(current, r, overlap))
+        covered.push_back(overlap);
+    }
+    // Already merges slabs with identical cross-sections
+    complement_within(r, covered, 0, out);
+    return;
+  }
+  coalesce(out);
 }
 
 bool range_store::entire_range_equals(
     const rect& r, data_state desired_state) const
 {
-  for(size_t x = r.first[0]; x < r.second[0]+r.first[0]; ++x){
-    for(size_t y = r.first[1]; y < r.second[1]+r.first[1]; ++y){
-      for(size_t z = r.first[2]; z < r.second[2]+r.first[2]; ++z){
-
-        id<3> idx{x,y,z};
-        size_t pos = get_index(idx);
-        if(_contained_data[pos] != desired_state)
-          return false;
-      }
-    }
+  if(is_empty_rect(r))
+    return true;
+
+  if(desired_state == data_state::empty) {
+    for(const rect& current : _available_rects)
+      if(overlaps(current, r))
+        return false;
+    return true;
   }
 
-  return true;
+  // Available rects are disjoint, so their overlaps with r cover r entirely
+  // iff the overlap volumes add up to the volume of r.
+  std::size_t covered_volume = 0;
+  rect overlap;
+  for(const rect& current : _available_rects) {
+    if(get_overlap(current, r, overlap))
+      covered_volume += get_volume(overlap);
+  }
+  return covered_volume == get_volume(r);
 }
 
 }
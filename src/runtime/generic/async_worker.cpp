@@ -17,8 +17,27 @@
 namespace hipsycl {
 namespace rt {
 
+namespace {
+
+// Number of times the worker (or a thread in wait()) yields before
+// going to sleep on a condition variable.
+constexpr int num_spin_iterations = 64;
+
+template<class Predicate>
+bool spin_until(Predicate p) {
+  for(int i = 0; i < num_spin_iterations; ++i) {
+    if(p())
+      return true;
+    std::this_thread::yield();
+  }
+  return p();
+}
+
+}
+
 worker_thread::worker_thread()
-    : _continue{true}
+    : _continue{true}, _num_pending_tasks{0}, _is_worker_parked{false},
+      _num_waiting_threads{0}, _is_overflow_active{false}
 {
   _worker_thread = std::thread{[this](){ work(); } };
 }
@@ -28,20 +47,24 @@ worker_thread::~worker_thread()
 {
   halt();
 
-  assert(_enqueued_operations.empty());
+  assert(queue_size() == 0);
 }
 
 void worker_thread::wait()
 {
-  std::unique_lock<std::mutex> lock(_mutex);
-  if(!_enqueued_operations.empty())
+  auto is_drained = [this]() { return _num_pending_tasks.load() == 0; };
+  if(spin_until(is_drained))
+    return;
+
+  ++_num_waiting_threads;
   {
-    // Before going to sleep, wake up the other thread to avoid deadlocks
-    _condition_wait.notify_all();
+    std::unique_lock<std::mutex> lock(_mutex);
     // Wait until no operation is pending
-    _condition_wait.wait(lock, [this]{return _enqueued_operations.empty();});
+    _queue_drained.wait(lock, is_drained);
   }
-  assert(_enqueued_operations.empty());
+  --_num_waiting_threads;
+
+  assert(queue_size() == 0);
 }
 
 
@@ -52,8 +75,9 @@ void worker_thread::halt()
   {
     std::unique_lock<std::mutex> lock(_mutex);
     _continue = false;
-    _condition_wait.notify_all();
   }
+  _work_available.notify_all();
+
   if(_worker_thread.joinable())
     _worker_thread.join();
 }
@@ -62,65 +86,100 @@ void worker_thread::work()
 {
   // This is the main function executed by the worker thread.
   // The loop is executed as long as there are enqueued operations,
-  // (_is_operation_pending) or we should wait for new operations
-  // (_continue).
-  while(_continue || queue_size() > 0)
-  {
-    {
-      std::unique_lock<std::mutex> lock(_mutex);
-
-      // Before going to sleep, wake up the other thread in case it is is waiting
-      // for the queue to get empty
-      _condition_wait.notify_all();
-      // Wait until we have work, or until _continue becomes false
-      _condition_wait.wait(lock,
-                           [this](){
-        return _enqueued_operations.size()>0 || !_continue;
-      });
+  // or we should wait for new operations (_continue).
+  detail::worker_task operation;
+  auto has_work = [this]() { return _num_pending_tasks.load() > 0; };
+
+  for(;;) {
+    if(try_dequeue(operation)) {
+      operation();
+      operation.reset();
+      notify_task_completed();
+      continue;
     }
 
-    // In any way, process the pending operations
+    // Pending tasks that we could not dequeue are currently
+    // being published by a producer; just retry.
+    if(spin_until(has_work))
+      continue;
 
-    async_function operation = [](){};
-    bool has_operation = false;
+    if(!_continue)
+      return;
 
+    _is_worker_parked = true;
     {
-      std::lock_guard<std::mutex> lock(_mutex);
-
-      if(!_enqueued_operations.empty())
-      {
-        operation = _enqueued_operations.front();
-        has_operation = true;
-      }
+      std::unique_lock<std::mutex> lock(_mutex);
+      // Wait until we have work, or until _continue becomes false
+      _work_available.wait(lock, [&]() { return has_work() || !_continue; });
     }
+    _is_worker_parked = false;
+  }
+}
 
-    operation();
-
-    {
-      std::lock_guard<std::mutex> lock{_mutex};
-      if(has_operation)
-        _enqueued_operations.pop();
+void worker_thread::enqueue(detail::worker_task& t)
+{
+  ++_num_pending_tasks;
+
+  if(_is_overflow_active.load() || !_ring.try_push(t)) {
+    std::lock_guard<std::mutex> lock{_overflow_mutex};
+    // The worker may have drained the overflow queue in the meantime,
+    // in which case it is fine to use the ring again.
+    if(_is_overflow_active.load() || !_ring.try_push(t)) {
+      _is_overflow_active = true;
+      _overflow_operations.push_back(std::move(t));
     }
+  }
 
-    _condition_wait.notify_all();
-
+  if(_is_worker_parked.load()) {
+    // Taking the lock ensures that the notification cannot get lost
+    // between the worker checking its wait predicate and going to sleep.
+    std::lock_guard<std::mutex> lock{_mutex};
+    _work_available.notify_one();
   }
 }
 
-void worker_thread::operator()(worker_thread::async_function f)
+bool worker_thread::try_dequeue(detail::worker_task& out)
 {
-  std::unique_lock<std::mutex> lock(_mutex);
+  // Overflow tasks that were already taken over by the worker are
+  // older than anything that might be in the ring now.
+  if(!_drained_overflow_operations.empty()) {
+    out = std::move(_drained_overflow_operations.front());
+    _drained_overflow_operations.pop_front();
+    return true;
+  }
 
-  _enqueued_operations.push(f);
+  if(_ring.try_pop(out))
+    return true;
 
-  lock.unlock();
-  _condition_wait.notify_all();
+  // Only take over the overflow queue once every task that entered the
+  // ring before it has been processed.
+  if(_is_overflow_active.load() && _ring.is_drained()) {
+    std::lock_guard<std::mutex> lock{_overflow_mutex};
+    if(_ring.is_drained()) {
+      _drained_overflow_operations.swap(_overflow_operations);
+      _is_overflow_active = false;
+    }
+  }
+
+  if(!_drained_overflow_operations.empty()) {
+    out = std::move(_drained_overflow_operations.front());
+    _drained_overflow_operations.pop_front();
+    return true;
+  }
+  return false;
+}
+
+void worker_thread::notify_task_completed()
+{
+  if(--_num_pending_tasks == 0 && _num_waiting_threads.load() > 0) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _queue_drained.notify_all();
+  }
 }
 
 std::size_t worker_thread::queue_size() const
 {
-  std::lock_guard<std::mutex> lock(_mutex);
-  return _enqueued_operations.size();
+  return _num_pending_tasks.load();
 }
 
 
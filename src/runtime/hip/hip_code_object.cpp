@@ -37,11 +37,11 @@ void unload_hip_module(ihipModule_t* module, int device) {
 }
 
 result build_hip_module(ihipModule_t *&module, int device,
-                        const std::string &hip_fat_binary) {
+                        std::string_view hip_fat_binary) {
   // It's unclear if this is actually needed for HIP?
   hip_device_manager::get().activate_device(device);
 
-  auto err = hipModuleLoadData(&module, hip_fat_binary.c_str());
+  auto err = hipModuleLoadData(&module, hip_fat_binary.data());
 
   if(err == hipSuccess)
     return make_success();
@@ -127,7 +127,7 @@ result hip_multipass_executable_object::build(const std::string& hip_fat_binary)
 }
 
 hip_sscp_executable_object::hip_sscp_executable_object(
-    const std::string &code_image, const std::string &target_arch,
+    std::string_view code_image, const std::string &target_arch,
     hcf_object_id hcf_source, const std::vector<std::string> &kernel_names,
     int device, const kernel_configuration &config)
     : _target{target_arch}, _origin{hcf_source}, _kernel_names{kernel_names},
@@ -190,7 +190,7 @@ int hip_sscp_executable_object::get_device() const {
   return _device;
 }
 
-result hip_sscp_executable_object::build(const std::string& hip_fat_binary) {
+result hip_sscp_executable_object::build(std::string_view hip_fat_binary) {
   return build_hip_module(_module, _device, hip_fat_binary);
 }
 
@@ -10,6 +10,7 @@
 // SPDX-License-Identifier: BSD-2-Clause
 #include "hipSYCL/runtime/kernel_configuration.hpp"
 #include "hipSYCL/runtime/adaptivity_engine.hpp"
+#include "hipSYCL/runtime/application.hpp"
 #include "hipSYCL/runtime/hip/hip_target.hpp"
 #include "hipSYCL/common/hcf_container.hpp"
 #include "hipSYCL/runtime/hip/hip_hardware_manager.hpp"
@@ -621,45 +622,56 @@ result hip_queue::submit_sscp_kernel_from_code_object(
                           target_arch_name);
 
   auto binary_configuration_id = adaptivity_engine.finalize_binary_configuration(_config);
-  auto code_object_configuration_id = binary_configuration_id;
-  kernel_configuration::extend_hash(
-      code_object_configuration_id,
-      kernel_base_config_parameter::runtime_device, device);
+  auto get_code_object_configuration_id =
+      [&](kernel_configuration::id_type id) {
+    kernel_configuration::extend_hash(
+        id,
+        kernel_base_config_parameter::runtime_device, device);
+    return id;
+  };
+  auto code_object_configuration_id =
+      get_code_object_configuration_id(binary_configuration_id);
 
   auto get_image_and_kernel_names =
       [&](std::vector<std::string> &contained_kernels) -> std::string {
     return adaptivity_engine.select_image_and_kernels(&contained_kernels);
   };
 
-  auto jit_compiler = [&](std::string& compiled_image) -> bool {
+  auto make_jit_compiler = [&]() {
     
     std::vector<std::string> kernel_names;
     std::string selected_image_name = get_image_and_kernel_names(kernel_names);
 
-    // Construct amdgpu translator to compile the specified kernels
-    std::unique_ptr<compiler::LLVMToBackendTranslator> translator = 
-      compiler::createLLVMToAmdgpuTranslator(kernel_names);
-
-    // Lower kernels
-    rt::result err;
-    if(kernel_names.size() == 1) {
-      err = glue::jit::dead_argument_elimination::compile_kernel(
-          translator.get(), hcf_object, selected_image_name, _config,
-          binary_configuration_id, _reflection_map, compiled_image);
-    } else {
-      err =
-          glue::jit::compile(translator.get(), hcf_object, selected_image_name,
-                             _config, _reflection_map, compiled_image);
-    }
-    
-    if(!err.is_success()) {
-      register_error(err);
-      return false;
-    }
-    return true;
+    // Everything is captured by value, since the kernel cache
+    // may carry out compilation in the background.
+    return [kernel_names, selected_image_name, hcf_object, config = _config,
+            binary_configuration_id,
+            reflection_map = _reflection_map](std::string &compiled_image) {
+      // Construct amdgpu translator to compile the specified kernels
+      std::unique_ptr<compiler::LLVMToBackendTranslator> translator = 
+        compiler::createLLVMToAmdgpuTranslator(kernel_names);
+
+      // Lower kernels
+      rt::result err;
+      if(kernel_names.size() == 1) {
+        err = glue::jit::dead_argument_elimination::compile_kernel(
+            translator.get(), hcf_object, selected_image_name, config,
+            binary_configuration_id, reflection_map, compiled_image);
+      } else {
+        err =
+            glue::jit::compile(translator.get(), hcf_object, selected_image_name,
+                               config, reflection_map, compiled_image);
+      }
+
+      if(!err.is_success()) {
+        register_error(err);
+        return false;
+      }
+      return true;
+    };
   };
 
-  auto code_object_constructor = [&](const std::string& amdgpu_image) -> code_object * {
+  auto code_object_constructor = [&](std::string_view amdgpu_image) -> code_object * {
    
     std::vector<std::string> kernel_names;
     get_image_and_kernel_names(kernel_names);
@@ -687,9 +699,24 @@ result hip_queue::submit_sscp_kernel_from_code_object(
     return exec_obj;
   };
 
-  const code_object *obj = _kernel_cache->get_or_construct_jit_code_object(
-      code_object_configuration_id, binary_configuration_id,
-      jit_compiler, code_object_constructor);
+  const code_object *obj = nullptr;
+  if (adaptivity_engine.get_fallback_configuration().has_value() &&
+      application::get_settings().get<setting::async_jit>()) {
+    obj = _kernel_cache->get_or_construct_jit_code_object_async(
+        code_object_configuration_id, binary_configuration_id,
+        make_jit_compiler, code_object_constructor);
+    if (!obj) {
+      // Run the less specialized kernel until the specialized one is ready
+      _config = adaptivity_engine.get_fallback_configuration().value();
+      binary_configuration_id = _config.generate_id();
+      code_object_configuration_id =
+          get_code_object_configuration_id(binary_configuration_id);
+    }
+  }
+  if (!obj)
+    obj = _kernel_cache->get_or_construct_jit_code_object(
+        code_object_configuration_id, binary_configuration_id,
+        make_jit_compiler, code_object_constructor);
 
   
   if(!obj) {
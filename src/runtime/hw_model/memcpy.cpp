@@ -9,32 +9,59 @@
  */
 // SPDX-License-Identifier: BSD-2-Clause
 #include "hipSYCL/runtime/hw_model/memcpy.hpp"
+#include "hipSYCL/runtime/allocator.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/backend.hpp"
+#include "hipSYCL/runtime/dag_node.hpp"
+#include "hipSYCL/runtime/hardware.hpp"
+#include "hipSYCL/runtime/inorder_executor.hpp"
+#include "hipSYCL/runtime/inorder_queue.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+#include "hipSYCL/common/appdb.hpp"
+#include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/common/filesystem.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <limits>
 
 
 namespace hipsycl {
 namespace rt {
 
+namespace {
+
+constexpr std::size_t calibration_small_transfer_size = 64;
+constexpr std::size_t calibration_large_transfer_size = 16 * 1024 * 1024;
+constexpr int calibration_small_transfer_reps = 16;
+constexpr int calibration_large_transfer_reps = 4;
+
+}
+
+memcpy_model::memcpy_model(backend_manager* mgr)
+: _backends{mgr} {}
 
 cost_type
 memcpy_model::estimate_runtime_cost(const memory_location &source,
                                     const memory_location &dest,
                                     range<3> num_elements) const
 {
-  // Strongly prefer transfers from the same device to the same device
-  if(source.get_device() == dest.get_device())
-    return 1.0;
-
-  if (source.get_device().get_full_backend_descriptor().hw_platform ==
-      dest.get_device().get_full_backend_descriptor().hw_platform)
-    return 2.0;
+  return estimate_transfer_time(source.get_device(), dest.get_device(),
+                                num_elements.size() *
+                                    source.get_element_size());
+}
 
-  return 3.0;
+cost_type memcpy_model::estimate_transfer_time(device_id source,
+                                               device_id dest,
+                                               std::size_t num_bytes) const {
+  transfer_parameters p = get_transfer_parameters(source, dest);
+  return p.latency + static_cast<double>(num_bytes) / p.bandwidth;
 }
 
 memory_location memcpy_model::choose_source(
     const std::vector<memory_location> &candidate_sources,
-    const memory_location &target, range<3> num_elements) const 
+    const memory_location &target, range<3> num_elements) const
 {
   std::size_t best_transfer_index = 0;
   cost_type best_cost = std::numeric_limits<cost_type>::max();
@@ -50,5 +77,218 @@ memory_location memcpy_model::choose_source(
   return candidate_sources[best_transfer_index];
 }
 
+memcpy_model::transfer_parameters
+memcpy_model::get_transfer_parameters(device_id source, device_id dest) const {
+  const device_pair pair{source, dest};
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    auto it = _parameters.find(pair);
+    if(it != _parameters.end())
+      return it->second;
+  }
+
+  // Only needed to persist the parameters, i.e. once per device pair
+  std::string key = get_device_key(source) + "->" + get_device_key(dest);
+
+  transfer_parameters result = get_default_parameters(source, dest);
+  bool needs_calibration = false;
+
+  if(application::get_settings().get<setting::memcpy_calibration>()) {
+    auto &appdb =
+        common::filesystem::persistent_storage::get().get_this_app_db();
+
+    bool is_persisted = appdb.read_access([&](const common::db::appdb_data &data) {
+      auto entry = data.memcpy_models.find(key);
+      if(entry == data.memcpy_models.end())
+        return false;
+      result.latency = entry->second.latency;
+      result.bandwidth = entry->second.bandwidth;
+      return true;
+    });
+    needs_calibration = !is_persisted;
+  }
+
+  std::lock_guard<std::mutex> lock{_mutex};
+  // Another thread may have queried the same pair in the meantime
+  auto existing = _parameters.find(pair);
+  if(existing != _parameters.end())
+    return existing->second;
+  _parameters[pair] = result;
+
+  if(needs_calibration) {
+    // Calibration allocates memory and waits for transfers, so it must not
+    // stall the submitting thread. Until it has completed, the default
+    // parameters are used.
+    if(!_calibration_worker)
+      _calibration_worker = std::make_unique<worker_thread>();
+    (*_calibration_worker)([this, pair, key]() {
+      auto [source, dest] = pair;
+      transfer_parameters measured;
+      if(!calibrate(source, dest, measured))
+        return;
+
+      HIPSYCL_DEBUG_INFO << "memcpy_model: Calibrated " << key
+                         << ": latency " << measured.latency
+                         << " ns, bandwidth " << measured.bandwidth
+                         << " bytes/ns" << std::endl;
+      {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _parameters[pair] = measured;
+      }
+      auto &appdb =
+          common::filesystem::persistent_storage::get().get_this_app_db();
+      appdb.read_write_access([&](common::db::appdb_data &data) {
+        common::db::memcpy_entry &entry = data.memcpy_models[key];
+        entry.latency = measured.latency;
+        entry.bandwidth = measured.bandwidth;
+      });
+    });
+  }
+
+  return result;
+}
+
+void memcpy_model::wait_for_calibration() const {
+  worker_thread *worker = nullptr;
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    worker = _calibration_worker.get();
+  }
+  if(worker)
+    worker->wait();
+}
+
+memcpy_model::transfer_parameters
+memcpy_model::get_default_parameters(device_id source, device_id dest) const {
+  // Strongly prefer transfers from the same device to the same device
+  if(source == dest)
+    return transfer_parameters{1000.0, 100.0};
+
+  if (source.get_full_backend_descriptor().hw_platform ==
+      dest.get_full_backend_descriptor().hw_platform)
+    return transfer_parameters{5000.0, 50.0};
+
+  return transfer_parameters{10000.0, 16.0};
+}
+
+bool memcpy_model::calibrate(device_id source, device_id dest,
+                             transfer_parameters &out) const {
+  if(!_backends)
+    return false;
+
+  backend *source_backend = _backends->get(source.get_backend());
+  backend *dest_backend = _backends->get(dest.get_backend());
+  if(!source_backend || !dest_backend)
+    return false;
+
+  backend_allocator *source_allocator = source_backend->get_allocator(source);
+  backend_allocator *dest_allocator = dest_backend->get_allocator(dest);
+
+  const std::size_t max_size = calibration_large_transfer_size;
+  void *source_ptr = allocate_device(source_allocator, 0, max_size);
+  void *dest_ptr = allocate_device(dest_allocator, 0, max_size);
+
+  auto make_transfer = [&](std::size_t num_bytes) {
+    range<3> shape{1, 1, num_bytes};
+    return memcpy_operation{
+        memory_location{source, source_ptr, id<3>{}, shape, 1},
+        memory_location{dest, dest_ptr, id<3>{}, shape, 1}, shape};
+  };
+
+  // Transfers are executed by a dedicated queue, so that
+  // calibration does not interfere with regular submissions.
+  // This uses the same backend selection as the scheduler.
+  backend_id executing_backend;
+  device_id executing_device;
+  make_transfer(max_size).has_preferred_backend(executing_backend,
+                                                executing_device);
+  std::unique_ptr<backend_executor> executor =
+      _backends->get(executing_backend)
+          ->create_inorder_executor(executing_device, 0);
+  inorder_queue *q = nullptr;
+  if(auto *inorder = dynamic_cast<inorder_executor *>(executor.get()))
+    q = inorder->get_queue();
+
+  // Backends without in-order executors only copy between host
+  // allocations, which is a plain memcpy.
+  bool is_host_transfer = source.is_host() && dest.is_host();
+
+  bool success = source_ptr && dest_ptr && (q || is_host_transfer);
+
+  auto measure = [&](std::size_t num_bytes, int reps) -> double {
+    range<3> shape{1, 1, num_bytes};
+    auto op = std::make_unique<memcpy_operation>(
+        memory_location{source, source_ptr, id<3>{}, shape, 1},
+        memory_location{dest, dest_ptr, id<3>{}, shape, 1}, shape);
+    memcpy_operation *op_ptr = op.get();
+    // The node is only used by the backends to look up instrumentation
+    // hints; it never enters the DAG.
+    dag_node_ptr node = make_dag_node(execution_hints{}, node_list_t{},
+                                      std::move(op), nullptr);
+    node->assign_to_device(executing_device);
+
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < reps && success; ++i) {
+      if(q) {
+        success = q->submit_memcpy(*op_ptr, node).is_success() &&
+                  q->wait().is_success();
+      } else {
+        std::memcpy(dest_ptr, source_ptr, num_bytes);
+      }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    return static_cast<double>(
+               std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+                   .count()) /
+           reps;
+  };
+
+  if(success) {
+    // Warm up, e.g. to trigger lazy initialization in the backend
+    // and to fault in the pages of both allocations
+    measure(calibration_large_transfer_size, 1);
+
+    double small_time = measure(calibration_small_transfer_size,
+                                calibration_small_transfer_reps);
+    double large_time = measure(calibration_large_transfer_size,
+                                calibration_large_transfer_reps);
+
+    double delta_bytes = static_cast<double>(calibration_large_transfer_size -
+                                             calibration_small_transfer_size);
+    out.bandwidth = delta_bytes / std::max(large_time - small_time, 1.0);
+    out.latency = std::max(
+        small_time - calibration_small_transfer_size / out.bandwidth, 0.0);
+  }
+
+  if(!success) {
+    HIPSYCL_DEBUG_WARNING << "memcpy_model: Could not calibrate transfers from "
+                          << get_device_key(source) << " to "
+                          << get_device_key(dest)
+                          << ", using default estimates." << std::endl;
+  }
+
+  if(source_ptr)
+    deallocate(source_allocator, source_ptr);
+  if(dest_ptr)
+    deallocate(dest_allocator, dest_ptr);
+
+  return success;
+}
+
+std::string memcpy_model::get_device_key(device_id dev) const {
+  std::string key = std::to_string(static_cast<int>(dev.get_backend())) + "." +
+                    std::to_string(dev.get_id());
+  if(_backends) {
+    if(backend* b = _backends->get(dev.get_backend())) {
+      key = b->get_name() + "." + std::to_string(dev.get_id());
+      if (hardware_context *ctx =
+              b->get_hardware_manager()->get_device(dev.get_id()))
+        key += ":" + ctx->get_device_name();
+    }
+  }
+  return key;
+}
+
 }
 }
@@ -0,0 +1,150 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/jit_service.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+std::size_t get_num_compiler_threads() {
+  std::size_t num_threads =
+      application::get_settings().get<setting::jit_compiler_threads>();
+  if(num_threads == 0) {
+    std::size_t hw_threads = std::thread::hardware_concurrency();
+    num_threads = std::clamp(hw_threads / 2, std::size_t{1}, std::size_t{4});
+  }
+  return num_threads;
+}
+
+}
+
+jit_service::jit_service() = default;
+
+jit_service::~jit_service() {
+  wait();
+}
+
+jit_service::binary_ptr jit_service::compile(binary_id id,
+                                             const compilation_task &task) {
+  std::unique_lock<std::mutex> lock{_mutex};
+
+  auto it = _requests.find(id);
+  if(it != _requests.end()) {
+    std::shared_ptr<request> r = it->second;
+    HIPSYCL_DEBUG_INFO << "jit_service: Waiting for compilation in flight of "
+                       << kernel_configuration::to_string(id) << std::endl;
+    _request_finished.wait(lock,
+                           [&]() { return r->state != status::in_flight; });
+    return r->binary;
+  }
+
+  auto r = std::make_shared<request>();
+  _requests[id] = r;
+  lock.unlock();
+
+  std::string binary;
+  bool success = task(binary);
+  finish(r, success, std::move(binary));
+
+  return r->binary;
+}
+
+void jit_service::compile_async(binary_id id, compilation_task task) {
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  if(_requests.find(id) != _requests.end())
+    return;
+
+  auto r = std::make_shared<request>();
+  _requests[id] = r;
+
+  if(_compiler_threads.empty()) {
+    std::size_t num_threads = get_num_compiler_threads();
+    HIPSYCL_DEBUG_INFO << "jit_service: Starting " << num_threads
+                       << " compiler threads" << std::endl;
+    for(std::size_t i = 0; i < num_threads; ++i)
+      _compiler_threads.push_back(std::make_unique<worker_thread>());
+  }
+
+  // Prefer idle threads, so that one long compilation
+  // does not delay others.
+  std::size_t selected = _next_compiler_thread++ % _compiler_threads.size();
+  for(std::size_t i = 0; i < _compiler_threads.size(); ++i) {
+    if(_compiler_threads[i]->queue_size() <
+       _compiler_threads[selected]->queue_size())
+      selected = i;
+  }
+
+  HIPSYCL_DEBUG_INFO << "jit_service: Enqueuing background compilation of "
+                     << kernel_configuration::to_string(id) << std::endl;
+
+  (*_compiler_threads[selected])([this, r, task = std::move(task)]() {
+    std::string binary;
+    bool success = task(binary);
+    finish(r, success, std::move(binary));
+  });
+}
+
+jit_service::status jit_service::try_get(binary_id id, binary_ptr &out) {
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  auto it = _requests.find(id);
+  if(it == _requests.end())
+    return status::not_requested;
+
+  status s = it->second->state;
+  if(s == status::ready)
+    out = it->second->binary;
+  return s;
+}
+
+void jit_service::forget(binary_id id) {
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  auto it = _requests.find(id);
+  if(it != _requests.end() && it->second->state == status::ready)
+    _requests.erase(it);
+}
+
+void jit_service::wait() {
+  std::vector<worker_thread*> compiler_threads;
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    for(auto& t : _compiler_threads)
+      compiler_threads.push_back(t.get());
+  }
+  for(auto* t : compiler_threads)
+    t->wait();
+}
+
+void jit_service::finish(const std::shared_ptr<request> &r, bool success,
+                         std::string &&binary) {
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    if(success) {
+      r->binary = std::make_shared<const std::string>(std::move(binary));
+      r->state = status::ready;
+    } else {
+      r->state = status::failed;
+    }
+  }
+  _request_finished.notify_all();
+}
+
+}
+}
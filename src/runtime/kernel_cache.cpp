@@ -427,6 +427,30 @@ hcf_cache::get_image_info(hcf_object_id obj,
 
 
 
+kernel_cache::kernel_cache()
+    : _persistent_cache{common::filesystem::join_path(
+          common::filesystem::persistent_storage::get().get_jit_cache_dir(),
+          "binaries.pack")} {
+  auto &appdb = common::filesystem::persistent_storage::get().get_this_app_db();
+
+  // Start reading the binaries that were used in the most recent
+  // application run, since they are likely needed again.
+  std::vector<code_object_id> recently_used_binaries;
+  appdb.read_access([&](const common::db::appdb_data &data) {
+    _application_run = data.content_version;
+
+    uint64_t most_recent_run = 0;
+    for(const auto& entry : data.binaries)
+      most_recent_run = std::max(most_recent_run, entry.second.last_used_run);
+    for(const auto& entry : data.binaries)
+      if(entry.second.last_used_run == most_recent_run)
+        recently_used_binaries.push_back(entry.first);
+  });
+
+  for(const auto& id : recently_used_binaries)
+    _persistent_cache.prefetch(id);
+}
+
 std::shared_ptr<kernel_cache> kernel_cache::get() {
   // required since kernel_cache has a private default constructor
   struct make_shared_enabler : public kernel_cache {};
@@ -435,9 +459,13 @@ std::shared_ptr<kernel_cache> kernel_cache::get() {
 }
 
 void kernel_cache::unload() {
+  // Background compilations may still access the persistent cache
+  _jit_service.wait();
+
   std::lock_guard<std::mutex> lock{_mutex};
 
   _code_objects.clear();
+  _failed_code_objects.clear();
 }
 
 const code_object* kernel_cache::get_code_object(code_object_id id) const {
@@ -445,6 +473,11 @@ const code_object* kernel_cache::get_code_object(code_object_id id) const {
   return get_code_object_impl(id);
 }
 
+bool kernel_cache::has_construction_failed(code_object_id id) const {
+  std::lock_guard<std::mutex> lock{_mutex};
+  return _failed_code_objects.find(id) != _failed_code_objects.end();
+}
+
 const code_object* kernel_cache::get_code_object_impl(code_object_id id) const {
   auto it = _code_objects.find(id);
   if(it == _code_objects.end())
@@ -458,65 +491,94 @@ std::string kernel_cache::get_persistent_cache_file(code_object_id id_of_binary)
   return join_path(cache_dir, kernel_configuration::to_string(id_of_binary)+".jit");
 }
 
-bool kernel_cache::persistent_cache_lookup(code_object_id id_of_binary,
-                                           std::string &out) const {
-  std::string filename;
-
-  bool filename_lookup_succeeded =
-      common::filesystem::persistent_storage::get()
-          .get_this_app_db()
-          .read_access([&](const common::db::appdb_data &appdb) {
-            auto binary = appdb.binaries.find(id_of_binary);
-            if (binary == appdb.binaries.end())
-              return false;
-
-            filename = binary->second.jit_cache_filename;
-            return true;
-          });
-
-  if(!filename_lookup_succeeded)
-    return false;
-
-  std::ifstream file{filename, std::ios::in | std::ios::binary | std::ios::ate};
-  
-  if(!file.is_open())
+bool kernel_cache::persistent_cache_lookup(
+    code_object_id id_of_binary, common::packed_binary_cache::binary &out) {
+  if(!_persistent_cache.lookup(id_of_binary, out))
     return false;
 
   HIPSYCL_DEBUG_INFO << "kernel_cache: Persistent cache hit for id "
                      << kernel_configuration::to_string(id_of_binary)
-                     << " in file " << filename << std::endl;
+                     << std::endl;
+
+  auto &appdb = common::filesystem::persistent_storage::get().get_this_app_db();
+  // Usually, the binary has already been marked as used in this
+  // application run, so only take the write lock if needed.
+  bool is_marked_used =
+      appdb.read_access([&](const common::db::appdb_data &data) {
+        auto it = data.binaries.find(id_of_binary);
+        return it != data.binaries.end() &&
+               it->second.last_used_run == _application_run;
+      });
+  if(!is_marked_used) {
+    appdb.read_write_access([&](common::db::appdb_data &data) {
+      data.binaries[id_of_binary].last_used_run = _application_run;
+    });
+  }
 
-  std::streamsize file_size = file.tellg();
-  file.seekg(0, std::ios::beg);
-  out.resize(file_size);
-  file.read(out.data(), file_size);
-  
   return true;
 }
 
+void kernel_cache::on_jit_compilation_finished(code_object_id id_of_binary,
+                                               const std::string &binary) {
+  if(_is_first_jit_compilation.exchange(false)) {
+    HIPSYCL_DEBUG_WARNING
+        << "kernel_cache: This application run has resulted in new "
+           "binaries being JIT-compiled. This indicates that the runtime "
+           "optimization process has not yet reached peak performance. You "
+           "may want to run the application again until this warning no "
+           "longer appears to achieve optimal performance."
+        << std::endl;
+  }
+  persistent_cache_store(id_of_binary, binary);
+}
+
+void kernel_cache::release_compiled_binary(code_object_id id_of_binary) {
+  // Without cache population, the JIT service is the only place where
+  // other threads and devices can find the binary.
+  if(!application::get_settings().get<setting::no_jit_cache_population>())
+    _jit_service.forget(id_of_binary);
+}
+
 void kernel_cache::persistent_cache_store(code_object_id id_of_binary,
-                                          const std::string &data) const {
+                                          std::string_view data) {
   if(application::get_settings().get<setting::no_jit_cache_population>())
     return;
 
-  std::string filename = get_persistent_cache_file(id_of_binary);
-
   HIPSYCL_DEBUG_INFO << "kernel_cache: Storing compiled binary with id "
                      << kernel_configuration::to_string(id_of_binary)
-                     << " in persistent cache file " << filename << std::endl;
-  
+                     << " in persistent cache" << std::endl;
 
-  if(!common::filesystem::atomic_write(filename, data)) {
+  if(!_persistent_cache.store(id_of_binary, data)) {
     HIPSYCL_DEBUG_ERROR
-        << "Could not store JIT result in persistent kernel cache in file "
-        << filename << std::endl;
+        << "Could not store JIT result in persistent kernel cache"
+        << std::endl;
+    return;
   }
 
-  common::filesystem::persistent_storage::get()
-      .get_this_app_db()
-      .read_write_access([&](common::db::appdb_data &appdb) {
-        appdb.binaries[id_of_binary].jit_cache_filename = filename;
-      });
+  auto& appdb = common::filesystem::persistent_storage::get().get_this_app_db();
+  appdb.read_write_access([&](common::db::appdb_data &data) {
+    data.binaries[id_of_binary].last_used_run = _application_run;
+  });
+
+  std::size_t max_size =
+      application::get_settings().get<setting::jit_cache_max_size>();
+  if(_persistent_cache.get_size() > max_size) {
+    HIPSYCL_DEBUG_INFO << "kernel_cache: Persistent cache exceeds "
+                       << max_size
+                       << " bytes, evicting least recently used binaries"
+                       << std::endl;
+
+    ankerl::unordered_dense::map<code_object_id, uint64_t, kernel_id_hash>
+        last_used_runs;
+    appdb.read_access([&](const common::db::appdb_data &data) {
+      for(const auto& entry : data.binaries)
+        last_used_runs[entry.first] = entry.second.last_used_run;
+    });
+    _persistent_cache.shrink(max_size, [&](const code_object_id &id) {
+      auto it = last_used_runs.find(id);
+      return it == last_used_runs.end() ? 0 : it->second;
+    });
+  }
 }
 
 } // rt
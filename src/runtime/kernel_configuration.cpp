@@ -27,7 +27,8 @@ public:
       {"amdgpu-target-device", kernel_build_option::amdgpu_target_device},
       {"rocm-device-libs-path", kernel_build_option::amdgpu_rocm_device_libs_path},
       {"rocm-path", kernel_build_option::amdgpu_rocm_path},
-      {"spirv-dynamic-local-mem-allocation-size", kernel_build_option::spirv_dynamic_local_mem_allocation_size}
+      {"spirv-dynamic-local-mem-allocation-size", kernel_build_option::spirv_dynamic_local_mem_allocation_size},
+      {"host-group-coarsening-factor", kernel_build_option::host_group_coarsening_factor}
     };
 
     _flags = {
@@ -36,7 +37,9 @@ public:
       {"ptx-ftz", kernel_build_flag::ptx_ftz},
       {"ptx-approx-div", kernel_build_flag::ptx_approx_div},
       {"ptx-approx-sqrt", kernel_build_flag::ptx_approx_sqrt},
-      {"spirv-enable-intel-llvm-spirv-options", kernel_build_flag::spirv_enable_intel_llvm_spirv_options}
+      {"spirv-enable-intel-llvm-spirv-options", kernel_build_flag::spirv_enable_intel_llvm_spirv_options},
+      {"host-fiber-barriers", kernel_build_flag::host_fiber_barriers},
+      {"host-vectorized-subgroups", kernel_build_flag::host_vectorized_subgroups}
     };
 
     for(const auto& elem : _options) {
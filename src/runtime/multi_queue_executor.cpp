@@ -263,5 +263,20 @@ bool multi_queue_executor::find_assigned_lane_index(
 
   return false;
 }
+
+inorder_executor *multi_queue_executor::get_assigned_lane_executor(
+    const dag_node_ptr &node) const {
+  if (!node->is_submitted() ||
+      static_cast<std::size_t>(node->get_assigned_device().get_id()) >=
+          _device_data.size())
+    return nullptr;
+  // The lane executors assign their inorder_queue as execution lane.
+  for (const auto &executor :
+       _device_data[node->get_assigned_device().get_id()].executors) {
+    if (executor->get_queue() == node->get_assigned_execution_lane())
+      return executor.get();
+  }
+  return nullptr;
+}
 }
 }
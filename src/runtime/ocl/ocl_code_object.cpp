@@ -34,7 +34,7 @@ result ocl_sscp_code_object_invoker::submit_kernel(
 }
 
 ocl_executable_object::ocl_executable_object(const cl::Context& ctx, cl::Device& dev,
-    hcf_object_id source, const std::string& code_image, const kernel_configuration &config)
+    hcf_object_id source, std::string_view code_image, const kernel_configuration &config)
 : _source{source}, _ctx{ctx}, _dev{dev}, _id{config.generate_id()} {
 
   std::vector<char> ir(code_image.size());
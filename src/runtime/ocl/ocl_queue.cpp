@@ -10,6 +10,7 @@
 // SPDX-License-Identifier: BSD-2-Clause
 #include "hipSYCL/runtime/kernel_configuration.hpp"
 #include "hipSYCL/runtime/adaptivity_engine.hpp"
+#include "hipSYCL/runtime/application.hpp"
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/serialization/serialization.hpp"
 #include "hipSYCL/runtime/kernel_cache.hpp"
@@ -500,47 +501,58 @@ result ocl_queue::submit_sscp_kernel_from_code_object(
   // config.set_build_flag(kernel_build_flag::spirv_enable_intel_llvm_spirv_options);
 
   auto binary_configuration_id = adaptivity_engine.finalize_binary_configuration(_config);
-  auto code_object_configuration_id = binary_configuration_id;
-  kernel_configuration::extend_hash(
-      code_object_configuration_id,
-      kernel_base_config_parameter::runtime_device, dev.get());
-  kernel_configuration::extend_hash(
-      code_object_configuration_id,
-      kernel_base_config_parameter::runtime_context, ctx.get());
+  auto get_code_object_configuration_id =
+      [&](kernel_configuration::id_type id) {
+    kernel_configuration::extend_hash(
+        id,
+        kernel_base_config_parameter::runtime_device, dev.get());
+    kernel_configuration::extend_hash(
+        id,
+        kernel_base_config_parameter::runtime_context, ctx.get());
+    return id;
+  };
+  auto code_object_configuration_id =
+      get_code_object_configuration_id(binary_configuration_id);
 
  
 
   
-  auto jit_compiler = [&](std::string& compiled_image) -> bool {
+  auto make_jit_compiler = [&]() {
     
     std::vector<std::string> kernel_names;
     std::string selected_image_name =
         adaptivity_engine.select_image_and_kernels(&kernel_names);
 
-    // Construct SPIR-V translator to compile the specified kernels
-    std::unique_ptr<compiler::LLVMToBackendTranslator> translator = 
-      std::move(compiler::createLLVMToSpirvTranslator(kernel_names));
-    
-    // Lower kernels to SPIR-V
-    rt::result err;
-    if(kernel_names.size() == 1) {
-      err = glue::jit::dead_argument_elimination::compile_kernel(
-          translator.get(), hcf_object, selected_image_name, _config,
-          binary_configuration_id, _reflection_map, compiled_image);
-    } else {
-      err =
-          glue::jit::compile(translator.get(), hcf_object, selected_image_name,
-                             _config, _reflection_map, compiled_image);
-    }
-    
-    if(!err.is_success()) {
-      register_error(err);
-      return false;
-    }
-    return true;
+    // Everything is captured by value, since the kernel cache
+    // may carry out compilation in the background.
+    return [kernel_names, selected_image_name, hcf_object, config = _config,
+            binary_configuration_id,
+            reflection_map = _reflection_map](std::string &compiled_image) {
+      // Construct SPIR-V translator to compile the specified kernels
+      std::unique_ptr<compiler::LLVMToBackendTranslator> translator = 
+        std::move(compiler::createLLVMToSpirvTranslator(kernel_names));
+
+      // Lower kernels to SPIR-V
+      rt::result err;
+      if(kernel_names.size() == 1) {
+        err = glue::jit::dead_argument_elimination::compile_kernel(
+            translator.get(), hcf_object, selected_image_name, config,
+            binary_configuration_id, reflection_map, compiled_image);
+      } else {
+        err =
+            glue::jit::compile(translator.get(), hcf_object, selected_image_name,
+                               config, reflection_map, compiled_image);
+      }
+
+      if(!err.is_success()) {
+        register_error(err);
+        return false;
+      }
+      return true;
+    };
   };
 
-  auto code_object_constructor = [&](const std::string& compiled_image) -> code_object* {
+  auto code_object_constructor = [&](std::string_view compiled_image) -> code_object* {
     ocl_executable_object *exec_obj = new ocl_executable_object{
         ctx, dev, hcf_object, compiled_image, _config};
     result r = exec_obj->get_build_result();
@@ -560,9 +572,24 @@ result ocl_queue::submit_sscp_kernel_from_code_object(
     return exec_obj;
   };
 
-  const code_object *obj = _kernel_cache->get_or_construct_jit_code_object(
-      code_object_configuration_id, binary_configuration_id,
-      jit_compiler, code_object_constructor);
+  const code_object *obj = nullptr;
+  if (adaptivity_engine.get_fallback_configuration().has_value() &&
+      application::get_settings().get<setting::async_jit>()) {
+    obj = _kernel_cache->get_or_construct_jit_code_object_async(
+        code_object_configuration_id, binary_configuration_id,
+        make_jit_compiler, code_object_constructor);
+    if (!obj) {
+      // Run the less specialized kernel until the specialized one is ready
+      _config = adaptivity_engine.get_fallback_configuration().value();
+      binary_configuration_id = _config.generate_id();
+      code_object_configuration_id =
+          get_code_object_configuration_id(binary_configuration_id);
+    }
+  }
+  if (!obj)
+    obj = _kernel_cache->get_or_construct_jit_code_object(
+        code_object_configuration_id, binary_configuration_id,
+        make_jit_compiler, code_object_constructor);
 
   if(!obj) {
     return make_error(__acpp_here(),
@@ -54,7 +54,7 @@ create_multi_queue_executor(omp_backend *b) {
 omp_backend::omp_backend()
     : _allocator{device_id{
           backend_descriptor{omp_backend::get_hardware_platform(), omp_backend::get_api_platform()}, 0}},
-      _hw{},
+      _hw{}, _num_assigned_lanes{0},
       _executor([this](){
         return create_multi_queue_executor(this);
       }) {}
@@ -105,5 +105,22 @@ omp_backend::create_inorder_executor(device_id dev, int priority){
   return nullptr;
 }
 
+omp_thread_pool* omp_backend::get_thread_pool() {
+  if(!application::get_settings().get<setting::omp_work_stealing>())
+    return nullptr;
+
+  std::call_once(_thread_pool_init_flag, [this]() {
+    auto *ctx = static_cast<omp_hardware_context *>(_hw.get_device(0));
+    _thread_pool =
+        std::make_unique<omp_thread_pool>(ctx->get_execution_lanes());
+  });
+  return _thread_pool.get();
+}
+
+std::size_t omp_backend::assign_execution_lane() {
+  auto *ctx = static_cast<omp_hardware_context *>(_hw.get_device(0));
+  return _num_assigned_lanes++ % ctx->get_execution_lanes().size();
+}
+
 }
 }
@@ -21,60 +21,23 @@
 #include "hipSYCL/common/debug.hpp"
 #include "hipSYCL/common/filesystem.hpp"
 #include "hipSYCL/common/hcf_container.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/host/LLVMToHostFactory.hpp"
 #include "hipSYCL/runtime/kernel_configuration.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
-#include "hipSYCL/runtime/dylib_loader.hpp"
 #include "hipSYCL/runtime/error.hpp"
 
 namespace hipsycl {
 namespace rt {
 
-namespace {
-
-result make_shared_library_from_blob(void *&module, const std::string &blob,
-                                     const std::string &cache_file) {
-  // Write binary image to temporary file
-  if (!common::filesystem::atomic_write(cache_file, blob)) {
-    HIPSYCL_DEBUG_ERROR << "Could not store JIT kernel library in temporary "
-                           "kernel cache in file "
-                        << cache_file << std::endl;
-    return make_error(
-        __acpp_here(),
-        error_info{"omp_sscp_executable_object: could not store JIT kernel "
-                   "library in temporary kernel cache"});
-  }
-
-  // now load the same so file
-  HIPSYCL_DEBUG_INFO << "Load module: " << cache_file << "\n";
-  module = detail::load_library(cache_file, "omp_sscp_executable");
-
-  if (!module)
-    return make_error(__acpp_here(),
-                      error_info{"omp_sscp_executable_object: could not load "
-                                 "shared kernel library"});
-
-  return make_success();
-}
-
-} // namespace
-
 omp_sscp_executable_object::omp_sscp_executable_object(
-    const std::string &binary, hcf_object_id hcf_source,
+    std::string_view binary, hcf_object_id hcf_source,
     const std::vector<std::string> &kernel_names,
     const kernel_configuration &config)
-    : _hcf{hcf_source}, _id{config.generate_id()}, _module{nullptr},
-      _kernel_cache_path(kernel_cache::get_persistent_cache_file(_id) + ".so") {
+    : _hcf{hcf_source}, _id{config.generate_id()} {
   _build_result = build(binary, kernel_names);
 }
 
-omp_sscp_executable_object::~omp_sscp_executable_object() {
-  if (_module)
-    detail::close_library(_module, "omp_sscp_executable");
-  if(!common::filesystem::remove(_kernel_cache_path)) {
-    HIPSYCL_DEBUG_ERROR << "Could not remove kernel cache file: "
-                        << _kernel_cache_path << std::endl;
-  }
-}
+omp_sscp_executable_object::~omp_sscp_executable_object() = default;
 
 result omp_sscp_executable_object::get_build_result() const {
   return _build_result;
@@ -107,29 +70,47 @@ omp_sscp_executable_object::supported_backend_kernel_names() const {
   return _kernel_names;
 }
 
-void *omp_sscp_executable_object::get_module() const { return _module; }
+void *omp_sscp_executable_object::get_module() const { return _module.get(); }
 
 result omp_sscp_executable_object::build(
-    const std::string &source, const std::vector<std::string> &kernel_names) {
+    std::string_view source, const std::vector<std::string> &kernel_names) {
     
   if (_module != nullptr)
     return make_success();
 
-  if (auto result = make_shared_library_from_blob(_module, source, _kernel_cache_path);
-      !result.is_success())
-    return result;
+  // The binary is a relocatable object, which is linked into executable
+  // memory in-process.
+  std::string error_message;
+  _module = compiler::loadHostObject(source, error_message);
+  if (!_module)
+    return make_error(__acpp_here(),
+                      error_info{"omp_sscp_executable_object: could not load "
+                                 "kernel object: " + error_message});
 
   _kernel_names = kernel_names;
   // find all kernel symbols
   for (const auto &kernel_name : _kernel_names) {
-    if (auto kernel = (omp_sscp_kernel *)detail::get_symbol_from_library(
-            _module, kernel_name, "omp_sscp_exectuable_object")) {
+    if (auto kernel = (omp_sscp_kernel *)_module->getSymbol(kernel_name)) {
       _kernels.emplace(kernel_name, kernel);
     } else {
       return make_error(__acpp_here(),
                         error_info{"omp_sscp_executable_object: could not load "
-                                   "kernel from shared library"});
+                                   "kernel " + kernel_name + " from object"});
     }
+
+    kernel_properties properties;
+    if (auto flags = (const uint32_t *)_module->getSymbol(
+            compiler::HostKernelFlagsPrefix + kernel_name)) {
+      properties.uses_local_memory =
+          (*flags & compiler::HostKernelFlags::UsesLocalMemory) != 0;
+      properties.uses_internal_local_memory =
+          (*flags & compiler::HostKernelFlags::UsesInternalLocalMemory) != 0;
+      properties.uses_barriers =
+          (*flags & compiler::HostKernelFlags::UsesBarriers) != 0;
+      properties.uses_fiber_barriers =
+          (*flags & compiler::HostKernelFlags::UsesFiberBarriers) != 0;
+    }
+    _kernel_properties.emplace(kernel_name, properties);
   }
   return make_success();
 }
@@ -151,5 +132,14 @@ omp_sscp_executable_object::get_kernel(std::string_view backend_kernel_name) con
   return nullptr;
 }
 
+omp_sscp_executable_object::kernel_properties
+omp_sscp_executable_object::get_kernel_properties(
+    std::string_view backend_kernel_name) const {
+  auto it = _kernel_properties.find(backend_kernel_name);
+  if (it != _kernel_properties.end())
+    return it->second;
+  return kernel_properties{};
+}
+
 } // namespace rt
 } // namespace hipsycl
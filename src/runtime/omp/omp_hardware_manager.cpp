@@ -10,14 +10,187 @@
 // SPDX-License-Identifier: BSD-2-Clause
 #include <omp.h>
 #include <limits>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
 
 #include "hipSYCL/runtime/omp/omp_hardware_manager.hpp"
+#include "hipSYCL/runtime/application.hpp"
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
+#include "hipSYCL/common/debug.hpp"
 
 namespace hipsycl {
 namespace rt {
 
+namespace {
+
+// Parses lists in the format used by sysfs, e.g. "0-3,8,10-11"
+std::vector<int> parse_id_list(const std::string& list) {
+  std::vector<int> result;
+  std::stringstream sstr{list};
+  std::string entry;
+  while(std::getline(sstr, entry, ',')) {
+    if(entry.empty() || entry == "\n")
+      continue;
+    int first = 0;
+    int last = 0;
+    auto separator = entry.find('-');
+    try {
+      if(separator == std::string::npos) {
+        first = last = std::stoi(entry);
+      } else {
+        first = std::stoi(entry.substr(0, separator));
+        last = std::stoi(entry.substr(separator + 1));
+      }
+    } catch(...) {
+      return {};
+    }
+    for(int i = first; i <= last; ++i)
+      result.push_back(i);
+  }
+  return result;
+}
+
+std::vector<int> get_available_cores() {
+  std::vector<int> cores;
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if(sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for(int i = 0; i < CPU_SETSIZE; ++i)
+      if(CPU_ISSET(i, &set))
+        cores.push_back(i);
+  }
+#endif
+  if(cores.empty()) {
+    for(int i = 0; i < omp_get_num_procs(); ++i)
+      cores.push_back(i);
+  }
+  return cores;
+}
+
+// Returns pairs of (NUMA node id, available cores of that node)
+std::vector<std::pair<int, std::vector<int>>>
+get_numa_nodes(const std::vector<int>& available_cores) {
+  std::vector<std::pair<int, std::vector<int>>> nodes;
+#ifdef __linux__
+  const std::string sysfs_node_dir = "/sys/devices/system/node/";
+  std::ifstream online_file{sysfs_node_dir + "online"};
+  std::string online_nodes;
+  if(online_file && std::getline(online_file, online_nodes)) {
+    for(int node : parse_id_list(online_nodes)) {
+      std::ifstream cpulist_file{sysfs_node_dir + "node" +
+                                 std::to_string(node) + "/cpulist"};
+      std::string cpulist;
+      if(!cpulist_file || !std::getline(cpulist_file, cpulist))
+        continue;
+
+      std::vector<int> node_cores;
+      for(int core : parse_id_list(cpulist))
+        if(std::find(available_cores.begin(), available_cores.end(), core) !=
+           available_cores.end())
+          node_cores.push_back(core);
+
+      if(!node_cores.empty())
+        nodes.push_back(std::make_pair(node, node_cores));
+    }
+  }
+#endif
+  if(nodes.empty())
+    nodes.push_back(std::make_pair(-1, available_cores));
+  return nodes;
+}
+
+std::vector<omp_execution_lane> construct_execution_lanes() {
+  auto nodes = get_numa_nodes(get_available_cores());
+
+  // Honor OMP_NUM_THREADS and friends by only using the first
+  // max_threads cores, in NUMA node order.
+  std::size_t max_threads =
+      static_cast<std::size_t>(std::max(omp_get_max_threads(), 1));
+  std::size_t num_cores = 0;
+  for(auto& node : nodes) {
+    std::size_t remaining = max_threads - num_cores;
+    if(node.second.size() > remaining)
+      node.second.resize(remaining);
+    num_cores += node.second.size();
+  }
+  nodes.erase(std::remove_if(nodes.begin(), nodes.end(),
+                             [](const auto &node) {
+                               return node.second.empty();
+                             }),
+              nodes.end());
+
+  std::size_t num_lanes =
+      application::get_settings().get<setting::omp_execution_lanes>();
+  if(num_lanes == 0)
+    num_lanes = nodes.size();
+  num_lanes = std::max(std::size_t{1}, std::min(num_lanes, num_cores));
+
+  std::vector<omp_execution_lane> lanes(num_lanes);
+  if(num_lanes <= nodes.size()) {
+    // Fewer lanes than NUMA nodes: Merge nodes into lanes
+    for(std::size_t i = 0; i < nodes.size(); ++i) {
+      omp_execution_lane& lane = lanes[i % num_lanes];
+      lane.numa_node = lane.cores.empty() ? nodes[i].first : -1;
+      lane.cores.insert(lane.cores.end(), nodes[i].second.begin(),
+                        nodes[i].second.end());
+    }
+  } else {
+    // More lanes than NUMA nodes: Split nodes such that no lane
+    // crosses a NUMA boundary. Hand out additional lanes to
+    // the nodes that currently have the most cores per lane.
+    std::vector<std::size_t> lanes_per_node(nodes.size(), 1);
+    for(std::size_t i = nodes.size(); i < num_lanes; ++i) {
+      std::size_t best_node = 0;
+      double max_cores_per_lane = 0.0;
+      for(std::size_t n = 0; n < nodes.size(); ++n) {
+        double cores_per_lane = static_cast<double>(nodes[n].second.size()) /
+                                lanes_per_node[n];
+        if(lanes_per_node[n] < nodes[n].second.size() &&
+           cores_per_lane > max_cores_per_lane) {
+          max_cores_per_lane = cores_per_lane;
+          best_node = n;
+        }
+      }
+      ++lanes_per_node[best_node];
+    }
+
+    std::size_t current_lane = 0;
+    for(std::size_t n = 0; n < nodes.size(); ++n) {
+      const auto& node_cores = nodes[n].second;
+      for(std::size_t i = 0; i < lanes_per_node[n]; ++i) {
+        std::size_t begin = i * node_cores.size() / lanes_per_node[n];
+        std::size_t end = (i + 1) * node_cores.size() / lanes_per_node[n];
+        omp_execution_lane& lane = lanes[current_lane++];
+        lane.numa_node = nodes[n].first;
+        lane.cores.assign(node_cores.begin() + begin,
+                          node_cores.begin() + end);
+      }
+    }
+  }
+
+  for(std::size_t i = 0; i < lanes.size(); ++i) {
+    HIPSYCL_DEBUG_INFO << "omp_hardware_context: Execution lane " << i
+                       << " on NUMA node " << lanes[i].numa_node << " with "
+                       << lanes[i].cores.size() << " cores" << std::endl;
+  }
+
+  return lanes;
+}
+
+}
+
+omp_hardware_context::omp_hardware_context()
+    : _execution_lanes{construct_execution_lanes()} {}
+
 
 bool omp_hardware_context::is_cpu() const {
   return true;
@@ -28,7 +201,11 @@ bool omp_hardware_context::is_gpu() const {
 }
 
 std::size_t omp_hardware_context::get_max_kernel_concurrency() const {
-  return 1;
+  // Without the thread pool, every kernel opens an omp parallel region
+  // spanning all cores, so concurrent kernels would oversubscribe them.
+  if(!application::get_settings().get<setting::omp_work_stealing>())
+    return 1;
+  return _execution_lanes.size();
 }
   
 // TODO We could actually copy have more memcpy concurrency
@@ -283,6 +460,10 @@ std::vector<std::size_t> omp_hardware_context::get_property(device_uint_list_pro
 {
   switch(prop) {
   case device_uint_list_property::sub_group_sizes:
+    // Sub-groups only span SIMD lanes for kernels JIT-compiled with the
+    // host-vectorized-subgroups flag, and only if the kernel qualifies.
+    // That is decided per kernel, so the device reports the size that
+    // all kernels support.
     return std::vector<std::size_t>{1};
     break;
   }
@@ -300,6 +481,11 @@ std::size_t omp_hardware_context::get_platform_index() const {
   return 0;
 }
 
+const std::vector<omp_execution_lane> &
+omp_hardware_context::get_execution_lanes() const {
+  return _execution_lanes;
+}
+
 std::size_t omp_hardware_manager::get_num_platforms() const {
   return 1;
 }
@@ -0,0 +1,246 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/omp/omp_kernel_tuner.hpp"
+#include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/common/filesystem.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+common::db::tuning_candidate make_candidate(const range<3> &group_size,
+                                            std::size_t coarsening_factor,
+                                            bool fiber_barriers) {
+  common::db::tuning_candidate c;
+  c.group_size_x = group_size[0];
+  c.group_size_y = group_size[1];
+  c.group_size_z = group_size[2];
+  c.coarsening_factor = coarsening_factor;
+  c.fiber_barriers = fiber_barriers;
+  return c;
+}
+
+range<3> get_group_size(const common::db::tuning_candidate &c) {
+  return range<3>{c.group_size_x, c.group_size_y, c.group_size_z};
+}
+
+void add_candidate(common::db::kernel_tuning_entry &entry,
+                   const range<3> &group_size, std::size_t coarsening_factor,
+                   bool fiber_barriers = false) {
+  for (const auto &c : entry.candidates)
+    if (get_group_size(c) == group_size &&
+        c.coarsening_factor == coarsening_factor &&
+        c.fiber_barriers == fiber_barriers)
+      return;
+  entry.candidates.push_back(
+      make_candidate(group_size, coarsening_factor, fiber_barriers));
+}
+
+// Problem sizes within a factor of two share their tuning results, such
+// that e.g. a kernel whose range varies slightly between launches
+// does not need to be tuned again for every range.
+uint64_t get_size_bucket(std::size_t n) {
+  uint64_t bucket = 0;
+  while (n > 1) {
+    n >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+std::size_t get_fastest_candidate(const common::db::kernel_tuning_entry &entry) {
+  std::size_t fastest = 0;
+  double fastest_time = std::numeric_limits<double>::max();
+  for (std::size_t i = 0; i < entry.candidates.size(); ++i) {
+    const auto &c = entry.candidates[i];
+    if (c.num_samples > 0 && c.best_time < fastest_time) {
+      fastest = i;
+      fastest_time = c.best_time;
+    }
+  }
+  return fastest;
+}
+
+}
+
+omp_kernel_tuner &omp_kernel_tuner::get() {
+  static omp_kernel_tuner tuner;
+  return tuner;
+}
+
+omp_kernel_tuner::omp_kernel_tuner()
+    : _appdb{common::filesystem::persistent_storage::get().get_this_app_db()} {}
+
+omp_kernel_tuner::selection
+omp_kernel_tuner::select(std::string_view kernel_name,
+                         const range<3> &global_range,
+                         const range<3> &group_size,
+                         const range<3> &default_group_size,
+                         std::size_t concurrency) {
+  selection s;
+  kernel_configuration::extend_hash(s.key, std::string{"kernel"},
+                                    kernel_name);
+  for (int i = 0; i < 3; ++i) {
+    // If the tuner is free to choose the group size, the group count
+    // is not known yet and the global size is bucketed instead.
+    std::size_t num_groups =
+        group_size.size() != 0
+            ? (global_range[i] + group_size[i] - 1) / group_size[i]
+            : global_range[i];
+    kernel_configuration::extend_hash(s.key, std::string{"num_groups_log2"},
+                                      get_size_bucket(num_groups));
+    // Zero for all dimensions if the tuner is free to choose the group size
+    kernel_configuration::extend_hash(s.key, std::string{"group_size"},
+                                      static_cast<uint64_t>(group_size[i]));
+  }
+
+  std::lock_guard<std::mutex> lock{_mutex};
+  common::db::kernel_tuning_entry &entry = get_entry(s.key);
+
+  if (entry.candidates.empty()) {
+    if (group_size.size() != 0) {
+      add_candidate(entry, group_size, 1);
+    } else if (global_range[1] == 1 && global_range[2] == 1) {
+      const std::size_t min_size = 16;
+      const std::size_t max_size =
+          std::max<std::size_t>(std::min<std::size_t>(global_range[0], 1024),
+                                min_size);
+      for (std::size_t size : {default_group_size[0],
+                               default_group_size[0] / 4,
+                               default_group_size[0] * 4})
+        add_candidate(entry,
+                      range<3>{std::clamp(size, min_size, max_size), 1, 1}, 1);
+    } else {
+      add_candidate(entry, default_group_size, 1);
+    }
+  }
+
+  auto select_candidate = [&](std::size_t index, bool is_tuning) {
+    s.candidate = index;
+    s.group_size = get_group_size(entry.candidates[index]);
+    s.coarsening_factor = entry.candidates[index].coarsening_factor;
+    s.fiber_barriers = entry.candidates[index].fiber_barriers;
+    s.is_tuning = is_tuning;
+    return s;
+  };
+
+  if (entry.is_tuned && entry.selected_candidate < entry.candidates.size())
+    return select_candidate(entry.selected_candidate, false);
+
+  for (std::size_t i = 0; i < entry.candidates.size(); ++i)
+    if (entry.candidates[i].num_samples < samples_per_candidate)
+      return select_candidate(i, true);
+
+  if (!entry.coarsening_candidates_added) {
+    std::size_t num_candidates = entry.candidates.size();
+    add_coarsening_candidates(entry, global_range, concurrency);
+    if (entry.candidates.size() > num_candidates)
+      return select_candidate(num_candidates, true);
+  }
+
+  if (entry.uses_barriers && !entry.barrier_candidates_added) {
+    entry.barrier_candidates_added = true;
+    // Fiber barriers are only worth trying at the best group size; the
+    // fiber execution does not support coarsening.
+    const range<3> group_size =
+        get_group_size(entry.candidates[get_fastest_candidate(entry)]);
+    std::size_t num_candidates = entry.candidates.size();
+    add_candidate(entry, group_size, 1, true);
+    if (entry.candidates.size() > num_candidates)
+      return select_candidate(num_candidates, true);
+  }
+
+  finish_tuning(entry);
+  _appdb.read_write_access([&](common::db::appdb_data &data) {
+    data.kernel_tunings[s.key] = entry;
+  });
+  return select_candidate(entry.selected_candidate, false);
+}
+
+void omp_kernel_tuner::record(const selection &s, double time_ns,
+                              bool uses_barriers) {
+  if (!s.is_tuning)
+    return;
+
+  std::lock_guard<std::mutex> lock{_mutex};
+  common::db::kernel_tuning_entry &entry = get_entry(s.key);
+  if (s.candidate >= entry.candidates.size())
+    return;
+
+  entry.uses_barriers = uses_barriers;
+  auto &c = entry.candidates[s.candidate];
+  if (c.num_samples == 0 || time_ns < c.best_time)
+    c.best_time = time_ns;
+  ++c.num_samples;
+
+  _appdb.read_write_access([&](common::db::appdb_data &data) {
+    data.kernel_tunings[s.key] = entry;
+  });
+}
+
+void omp_kernel_tuner::add_coarsening_candidates(
+    common::db::kernel_tuning_entry &entry, const range<3> &global_range,
+    std::size_t concurrency) const {
+  entry.coarsening_candidates_added = true;
+
+  const range<3> group_size =
+      get_group_size(entry.candidates[get_fastest_candidate(entry)]);
+  range<3> num_groups;
+  for (int i = 0; i < 3; ++i)
+    num_groups[i] = (global_range[i] + group_size[i] - 1) / group_size[i];
+
+  for (std::size_t factor : {2, 8, 32}) {
+    // Coarsening must not leave threads without work
+    const std::size_t num_invocations =
+        (num_groups[0] + factor - 1) / factor * num_groups[1] * num_groups[2];
+    if (factor < num_groups[0] && num_invocations >= concurrency)
+      add_candidate(entry, group_size, factor);
+  }
+}
+
+void omp_kernel_tuner::finish_tuning(
+    common::db::kernel_tuning_entry &entry) const {
+  entry.selected_candidate = get_fastest_candidate(entry);
+  entry.is_tuned = true;
+
+  const auto &c = entry.candidates[entry.selected_candidate];
+  HIPSYCL_DEBUG_INFO << "omp_kernel_tuner: Selected group size " << c.group_size_x
+                     << "x" << c.group_size_y << "x" << c.group_size_z
+                     << ", coarsening factor " << c.coarsening_factor
+                     << " and " << (c.fiber_barriers ? "fiber" : "CBS")
+                     << " barriers"
+                     << " out of " << entry.candidates.size()
+                     << " candidates (" << c.best_time << " ns)" << std::endl;
+}
+
+common::db::kernel_tuning_entry &
+omp_kernel_tuner::get_entry(const kernel_configuration::id_type &key) {
+  auto it = _entries.find(key);
+  if (it == _entries.end()) {
+    common::db::kernel_tuning_entry new_entry;
+    _appdb.read_access([&](const common::db::appdb_data &data) {
+      auto db_entry = data.kernel_tunings.find(key);
+      if (db_entry != data.kernel_tunings.end())
+        new_entry = db_entry->second;
+    });
+    it = _entries.emplace(key, std::move(new_entry)).first;
+  }
+  return it->second;
+}
+
+}
+}
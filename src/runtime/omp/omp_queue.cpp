@@ -22,6 +22,7 @@
 #include "hipSYCL/runtime/kernel_launcher.hpp"
 #include "hipSYCL/runtime/omp/omp_event.hpp"
 #include "hipSYCL/runtime/omp/omp_backend.hpp"
+#include "hipSYCL/runtime/omp/omp_thread_pool.hpp"
 #include "hipSYCL/runtime/operations.hpp"
 #include "hipSYCL/runtime/queue_completion_event.hpp"
 #include "hipSYCL/runtime/signal_channel.hpp"
@@ -34,6 +35,9 @@
 #include "hipSYCL/runtime/adaptivity_engine.hpp"
 #include "hipSYCL/runtime/omp/omp_code_object.hpp"
 
+#include <boost/fiber/barrier.hpp>
+#include <boost/fiber/fiber.hpp>
+
 #ifndef WIN32
 #include <unistd.h>
 #else
@@ -43,6 +47,7 @@
 
 #include <omp.h>
 
+#include <chrono>
 #include <memory>
 
 namespace hipsycl {
@@ -201,17 +206,113 @@ void *resize_and_strongly_align(std::vector<char> &data, std::size_t size) {
   return resize_and_align(data, size, alignment);
 }
 
+// Executes the work-groups [begin, end) of a kernel that was compiled with
+// fiber barriers on the calling thread. Each work item runs as a fiber, and
+// barriers switch to the next fiber until all work items have arrived.
+// Groups are enumerated with dimension 0 as the fastest moving index.
+void execute_groups_with_fibers(
+    omp_sscp_executable_object::omp_sscp_kernel *kernel,
+    const rt::range<3> &num_groups, const rt::range<3> &local_size,
+    std::size_t begin, std::size_t end, void *local_memory,
+    void *internal_local_memory, void **kernel_args) {
+  const std::size_t num_items = local_size.size();
+  if (begin >= end || num_items == 0)
+    return;
+
+  boost::fibers::barrier group_barrier{num_items};
+  auto barrier = +[](void *context) {
+    static_cast<boost::fibers::barrier *>(context)->wait();
+  };
+
+  std::vector<boost::fibers::fiber> fibers;
+  fibers.reserve(num_items);
+  for (std::size_t lid = 0; lid < num_items; ++lid) {
+    fibers.emplace_back([&, lid]() {
+      omp_sscp_executable_object::work_group_info info{
+          num_groups, rt::id<3>{0, 0, 0}, local_size, local_memory,
+          internal_local_memory};
+      info._local_id = rt::range<3>{
+          lid % local_size[0], (lid / local_size[0]) % local_size[1],
+          lid / (local_size[0] * local_size[1])};
+      info._barrier = barrier;
+      info._barrier_context = &group_barrier;
+
+      for (std::size_t group = begin; group < end; ++group) {
+        // Local memory may only be reused once all work items
+        // have finished the previous group.
+        if (group != begin)
+          group_barrier.wait();
+        info._group_id = rt::range<3>{
+            group % num_groups[0], (group / num_groups[0]) % num_groups[1],
+            group / (num_groups[0] * num_groups[1])};
+        kernel(&info, kernel_args);
+      }
+    });
+  }
+  for (auto &f : fibers)
+    f.join();
+}
+
 result
 launch_kernel_from_so(omp_sscp_executable_object::omp_sscp_kernel *kernel,
+                      const omp_sscp_executable_object::kernel_properties &properties,
                       const rt::range<3> &num_groups,
                       const rt::range<3> &local_size, unsigned shared_memory,
-                      void **kernel_args) {
+                      std::size_t coarsening_factor, void **kernel_args,
+                      omp_thread_pool *pool, std::size_t execution_lane) {
+  // Kernels that don't use local memory, e.g. all basic parallel_for
+  // kernels, don't need any per-thread setup.
+  if (!properties.uses_local_memory)
+    shared_memory = 0;
+  const bool needs_internal_local_memory = properties.uses_internal_local_memory;
+  auto get_local_memory = [&](std::vector<char> &data) -> void * {
+    if (shared_memory == 0)
+      return nullptr;
+    return resize_and_strongly_align(data, shared_memory);
+  };
+  auto get_internal_local_memory = [&](std::vector<char> &data) -> void * {
+    if (!needs_internal_local_memory)
+      return nullptr;
+    return resize_and_strongly_align(data,
+                                     local_size.size() * sizeof(uint64_t));
+  };
+
+  if (properties.uses_fiber_barriers) {
+    // Kernels with fiber barriers are never coarsened.
+    auto execute_groups = [&](std::size_t begin, std::size_t end) {
+      static thread_local std::vector<char> local_memory;
+      static thread_local std::vector<char> internal_local_memory;
+      execute_groups_with_fibers(kernel, num_groups, local_size, begin, end,
+                                 get_local_memory(local_memory),
+                                 get_internal_local_memory(internal_local_memory),
+                                 kernel_args);
+    };
+
+    if (pool) {
+      pool->parallel_for(execution_lane, num_groups.size(), execute_groups);
+      return make_success();
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel
+    {
+      const std::size_t num_threads = omp_get_num_threads();
+      const std::size_t thread = omp_get_thread_num();
+      execute_groups(num_groups.size() * thread / num_threads,
+                     num_groups.size() * (thread + 1) / num_threads);
+    }
+#else
+    execute_groups(0, num_groups.size());
+#endif
+    return make_success();
+  }
+
   if (num_groups.size() == 1 && shared_memory == 0) {
     // still need to be able to support group algorithms
     // make thread-local in case we have multiple threads submitting.
     static thread_local std::vector<char> internal_local_memory;
-    auto aligned_internal_local_memory = resize_and_strongly_align(
-        internal_local_memory, local_size.size() * sizeof(uint64_t));
+    auto aligned_internal_local_memory =
+        get_internal_local_memory(internal_local_memory);
 
     omp_sscp_executable_object::work_group_info info{
         num_groups, rt::id<3>{0, 0, 0}, local_size, nullptr,
@@ -220,6 +321,48 @@ launch_kernel_from_so(omp_sscp_executable_object::omp_sscp_kernel *kernel,
     return make_success();
   }
 
+  // Coarsened kernels execute coarsening_factor consecutive work-groups
+  // in x direction per invocation, starting at the group id they are
+  // invoked with.
+  const std::size_t num_invocations_x =
+      (num_groups.get(0) + coarsening_factor - 1) / coarsening_factor;
+
+  if (pool) {
+    const std::size_t num_groups_y = num_groups.get(1);
+
+    pool->parallel_for(
+        execution_lane, num_invocations_x * num_groups_y * num_groups.get(2),
+        [&](std::size_t begin, std::size_t end) {
+          // get page aligned local memory from heap
+          static thread_local std::vector<char> local_memory;
+          static thread_local std::vector<char> internal_local_memory;
+          auto aligned_local_memory = get_local_memory(local_memory);
+          auto aligned_internal_local_memory =
+              get_internal_local_memory(internal_local_memory);
+
+          // Same traversal order as the OpenMP loop nest below:
+          // dimension 0 is the fastest moving index.
+          std::size_t i = begin % num_invocations_x;
+          std::size_t j = (begin / num_invocations_x) % num_groups_y;
+          std::size_t k = begin / (num_invocations_x * num_groups_y);
+          for (std::size_t group = begin; group < end; ++group) {
+            omp_sscp_executable_object::work_group_info info{
+                num_groups, rt::id<3>{i * coarsening_factor, j, k}, local_size,
+                aligned_local_memory, aligned_internal_local_memory};
+            kernel(&info, kernel_args);
+
+            if (++i == num_invocations_x) {
+              i = 0;
+              if (++j == num_groups_y) {
+                j = 0;
+                ++k;
+              }
+            }
+          }
+        });
+    return make_success();
+  }
+
 #ifndef _OPENMP
   HIPSYCL_DEBUG_WARNING << "omp_queue: SSCP kernel launching was built without OpenMP "
                           "support, the kernel will execute sequentially!"
@@ -233,19 +376,18 @@ launch_kernel_from_so(omp_sscp_executable_object::omp_sscp_kernel *kernel,
     // get page aligned local memory from heap
     static thread_local std::vector<char> local_memory;
     static thread_local std::vector<char> internal_local_memory;
-    auto aligned_local_memory =
-        resize_and_strongly_align(local_memory, shared_memory);
-    auto aligned_internal_local_memory = resize_and_strongly_align(
-        internal_local_memory, local_size.size() * sizeof(uint64_t));
+    auto aligned_local_memory = get_local_memory(local_memory);
+    auto aligned_internal_local_memory =
+        get_internal_local_memory(internal_local_memory);
 #ifdef _OPENMP
 #pragma omp for collapse(3)
 #endif
     for (std::size_t k = 0; k < num_groups.get(2); ++k) {
       for (std::size_t j = 0; j < num_groups.get(1); ++j) {
-        for (std::size_t i = 0; i < num_groups.get(0); ++i) {
+        for (std::size_t i = 0; i < num_invocations_x; ++i) {
           omp_sscp_executable_object::work_group_info info{
-              num_groups, rt::id<3>{i, j, k}, local_size, aligned_local_memory,
-              aligned_internal_local_memory};
+              num_groups, rt::id<3>{i * coarsening_factor, j, k}, local_size,
+              aligned_local_memory, aligned_internal_local_memory};
           kernel(&info, kernel_args);
         }
       }
@@ -257,7 +399,9 @@ launch_kernel_from_so(omp_sscp_executable_object::omp_sscp_kernel *kernel,
 } // namespace
 
 omp_queue::omp_queue(omp_backend* be, int dev)
-    : _backend_id{be->get_unique_backend_id()}, _sscp_code_object_invoker{this},
+    : _backend_id{be->get_unique_backend_id()}, _backend{be},
+      _execution_lane{be->assign_execution_lane()},
+      _sscp_code_object_invoker{this},
       _kernel_cache{kernel_cache::get()} {
   _reflection_map = glue::jit::construct_default_reflection_map(
       be->get_hardware_manager()->get_device(dev));
@@ -408,7 +552,8 @@ result omp_queue::submit_sscp_kernel_from_code_object(
     std::string_view kernel_name, const rt::hcf_kernel_info *kernel_info,
     const rt::range<3> &num_groups, const rt::range<3> &group_size,
     unsigned local_mem_size, void **args, std::size_t *arg_sizes,
-    std::size_t num_args, const kernel_configuration &initial_config) {
+    std::size_t num_args, const kernel_configuration &initial_config,
+    const omp_kernel_tuner::selection *tuning) {
 #ifdef HIPSYCL_WITH_SSCP_COMPILER
   common::spin_lock_guard lock{_sscp_submission_spin_lock};
 
@@ -442,6 +587,25 @@ result omp_queue::submit_sscp_kernel_from_code_object(
       compilation_flow::sscp);
   _config.append_base_configuration(
       kernel_base_config_parameter::hcf_object_id, hcf_object);
+  // Binaries are relocatable objects rather than shared libraries; make sure
+  // that shared libraries from previous versions in the persistent cache
+  // are not picked up.
+  _config.append_base_configuration(
+      kernel_base_config_parameter::target_arch,
+      std::string{"native-host-object"});
+
+  for(const auto& flag : kernel_info->get_compilation_flags())
+    _config.set_build_flag(flag);
+  for(const auto& opt : kernel_info->get_compilation_options())
+    _config.set_build_option(opt.first, opt.second);
+
+  const std::size_t coarsening_factor =
+      tuning ? tuning->coarsening_factor : 1;
+  if (coarsening_factor > 1)
+    _config.set_build_option(kernel_build_option::host_group_coarsening_factor,
+                             coarsening_factor);
+  if (tuning && tuning->fiber_barriers)
+    _config.set_build_flag(kernel_build_flag::host_fiber_barriers);
 
   auto binary_configuration_id =
       adaptivity_engine.finalize_binary_configuration(_config);
@@ -452,29 +616,35 @@ result omp_queue::submit_sscp_kernel_from_code_object(
     return adaptivity_engine.select_image_and_kernels(&contained_kernels);
   };
 
-  auto jit_compiler = [&](std::string &compiled_image) -> bool {
-    const common::hcf_container *hcf = rt::hcf_cache::get().get_hcf(hcf_object);
-
+  auto make_jit_compiler = [&]() {
     std::vector<std::string> kernel_names;
     std::string selected_image_name = get_image_and_kernel_names(kernel_names);
 
-    // Construct Host translator to compile the specified kernels
-    std::unique_ptr<compiler::LLVMToBackendTranslator> translator =
-        compiler::createLLVMToHostTranslator(kernel_names);
+    // Everything is captured by value, since the kernel cache
+    // may carry out compilation in the background.
+    return [kernel_names, selected_image_name, hcf_object, config = _config,
+            reflection_map = _reflection_map](std::string &compiled_image) {
+      const common::hcf_container *hcf =
+          rt::hcf_cache::get().get_hcf(hcf_object);
 
-    // Lower kernels to binary
-    auto err = glue::jit::compile(translator.get(), hcf, selected_image_name,
-                                  _config, _reflection_map, compiled_image);
+      // Construct Host translator to compile the specified kernels
+      std::unique_ptr<compiler::LLVMToBackendTranslator> translator =
+          compiler::createLLVMToHostTranslator(kernel_names);
 
-    if (!err.is_success()) {
-      register_error(err);
-      return false;
-    }
-    return true;
+      // Lower kernels to binary
+      auto err = glue::jit::compile(translator.get(), hcf, selected_image_name,
+                                    config, reflection_map, compiled_image);
+
+      if (!err.is_success()) {
+        register_error(err);
+        return false;
+      }
+      return true;
+    };
   };
 
   auto code_object_constructor =
-      [&](const std::string &binary_image) -> code_object * {
+      [&](std::string_view binary_image) -> code_object * {
     std::vector<std::string> kernel_names;
     get_image_and_kernel_names(kernel_names);
 
@@ -495,21 +665,54 @@ result omp_queue::submit_sscp_kernel_from_code_object(
     return exec_obj;
   };
 
-  const code_object *obj = _kernel_cache->get_or_construct_jit_code_object(
-      code_object_configuration_id, binary_configuration_id, jit_compiler,
-      code_object_constructor);
+  const code_object *obj = nullptr;
+  bool uses_fallback_configuration = false;
+  if (adaptivity_engine.get_fallback_configuration().has_value() &&
+      application::get_settings().get<setting::async_jit>()) {
+    obj = _kernel_cache->get_or_construct_jit_code_object_async(
+        code_object_configuration_id, binary_configuration_id,
+        make_jit_compiler, code_object_constructor);
+    if (!obj) {
+      // Run the less specialized kernel until the specialized one is ready
+      _config = adaptivity_engine.get_fallback_configuration().value();
+      uses_fallback_configuration = true;
+      binary_configuration_id = _config.generate_id();
+      code_object_configuration_id = binary_configuration_id;
+    }
+  }
+  if (!obj)
+    obj = _kernel_cache->get_or_construct_jit_code_object(
+        code_object_configuration_id, binary_configuration_id,
+        make_jit_compiler, code_object_constructor);
 
   if (!obj) {
     return make_error(__acpp_here(),
                       error_info{"omp_queue: Code object construction failed"});
   }
 
-  auto kernel =
-      static_cast<const omp_sscp_executable_object *>(obj)->get_kernel(
-          kernel_name);
-
-  return launch_kernel_from_so(kernel, num_groups, group_size, local_mem_size,
-                               _arg_mapper.get_mapped_args());
+  auto *executable_object =
+      static_cast<const omp_sscp_executable_object *>(obj);
+  auto kernel = executable_object->get_kernel(kernel_name);
+
+  // Only the kernel execution itself is timed for tuning, JIT compilation
+  // has already happened at this point.
+  auto start = std::chrono::steady_clock::now();
+  const auto &properties = executable_object->get_kernel_properties(kernel_name);
+  auto err = launch_kernel_from_so(
+      kernel, properties,
+      num_groups, group_size, local_mem_size, coarsening_factor,
+      _arg_mapper.get_mapped_args(), _backend->get_thread_pool(),
+      _execution_lane);
+  auto stop = std::chrono::steady_clock::now();
+
+  // The fallback configuration lacks specializations, so its timings
+  // are not representative.
+  if (tuning && !uses_fallback_configuration && err.is_success())
+    omp_kernel_tuner::get().record(
+        *tuning,
+        std::chrono::duration<double, std::nano>(stop - start).count(),
+        properties.uses_barriers);
+  return err;
 
 #else
   return make_error(
@@ -603,6 +806,16 @@ result omp_queue::submit_external_wait_for(const dag_node_ptr& node) {
 
 worker_thread &omp_queue::get_worker() { return _worker; }
 
+std::size_t omp_queue::get_kernel_concurrency() const {
+  if (omp_thread_pool *pool = _backend->get_thread_pool())
+    return pool->get_lane_concurrency(_execution_lane);
+#ifdef _OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
 device_id omp_queue::get_device() const {
   return device_id{
       backend_descriptor{hardware_platform::cpu, api_platform::omp}, 0};
@@ -623,14 +836,44 @@ result omp_sscp_code_object_invoker::submit_kernel(
       local_mem_size, args, arg_sizes, num_args, config);
 }
 
+result omp_sscp_code_object_invoker::submit_kernel_for_global_range(
+    const kernel_operation &op, hcf_object_id hcf_object,
+    const rt::range<3> &global_range, const rt::range<3> &group_size,
+    unsigned local_mem_size, void **args, std::size_t *arg_sizes,
+    std::size_t num_args, std::string_view kernel_name,
+    const rt::hcf_kernel_info *kernel_info,
+    const kernel_configuration &config) {
+
+  if (application::get_settings().get<setting::adaptivity_level>() < 3)
+    return sscp_code_object_invoker::submit_kernel_for_global_range(
+        op, hcf_object, global_range, group_size, local_mem_size, args,
+        arg_sizes, num_args, kernel_name, kernel_info, config);
+
+  // If the group size was chosen by the user, only the coarsening
+  // factor can be tuned.
+  rt::range<3> default_group_size = group_size;
+  if (group_size.size() == 0)
+    default_group_size = select_group_size(global_range, group_size);
+
+  omp_kernel_tuner::selection tuning = omp_kernel_tuner::get().select(
+      kernel_name, global_range, group_size, default_group_size,
+      _queue->get_kernel_concurrency());
+
+  rt::range<3> num_groups;
+  for (int i = 0; i < 3; ++i) {
+    num_groups[i] = (global_range[i] + tuning.group_size[i] - 1) /
+                    tuning.group_size[i];
+  }
+
+  return _queue->submit_sscp_kernel_from_code_object(
+      op, hcf_object, kernel_name, kernel_info, num_groups, tuning.group_size,
+      local_mem_size, args, arg_sizes, num_args, config, &tuning);
+}
+
 rt::range<3> omp_sscp_code_object_invoker::select_group_size(
     const rt::range<3> &global_range, const rt::range<3> &group_size) const {
   rt::range<3> selected_group_size = group_size;
-#ifdef _OPENMP
-  const int max_threads = omp_get_max_threads();
-#else
-  const int max_threads = 1;
-#endif
+  const std::size_t max_threads = _queue->get_kernel_concurrency();
   constexpr auto divisor = 1;
   auto z = std::min(
       std::max<std::size_t>(global_range.get(0) / (max_threads * divisor), 16),
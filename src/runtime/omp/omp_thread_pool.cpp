@@ -0,0 +1,236 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/omp/omp_thread_pool.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+// How long idle threads keep polling for new work before parking.
+// This keeps the latency low for streams of many small kernels.
+constexpr auto max_spin_duration = std::chrono::microseconds{100};
+
+// Threads claim 1/chunk_divisor of their remaining range at a time.
+constexpr std::size_t chunk_divisor = 4;
+
+template<class Predicate>
+bool spin_until(Predicate p) {
+  auto start = std::chrono::steady_clock::now();
+  do {
+    if(p())
+      return true;
+    std::this_thread::yield();
+  } while(std::chrono::steady_clock::now() - start < max_spin_duration);
+  return p();
+}
+
+void bind_to_cores(std::thread& t, const std::vector<int>& cores) {
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for(int core : cores)
+    CPU_SET(core, &set);
+  if(pthread_setaffinity_np(t.native_handle(), sizeof(set), &set) != 0) {
+    HIPSYCL_DEBUG_WARNING
+        << "omp_thread_pool: Could not bind worker thread to its cores"
+        << std::endl;
+  }
+#endif
+}
+
+}
+
+omp_thread_pool::omp_thread_pool(const std::vector<omp_execution_lane> &lanes) {
+  for(const auto& lane : lanes) {
+    auto state = std::make_unique<lane_state>();
+    state->cores = lane.cores;
+    state->num_participants = std::max(std::size_t{1}, lane.cores.size());
+    state->ranges = std::make_unique<work_range[]>(state->num_participants);
+    _lanes.push_back(std::move(state));
+  }
+
+  for(auto& lane : _lanes) {
+    lane_state* l = lane.get();
+    // The submitting thread acts as participant 0
+    for(std::size_t i = 1; i < l->num_participants; ++i) {
+      l->threads.emplace_back([this, l, i]() { thread_main(l, i); });
+      // If there is only a single lane, leave thread placement to the OS.
+      if(_lanes.size() > 1)
+        bind_to_cores(l->threads.back(), l->cores);
+    }
+  }
+}
+
+omp_thread_pool::~omp_thread_pool() {
+  for(auto& lane : _lanes) {
+    {
+      std::lock_guard<std::mutex> lock{lane->park_mutex};
+      lane->shutdown = true;
+    }
+    lane->job_available.notify_all();
+    for(auto& t : lane->threads)
+      if(t.joinable())
+        t.join();
+  }
+}
+
+std::size_t omp_thread_pool::get_num_lanes() const {
+  return _lanes.size();
+}
+
+std::size_t omp_thread_pool::get_lane_concurrency(std::size_t lane) const {
+  assert(lane < _lanes.size());
+  return _lanes[lane]->num_participants;
+}
+
+void omp_thread_pool::run(std::size_t lane, std::size_t num_items,
+                          chunk_function f) {
+  assert(lane < _lanes.size());
+  lane_state* l = _lanes[lane].get();
+
+  if(num_items == 0)
+    return;
+  if(num_items == 1 || l->num_participants == 1) {
+    f.invoke(f.context, 0, num_items);
+    return;
+  }
+
+  std::lock_guard<std::mutex> submission_lock{l->submission_mutex};
+
+  for(std::size_t i = 0; i < l->num_participants; ++i) {
+    work_range& r = l->ranges[i];
+    common::spin_lock_guard guard{r.lock};
+    r.begin = i * num_items / l->num_participants;
+    r.end = (i + 1) * num_items / l->num_participants;
+  }
+  l->current_function = f;
+
+  l->is_job_open = true;
+  ++l->job_generation;
+  if(l->num_parked_threads.load() > 0) {
+    std::lock_guard<std::mutex> lock{l->park_mutex};
+    l->job_available.notify_all();
+  }
+
+  participate(l, 0);
+
+  // Threads that have not joined by now will not join anymore; all
+  // remaining work is in the hands of threads that are already busy.
+  l->is_job_open = false;
+  auto is_finished = [l]() { return l->num_busy_threads.load() == 0; };
+  if(!spin_until(is_finished)) {
+    std::unique_lock<std::mutex> lock{l->park_mutex};
+    l->job_finished.wait(lock, is_finished);
+  }
+}
+
+void omp_thread_pool::thread_main(lane_state *lane,
+                                  std::size_t participant_index) {
+  std::uint64_t seen_generation = 0;
+  auto has_job = [&]() {
+    return lane->job_generation.load() != seen_generation ||
+           lane->shutdown.load();
+  };
+
+  for(;;) {
+    if(!spin_until(has_job)) {
+      ++lane->num_parked_threads;
+      {
+        std::unique_lock<std::mutex> lock{lane->park_mutex};
+        lane->job_available.wait(lock, has_job);
+      }
+      --lane->num_parked_threads;
+    }
+    if(lane->shutdown)
+      return;
+
+    seen_generation = lane->job_generation.load();
+
+    ++lane->num_busy_threads;
+    if(lane->is_job_open.load())
+      participate(lane, participant_index);
+
+    if(--lane->num_busy_threads == 0) {
+      std::lock_guard<std::mutex> lock{lane->park_mutex};
+      lane->job_finished.notify_all();
+    }
+  }
+}
+
+void omp_thread_pool::participate(lane_state *lane,
+                                  std::size_t participant_index) {
+  chunk_function f = lane->current_function;
+  std::size_t begin = 0;
+  std::size_t end = 0;
+  do {
+    while(claim_chunk(lane, participant_index, begin, end))
+      f.invoke(f.context, begin, end);
+  } while(steal(lane, participant_index));
+}
+
+bool omp_thread_pool::claim_chunk(lane_state *lane,
+                                  std::size_t participant_index,
+                                  std::size_t &begin, std::size_t &end) {
+  work_range& r = lane->ranges[participant_index];
+  common::spin_lock_guard guard{r.lock};
+
+  std::size_t remaining = r.end - r.begin;
+  if(remaining == 0)
+    return false;
+
+  std::size_t chunk_size =
+      std::max(std::size_t{1}, remaining / chunk_divisor);
+  begin = r.begin;
+  end = begin + chunk_size;
+  r.begin = end;
+  return true;
+}
+
+bool omp_thread_pool::steal(lane_state *lane, std::size_t participant_index) {
+  for(std::size_t offset = 1; offset < lane->num_participants; ++offset) {
+    std::size_t victim = (participant_index + offset) % lane->num_participants;
+
+    std::size_t begin = 0;
+    std::size_t end = 0;
+    {
+      work_range& v = lane->ranges[victim];
+      common::spin_lock_guard guard{v.lock};
+      std::size_t remaining = v.end - v.begin;
+      if(remaining == 0)
+        continue;
+      // Take the upper half, the victim keeps working from the front.
+      end = v.end;
+      begin = end - (remaining + 1) / 2;
+      v.end = begin;
+    }
+
+    work_range& own = lane->ranges[participant_index];
+    common::spin_lock_guard guard{own.lock};
+    own.begin = begin;
+    own.end = end;
+    return true;
+  }
+  return false;
+}
+
+}
+}
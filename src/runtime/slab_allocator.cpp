@@ -0,0 +1,78 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/slab_allocator.hpp"
+#include "hipSYCL/common/slab_cache.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+struct heap_slabs {
+  static constexpr std::size_t min_block_size = 32;
+  // Size classes 32, 64, ..., slab_allocator::max_size
+  static constexpr std::size_t num_size_classes = 6;
+  static constexpr std::size_t slab_size = 64 * 1024;
+
+  static void *allocate_slab(std::size_t) {
+#if defined(__APPLE__)
+    return aligned_alloc(slab_size, slab_size);
+#elif !defined(_WIN32)
+    return std::aligned_alloc(slab_size, slab_size);
+#else
+    return _aligned_malloc(slab_size, slab_size);
+#endif
+  }
+
+  static void release_slab(void *slab, std::size_t) {
+#if !defined(_WIN32)
+    std::free(slab);
+#else
+    _aligned_free(slab);
+#endif
+  }
+};
+
+using cache = common::slab_cache<heap_slabs>;
+
+static_assert(cache::max_block_size == slab_allocator::max_size);
+
+}
+
+std::size_t slab_allocator::get_num_slabs() noexcept {
+  return cache::get_num_slabs();
+}
+
+void *slab_allocator::allocate(std::size_t size) {
+  if (size > max_size)
+    return ::operator new(size);
+
+  void *ptr = cache::allocate(cache::get_size_class(size));
+  if (!ptr)
+    throw std::bad_alloc{};
+  return ptr;
+}
+
+void slab_allocator::deallocate(void *ptr, std::size_t size) noexcept {
+  if (!ptr)
+    return;
+  if (size > max_size) {
+    ::operator delete(ptr);
+    return;
+  }
+  cache::deallocate(ptr, cache::get_size_class(size));
+}
+
+}
+}
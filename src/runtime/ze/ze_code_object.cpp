@@ -44,7 +44,7 @@ ze_executable_object::ze_executable_object(ze_context_handle_t ctx,
                                            ze_device_handle_t dev,
                                            hcf_object_id source,
                                            ze_source_format fmt,
-                                           const std::string &code_image)
+                                           std::string_view code_image)
     : _source{source}, _format{fmt}, _ctx{ctx}, _dev{dev}, _module{nullptr}
 {
 
@@ -61,7 +61,7 @@ ze_executable_object::ze_executable_object(ze_context_handle_t ctx,
   }
   
   desc.inputSize = code_image.size();
-  desc.pInputModule = reinterpret_cast<const uint8_t *>(code_image.c_str());
+  desc.pInputModule = reinterpret_cast<const uint8_t *>(code_image.data());
   // TODO: We may want to expose some of the build flags, e.g. to
   // enable greater than 4GB buffers
   desc.pBuildFlags = nullptr;
@@ -231,7 +231,7 @@ void ze_executable_object::load_kernel_handles() {
 
 ze_sscp_executable_object::ze_sscp_executable_object(ze_context_handle_t ctx, ze_device_handle_t dev,
                           hcf_object_id source,
-                          const std::string &spirv_image,
+                          std::string_view spirv_image,
                           const kernel_configuration &config)
     : ze_executable_object(ctx, dev, source, ze_source_format::spirv,
                             spirv_image),
@@ -63,7 +63,7 @@ int main(int argc, char** argv) {
   if(command == "-p")
     print_content(appdb_path);
   else if(command == "-c")
-    hipsycl::common::filesystem::remove(appdb_path);
+    hipsycl::common::db::appdb::remove(appdb_path);
   else {
     usage();
     return -1;
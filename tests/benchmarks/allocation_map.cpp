@@ -0,0 +1,79 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "benchmark_suite.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <hipSYCL/common/allocation_map.hpp>
+
+namespace {
+
+struct payload{};
+using amap_t = hipsycl::common::allocation_map<payload>;
+
+}
+
+BOOST_AUTO_TEST_SUITE(allocation_map)
+
+BOOST_AUTO_TEST_CASE(lookup_latency) {
+  const std::size_t num_lookups = 100000;
+
+  for(std::size_t num_allocations : {16, 1024, 65536}) {
+    // Allocations of varying sizes in a 48-bit address range, similar
+    // to heap allocations
+    std::mt19937 gen(123);
+    std::uniform_int_distribution<uint64_t> dist{0, (1ull << 40) - 1};
+    std::vector<uint64_t> addresses;
+    amap_t amap;
+    for(std::size_t i = 0; i < num_allocations; ++i) {
+      uint64_t address = (1ull << 46) + (dist(gen) << 4);
+      amap_t::value_type v;
+      v.allocation_size = 16 * (1 + i % 64);
+      if(amap.insert(address, v))
+        addresses.push_back(address);
+    }
+
+    std::vector<uint64_t> queries;
+    for(std::size_t i = 0; i < num_lookups; ++i) {
+      queries.push_back(addresses[dist(gen) % addresses.size()] + 8);
+    }
+
+    auto measure = [&](auto&& get_address) {
+      std::size_t num_found = 0;
+      auto start = std::chrono::steady_clock::now();
+      for(std::size_t i = 0; i < num_lookups; ++i) {
+        uint64_t root_address = 0;
+        if(amap.get_entry(get_address(i), root_address))
+          ++num_found;
+      }
+      auto stop = std::chrono::steady_clock::now();
+      BOOST_CHECK(num_found == num_lookups);
+      return std::chrono::duration<double, std::nano>(stop - start).count() /
+             num_lookups;
+    };
+
+    double random_latency = measure([&](std::size_t i) { return queries[i]; });
+    // Repeated lookups of the same allocation, e.g. from consecutive
+    // kernel arguments
+    double repeated_latency =
+        measure([&](std::size_t i) { return queries[i / 64] + i % 8; });
+
+    BOOST_TEST_MESSAGE("allocation_map: " << num_allocations
+                       << " allocations: random lookup: " << random_latency
+                       << " ns, repeated lookup: " << repeated_latency
+                       << " ns");
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
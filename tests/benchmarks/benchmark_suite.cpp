@@ -0,0 +1,51 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#define BOOST_TEST_MODULE AdaptiveCpp runtime benchmarks
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/included/unit_test.hpp>
+
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+#include <stdlib.h>
+
+namespace {
+
+std::string persistent_storage_dir;
+
+void remove_persistent_storage() {
+  std::error_code ec;
+  std::filesystem::remove_all(persistent_storage_dir, ec);
+}
+
+}
+
+// Benchmarks run against a fresh persistent storage directory, such that they
+// neither depend on nor add to the kernel cache and appdb of the user.
+struct temporary_persistent_storage {
+  temporary_persistent_storage() {
+    std::string dir_template =
+        (std::filesystem::temp_directory_path() / "acpp-benchmarks-XXXXXX")
+            .string();
+    if(!mkdtemp(dir_template.data()))
+      return;
+
+    persistent_storage_dir = dir_template;
+    setenv("ACPP_APPDB_DIR", persistent_storage_dir.c_str(), 1);
+    // Registered before the runtime creates its persistent storage, so
+    // the directory is only removed once that storage has been destroyed.
+    std::atexit(remove_persistent_storage);
+  }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE(temporary_persistent_storage);
@@ -0,0 +1,19 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <boost/test/unit_test.hpp>
+
+#ifndef HIPSYCL_RT_BENCHMARKS_HPP
+#define HIPSYCL_RT_BENCHMARKS_HPP
+
+#include "../common/reset.hpp"
+
+#endif
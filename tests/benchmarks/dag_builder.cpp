@@ -0,0 +1,111 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "hipSYCL/glue/kernel_launcher_data.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/kernel_launcher.hpp"
+#include "benchmark_suite.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include <memory>
+#include <hipSYCL/runtime/dag_builder.hpp>
+#include <hipSYCL/runtime/data.hpp>
+
+using namespace hipsycl;
+
+BOOST_FIXTURE_TEST_SUITE(dag_builder, reset_device_fixture)
+
+BOOST_AUTO_TEST_CASE(halo_exchange) {
+  // Halo exchange on a 2D grid that is split into one tile per page:
+  // Every tile is written, and then read together with a one-element halo
+  // that reaches into the neighboring tiles.
+  rt::runtime_keep_alive_token rt;
+  rt::execution_hints hints;
+  rt::device_id id{rt::backend_descriptor{rt::hardware_platform::cpu,
+                                          rt::api_platform::omp},
+                   12345};
+  hints.set_hint(rt::hints::bind_to_device{id});
+  rt::dag_builder builder{rt.get()};
+
+  const std::size_t tile_size = 16;
+  const std::size_t num_tiles = 64;
+  const std::size_t grid_size = num_tiles * tile_size;
+  auto region = std::make_shared<rt::buffer_data_region>(
+      rt::range<3>{grid_size, grid_size, 1}, sizeof(float),
+      rt::range<3>{tile_size, tile_size, 1});
+
+  std::vector<rt::dag_node_ptr> nodes;
+  auto submit = [&](rt::id<2> offset, rt::range<2> range,
+                    sycl::access::mode mode) {
+    rt::requirements_list reqs{rt.get()};
+    reqs.add_requirement<rt::buffer_memory_requirement>(
+        region, offset, range, mode, sycl::access::target::device);
+
+    auto op = rt::make_operation<rt::kernel_operation>(
+        "test_kernel",
+        rt::kernel_launcher{glue::kernel_launcher_data{},
+                            common::auto_small_vector<
+                                std::unique_ptr<rt::backend_kernel_launcher>>{}},
+        reqs);
+    nodes.push_back(builder.add_command_group(std::move(op), reqs, hints));
+    return reqs.get().front();
+  };
+
+  using clock = std::chrono::steady_clock;
+  auto start = clock::now();
+  for(std::size_t x = 0; x < num_tiles; ++x)
+    for(std::size_t y = 0; y < num_tiles; ++y)
+      submit(rt::id<2>{x * tile_size, y * tile_size},
+             rt::range<2>{tile_size, tile_size}, sycl::access::mode::write);
+  auto writes_done = clock::now();
+
+  for(std::size_t x = 0; x < num_tiles; ++x) {
+    for(std::size_t y = 0; y < num_tiles; ++y) {
+      std::size_t begin_x = x > 0 ? x * tile_size - 1 : 0;
+      std::size_t begin_y = y > 0 ? y * tile_size - 1 : 0;
+      std::size_t end_x = std::min((x + 1) * tile_size + 1, grid_size);
+      std::size_t end_y = std::min((y + 1) * tile_size + 1, grid_size);
+
+      rt::dag_node_ptr req = submit(
+          rt::id<2>{begin_x, begin_y},
+          rt::range<2>{end_x - begin_x, end_y - begin_y},
+          sycl::access::mode::read);
+
+      // Depends on the writers of the tile and its neighbors
+      std::size_t num_neighbors_x = 1 + (x > 0) + (x + 1 < num_tiles);
+      std::size_t num_neighbors_y = 1 + (y > 0) + (y + 1 < num_tiles);
+      BOOST_CHECK(req->get_requirements().size() ==
+                  num_neighbors_x * num_neighbors_y);
+    }
+  }
+  auto reads_done = clock::now();
+
+  // Reads can neither replace writes nor reads that are not
+  // among their dependencies
+  BOOST_CHECK(region->get_users().get_num_users() ==
+              2 * num_tiles * num_tiles);
+
+  auto to_us = [](auto duration) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration)
+        .count();
+  };
+  BOOST_TEST_MESSAGE("dag_builder benchmark (" << num_tiles * num_tiles
+                     << " tiles): writes " << to_us(writes_done - start)
+                     << " us, halo reads " << to_us(reads_done - writes_done)
+                     << " us");
+
+  for(auto& node : nodes)
+    node->cancel();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
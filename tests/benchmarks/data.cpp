@@ -0,0 +1,172 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "benchmark_suite.hpp"
+#include "../common/dense_page_table.hpp"
+
+#include <chrono>
+#include <vector>
+#include <hipSYCL/runtime/data.hpp>
+
+using namespace hipsycl;
+
+BOOST_FIXTURE_TEST_SUITE(data, reset_device_fixture)
+
+BOOST_AUTO_TEST_CASE(page_table_benchmark) {
+  // Compares the range_store against a dense per-page table for the
+  // operations that data_region::mark_range_current() and
+  // data_region::get_outdated_regions() perform: Slabs of a 3D buffer are
+  // written on one device, and another device queries its outdated pages.
+  const rt::range<3> num_pages{64, 64, 64};
+  const rt::range_store::rect full_range{rt::id<3>{0, 0, 0}, num_pages};
+  const std::size_t num_slabs = 8;
+  const int num_iterations = 10;
+
+  using clock = std::chrono::steady_clock;
+  std::vector<rt::range_store::rect> outdated;
+
+  auto run = [&](auto& table, auto&& mark_current, auto&& get_outdated) {
+    auto start = clock::now();
+    for(int it = 0; it < num_iterations; ++it) {
+      for(std::size_t slab = 0; slab < num_slabs; ++slab) {
+        rt::range_store::rect r{
+            rt::id<3>{slab * num_pages[0] / num_slabs, 0, 0},
+            rt::range<3>{num_pages[0] / num_slabs, num_pages[1],
+                         num_pages[2]}};
+        mark_current(table, r);
+        get_outdated(table, full_range, outdated);
+      }
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(clock::now() -
+                                                                 start)
+        .count();
+  };
+
+  rt::range_store sparse{num_pages};
+  auto sparse_time = run(
+      sparse,
+      [](rt::range_store &t, const rt::range_store::rect &r) { t.add(r); },
+      [](const rt::range_store &t, const rt::range_store::rect &r,
+         std::vector<rt::range_store::rect> &out) {
+        t.inverted_intersections_with(r, out);
+      });
+  std::size_t sparse_num_outdated = outdated.size();
+
+  dense_page_table dense{num_pages};
+  auto dense_time = run(
+      dense,
+      [](dense_page_table &t, const rt::range_store::rect &r) {
+        t.set(r, true);
+      },
+      [](const dense_page_table &t, const rt::range_store::rect &r,
+         std::vector<rt::range_store::rect> &out) {
+        t.intersections_with(r, false, out);
+      });
+
+  BOOST_CHECK(sparse_num_outdated == 0);
+  BOOST_CHECK(outdated.empty());
+
+  // Same pattern through data_region, which also converts between
+  // elements and pages
+  const rt::range<3> page_size{4, 4, 4};
+  rt::buffer_data_region region{
+      rt::range<3>{num_pages[0] * page_size[0], num_pages[1] * page_size[1],
+                   num_pages[2] * page_size[2]},
+      sizeof(float), page_size};
+  rt::device_id dev0{
+      rt::backend_descriptor{rt::hardware_platform::cpu, rt::api_platform::omp},
+      0};
+  rt::device_id dev1{
+      rt::backend_descriptor{rt::hardware_platform::cpu, rt::api_platform::omp},
+      1};
+  region.add_empty_allocation(dev0, nullptr, nullptr, false);
+  region.add_empty_allocation(dev1, nullptr, nullptr, false);
+
+  rt::range<3> num_elements = region.get_num_elements();
+  auto region_start = clock::now();
+  for(int it = 0; it < num_iterations; ++it) {
+    for(std::size_t slab = 0; slab < num_slabs; ++slab) {
+      rt::range<3> slab_size{num_elements[0] / num_slabs, num_elements[1],
+                             num_elements[2]};
+      rt::id<3> slab_offset{slab * slab_size[0], 0, 0};
+      region.mark_range_current(dev0, slab_offset, slab_size);
+      region.get_outdated_regions(dev1, rt::id<3>{0, 0, 0}, num_elements,
+                                  outdated);
+      // dev1 has never been updated, so the entire range must be outdated
+      BOOST_CHECK(outdated.size() == 1);
+    }
+  }
+  auto region_time = std::chrono::duration_cast<std::chrono::microseconds>(
+                         clock::now() - region_start)
+                         .count();
+
+  BOOST_TEST_MESSAGE("range_store benchmark ("
+                     << num_pages[0] << "x" << num_pages[1] << "x"
+                     << num_pages[2] << " pages): sparse " << sparse_time
+                     << " us, dense " << dense_time
+                     << " us, data_region (sparse) " << region_time << " us");
+}
+
+BOOST_AUTO_TEST_CASE(page_table_checkerboard_benchmark) {
+  // Worst case for the range_store: Every other page is written, so
+  // that no two available pages can be merged.
+  const rt::range<3> num_pages{48, 48, 1};
+  const rt::range_store::rect full_range{rt::id<3>{0, 0, 0}, num_pages};
+
+  using clock = std::chrono::steady_clock;
+  std::vector<rt::range_store::rect> outdated;
+
+  auto run = [&](auto &table, auto &&mark_current, auto &&get_outdated) {
+    auto start = clock::now();
+    for(int parity = 0; parity < 2; ++parity) {
+      for(std::size_t i = 0; i < num_pages[0]; ++i) {
+        for(std::size_t j = (i + parity) % 2; j < num_pages[1]; j += 2) {
+          mark_current(table, rt::range_store::rect{rt::id<3>{i, j, 0},
+                                                    rt::range<3>{1, 1, 1}});
+          get_outdated(table, full_range, outdated);
+        }
+      }
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(clock::now() -
+                                                                 start)
+        .count();
+  };
+
+  rt::range_store sparse{num_pages};
+  auto sparse_time = run(
+      sparse,
+      [](rt::range_store &t, const rt::range_store::rect &r) { t.add(r); },
+      [](const rt::range_store &t, const rt::range_store::rect &r,
+         std::vector<rt::range_store::rect> &out) {
+        t.inverted_intersections_with(r, out);
+      });
+  BOOST_CHECK(outdated.empty());
+  BOOST_CHECK(sparse.entire_range_filled(full_range));
+  BOOST_CHECK(sparse.get_num_fragments() == 1);
+
+  dense_page_table dense{num_pages};
+  auto dense_time = run(
+      dense,
+      [](dense_page_table &t, const rt::range_store::rect &r) {
+        t.set(r, true);
+      },
+      [](const dense_page_table &t, const rt::range_store::rect &r,
+         std::vector<rt::range_store::rect> &out) {
+        t.intersections_with(r, false, out);
+      });
+
+  BOOST_TEST_MESSAGE("range_store checkerboard benchmark ("
+                     << num_pages[0] << "x" << num_pages[1] << "x"
+                     << num_pages[2] << " pages): sparse " << sparse_time
+                     << " us, dense " << dense_time << " us");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
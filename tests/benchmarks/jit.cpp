@@ -0,0 +1,113 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "benchmark_suite.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+#include <sycl/sycl.hpp>
+
+namespace {
+
+#ifdef __ACPP_ENABLE_LLVM_SSCP_TARGET__
+
+template <int Variant> class math_kernel {
+public:
+  math_kernel(float *data, uint64_t salt) : _data{data}, _salt{salt} {}
+
+  void operator()(sycl::id<1> idx) const {
+    float x = _data[idx[0]] + static_cast<float>(Variant) +
+              static_cast<float>(_salt & 0x1);
+    _data[idx[0]] = sycl::sin(x) * sycl::cos(x) + sycl::exp(-x * x) +
+                    sycl::sqrt(sycl::fabs(x));
+  }
+
+private:
+  float *_data;
+  sycl::specialized<uint64_t> _salt;
+};
+
+template <int... Variants>
+void run_math_kernels(sycl::queue &q, float *data, std::size_t n,
+                      uint64_t salt, std::integer_sequence<int, Variants...>,
+                      std::vector<double> &latencies) {
+  auto run = [&](auto kernel) {
+    auto start = std::chrono::steady_clock::now();
+    q.parallel_for(sycl::range{n}, kernel).wait();
+    auto stop = std::chrono::steady_clock::now();
+    latencies.push_back(
+        std::chrono::duration<double, std::milli>(stop - start).count());
+  };
+  (run(math_kernel<Variants>{data, salt}), ...);
+}
+
+constexpr int num_kernels = 16;
+
+template <class KernelVariants>
+void report_jit_latency(sycl::queue &q, float *data, std::size_t n,
+                        uint64_t salt, const std::string &mode) {
+  std::vector<double> latencies;
+  run_math_kernels(q, data, n, salt, KernelVariants{}, latencies);
+
+  std::sort(latencies.begin(), latencies.end());
+  double total = 0.0;
+  for(double l : latencies)
+    total += l;
+
+  BOOST_TEST_MESSAGE("JIT latency, " << mode << " bitcode linking ("
+                     << num_kernels << " kernels on "
+                     << q.get_device().get_info<sycl::info::device::name>()
+                     << "): mean " << total / num_kernels << " ms, median "
+                     << latencies[num_kernels / 2] << " ms, min "
+                     << latencies.front() << " ms, max " << latencies.back()
+                     << " ms");
+}
+
+#endif
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(jit, reset_device_fixture)
+
+#ifdef __ACPP_ENABLE_LLVM_SSCP_TARGET__
+BOOST_AUTO_TEST_CASE(jit_latency) {
+  // The persistent kernel cache starts out empty, and each measured round
+  // specializes the kernels on a different value, so every launch requires
+  // a new JIT compilation including linking the builtin bitcode library.
+  using kernel_variants = std::make_integer_sequence<int, num_kernels>;
+  constexpr std::size_t n = 1024;
+
+  sycl::queue q;
+  float *data = sycl::malloc_shared<float>(n, q);
+  std::fill(data, data + n, 0.5f);
+
+  // Loads the JIT compiler and backend, which should not be attributed
+  // to either mode.
+  q.parallel_for(sycl::range{n}, math_kernel<0>{data, 0}).wait();
+
+  setenv("ACPP_S2_EAGER_BITCODE_LINKING", "1", 1);
+  report_jit_latency<kernel_variants>(q, data, n, 2, "eager");
+  unsetenv("ACPP_S2_EAGER_BITCODE_LINKING");
+  report_jit_latency<kernel_variants>(q, data, n, 4, "resident lazy");
+
+  for(std::size_t i = 0; i < n; ++i)
+    BOOST_CHECK(sycl::isfinite(data[i]));
+
+  sycl::free(data, q);
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
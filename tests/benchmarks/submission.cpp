@@ -0,0 +1,81 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "benchmark_suite.hpp"
+
+#include <chrono>
+#include <sycl/sycl.hpp>
+
+namespace {
+
+constexpr int num_warmup_submissions = 100;
+constexpr int num_submissions = 10000;
+
+template<class KernelName>
+double measure_submission_latency(sycl::queue &q, int *counter) {
+  auto submit = [&]() {
+    q.single_task<KernelName>([=]() {
+      sycl::atomic_ref<int, sycl::memory_order::relaxed,
+                       sycl::memory_scope::device>{*counter}++;
+    });
+  };
+
+  // Includes JIT compilation and runtime initialization
+  for(int i = 0; i < num_warmup_submissions; ++i)
+    submit();
+  q.wait();
+
+  auto start = std::chrono::steady_clock::now();
+  for(int i = 0; i < num_submissions; ++i)
+    submit();
+  auto stop = std::chrono::steady_clock::now();
+  q.wait();
+
+  BOOST_CHECK_EQUAL(*counter, num_warmup_submissions + num_submissions);
+  return std::chrono::duration<double, std::micro>(stop - start).count() /
+         num_submissions;
+}
+
+class in_order_submission_kernel;
+class out_of_order_submission_kernel;
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(submission, reset_device_fixture)
+
+BOOST_AUTO_TEST_CASE(submission_latency) {
+  // Measures the runtime overhead of submissions to the host device that
+  // is not hidden by any kernel execution, which is dominated by
+  // allocating DAG nodes, operations and requirement lists.
+  sycl::queue in_order_queue{sycl::cpu_selector_v,
+                             sycl::property::queue::in_order{}};
+  sycl::queue out_of_order_queue{sycl::cpu_selector_v};
+
+  int *counter = sycl::malloc_shared<int>(1, in_order_queue);
+  *counter = 0;
+  double in_order_latency =
+      measure_submission_latency<in_order_submission_kernel>(in_order_queue,
+                                                             counter);
+  *counter = 0;
+  double out_of_order_latency =
+      measure_submission_latency<out_of_order_submission_kernel>(
+          out_of_order_queue, counter);
+  sycl::free(counter, in_order_queue);
+
+  BOOST_TEST_MESSAGE("submission latency benchmark (" << num_submissions
+                     << " kernels on "
+                     << in_order_queue.get_device()
+                            .get_info<sycl::info::device::name>()
+                     << "): in-order " << in_order_latency
+                     << " us, out-of-order " << out_of_order_latency << " us");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
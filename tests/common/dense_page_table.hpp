@@ -0,0 +1,86 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef HIPSYCL_TESTS_DENSE_PAGE_TABLE_HPP
+#define HIPSYCL_TESTS_DENSE_PAGE_TABLE_HPP
+
+#include <cstddef>
+#include <vector>
+#include <hipSYCL/runtime/data.hpp>
+
+// Dense reference implementation with one entry per page, as the
+// range_store used to be implemented.
+class dense_page_table {
+public:
+  dense_page_table(hipsycl::rt::range<3> size)
+  : _size{size}, _entries(size.size(), false) {}
+
+  void set(const hipsycl::rt::range_store::rect& r, bool value) {
+    for_each_page(r, [&](std::size_t pos){ _entries[pos] = value; });
+  }
+
+  bool get(hipsycl::rt::id<3> idx) const {
+    return _entries[get_index(idx)];
+  }
+
+  bool entire_range_equals(const hipsycl::rt::range_store::rect& r, bool value) const {
+    bool result = true;
+    for_each_page(r, [&](std::size_t pos) {
+      if(_entries[pos] != value)
+        result = false;
+    });
+    return result;
+  }
+
+  // Collects the pages in state value as 1x1xN row fragments
+  void intersections_with(const hipsycl::rt::range_store::rect &r, bool value,
+                          std::vector<hipsycl::rt::range_store::rect> &out) const {
+    out.clear();
+    for(std::size_t x = r.first[0]; x < r.first[0] + r.second[0]; ++x) {
+      for(std::size_t y = r.first[1]; y < r.first[1] + r.second[1]; ++y) {
+        std::size_t row_begin = 0;
+        std::size_t row_length = 0;
+        for(std::size_t z = r.first[2]; z < r.first[2] + r.second[2]; ++z) {
+          if(_entries[get_index(hipsycl::rt::id<3>{x, y, z})] == value) {
+            if(row_length == 0)
+              row_begin = z;
+            ++row_length;
+          } else if(row_length > 0) {
+            out.push_back({hipsycl::rt::id<3>{x, y, row_begin},
+                           hipsycl::rt::range<3>{1, 1, row_length}});
+            row_length = 0;
+          }
+        }
+        if(row_length > 0)
+          out.push_back({hipsycl::rt::id<3>{x, y, row_begin},
+                         hipsycl::rt::range<3>{1, 1, row_length}});
+      }
+    }
+  }
+
+private:
+  template<class F>
+  void for_each_page(const hipsycl::rt::range_store::rect& r, F&& f) const {
+    for(std::size_t x = r.first[0]; x < r.first[0] + r.second[0]; ++x)
+      for(std::size_t y = r.first[1]; y < r.first[1] + r.second[1]; ++y)
+        for(std::size_t z = r.first[2]; z < r.first[2] + r.second[2]; ++z)
+          f(get_index(hipsycl::rt::id<3>{x, y, z}));
+  }
+
+  std::size_t get_index(hipsycl::rt::id<3> idx) const {
+    return idx[0] * _size[1] * _size[2] + idx[1] * _size[2] + idx[2];
+  }
+
+  hipsycl::rt::range<3> _size;
+  std::vector<bool> _entries;
+};
+
+#endif
@@ -0,0 +1,76 @@
+// RUN: %acpp %s -o %t --acpp-targets=generic -mllvm -acpp-sscp-kernel-opts=host-fiber-barriers
+// RUN: ACPP_VISIBILITY_MASK=omp; %t | FileCheck %s
+// RUN: %acpp %s -o %t --acpp-targets=generic -O -mllvm -acpp-sscp-kernel-opts=host-fiber-barriers
+// RUN: ACPP_VISIBILITY_MASK=omp; %t | FileCheck %s
+
+// Forces the host-fiber-barriers lowering, which executes each work item
+// as a fiber that yields at barriers instead of splitting the kernel.
+
+#include <iostream>
+
+#include <CL/sycl.hpp>
+
+int main()
+{
+  constexpr size_t local_size = 256;
+  constexpr size_t global_size = 1024;
+  constexpr size_t num_rotations = 3;
+
+  cl::sycl::queue queue;
+  std::vector<int> host_buf;
+  for(size_t i = 0; i < global_size; ++i)
+  {
+    host_buf.push_back(static_cast<int>(i));
+  }
+
+  {
+    cl::sycl::buffer<int, 1> buf{host_buf.data(), host_buf.size()};
+
+    queue.submit([&](cl::sycl::handler &cgh) {
+      using namespace cl::sycl::access;
+      auto acc = buf.get_access<mode::read_write>(cgh);
+      auto scratch = cl::sycl::accessor<int, 1, mode::read_write, target::local>{local_size, cgh};
+
+      cgh.parallel_for<class fiber_rotate_and_reduce>(
+        cl::sycl::nd_range<1>{global_size, local_size},
+          [=](cl::sycl::nd_item<1> item) noexcept {
+            const auto lid = item.get_local_id(0);
+            const auto group_size = item.get_local_range(0);
+
+            scratch[lid] = acc[item.get_global_id()];
+            // Values held in registers must survive the barriers
+            for(size_t r = 0; r < num_rotations; ++r)
+            {
+              item.barrier();
+              int next = scratch[(lid + 1) % group_size];
+              item.barrier();
+              scratch[lid] = next;
+            }
+            item.barrier();
+            // Store the rotated values, the reduction overwrites scratch
+            acc[item.get_global_id()] = scratch[lid];
+
+            for(size_t i = group_size / 2; i > 0; i /= 2)
+            {
+              item.barrier();
+              if(lid < i)
+                scratch[lid] += scratch[lid + i];
+            }
+
+            if(lid == 0)
+              acc[item.get_global_id()] += scratch[lid];
+          });
+    });
+  }
+  for(size_t i = 0; i < global_size / local_size; ++i)
+  {
+    // CHECK: 32643 4 0 2
+    // CHECK: 98435 260 256 258
+    // CHECK: 164227 516 512 514
+    // CHECK: 230019 772 768 770
+    const size_t offset = i * local_size;
+    std::cout << host_buf[offset] << " " << host_buf[offset + 1] << " "
+              << host_buf[offset + local_size - 3] << " "
+              << host_buf[offset + local_size - 1] << "\n";
+  }
+}
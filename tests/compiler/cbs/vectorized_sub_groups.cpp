@@ -0,0 +1,91 @@
+// RUN: %acpp %s -o %t --acpp-targets=generic -mllvm -acpp-sscp-kernel-opts=host-vectorized-subgroups
+// RUN: ACPP_VISIBILITY_MASK=omp; %t | FileCheck %s
+// RUN: %acpp %s -o %t --acpp-targets=generic -O -mllvm -acpp-sscp-kernel-opts=host-vectorized-subgroups
+// RUN: ACPP_VISIBILITY_MASK=omp; %t | FileCheck %s
+
+// Maps sub-groups to the SIMD lanes of the host. The sub-group size depends on
+// the host ISA, so each work item checks the results of the sub-group
+// operations against the sizes it queries. The local size in x direction is
+// not a multiple of typical SIMD widths, so the last sub-group of each row is
+// only partially filled.
+
+#include <iostream>
+
+#include <CL/sycl.hpp>
+
+int main()
+{
+  constexpr size_t local_size_x = 30;
+  constexpr size_t local_size_y = 2;
+  constexpr size_t global_size_x = 4 * local_size_x;
+  constexpr size_t global_size_y = 2 * local_size_y;
+
+  cl::sycl::queue queue;
+  std::vector<int> errors(global_size_x * global_size_y, -1);
+
+  {
+    cl::sycl::buffer<int, 2> buf{errors.data(), cl::sycl::range<2>{global_size_y, global_size_x}};
+
+    queue.submit([&](cl::sycl::handler &cgh) {
+      using namespace cl::sycl::access;
+      auto acc = buf.get_access<mode::discard_write>(cgh);
+
+      cgh.parallel_for<class vectorized_sub_group_ops>(
+        cl::sycl::nd_range<2>{{global_size_y, global_size_x}, {local_size_y, local_size_x}},
+          [=](cl::sycl::nd_item<2> item) noexcept {
+            auto sg = item.get_sub_group();
+            const int lid = static_cast<int>(item.get_local_id(1));
+            const int row = static_cast<int>(item.get_local_id(0));
+            const int sg_lid = static_cast<int>(sg.get_local_id()[0]);
+            const int sg_size = static_cast<int>(sg.get_local_range()[0]);
+            const int sg_max_size = static_cast<int>(sg.get_max_local_range()[0]);
+            // sub-groups consist of consecutive work items within a row
+            const int first = lid - sg_lid;
+            const int sgs_per_row = (local_size_x + sg_max_size - 1) / sg_max_size;
+
+            int err = 0;
+            err += sg_size < 1 || sg_size > sg_max_size || sg_lid >= sg_size;
+            err += first % sg_max_size != 0;
+            err += static_cast<int>(sg.get_group_id()[0]) != row * sgs_per_row + first / sg_max_size;
+            err += static_cast<int>(sg.get_group_range()[0]) != local_size_y * sgs_per_row;
+
+            err += cl::sycl::reduce_over_group(sg, lid, cl::sycl::plus<int>()) !=
+                   sg_size * first + sg_size * (sg_size - 1) / 2;
+            err += cl::sycl::reduce_over_group(sg, lid, cl::sycl::maximum<int>()) !=
+                   first + sg_size - 1;
+            err += cl::sycl::reduce_over_group(sg, -lid, cl::sycl::minimum<int>()) !=
+                   -(first + sg_size - 1);
+            err += cl::sycl::reduce_over_group(sg, 0.5f, cl::sycl::plus<float>()) !=
+                   0.5f * sg_size;
+
+            const int inclusive = (sg_lid + 1) * first + sg_lid * (sg_lid + 1) / 2;
+            err += cl::sycl::inclusive_scan_over_group(sg, lid, cl::sycl::plus<int>()) != inclusive;
+            err += cl::sycl::exclusive_scan_over_group(sg, lid, cl::sycl::plus<int>()) !=
+                   inclusive - lid;
+
+            err += cl::sycl::group_broadcast(sg, lid, 0) != first;
+            err += cl::sycl::select_from_group(sg, lid, sg_size - 1) != first + sg_size - 1;
+            // the results of lanes without a source lane are unspecified
+            const int left = cl::sycl::shift_group_left(sg, lid, 1);
+            const int right = cl::sycl::shift_group_right(sg, lid, 1);
+            const int swapped = cl::sycl::permute_group_by_xor(sg, lid, 1);
+            err += sg_lid + 1 < sg_size && left != lid + 1;
+            err += sg_lid >= 1 && right != lid - 1;
+            err += (sg_lid ^ 1) < sg_size && swapped != first + (sg_lid ^ 1);
+
+            err += !cl::sycl::any_of_group(sg, sg_lid == sg_size - 1);
+            err += !cl::sycl::all_of_group(sg, lid >= first);
+            err += !cl::sycl::none_of_group(sg, lid < first);
+            err += cl::sycl::all_of_group(sg, sg_lid == 0) != (sg_size == 1);
+
+            acc[item.get_global_id()] = err;
+          });
+    });
+  }
+
+  int total_errors = 0;
+  for(int e : errors)
+    total_errors += e;
+  // CHECK: errors: 0
+  std::cout << "errors: " << total_errors << "\n";
+}
@@ -13,9 +13,12 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/test/unit_test_suite.hpp>
 
+#include <atomic>
+#include <cstdlib>
 #include <cstdint>
 #include <random>
 #include <unordered_set>
+#include <vector>
 #include <thread>
 #include <hipSYCL/std/stdpar/detail/allocation_map.hpp>
 
@@ -242,5 +245,163 @@ BOOST_AUTO_TEST_CASE(multi_threaded) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(lookup_after_erase) {
+  amap_t amap;
+  const uint64_t address = 1ull << 46;
+  amap_t::value_type v;
+  v.allocation_size = 128;
+  BOOST_CHECK(amap.insert(address, v));
+
+  // Populate this thread's cached lookup result
+  uint64_t root_address = 0;
+  BOOST_CHECK(amap.get_entry(address + 16, root_address));
+  BOOST_CHECK(root_address == address);
+  BOOST_CHECK(amap.get_entry_of_root_address(address));
+
+  BOOST_CHECK(amap.erase(address));
+  BOOST_CHECK(!amap.get_entry(address + 16, root_address));
+  BOOST_CHECK(!amap.get_entry(address, root_address));
+  BOOST_CHECK(!amap.get_entry_of_root_address(address));
+}
+
+BOOST_AUTO_TEST_CASE(reinsert_with_different_size) {
+  amap_t amap;
+  const uint64_t address = 1ull << 46;
+
+  for(std::size_t size : {128, 256, 32}) {
+    amap_t::value_type v;
+    v.allocation_size = size;
+    BOOST_CHECK(amap.insert(address, v));
+
+    uint64_t root_address = 0;
+    auto* ret = amap.get_entry(address + 16, root_address);
+    BOOST_CHECK(ret);
+    if(ret) {
+      BOOST_CHECK(root_address == address);
+      BOOST_CHECK(ret->allocation_size == size);
+    }
+    ret = amap.get_entry_of_root_address(address);
+    BOOST_CHECK(ret);
+    if(ret)
+      BOOST_CHECK(ret->allocation_size == size);
+    // The end of the new allocation must be seen, and not that of the
+    // previous one.
+    BOOST_CHECK(amap.get_entry(address + size - 1, root_address));
+    BOOST_CHECK(!amap.get_entry(address + size, root_address));
+
+    BOOST_CHECK(amap.erase(address));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(separate_maps_in_one_thread) {
+  amap_t amap1;
+  amap_t amap2;
+  const uint64_t address = 1ull << 46;
+
+  amap_t::value_type v;
+  v.allocation_size = 128;
+  BOOST_CHECK(amap1.insert(address, v));
+
+  uint64_t root_address = 0;
+  BOOST_CHECK(amap1.get_entry(address + 16, root_address));
+  // amap2 must not return the entry cached by the lookup in amap1
+  BOOST_CHECK(!amap2.get_entry(address + 16, root_address));
+  BOOST_CHECK(!amap2.get_entry_of_root_address(address));
+
+  v.allocation_size = 64;
+  BOOST_CHECK(amap2.insert(address, v));
+  auto* entry1 = amap1.get_entry(address + 16, root_address);
+  auto* entry2 = amap2.get_entry(address + 16, root_address);
+  BOOST_CHECK(entry1 && entry2 && entry1 != entry2);
+  if(entry1 && entry2) {
+    BOOST_CHECK(entry1->allocation_size == 128);
+    BOOST_CHECK(entry2->allocation_size == 64);
+  }
+  BOOST_CHECK(amap1.get_entry(address + 100, root_address));
+  BOOST_CHECK(!amap2.get_entry(address + 100, root_address));
+}
+
+struct counting_untyped_allocator {
+  static void* allocate(size_t n) {
+    num_live_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(n);
+  }
+
+  static void deallocate(void* ptr) {
+    num_live_allocations.fetch_sub(1, std::memory_order_relaxed);
+    std::free(ptr);
+  }
+
+  static inline std::atomic<long> num_live_allocations{0};
+};
+
+BOOST_AUTO_TEST_CASE(node_reclamation_during_lookups) {
+  using counting_amap_t =
+      hipsycl::common::allocation_map<payload, counting_untyped_allocator>;
+  const int num_readers = 4;
+  const uint64_t num_persistent = 256;
+  const uint64_t num_erased = 512;
+
+  counting_amap_t amap;
+  // Allocations that remain in the map and are looked up concurrently
+  std::vector<uint64_t> persistent_addresses;
+  for(uint64_t i = 0; i < num_persistent; ++i) {
+    counting_amap_t::value_type v;
+    v.allocation_size = 64 + i;
+    uint64_t address = (1ull << 46) + i * 4096;
+    BOOST_CHECK(amap.insert(address, v));
+    persistent_addresses.push_back(address);
+  }
+  // Each of these allocations owns a chain of nodes, so that erasing them
+  // retires many more than a single batch of nodes.
+  std::vector<uint64_t> erased_addresses;
+  for(uint64_t i = 1; i <= num_erased; ++i) {
+    counting_amap_t::value_type v;
+    v.allocation_size = 64;
+    uint64_t address = i << 36;
+    BOOST_CHECK(amap.insert(address, v));
+    erased_addresses.push_back(address);
+  }
+  long num_live_before_erase =
+      counting_untyped_allocator::num_live_allocations.load();
+
+  std::atomic<bool> is_done = false;
+  std::atomic<int> num_failures = 0;
+  std::vector<std::thread> readers;
+  for(int t = 0; t < num_readers; ++t) {
+    readers.push_back(std::thread{[&, t]() {
+      std::size_t i = t;
+      while(!is_done.load(std::memory_order_acquire)) {
+        uint64_t address = persistent_addresses[i % num_persistent];
+        uint64_t root_address = 0;
+        auto *ret = amap.get_entry(address + 8, root_address);
+        if (!ret || root_address != address ||
+            ret->allocation_size != 64 + i % num_persistent)
+          num_failures.fetch_add(1, std::memory_order_relaxed);
+        // Walks nodes that may be retired concurrently
+        amap.get_entry(erased_addresses[i % num_erased] + 8, root_address);
+        ++i;
+      }
+    }});
+  }
+
+  for(uint64_t address : erased_addresses)
+    BOOST_CHECK(amap.erase(address));
+  long num_live_after_erase =
+      counting_untyped_allocator::num_live_allocations.load();
+
+  is_done.store(true, std::memory_order_release);
+  for(auto& reader : readers)
+    reader.join();
+
+  BOOST_CHECK(num_failures.load() == 0);
+  // Retired nodes must be freed while the map is still in use
+  BOOST_CHECK(num_live_before_erase - num_live_after_erase >=
+              static_cast<long>(num_erased));
+  for(uint64_t address : erased_addresses) {
+    uint64_t root_address = 0;
+    BOOST_CHECK(!amap.get_entry(address, root_address));
+  }
+}
 
 BOOST_AUTO_TEST_SUITE_END()
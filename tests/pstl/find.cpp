@@ -0,0 +1,108 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <algorithm>
+#include <execution>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "pstl_test_suite.hpp"
+
+BOOST_FIXTURE_TEST_SUITE(pstl_find, enable_unified_shared_memory)
+
+template <class Policy, class Generator, class Predicate>
+void test_find(Policy&& pol, std::size_t problem_size, Generator gen, Predicate p) {
+  std::vector<int> data(problem_size);
+  for(int i = 0; i < problem_size; ++i)
+    data[i] = gen(i);
+
+  BOOST_CHECK(std::find_if(pol, data.begin(), data.end(), p) ==
+              std::find_if(data.begin(), data.end(), p));
+  BOOST_CHECK(std::find_if_not(pol, data.begin(), data.end(), p) ==
+              std::find_if_not(data.begin(), data.end(), p));
+  BOOST_CHECK(std::find(pol, data.begin(), data.end(), 42) ==
+              std::find(data.begin(), data.end(), 42));
+  BOOST_CHECK(std::adjacent_find(pol, data.begin(), data.end()) ==
+              std::adjacent_find(data.begin(), data.end()));
+
+  std::vector<int> other = data;
+  if(problem_size > 0)
+    other[problem_size / 2] = -1;
+  BOOST_CHECK(std::mismatch(pol, data.begin(), data.end(), other.begin()) ==
+              std::mismatch(data.begin(), data.end(), other.begin()));
+  BOOST_CHECK(std::mismatch(pol, data.begin(), data.end(), other.begin(),
+                            other.begin() + problem_size / 3) ==
+              std::mismatch(data.begin(), data.end(), other.begin(),
+                            other.begin() + problem_size / 3));
+}
+
+template<class Policy>
+void empty_tests(Policy&& pol) {
+  test_find(pol, 0, [](int i){return i;}, [](int x){ return x > 0;});
+}
+
+template<class Policy>
+void single_element_tests(Policy&& pol) {
+  test_find(pol, 1, [](int i){return i;}, [](int x){ return x < 0;});
+  test_find(pol, 1, [](int i){return 42;}, [](int x){ return x >= 0;});
+}
+
+template<class Policy>
+void medium_size_tests(Policy&& pol) {
+  test_find(pol, 1000, [](int i){return i;}, [](int x){ return x < 0;});
+  test_find(pol, 1000, [](int i){return i;}, [](int x){ return x > 500;});
+  test_find(pol, 1000, [](int i){return i / 2;}, [](int x){ return x % 7 == 6;});
+}
+
+template<class Policy>
+void large_size_tests(Policy&& pol) {
+  // Many matches, so that multiple work items race for the lowest index
+  test_find(pol, 100000, [](int i){return (i * 7919) % 10007;},
+            [](int x){ return x % 3 == 0;});
+  test_find(pol, 100000, [](int i){return i == 99998 ? 42 : 0;},
+            [](int x){ return x == 42;});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_empty) {
+  empty_tests(std::execution::par_unseq);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_single_element) {
+  single_element_tests(std::execution::par_unseq);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_medium_size) {
+  medium_size_tests(std::execution::par_unseq);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_large_size) {
+  large_size_tests(std::execution::par_unseq);
+}
+
+BOOST_AUTO_TEST_CASE(par_empty) {
+  empty_tests(std::execution::par);
+}
+
+BOOST_AUTO_TEST_CASE(par_single_element) {
+  single_element_tests(std::execution::par);
+}
+
+BOOST_AUTO_TEST_CASE(par_medium_size) {
+  medium_size_tests(std::execution::par);
+}
+
+BOOST_AUTO_TEST_CASE(par_large_size) {
+  large_size_tests(std::execution::par);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
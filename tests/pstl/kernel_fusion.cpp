@@ -0,0 +1,113 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <algorithm>
+#include <cstdlib>
+#include <execution>
+#include <functional>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "pstl_test_suite.hpp"
+
+namespace {
+
+// The stdpar runtime is thread-local and reads ACPP_STDPAR_KERNEL_FUSION
+// when it is constructed, so run f on a fresh thread.
+template<class F>
+void run_with_kernel_fusion(bool enabled, F f) {
+  setenv("ACPP_STDPAR_KERNEL_FUSION", enabled ? "1" : "0", 1);
+  std::thread worker{f};
+  worker.join();
+  unsetenv("ACPP_STDPAR_KERNEL_FUSION");
+}
+
+void init(std::vector<long long>& a, std::vector<long long>& b) {
+  for(std::size_t i = 0; i < a.size(); ++i) {
+    a[i] = static_cast<long long>(i);
+    b[i] = 0;
+  }
+}
+
+void for_each_then_transform(std::vector<long long> &a,
+                             std::vector<long long> &b) {
+  std::for_each(std::execution::par_unseq, a.begin(), a.end(),
+                [](long long &x) { x = 2 * x + 1; });
+  std::transform(std::execution::par_unseq, a.begin(), a.end(), b.begin(),
+                 [](long long x) { return 3 * x; });
+}
+
+long long chain(std::vector<long long> &a, std::vector<long long> &b) {
+  for_each_then_transform(a, b);
+  return std::transform_reduce(std::execution::par_unseq, b.begin(), b.end(),
+                               0ll, std::plus<>{},
+                               [](long long x) { return x + 1; });
+}
+
+void check(const std::vector<long long>& a, const std::vector<long long>& b) {
+  for(std::size_t i = 0; i < a.size(); ++i) {
+    long long expected = 2 * static_cast<long long>(i) + 1;
+    BOOST_CHECK(a[i] == expected);
+    BOOST_CHECK(b[i] == 3 * expected);
+  }
+}
+
+long long reference_result(std::size_t size) {
+  long long result = 0;
+  for(std::size_t i = 0; i < size; ++i)
+    result += 3 * (2 * static_cast<long long>(i) + 1) + 1;
+  return result;
+}
+
+void test_chain(bool kernel_fusion, std::size_t size) {
+  std::vector<long long> a(size);
+  std::vector<long long> b(size);
+  init(a, b);
+
+  long long result = 0;
+  run_with_kernel_fusion(kernel_fusion, [&]() { result = chain(a, b); });
+
+  BOOST_CHECK(result == reference_result(size));
+  check(a, b);
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(pstl_kernel_fusion, enable_unified_shared_memory)
+
+BOOST_AUTO_TEST_CASE(par_unseq_chain_fused) {
+  test_chain(true, 1000);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_chain_unfused) {
+  test_chain(false, 1000);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_chain_fused_single_element) {
+  test_chain(true, 1);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_deferred_at_thread_exit) {
+  std::vector<long long> a(1000);
+  std::vector<long long> b(1000);
+  init(a, b);
+
+  // The worker exits without anything forcing its deferred
+  // operations to complete.
+  run_with_kernel_fusion(true, [&]() { for_each_then_transform(a, b); });
+
+  check(a, b);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -2,6 +2,8 @@
 #include <execution>
 #include <vector>
 #include <cstdlib>
+#include <cstring>
+#include <thread>
 
 #include <boost/test/unit_test.hpp>
 
@@ -63,4 +65,73 @@ BOOST_AUTO_TEST_CASE(pstl_aligned_alloc) {
   std::free(p1);
 }
 
+BOOST_AUTO_TEST_CASE(pstl_small_allocations_from_multiple_threads) {
+  // Small allocations are served from slabs of the memory pool, which
+  // are found by masking block addresses. Freeing half of the blocks in
+  // between moves blocks between the thread caches and the slabs.
+  constexpr int num_threads = 4;
+  constexpr std::size_t num_blocks = 4096;
+  constexpr std::size_t max_size = 2048;
+
+  auto get_size = [](std::size_t i) { return 1 + (i * 37) % max_size; };
+  auto get_value = [](int thread, std::size_t i) {
+    return static_cast<unsigned char>(thread * 31 + i);
+  };
+
+  std::vector<std::vector<unsigned char *>> blocks(num_threads);
+  auto allocate = [&](int t, std::size_t i) {
+    auto *p = static_cast<unsigned char *>(std::malloc(get_size(i)));
+    std::memset(p, get_value(t, i), get_size(i));
+    blocks[t][i] = p;
+  };
+
+  std::vector<std::thread> threads;
+  for(int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      enable_unified_shared_memory usm;
+      blocks[t].resize(num_blocks);
+      for(std::size_t i = 0; i < num_blocks; ++i)
+        allocate(t, i);
+      for(std::size_t i = 0; i < num_blocks; i += 2)
+        std::free(blocks[t][i]);
+      for(std::size_t i = 0; i < num_blocks; i += 2)
+        allocate(t, i);
+    });
+  }
+  for(auto& thread : threads)
+    thread.join();
+  threads.clear();
+
+  std::size_t num_corrupted = 0;
+  for(int t = 0; t < num_threads; ++t) {
+    for(std::size_t i = 0; i < num_blocks; ++i) {
+      for(std::size_t j = 0; j < get_size(i); ++j) {
+        if(blocks[t][i][j] != get_value(t, i)) {
+          ++num_corrupted;
+          break;
+        }
+      }
+    }
+  }
+  BOOST_CHECK_EQUAL(num_corrupted, 0);
+
+  // Small blocks must still be usable on the device
+  int *p = static_cast<int *>(std::malloc(16 * sizeof(int)));
+  std::fill(std::execution::par_unseq, p, p + 16, 42);
+  for(int i = 0; i < 16; ++i)
+    BOOST_CHECK_EQUAL(p[i], 42);
+  std::free(p);
+
+  // Free the blocks of another thread
+  for(int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      enable_unified_shared_memory usm;
+      for(unsigned char *p : blocks[(t + 1) % num_threads])
+        std::free(p);
+    });
+  }
+  for(auto& thread : threads)
+    thread.join();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
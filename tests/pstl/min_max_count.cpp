@@ -0,0 +1,67 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <algorithm>
+#include <execution>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "pstl_test_suite.hpp"
+
+BOOST_FIXTURE_TEST_SUITE(pstl_min_max_count, enable_unified_shared_memory)
+
+template <class Policy, class Generator>
+void test_min_max_count(Policy&& pol, std::size_t problem_size, Generator gen) {
+  std::vector<int> data(problem_size);
+  for(int i = 0; i < problem_size; ++i)
+    data[i] = gen(i);
+
+  BOOST_CHECK(std::min_element(pol, data.begin(), data.end()) ==
+              std::min_element(data.begin(), data.end()));
+  BOOST_CHECK(std::max_element(pol, data.begin(), data.end()) ==
+              std::max_element(data.begin(), data.end()));
+  BOOST_CHECK(
+      std::min_element(pol, data.begin(), data.end(), std::greater<>{}) ==
+      std::min_element(data.begin(), data.end(), std::greater<>{}));
+  BOOST_CHECK(
+      std::max_element(pol, data.begin(), data.end(), std::greater<>{}) ==
+      std::max_element(data.begin(), data.end(), std::greater<>{}));
+
+  BOOST_CHECK(std::count(pol, data.begin(), data.end(), 3) ==
+              std::count(data.begin(), data.end(), 3));
+  auto p = [](int x) { return x % 2 == 0; };
+  BOOST_CHECK(std::count_if(pol, data.begin(), data.end(), p) ==
+              std::count_if(data.begin(), data.end(), p));
+}
+
+template<class Policy>
+void run_tests(Policy&& pol) {
+  test_min_max_count(pol, 0, [](int i){return i;});
+  test_min_max_count(pol, 1, [](int i){return i;});
+  test_min_max_count(pol, 1000, [](int i){return i;});
+  test_min_max_count(pol, 1000, [](int i){return -i;});
+  // Duplicate extrema test that the first one is returned
+  test_min_max_count(pol, 1000, [](int i){return i % 10;});
+  test_min_max_count(pol, 100000, [](int i){return (i * 7919) % 10007;});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq) {
+  run_tests(std::execution::par_unseq);
+}
+
+BOOST_AUTO_TEST_CASE(par) {
+  run_tests(std::execution::par);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -22,13 +22,14 @@
 
 BOOST_FIXTURE_TEST_SUITE(pstl_sort, enable_unified_shared_memory)
 
-template <class Policy, class Generator, class Comp = std::less<>>
+template <class T = int, class Policy, class Generator,
+          class Comp = std::less<>>
 void test_sort(Policy &&pol, std::size_t problem_size, Generator gen,
                Comp comp = {}) {
-  std::vector<int> data(problem_size);
+  std::vector<T> data(problem_size);
   for(int i = 0; i < problem_size; ++i)
     data[i] = gen(i);
-  std::vector<int> host_data = data;
+  std::vector<T> host_data = data;
 
   std::sort(pol, data.begin(), data.end(), comp);
   
@@ -62,4 +63,41 @@ BOOST_AUTO_TEST_CASE(par_unseq_non_pow2_ascending) {
   test_sort(std::execution::par_unseq, 1000, [](int i){return i;});
 }
 
+BOOST_AUTO_TEST_CASE(par_unseq_large_random) {
+  test_sort(std::execution::par_unseq, 100000,
+            [](int i) { return static_cast<int>((i * 2654435761u) >> 1) - i; });
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_large_duplicates) {
+  test_sort(std::execution::par_unseq, 100000, [](int i){return (i * 7) % 13;});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_greater) {
+  test_sort(std::execution::par_unseq, 100000,
+            [](int i) { return (i * 37) % 1001 - 500; }, std::greater<>{});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_unsigned) {
+  test_sort<unsigned long>(std::execution::par_unseq, 100000, [](int i) {
+    return static_cast<unsigned long>(i) * 0x9e3779b97f4a7c15ul;
+  });
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_float) {
+  test_sort<float>(std::execution::par_unseq, 100000,
+                   [](int i) { return (i % 2 ? -1.5f : 1.f) * (i % 977); });
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_double_greater) {
+  test_sort<double>(std::execution::par_unseq, 100000,
+                    [](int i) { return 1.0 / (i - 50000.5); },
+                    std::greater<double>{});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_custom_comparator) {
+  test_sort(std::execution::par_unseq, 1000, [](int i){return (i * 37) % 1001;},
+            [](int a, int b) { return a % 100 < b % 100 ||
+                                      (a % 100 == b % 100 && a < b); });
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,124 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <utility>
+#include <vector>
+#include <functional>
+
+#include <boost/test/unit_test.hpp>
+
+#include "pstl_test_suite.hpp"
+
+BOOST_FIXTURE_TEST_SUITE(pstl_stable_sort, enable_unified_shared_memory)
+
+struct keyed_element {
+  int key;
+  int index;
+
+  friend bool operator==(const keyed_element &a, const keyed_element &b) {
+    return a.key == b.key && a.index == b.index;
+  }
+};
+
+struct compare_keys {
+  bool operator()(const keyed_element &a, const keyed_element &b) const {
+    return a.key < b.key;
+  }
+};
+
+template <class Policy, class Generator>
+void test_stable_sort(Policy &&pol, std::size_t problem_size, Generator gen) {
+  std::vector<keyed_element> data(problem_size);
+  for(int i = 0; i < problem_size; ++i)
+    data[i] = keyed_element{gen(i), i};
+  std::vector<keyed_element> host_data = data;
+
+  std::stable_sort(pol, data.begin(), data.end(), compare_keys{});
+
+  std::stable_sort(host_data.begin(), host_data.end(), compare_keys{});
+  BOOST_CHECK(host_data == data);
+}
+
+template <class Policy, class Generator>
+void test_stable_sort_int(Policy &&pol, std::size_t problem_size,
+                          Generator gen) {
+  std::vector<int> data(problem_size);
+  for(int i = 0; i < problem_size; ++i)
+    data[i] = gen(i);
+  std::vector<int> host_data = data;
+
+  std::stable_sort(pol, data.begin(), data.end());
+
+  std::stable_sort(host_data.begin(), host_data.end());
+  BOOST_CHECK(host_data == data);
+}
+
+template <class Policy>
+void test_stable_sort_signed_zeros(Policy &&pol, std::size_t problem_size) {
+  std::vector<double> data(problem_size);
+  for(int i = 0; i < problem_size; ++i)
+    data[i] = (i % 3 == 0) ? 0.0 : ((i % 3 == 1) ? -0.0 : -1.0);
+  std::vector<double> host_data = data;
+
+  std::stable_sort(pol, data.begin(), data.end());
+
+  std::stable_sort(host_data.begin(), host_data.end());
+  // -0.0 == 0.0, so also compare the signs to check stability
+  for(std::size_t i = 0; i < problem_size; ++i) {
+    BOOST_CHECK(host_data[i] == data[i]);
+    BOOST_CHECK(std::signbit(host_data[i]) == std::signbit(data[i]));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_empty) {
+  test_stable_sort(std::execution::par_unseq, 0, [](int i){return 0;});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_single_element) {
+  test_stable_sort(std::execution::par_unseq, 1, [](int i){return i;});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_descending) {
+  test_stable_sort(std::execution::par_unseq, 1000, [](int i){return -i;});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_duplicates) {
+  test_stable_sort(std::execution::par_unseq, 1000, [](int i){return i % 7;});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_large_duplicates) {
+  test_stable_sort(std::execution::par_unseq, 100000,
+                   [](int i) { return (i * 37) % 101; });
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_large_random_int) {
+  test_stable_sort_int(std::execution::par_unseq, 100000,
+                       [](int i) { return (i * 7919) % 10007 - 5000; });
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_signed_zeros) {
+  test_stable_sort_signed_zeros(std::execution::par_unseq, 2);
+  test_stable_sort_signed_zeros(std::execution::par_unseq, 1000);
+}
+
+BOOST_AUTO_TEST_CASE(par_duplicates) {
+  test_stable_sort(std::execution::par, 1000, [](int i){return i % 7;});
+}
+
+BOOST_AUTO_TEST_CASE(par_large_duplicates) {
+  test_stable_sort(std::execution::par, 100000,
+                   [](int i) { return (i * 37) % 101; });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,196 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "runtime_test_suite.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+#include <hipSYCL/common/appdb.hpp>
+#include <hipSYCL/common/config.hpp>
+#include <hipSYCL/common/filesystem.hpp>
+
+#include HIPSYCL_CXX_FILESYSTEM_HEADER
+namespace fs = HIPSYCL_CXX_FILESYSTEM_NAMESPACE;
+
+using namespace hipsycl;
+using common::db::appdb;
+using common::db::appdb_data;
+
+namespace {
+
+std::string get_test_db_path(const std::string& name) {
+  fs::path dir = fs::temp_directory_path() / "acpp-rt-tests";
+  fs::create_directories(dir);
+  std::string path = (dir / name).string();
+  appdb::remove(path);
+  return path;
+}
+
+void set_latency(appdb& db, const std::string& key, double latency) {
+  db.read_write_access([&](appdb_data& data) {
+    data.memcpy_models[key].latency = latency;
+  });
+}
+
+// Opens the database like a new process would
+std::size_t count_entries(const std::string& path, const std::string& prefix,
+                          std::size_t num_entries) {
+  appdb db{path};
+  return db.read_access([&](const appdb_data& data) {
+    std::size_t count = 0;
+    for(std::size_t i = 0; i < num_entries; ++i) {
+      auto it = data.memcpy_models.find(prefix + std::to_string(i));
+      if(it != data.memcpy_models.end() &&
+         it->second.latency == static_cast<double>(i))
+        ++count;
+    }
+    return count;
+  });
+}
+
+std::string read_journal(const std::string& path) {
+  std::ifstream file{path + ".journal", std::ios::in | std::ios::binary};
+  return std::string{std::istreambuf_iterator<char>{file},
+                     std::istreambuf_iterator<char>{}};
+}
+
+// Simulates a process that was killed while appending a record
+std::string append_torn_record(const std::string& path) {
+  std::string torn_record = read_journal(path).substr(0, 24);
+  BOOST_REQUIRE_EQUAL(torn_record.size(), 24);
+  common::filesystem::append(path + ".journal", torn_record);
+  return torn_record;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(appdb_journal)
+
+BOOST_AUTO_TEST_CASE(torn_tail_followed_by_append) {
+  std::string path = get_test_db_path("torn_tail");
+  {
+    appdb db{path};
+    set_latency(db, "a0", 0);
+    db.sync();
+  }
+  append_torn_record(path);
+  {
+    appdb db{path};
+    set_latency(db, "b0", 0);
+    db.sync();
+    set_latency(db, "b1", 1);
+    db.sync();
+  }
+  BOOST_CHECK_EQUAL(count_entries(path, "a", 1), 1);
+  BOOST_CHECK_EQUAL(count_entries(path, "b", 2), 2);
+
+  // The torn record is removed before appending the next one
+  appdb db{path};
+  std::size_t journal_size = read_journal(path).size();
+  std::string torn_record = append_torn_record(path);
+  set_latency(db, "c0", 0);
+  db.sync();
+  std::string journal = read_journal(path);
+  BOOST_CHECK(journal.size() > journal_size + torn_record.size());
+  BOOST_CHECK(journal.compare(journal_size, torn_record.size(), torn_record) != 0);
+  BOOST_CHECK_EQUAL(count_entries(path, "c", 1), 1);
+  appdb::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_appends) {
+  // Each appdb instance behaves like a separate process that
+  // shares the database.
+  constexpr int num_writers = 4;
+  constexpr std::size_t num_entries = 50;
+  std::string path = get_test_db_path("concurrent_appends");
+
+  std::vector<std::thread> writers;
+  for(int w = 0; w < num_writers; ++w) {
+    writers.emplace_back([&, w]() {
+      appdb db{path};
+      for(std::size_t i = 0; i < num_entries; ++i) {
+        set_latency(db, std::to_string(w) + "-" + std::to_string(i), i);
+        db.sync();
+      }
+    });
+  }
+  for(auto& w : writers)
+    w.join();
+
+  for(int w = 0; w < num_writers; ++w)
+    BOOST_CHECK_EQUAL(count_entries(path, std::to_string(w) + "-", num_entries),
+                      num_entries);
+  appdb::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(compaction) {
+  // Enough data to exceed the journal size that triggers compaction
+  constexpr std::size_t num_entries = 200;
+  const std::string padding(8192, 'x');
+  std::string path = get_test_db_path("compaction");
+  {
+    appdb db{path};
+    set_latency(db, "a0", 0);
+    db.sync();
+  }
+  append_torn_record(path);
+  {
+    appdb db{path};
+    for(std::size_t i = 0; i < num_entries; ++i) {
+      set_latency(db, padding + std::to_string(i), i);
+      db.sync();
+    }
+  }
+  BOOST_CHECK(common::filesystem::file_size(path) > 0);
+  BOOST_CHECK(common::filesystem::file_size(path + ".journal") <
+              num_entries * padding.size());
+  BOOST_CHECK_EQUAL(count_entries(path, "a", 1), 1);
+  BOOST_CHECK_EQUAL(count_entries(path, padding, num_entries), num_entries);
+  appdb::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(torn_tail_after_compaction_by_other_process) {
+  // db only verifies the journal behind the end of its own last record,
+  // which is meaningless once another process has compacted the journal.
+  constexpr std::size_t num_entries = 200;
+  const std::string padding(8192, 'x');
+  std::string path = get_test_db_path("torn_tail_after_compaction");
+
+  appdb db{path};
+  set_latency(db, "a0", 0);
+  db.sync();
+  std::string torn_record = read_journal(path).substr(0, 24);
+  BOOST_REQUIRE_EQUAL(torn_record.size(), 24);
+  {
+    appdb other{path};
+    for(std::size_t i = 0; i < num_entries; ++i) {
+      set_latency(other, padding + std::to_string(i), i);
+      other.sync();
+    }
+  }
+  std::size_t journal_size = read_journal(path).size();
+  common::filesystem::append(path + ".journal", torn_record);
+
+  set_latency(db, "b0", 0);
+  db.sync();
+  std::string journal = read_journal(path);
+  BOOST_CHECK(journal.size() > journal_size + torn_record.size());
+  BOOST_CHECK(journal.compare(journal_size, torn_record.size(), torn_record) != 0);
+  BOOST_CHECK_EQUAL(count_entries(path, "a", 1), 1);
+  BOOST_CHECK_EQUAL(count_entries(path, "b", 1), 1);
+  BOOST_CHECK_EQUAL(count_entries(path, padding, num_entries), num_entries);
+  appdb::remove(path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -14,9 +14,11 @@
 #include "hipSYCL/runtime/kernel_launcher.hpp"
 #include "runtime_test_suite.hpp"
 
+#include <algorithm>
 #include <vector>
 #include <memory>
 #include <hipSYCL/runtime/dag_builder.hpp>
+#include <hipSYCL/runtime/data.hpp>
 
 using namespace hipsycl;
 
@@ -52,4 +54,75 @@ BOOST_AUTO_TEST_CASE(default_hints) {
   node->cancel();
 }
 
+BOOST_AUTO_TEST_CASE(many_subrange_accesses) {
+  // Halo exchange on a 2D grid that is split into one tile per page:
+  // Every tile is written, and then read together with a one-element halo
+  // that reaches into the neighboring tiles, and must only depend on
+  // the writers of these tiles.
+  rt::runtime_keep_alive_token rt;
+  rt::execution_hints hints;
+  rt::device_id id{rt::backend_descriptor{rt::hardware_platform::cpu,
+                                          rt::api_platform::omp},
+                   12345};
+  hints.set_hint(rt::hints::bind_to_device{id});
+  rt::dag_builder builder{rt.get()};
+
+  const std::size_t tile_size = 16;
+  const std::size_t num_tiles = 8;
+  const std::size_t grid_size = num_tiles * tile_size;
+  auto region = std::make_shared<rt::buffer_data_region>(
+      rt::range<3>{grid_size, grid_size, 1}, sizeof(float),
+      rt::range<3>{tile_size, tile_size, 1});
+
+  std::vector<rt::dag_node_ptr> nodes;
+  auto submit = [&](rt::id<2> offset, rt::range<2> range,
+                    sycl::access::mode mode) {
+    rt::requirements_list reqs{rt.get()};
+    reqs.add_requirement<rt::buffer_memory_requirement>(
+        region, offset, range, mode, sycl::access::target::device);
+
+    auto op = rt::make_operation<rt::kernel_operation>(
+        "test_kernel",
+        rt::kernel_launcher{glue::kernel_launcher_data{},
+                            common::auto_small_vector<
+                                std::unique_ptr<rt::backend_kernel_launcher>>{}},
+        reqs);
+    nodes.push_back(builder.add_command_group(std::move(op), reqs, hints));
+    return reqs.get().front();
+  };
+
+  for(std::size_t x = 0; x < num_tiles; ++x)
+    for(std::size_t y = 0; y < num_tiles; ++y)
+      submit(rt::id<2>{x * tile_size, y * tile_size},
+             rt::range<2>{tile_size, tile_size}, sycl::access::mode::write);
+
+  for(std::size_t x = 0; x < num_tiles; ++x) {
+    for(std::size_t y = 0; y < num_tiles; ++y) {
+      std::size_t begin_x = x > 0 ? x * tile_size - 1 : 0;
+      std::size_t begin_y = y > 0 ? y * tile_size - 1 : 0;
+      std::size_t end_x = std::min((x + 1) * tile_size + 1, grid_size);
+      std::size_t end_y = std::min((y + 1) * tile_size + 1, grid_size);
+
+      rt::dag_node_ptr req = submit(
+          rt::id<2>{begin_x, begin_y},
+          rt::range<2>{end_x - begin_x, end_y - begin_y},
+          sycl::access::mode::read);
+
+      // Depends on the writers of the tile and its neighbors
+      std::size_t num_neighbors_x = 1 + (x > 0) + (x + 1 < num_tiles);
+      std::size_t num_neighbors_y = 1 + (y > 0) + (y + 1 < num_tiles);
+      BOOST_CHECK(req->get_requirements().size() ==
+                  num_neighbors_x * num_neighbors_y);
+    }
+  }
+
+  // Reads can neither replace writes nor reads that are not
+  // among their dependencies
+  BOOST_CHECK(region->get_users().get_num_users() ==
+              2 * num_tiles * num_tiles);
+
+  for(auto& node : nodes)
+    node->cancel();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
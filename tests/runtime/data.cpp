@@ -10,15 +10,38 @@
 // SPDX-License-Identifier: BSD-2-Clause
 
 #include "runtime_test_suite.hpp"
+#include "../common/dense_page_table.hpp"
 
 #include <boost/test/tools/old/interface.hpp>
+#include <algorithm>
+#include <random>
 #include <vector>
 #include <memory>
+#include <hipSYCL/runtime/application.hpp>
+#include <hipSYCL/runtime/backend.hpp>
 #include <hipSYCL/runtime/data.hpp>
+#include <hipSYCL/runtime/hw_model/hw_model.hpp>
+#include <hipSYCL/runtime/runtime.hpp>
 #include <hipSYCL/runtime/util.hpp>
 
 using namespace hipsycl;
 
+namespace {
+
+rt::range_store::rect random_rect(std::mt19937 &gen, rt::range<3> size) {
+  rt::range_store::rect r;
+  for(int i = 0; i < 3; ++i) {
+    std::uniform_int_distribution<std::size_t> begin_dist{0, size[i] - 1};
+    r.first[i] = begin_dist(gen);
+    std::uniform_int_distribution<std::size_t> size_dist{1,
+                                                         size[i] - r.first[i]};
+    r.second[i] = size_dist(gen);
+  }
+  return r;
+}
+
+}
+
 BOOST_FIXTURE_TEST_SUITE(data, reset_device_fixture)
 BOOST_AUTO_TEST_CASE(page_table) {
   rt::range_store::rect full_range{rt::id<3>{0, 0, 0},
@@ -79,4 +102,245 @@ BOOST_AUTO_TEST_CASE(page_table) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(page_table_matches_dense_reference) {
+  std::mt19937 gen{42};
+  const rt::range<3> size{7, 9, 13};
+  const rt::range_store::rect full_range{rt::id<3>{0, 0, 0}, size};
+
+  rt::range_store pt{size};
+  dense_page_table reference{size};
+
+  auto check_covers_exactly = [&](const rt::range_store::rect &query,
+                                  const std::vector<rt::range_store::rect> &rects,
+                                  bool value) {
+    dense_page_table coverage{size};
+    for(const auto& r : rects) {
+      // Returned rects must be disjoint and lie within the query range
+      BOOST_CHECK(coverage.entire_range_equals(r, false));
+      coverage.set(r, true);
+      for(int i = 0; i < 3; ++i) {
+        BOOST_CHECK(r.first[i] >= query.first[i]);
+        BOOST_CHECK(r.first[i] + r.second[i] <=
+                    query.first[i] + query.second[i]);
+      }
+    }
+    for(std::size_t x = 0; x < size[0]; ++x)
+      for(std::size_t y = 0; y < size[1]; ++y)
+        for(std::size_t z = 0; z < size[2]; ++z) {
+          rt::id<3> idx{x, y, z};
+          bool in_query = x >= query.first[0] &&
+                          x < query.first[0] + query.second[0] &&
+                          y >= query.first[1] &&
+                          y < query.first[1] + query.second[1] &&
+                          z >= query.first[2] &&
+                          z < query.first[2] + query.second[2];
+          bool expected = in_query && reference.get(idx) == value;
+          BOOST_CHECK(coverage.get(idx) == expected);
+        }
+  };
+
+  std::vector<rt::range_store::rect> intersections;
+  for(int iteration = 0; iteration < 200; ++iteration) {
+    auto r = random_rect(gen, size);
+    if(iteration % 3 == 0) {
+      pt.remove(r);
+      reference.set(r, false);
+    } else {
+      pt.add(r);
+      reference.set(r, true);
+    }
+
+    auto query = random_rect(gen, size);
+    BOOST_CHECK(pt.entire_range_filled(query) ==
+                reference.entire_range_equals(query, true));
+    BOOST_CHECK(pt.entire_range_empty(query) ==
+                reference.entire_range_equals(query, false));
+
+    pt.intersections_with(query, intersections);
+    check_covers_exactly(query, intersections, true);
+    pt.inverted_intersections_with(query, intersections);
+    check_covers_exactly(query, intersections, false);
+  }
+
+  pt.add(full_range);
+  BOOST_CHECK(pt.entire_range_filled(full_range));
+  BOOST_CHECK(pt.get_num_fragments() == 1);
+  pt.remove(full_range);
+  BOOST_CHECK(pt.entire_range_empty(full_range));
+  BOOST_CHECK(pt.get_num_fragments() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(user_tracker_matches_linear_scan) {
+  std::mt19937 gen{42};
+  const rt::range<3> num_elements{200, 150, 40};
+  rt::buffer_data_region region{num_elements, sizeof(int),
+                                rt::range<3>{8, 16, 4}};
+  rt::data_user_tracker& tracker = region.get_users();
+
+  auto pages_intersect = [&](const rt::range_store::rect &a,
+                             const rt::range_store::rect &b) {
+    auto pa = region.get_page_range(a.first, a.second);
+    auto pb = region.get_page_range(b.first, b.second);
+    for(int i = 0; i < 3; ++i)
+      if(pa.first[i] >= pb.first[i] + pb.second[i] ||
+         pb.first[i] >= pa.first[i] + pa.second[i])
+        return false;
+    return true;
+  };
+  auto contains = [](const rt::range_store::rect &outer,
+                     const rt::id<3> &offset, const rt::range<3> &range) {
+    for(int i = 0; i < 3; ++i)
+      if(offset[i] < outer.first[i] ||
+         offset[i] + range[i] > outer.first[i] + outer.second[i])
+        return false;
+    return true;
+  };
+
+  std::vector<rt::range_store::rect> reference;
+  auto random_access = [&]() {
+    // Mostly small accesses, such that most users are indexed
+    if(gen() % 4 == 0)
+      return random_rect(gen, num_elements);
+    rt::range_store::rect r = random_rect(gen, rt::range<3>{24, 24, 8});
+    rt::range_store::rect shift =
+        random_rect(gen, rt::range<3>{num_elements[0] - 24,
+                                      num_elements[1] - 24,
+                                      num_elements[2] - 8});
+    for(int i = 0; i < 3; ++i)
+      r.first[i] += shift.first[i];
+    return r;
+  };
+
+  for(int it = 0; it < 2000; ++it) {
+    rt::range_store::rect r = random_access();
+    if(it % 2 == 0) {
+      // Write accesses replace the users that they contain
+      tracker.add_user(nullptr, sycl::access::mode::write,
+                       sycl::access::target::device, r.first, r.second,
+                       [&](const rt::data_user &user) {
+                         return contains(r, user.offset, user.range);
+                       });
+      reference.erase(std::remove_if(reference.begin(), reference.end(),
+                                     [&](const rt::range_store::rect &u) {
+                                       return contains(r, u.first, u.second);
+                                     }),
+                      reference.end());
+      reference.push_back(r);
+      BOOST_CHECK(tracker.get_num_users() == reference.size());
+    } else {
+      std::vector<rt::range_store::rect> visited;
+      tracker.for_each_overlapping_user(
+          r.first, r.second, [&](rt::data_user &user) {
+            visited.push_back(std::make_pair(user.offset, user.range));
+          });
+      std::size_t num_expected = 0;
+      for(const auto& u : reference) {
+        if(pages_intersect(r, u)) {
+          ++num_expected;
+          BOOST_CHECK(std::count(visited.begin(), visited.end(), u) >= 1);
+        }
+      }
+      BOOST_CHECK(visited.size() >= num_expected);
+      BOOST_CHECK(visited.size() <= reference.size());
+    }
+  }
+
+  tracker.release_dead_users();
+  BOOST_CHECK(tracker.get_num_users() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(fragmented_update_sources) {
+  rt::buffer_data_region region{rt::range<3>{64, 1, 1}, sizeof(int),
+                                rt::range<3>{8, 1, 1}};
+
+  auto make_dev = [](int id) {
+    return rt::device_id{rt::backend_descriptor{rt::hardware_platform::cpu,
+                                                rt::api_platform::omp},
+                         id};
+  };
+  rt::device_id dev0 = make_dev(0);
+  rt::device_id dev1 = make_dev(1);
+  rt::device_id target = make_dev(2);
+
+  region.add_empty_allocation(dev0, nullptr, nullptr, false);
+  region.add_empty_allocation(dev1, nullptr, nullptr, false);
+  region.add_empty_allocation(target, nullptr, nullptr, false);
+
+  // dev0 holds [0, 24), dev1 holds [8, 64)
+  region.mark_range_current(dev0, rt::id<3>{0, 0, 0}, rt::range<3>{64, 1, 1});
+  region.mark_range_current(dev1, rt::id<3>{24, 0, 0}, rt::range<3>{40, 1, 1});
+  region.mark_range_valid(dev1, rt::id<3>{8, 0, 0}, rt::range<3>{16, 1, 1});
+
+  // Not page-aligned, to check that fragments are clamped to the range
+  rt::range_store::rect accessed{rt::id<3>{4, 0, 0}, rt::range<3>{56, 1, 1}};
+
+  std::vector<std::pair<rt::device_id, rt::range_store::rect>> sources;
+  region.get_update_source_candidates(target, accessed, sources);
+  BOOST_CHECK(sources.empty());
+
+  auto check_fragments = [&](rt::device_id preferred, std::size_t split,
+                             rt::device_id lower_source,
+                             rt::device_id upper_source) {
+    BOOST_CHECK(region.get_update_source_fragments(
+        target, accessed,
+        [&](rt::device_id dev) { return dev == preferred ? 1.0 : 2.0; },
+        sources));
+
+    std::size_t total_size = 0;
+    for (const auto &fragment : sources) {
+      std::size_t begin = fragment.second.first[0];
+      std::size_t end = begin + fragment.second.second[0];
+      BOOST_CHECK(begin >= 4);
+      BOOST_CHECK(end <= 60);
+      if (end <= split)
+        BOOST_CHECK(fragment.first == lower_source);
+      else
+        BOOST_CHECK(begin >= split && fragment.first == upper_source);
+      total_size += fragment.second.second.size();
+    }
+    BOOST_CHECK(total_size == accessed.second.size());
+  };
+
+  // Fragments must be taken from the cheapest source that holds them
+  check_fragments(dev1, 8, dev0, dev1);
+  check_fragments(dev0, 24, dev0, dev1);
+
+  // Coverage is incomplete once [0, 24) is only valid on the target
+  region.mark_range_current(target, rt::id<3>{0, 0, 0}, rt::range<3>{24, 1, 1});
+  BOOST_CHECK(!region.get_update_source_fragments(
+      target, accessed, [](rt::device_id) { return 1.0; }, sources));
+  for (const auto &fragment : sources)
+    BOOST_CHECK(fragment.first == dev1 && fragment.second.first[0] >= 24);
+}
+
+BOOST_AUTO_TEST_CASE(memcpy_model_calibration) {
+  rt::runtime_keep_alive_token rt;
+  rt::device_id host{rt::backend_descriptor{rt::hardware_platform::cpu,
+                                            rt::api_platform::omp},
+                     0};
+  const rt::memcpy_model *model =
+      rt.get()->backends().hardware_model().get_memcpy_model();
+
+  // Calibration runs in the background, so the first query may
+  // return the default estimates.
+  model->get_transfer_parameters(host, host);
+  model->wait_for_calibration();
+
+  auto params = model->get_transfer_parameters(host, host);
+  BOOST_CHECK(params.bandwidth > 0.0);
+  BOOST_CHECK(params.latency >= 0.0);
+
+  // Repeated queries must be served from the cached calibration
+  auto cached_params = model->get_transfer_parameters(host, host);
+  BOOST_CHECK(cached_params.bandwidth == params.bandwidth);
+  BOOST_CHECK(cached_params.latency == params.latency);
+
+  BOOST_CHECK(model->estimate_transfer_time(host, host, 1024 * 1024) >
+              model->estimate_transfer_time(host, host, 1024));
+
+  BOOST_TEST_MESSAGE("memcpy_model host->host: latency "
+                     << params.latency << " ns, bandwidth " << params.bandwidth
+                     << " bytes/ns");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,96 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "runtime_test_suite.hpp"
+
+#include <atomic>
+#include <string>
+#include <hipSYCL/runtime/jit_service.hpp>
+
+using namespace hipsycl;
+
+namespace {
+
+rt::jit_service::binary_id make_id(uint64_t value) {
+  rt::jit_service::binary_id id{};
+  id[0] = value;
+  return id;
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(jit_service, reset_device_fixture)
+
+BOOST_AUTO_TEST_CASE(async_result_is_shared_until_forgotten) {
+  rt::jit_service service;
+  std::atomic<int> num_compilations{0};
+  auto task = [&](std::string &out) {
+    ++num_compilations;
+    out = "binary";
+    return true;
+  };
+
+  const auto id = make_id(1);
+  service.compile_async(id, task);
+  service.wait();
+
+  // Every caller collects the same result, e.g. threads launching the
+  // same kernel configuration
+  rt::jit_service::binary_ptr first, second;
+  BOOST_CHECK(service.try_get(id, first) == rt::jit_service::status::ready);
+  BOOST_CHECK(service.try_get(id, second) == rt::jit_service::status::ready);
+  BOOST_REQUIRE(first && second);
+  BOOST_CHECK(first == second);
+  BOOST_CHECK(*first == "binary");
+
+  service.compile_async(id, task);
+  BOOST_CHECK(service.compile(id, task) == first);
+  service.wait();
+  BOOST_CHECK(num_compilations == 1);
+
+  service.forget(id);
+  rt::jit_service::binary_ptr forgotten;
+  BOOST_CHECK(service.try_get(id, forgotten) ==
+              rt::jit_service::status::not_requested);
+  BOOST_CHECK(!forgotten);
+}
+
+BOOST_AUTO_TEST_CASE(failures_are_not_retried) {
+  rt::jit_service service;
+  std::atomic<int> num_compilations{0};
+  auto task = [&](std::string &) {
+    ++num_compilations;
+    return false;
+  };
+
+  const auto async_id = make_id(2);
+  service.compile_async(async_id, task);
+  service.wait();
+  rt::jit_service::binary_ptr binary;
+  BOOST_CHECK(service.try_get(async_id, binary) ==
+              rt::jit_service::status::failed);
+  service.compile_async(async_id, task);
+  BOOST_CHECK(!service.compile(async_id, task));
+  // Forgetting only applies to successful compilations
+  service.forget(async_id);
+  BOOST_CHECK(service.try_get(async_id, binary) ==
+              rt::jit_service::status::failed);
+
+  const auto sync_id = make_id(3);
+  BOOST_CHECK(!service.compile(sync_id, task));
+  BOOST_CHECK(!service.compile(sync_id, task));
+
+  service.wait();
+  BOOST_CHECK(!binary);
+  BOOST_CHECK(num_compilations == 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,114 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "runtime_test_suite.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <hipSYCL/common/msgpack/msgpack.hpp>
+
+namespace {
+
+// Non-zero defaults make sure that unpacking overwrites the
+// previous value of a field instead of accumulating into it.
+template<class T>
+struct packed_value {
+  T value = static_cast<T>(0x5a);
+
+  template<class Packer>
+  void pack(Packer &pack) {
+    pack(value);
+  }
+};
+
+struct packed_vector {
+  std::vector<uint64_t> value;
+
+  template<class Packer>
+  void pack(Packer &pack) {
+    pack(value);
+  }
+};
+
+template<class T>
+void check_round_trip(T value) {
+  packed_value<T> in;
+  in.value = value;
+  auto data = msgpack::pack(in);
+
+  std::error_code ec;
+  auto out = msgpack::unpack<packed_value<T>>(data, ec);
+  BOOST_CHECK(!ec);
+  BOOST_CHECK(out.value == value);
+}
+
+template<class T>
+void check_unsigned_round_trips() {
+  for(uint64_t v : {uint64_t{0}, uint64_t{1}, uint64_t{127}, uint64_t{128},
+                    uint64_t{255}, uint64_t{256}, uint64_t{0x1234},
+                    uint64_t{0xffff}, uint64_t{0x10000}, uint64_t{0x12345678},
+                    uint64_t{0xffffffff}, uint64_t{0x100000000},
+                    uint64_t{1} << 63, std::numeric_limits<uint64_t>::max()}) {
+    if(v <= std::numeric_limits<T>::max())
+      check_round_trip(static_cast<T>(v));
+  }
+}
+
+template<class T>
+void check_signed_round_trips() {
+  for(int64_t v : {int64_t{0}, int64_t{1}, int64_t{-1}, int64_t{-5},
+                   int64_t{-32}, int64_t{-33}, int64_t{127}, int64_t{-128},
+                   int64_t{-129}, int64_t{1000}, int64_t{-1000},
+                   int64_t{-40000}, int64_t{0x12345678}, int64_t{-0x12345678},
+                   std::numeric_limits<int64_t>::min(),
+                   std::numeric_limits<int64_t>::max()}) {
+    if(v >= std::numeric_limits<T>::min() && v <= std::numeric_limits<T>::max())
+      check_round_trip(static_cast<T>(v));
+  }
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(msgpack_tests)
+
+BOOST_AUTO_TEST_CASE(unsigned_integer_round_trip) {
+  check_unsigned_round_trips<uint8_t>();
+  check_unsigned_round_trips<uint16_t>();
+  check_unsigned_round_trips<uint32_t>();
+  check_unsigned_round_trips<uint64_t>();
+}
+
+BOOST_AUTO_TEST_CASE(signed_integer_round_trip) {
+  check_signed_round_trips<int8_t>();
+  check_signed_round_trips<int16_t>();
+  check_signed_round_trips<int32_t>();
+  check_signed_round_trips<int64_t>();
+}
+
+BOOST_AUTO_TEST_CASE(floating_point_round_trip) {
+  for(double v : {0.0, 1.5, -2.25, 1e-30, 3.0e38, 123456.789})
+    check_round_trip(static_cast<float>(v));
+  // Integral values are packed as integers if they fit
+  for(double v : {0.0, 1.5, -2.25, 1e-300, 1e300, 123456.789, 1234567800000.0,
+                  -9.5e18, 1.5e19})
+    check_round_trip(v);
+}
+
+BOOST_AUTO_TEST_CASE(container_round_trip) {
+  packed_vector in;
+  in.value = {0, 300, 70000, uint64_t{1} << 40, uint64_t{1} << 63};
+  auto data = msgpack::pack(in);
+  auto out = msgpack::unpack<packed_vector>(data);
+  BOOST_CHECK(out.value == in.value);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
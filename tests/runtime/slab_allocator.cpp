@@ -0,0 +1,195 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "runtime_test_suite.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include <hipSYCL/runtime/slab_allocator.hpp>
+
+using namespace hipsycl;
+
+namespace {
+
+void fill(void* ptr, std::size_t size, std::uint64_t value) {
+  for(std::size_t i = 0; i + sizeof(value) <= size; i += sizeof(value))
+    std::memcpy(static_cast<char*>(ptr) + i, &value, sizeof(value));
+}
+
+bool is_filled(const void* ptr, std::size_t size, std::uint64_t value) {
+  for(std::size_t i = 0; i + sizeof(value) <= size; i += sizeof(value)) {
+    std::uint64_t current;
+    std::memcpy(&current, static_cast<const char*>(ptr) + i, sizeof(current));
+    if(current != value)
+      return false;
+  }
+  return true;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(slab_allocator)
+
+BOOST_AUTO_TEST_CASE(reuse) {
+  // Freed blocks are reused by the next allocation of the same size class
+  for(std::size_t size : {1, 32, 100, 128, 1000, 1024}) {
+    void* ptr = rt::slab_allocator::allocate(size);
+    rt::slab_allocator::deallocate(ptr, size);
+    void* reused = rt::slab_allocator::allocate(size);
+    BOOST_CHECK(reused == ptr);
+    rt::slab_allocator::deallocate(reused, size);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(no_overlap) {
+  // Live blocks of all size classes must not overlap, including requests
+  // that are forwarded to the global allocator.
+  std::vector<std::pair<void*, std::size_t>> blocks;
+  for(int i = 0; i < 1000; ++i) {
+    std::size_t size = 1 + (i * 37) % (rt::slab_allocator::max_size + 256);
+    void* ptr = rt::slab_allocator::allocate(size);
+    fill(ptr, size, i);
+    blocks.push_back(std::make_pair(ptr, size));
+  }
+  for(std::size_t i = 0; i < blocks.size(); ++i) {
+    BOOST_CHECK(is_filled(blocks[i].first, blocks[i].second, i));
+    rt::slab_allocator::deallocate(blocks[i].first, blocks[i].second);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(cross_thread_free) {
+  constexpr std::size_t size = 512;
+  constexpr std::size_t num_blocks = 1000;
+
+  // One block of each (64 KiB aligned) slab remains allocated, such that
+  // the slabs are not released once the other blocks are freed.
+  constexpr std::uintptr_t slab_size = 64 * 1024;
+
+  std::vector<void*> blocks;
+  std::vector<void*> kept_blocks;
+  std::thread allocating_thread{[&](){
+    std::set<std::uintptr_t> slabs;
+    while(blocks.size() < num_blocks) {
+      void* ptr = rt::slab_allocator::allocate(size);
+      if(slabs.insert(reinterpret_cast<std::uintptr_t>(ptr) / slab_size)
+             .second)
+        kept_blocks.push_back(ptr);
+      else
+        blocks.push_back(ptr);
+    }
+  }};
+  allocating_thread.join();
+
+  // Blocks freed on a thread that did not allocate them and then exits
+  // must become available to all other threads.
+  std::thread freeing_thread{[&](){
+    for(void* ptr : blocks)
+      rt::slab_allocator::deallocate(ptr, size);
+  }};
+  freeing_thread.join();
+
+  // Blocks that are still cached by other threads may be handed out
+  // in between, so allow for some more allocations.
+  std::set<void*> freed_blocks(blocks.begin(), blocks.end());
+  std::vector<void*> reused_blocks;
+  std::size_t num_reused = 0;
+  std::thread reusing_thread{[&](){
+    for(std::size_t i = 0;
+        i < 2 * num_blocks && num_reused < num_blocks; ++i) {
+      void* ptr = rt::slab_allocator::allocate(size);
+      reused_blocks.push_back(ptr);
+      if(freed_blocks.count(ptr))
+        ++num_reused;
+    }
+  }};
+  reusing_thread.join();
+  BOOST_CHECK_EQUAL(num_reused, num_blocks);
+
+  for(void* ptr : reused_blocks)
+    rt::slab_allocator::deallocate(ptr, size);
+  for(void* ptr : kept_blocks)
+    rt::slab_allocator::deallocate(ptr, size);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_cross_thread_free) {
+  // A producer allocates blocks that a consumer frees concurrently, similar
+  // to DAG nodes being released by backend worker threads. A block that is
+  // handed out twice while still alive would have its content overwritten.
+  constexpr std::size_t size = 64;
+  constexpr std::uint64_t num_blocks = 100000;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<std::pair<void*, std::uint64_t>> queue;
+  std::size_t num_corrupted = 0;
+
+  std::thread consumer{[&](){
+    for(std::uint64_t i = 0; i < num_blocks; ++i) {
+      std::pair<void*, std::uint64_t> block;
+      {
+        std::unique_lock<std::mutex> lock{mutex};
+        cv.wait(lock, [&](){ return !queue.empty(); });
+        block = queue.front();
+        queue.pop_front();
+      }
+      if(!is_filled(block.first, size, block.second))
+        ++num_corrupted;
+      rt::slab_allocator::deallocate(block.first, size);
+    }
+  }};
+
+  for(std::uint64_t i = 0; i < num_blocks; ++i) {
+    void* ptr = rt::slab_allocator::allocate(size);
+    fill(ptr, size, i);
+    {
+      std::lock_guard<std::mutex> lock{mutex};
+      queue.push_back(std::make_pair(ptr, i));
+    }
+    cv.notify_one();
+  }
+  consumer.join();
+
+  BOOST_CHECK_EQUAL(num_corrupted, 0);
+}
+
+BOOST_AUTO_TEST_CASE(release_unused_slabs) {
+  // After a burst of allocations has been freed and the freeing thread has
+  // returned its cached blocks, the slabs of the burst are released again.
+  constexpr std::size_t size = 1024;
+  constexpr std::size_t num_blocks = 4096;
+
+  std::size_t num_slabs_before = rt::slab_allocator::get_num_slabs();
+  std::size_t peak_num_slabs = 0;
+  std::thread burst_thread{[&](){
+    std::vector<void*> blocks;
+    for(std::size_t i = 0; i < num_blocks; ++i)
+      blocks.push_back(rt::slab_allocator::allocate(size));
+    peak_num_slabs = rt::slab_allocator::get_num_slabs();
+    for(void* ptr : blocks)
+      rt::slab_allocator::deallocate(ptr, size);
+  }};
+  burst_thread.join();
+
+  std::size_t num_slabs_after = rt::slab_allocator::get_num_slabs();
+  // Partially used slabs from earlier allocations may absorb some blocks
+  BOOST_CHECK_GT(peak_num_slabs,
+                 num_slabs_before + num_blocks * size / (2 * 64 * 1024));
+  // One empty slab per size class may be kept for reuse
+  BOOST_CHECK_LE(num_slabs_after, num_slabs_before + 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,151 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "runtime_test_suite.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <hipSYCL/common/slab_cache.hpp>
+
+using namespace hipsycl;
+
+namespace {
+
+// Same layout as the slabs of the stdpar memory pool, but taken from the
+// heap. At most max_slabs slabs are handed out at a time.
+template<std::size_t MaxSlabs>
+struct test_slabs {
+  static constexpr std::size_t min_block_size = 16;
+  static constexpr std::size_t num_size_classes = 8;
+  static constexpr std::size_t slab_size = 64 * 1024;
+  static constexpr std::size_t max_slabs = MaxSlabs;
+
+  static void* allocate_slab(std::size_t) {
+    if(num_allocated_slabs.fetch_add(1) >= max_slabs) {
+      --num_allocated_slabs;
+      return nullptr;
+    }
+    return std::aligned_alloc(slab_size, slab_size);
+  }
+
+  static void release_slab(void* slab, std::size_t) {
+    --num_allocated_slabs;
+    std::free(slab);
+  }
+
+  inline static std::atomic<std::size_t> num_allocated_slabs = 0;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(slab_cache)
+
+BOOST_AUTO_TEST_CASE(size_classes_and_reuse) {
+  using slabs_t = test_slabs<256>;
+  using cache_t = common::slab_cache<slabs_t>;
+
+  std::mt19937 gen(123);
+  std::uniform_int_distribution<std::size_t> dist{1, cache_t::max_block_size};
+
+  // Threads only allocate and free; all checks happen on the test thread.
+  std::vector<std::pair<void*, std::size_t>> allocs;
+  std::thread allocating_thread{[&]() {
+    for(int i = 0; i < 4096; ++i) {
+      std::size_t size = dist(gen);
+      void* ptr = cache_t::allocate(cache_t::get_size_class(size));
+      if(!ptr)
+        return;
+      std::memset(ptr, static_cast<int>(allocs.size() % 256), size);
+      allocs.push_back(std::make_pair(ptr, size));
+    }
+  }};
+  allocating_thread.join();
+  BOOST_REQUIRE_EQUAL(allocs.size(), 4096);
+
+  for(const auto& alloc : allocs) {
+    BOOST_CHECK(cache_t::get_block_size(cache_t::get_size_class(
+                    alloc.second)) >= alloc.second);
+    BOOST_CHECK(reinterpret_cast<std::uintptr_t>(alloc.first) %
+                    cache_t::min_block_size == 0);
+  }
+
+  // Allocations must not overlap
+  for(std::size_t i = 0; i < allocs.size(); ++i) {
+    const unsigned char* data = static_cast<unsigned char*>(allocs[i].first);
+    for(std::size_t j = 0; j < allocs[i].second; ++j)
+      BOOST_REQUIRE(data[j] == i % 256);
+  }
+
+  // Release half of the allocations on another thread; the blocks
+  // must become available again.
+  std::size_t num_slabs_before_release = cache_t::get_num_slabs();
+  std::thread releasing_thread{[&]() {
+    for(std::size_t i = 0; i < allocs.size(); i += 2)
+      cache_t::deallocate(allocs[i].first,
+                          cache_t::get_size_class(allocs[i].second));
+  }};
+  releasing_thread.join();
+
+  std::size_t num_failed = 0;
+  std::thread reusing_thread{[&]() {
+    for(std::size_t i = 0; i < allocs.size(); i += 2) {
+      void* ptr = cache_t::allocate(cache_t::get_size_class(allocs[i].second));
+      if(ptr)
+        allocs[i].first = ptr;
+      else
+        ++num_failed;
+    }
+  }};
+  reusing_thread.join();
+  BOOST_REQUIRE_EQUAL(num_failed, 0);
+  BOOST_CHECK_LE(cache_t::get_num_slabs(), num_slabs_before_release);
+
+  // Once all blocks are freed, only one empty slab per size class remains.
+  std::thread freeing_thread{[&]() {
+    for(const auto& alloc : allocs)
+      cache_t::deallocate(alloc.first, cache_t::get_size_class(alloc.second));
+  }};
+  freeing_thread.join();
+  BOOST_CHECK_LE(cache_t::get_num_slabs(), cache_t::num_size_classes);
+  BOOST_CHECK_EQUAL(slabs_t::num_allocated_slabs, cache_t::get_num_slabs());
+}
+
+BOOST_AUTO_TEST_CASE(exhausted_slab_source) {
+  using slabs_t = test_slabs<1>;
+  using cache_t = common::slab_cache<slabs_t>;
+
+  std::vector<void*> blocks;
+  void* other_size_class = nullptr;
+  std::thread thread{[&]() {
+    while(void* ptr = cache_t::allocate(0))
+      blocks.push_back(ptr);
+    // Other size classes cannot obtain a slab either
+    other_size_class = cache_t::allocate(1);
+
+    for(void* ptr : blocks)
+      cache_t::deallocate(ptr, 0);
+  }};
+  thread.join();
+
+  BOOST_CHECK(!blocks.empty());
+  BOOST_CHECK(blocks.size() <= slabs_t::slab_size / cache_t::min_block_size);
+  BOOST_CHECK(!other_size_class);
+  // The empty slab is kept for reuse
+  BOOST_CHECK_EQUAL(cache_t::get_num_slabs(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,149 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "hipSYCL/algorithms/algorithm.hpp"
+#include "hipSYCL/algorithms/sort/radix_sort.hpp"
+#include "hipSYCL/algorithms/util/allocation_cache.hpp"
+#include "../sycl_test_suite.hpp"
+using namespace cl;
+
+BOOST_FIXTURE_TEST_SUITE(algorithms_sort_tests, reset_device_fixture)
+
+template <class Key, class Compare>
+void test_radix_sort_by_key(std::size_t problem_size, Compare comp) {
+  sycl::queue q{sycl::property_list{sycl::property::queue::in_order{}}};
+  hipsycl::algorithms::util::allocation_cache cache{
+      hipsycl::algorithms::util::allocation_type::device};
+
+  Key *keys = sycl::malloc_shared<Key>(problem_size, q);
+  int *values = sycl::malloc_shared<int>(problem_size, q);
+
+  // Few distinct keys, such that stability is tested as well
+  std::mt19937 gen{123};
+  std::uniform_int_distribution<int> dist{-100, 100};
+  std::vector<std::pair<Key, int>> expected(problem_size);
+  for(std::size_t i = 0; i < problem_size; ++i) {
+    keys[i] = static_cast<Key>(dist(gen));
+    values[i] = static_cast<int>(i);
+    expected[i] = std::make_pair(keys[i], values[i]);
+  }
+  std::stable_sort(expected.begin(), expected.end(),
+                   [&](const auto &a, const auto &b) {
+                     return comp(a.first, b.first);
+                   });
+
+  {
+    hipsycl::algorithms::util::allocation_group scratch{&cache,
+                                                        q.get_device()};
+    hipsycl::algorithms::sorting::radix_sort_by_key(
+        q, scratch, keys, keys + problem_size, values, comp)
+        .wait();
+  }
+
+  for(std::size_t i = 0; i < problem_size; ++i) {
+    BOOST_CHECK(keys[i] == expected[i].first);
+    BOOST_CHECK(values[i] == expected[i].second);
+  }
+
+  sycl::free(keys, q);
+  sycl::free(values, q);
+}
+
+BOOST_AUTO_TEST_CASE(radix_sort_by_key_int) {
+  for(std::size_t size : {1, 100, 4096, 100000})
+    test_radix_sort_by_key<int>(size, std::less<>{});
+}
+
+BOOST_AUTO_TEST_CASE(radix_sort_by_key_descending) {
+  test_radix_sort_by_key<int64_t>(10000, std::greater<int64_t>{});
+}
+
+BOOST_AUTO_TEST_CASE(radix_sort_by_key_float) {
+  test_radix_sort_by_key<float>(10000, std::less<float>{});
+}
+
+BOOST_AUTO_TEST_CASE(stable_sort_custom_comparator) {
+  struct element {
+    int key;
+    int index;
+  };
+  // Not radix-sortable, so merge sort is used
+  auto comp = [](const element &a, const element &b) { return a.key < b.key; };
+
+  sycl::queue q{sycl::property_list{sycl::property::queue::in_order{}}};
+  hipsycl::algorithms::util::allocation_cache cache{
+      hipsycl::algorithms::util::allocation_type::device};
+
+  for(std::size_t problem_size : {1, 100, 5000, 100000}) {
+    element *data = sycl::malloc_shared<element>(problem_size, q);
+    std::mt19937 gen{42};
+    std::uniform_int_distribution<int> dist{0, 50};
+    std::vector<element> expected(problem_size);
+    for(std::size_t i = 0; i < problem_size; ++i) {
+      data[i] = element{dist(gen), static_cast<int>(i)};
+      expected[i] = data[i];
+    }
+    std::stable_sort(expected.begin(), expected.end(), comp);
+
+    {
+      hipsycl::algorithms::util::allocation_group scratch{&cache,
+                                                          q.get_device()};
+      hipsycl::algorithms::stable_sort(q, scratch, data, data + problem_size,
+                                       comp)
+          .wait();
+    }
+
+    for(std::size_t i = 0; i < problem_size; ++i) {
+      BOOST_CHECK(data[i].key == expected[i].key);
+      BOOST_CHECK(data[i].index == expected[i].index);
+    }
+    sycl::free(data, q);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(stable_sort_signed_zeros) {
+  sycl::queue q{sycl::property_list{sycl::property::queue::in_order{}}};
+  hipsycl::algorithms::util::allocation_cache cache{
+      hipsycl::algorithms::util::allocation_type::device};
+
+  // -0.0 and 0.0 compare equal, so their relative order must be preserved
+  for(std::size_t problem_size : {2, 1000}) {
+    double *data = sycl::malloc_shared<double>(problem_size, q);
+    std::vector<double> expected(problem_size);
+    for(std::size_t i = 0; i < problem_size; ++i) {
+      data[i] = (i % 3 == 0) ? 0.0 : ((i % 3 == 1) ? -0.0 : -1.0);
+      expected[i] = data[i];
+    }
+    std::stable_sort(expected.begin(), expected.end());
+
+    {
+      hipsycl::algorithms::util::allocation_group scratch{&cache,
+                                                          q.get_device()};
+      hipsycl::algorithms::stable_sort(q, scratch, data, data + problem_size)
+          .wait();
+    }
+
+    for(std::size_t i = 0; i < problem_size; ++i) {
+      BOOST_CHECK(data[i] == expected[i]);
+      BOOST_CHECK(std::signbit(data[i]) == std::signbit(expected[i]));
+    }
+    sycl::free(data, q);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1171,6 +1171,78 @@ BOOST_AUTO_TEST_CASE(coarse_grained_events) {
 }
 #endif
 
+#ifdef ACPP_EXT_COMMAND_GRAPH
+BOOST_AUTO_TEST_CASE(command_graph) {
+  using namespace cl;
+  constexpr std::size_t size = 128;
+
+  for(bool in_order : {false, true}) {
+    sycl::queue q = in_order ? sycl::queue{sycl::property::queue::in_order{}}
+                             : sycl::queue{};
+    int *data = sycl::malloc_shared<int>(size, q);
+    for(std::size_t i = 0; i < size; ++i)
+      data[i] = 0;
+
+    int step = 1;
+    std::vector<sycl::event> deps;
+    auto graph = q.AdaptiveCpp_record_graph([&](sycl::queue &q) {
+      int s = step;
+      auto e = q.parallel_for(sycl::range{size}, deps,
+                              [=](sycl::id<1> idx) { data[idx] += s; });
+      q.parallel_for(sycl::range{size}, e,
+                     [=](sycl::id<1> idx) { data[idx] *= 2; });
+    });
+    q.wait();
+    BOOST_CHECK(graph.get_num_nodes() == 2);
+    BOOST_CHECK(data[0] == 2);
+
+    // Replays on out-of-order queues are not ordered with respect to
+    // each other, so each replay depends on the previous one.
+    for(step = 2; step < 5; ++step)
+      deps = q.AdaptiveCpp_replay_graph(graph);
+    for(auto& e : deps)
+      e.wait();
+    q.wait();
+
+    // Replays use the updated step:
+    // ((((0 + 1) * 2 + 2) * 2 + 3) * 2 + 4) * 2
+    for(std::size_t i = 0; i < size; ++i)
+      BOOST_CHECK(data[i] == 52);
+
+    sycl::free(data, q);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(command_graph_external_dependency) {
+  using namespace cl;
+  constexpr std::size_t size = 128;
+
+  sycl::queue q;
+  int *data = sycl::malloc_shared<int>(size, q);
+  for(std::size_t i = 0; i < size; ++i)
+    data[i] = 0;
+
+  std::vector<sycl::event> deps;
+  auto graph = q.AdaptiveCpp_record_graph([&](sycl::queue &q) {
+    q.parallel_for(sycl::range{size}, deps,
+                   [=](sycl::id<1> idx) { data[idx] += 1; });
+  });
+  q.wait();
+
+  // The kernel has not necessarily been submitted to the backend
+  // yet when the replay starts.
+  deps = {q.parallel_for(sycl::range{size},
+                         [=](sycl::id<1> idx) { data[idx] = 10; })};
+  for(auto& e : q.AdaptiveCpp_replay_graph(graph))
+    e.wait();
+  q.wait();
+
+  for(std::size_t i = 0; i < size; ++i)
+    BOOST_CHECK(data[i] == 11);
+
+  sycl::free(data, q);
+}
+#endif
 #ifdef ACPP_EXT_SPECIALIZED
 BOOST_AUTO_TEST_CASE(sycl_specialized) {
   using namespace cl;